@@ -78,6 +78,19 @@ public:
   /// \brief List of fields
   using Fields = std::vector< Field >;
 
+  /// \brief Elements of a summarized array
+  ///
+  /// Every element of `element_size` bytes holds an integer in [lb, ub].
+  struct Elements {
+    MachineInt lb;
+    MachineInt ub;
+    MachineInt element_size;
+
+    bool operator==(const Elements& o) const {
+      return lb == o.lb && ub == o.ub && element_size == o.element_size;
+    }
+  };
+
 private:
   /// \brief Constant aggregate literal
   struct CstLit {
@@ -86,6 +99,15 @@ private:
     bool operator==(const CstLit& o) const { return fields == o.fields; }
   };
 
+  /// \brief Summarized array literal
+  struct SummarizedLit {
+    Elements elements;
+
+    bool operator==(const SummarizedLit& o) const {
+      return elements == o.elements;
+    }
+  };
+
   /// \brief Zero aggregate literal
   struct ZeroLit {
     bool operator==(const ZeroLit&) const { return true; }
@@ -105,7 +127,8 @@ private:
 
 private:
   /// \brief Union type for aggregate literals
-  using Lit = boost::variant< CstLit, ZeroLit, UndefinedLit, VarLit >;
+  using Lit =
+      boost::variant< CstLit, SummarizedLit, ZeroLit, UndefinedLit, VarLit >;
 
 private:
   /// \brief Literal value
@@ -152,6 +175,13 @@ public:
     return AggregateLiteral(Lit(CstLit{fields}), size);
   }
 
+  /// \brief Create a summarized array literal
+  ///
+  /// This is used for large constant arrays, instead of one field per element.
+  static AggregateLiteral summarized(Elements elements, MachineInt size) {
+    return AggregateLiteral(Lit(SummarizedLit{std::move(elements)}), size);
+  }
+
   /// \brief Create a zero-initialized aggregate literal
   static AggregateLiteral zero(MachineInt size) {
     return AggregateLiteral(Lit(ZeroLit{}), size);
@@ -186,6 +216,11 @@ public:
     return boost::apply_visitor(IsType< CstLit >(), this->_lit);
   }
 
+  /// \brief Return true if it's a summarized array literal
+  bool is_summarized() const {
+    return boost::apply_visitor(IsType< SummarizedLit >(), this->_lit);
+  }
+
   /// \brief Return true if it's a zero-initialized aggregate literal
   bool is_zero() const {
     return boost::apply_visitor(IsType< ZeroLit >(), this->_lit);
@@ -206,6 +241,10 @@ private:
   struct GetFields : public boost::static_visitor< const Fields& > {
     const Fields& operator()(const CstLit& lit) const { return lit.fields; }
 
+    const Fields& operator()(const SummarizedLit&) const {
+      ikos_unreachable("trying to call fields() on a summarized array");
+    }
+
     const Fields& operator()(const ZeroLit&) const {
       ikos_unreachable("trying to call fields() on literal zero");
     }
@@ -238,6 +277,10 @@ private:
       ikos_unreachable("trying to call var() on a constant");
     }
 
+    VariableRef operator()(const SummarizedLit&) const {
+      ikos_unreachable("trying to call var() on a summarized array");
+    }
+
     VariableRef operator()(const ZeroLit&) const {
       ikos_unreachable("trying to call var() on literal zero");
     }
@@ -249,6 +292,42 @@ private:
     VariableRef operator()(const VarLit& lit) const { return lit.var; }
   };
 
+private:
+  /// \brief Visitor that returns the elements of a summarized array
+  struct GetElements : public boost::static_visitor< const Elements& > {
+    const Elements& operator()(const CstLit&) const {
+      ikos_unreachable("trying to call elements() on a constant");
+    }
+
+    const Elements& operator()(const SummarizedLit& lit) const {
+      return lit.elements;
+    }
+
+    const Elements& operator()(const ZeroLit&) const {
+      ikos_unreachable("trying to call elements() on literal zero");
+    }
+
+    const Elements& operator()(const UndefinedLit&) const {
+      ikos_unreachable("trying to call elements() on literal undefined");
+    }
+
+    const Elements& operator()(const VarLit&) const {
+      ikos_unreachable("trying to call elements() on a variable");
+    }
+  };
+
+public:
+  /// \brief Get the elements of a summarized array
+  const Elements& elements() const {
+#if BOOST_VERSION == 105800
+    // Workaround for https://svn.boost.org/trac10/ticket/11285
+    GetElements vis;
+    return this->_lit.apply_visitor(vis);
+#else
+    return boost::apply_visitor(GetElements(), this->_lit);
+#endif
+  }
+
 public:
   /// \brief Get the variable
   VariableRef var() const { return boost::apply_visitor(GetVar(), this->_lit); }
@@ -259,6 +338,7 @@ public:
   /// Visitors should implement the following methods:
   ///
   /// R cst(const Fields& fields, const MachineInt& size);
+  /// R summarized(const Elements& elements, const MachineInt& size);
   /// R zero(const MachineInt& size);
   /// R undefined(const MachineInt& size);
   /// R var(VariableRef variable, const MachineInt& size);
@@ -282,6 +362,10 @@ private:
 
     ResultType operator()(const CstLit& lit) { return v.cst(lit.fields, size); }
 
+    ResultType operator()(const SummarizedLit& lit) {
+      return v.summarized(lit.elements, size);
+    }
+
     ResultType operator()(const ZeroLit&) { return v.zero(size); }
 
     ResultType operator()(const UndefinedLit&) { return v.undefined(size); }
@@ -304,6 +388,10 @@ private:
       return v.cst(lit.fields, size);
     }
 
+    ResultType operator()(const SummarizedLit& lit) const {
+      return v.summarized(lit.elements, size);
+    }
+
     ResultType operator()(const ZeroLit&) const { return v.zero(size); }
 
     ResultType operator()(const UndefinedLit&) const {
@@ -354,6 +442,12 @@ private:
       }
     }
 
+    void operator()(const SummarizedLit& lit) const {
+      o << "summarized_aggregate{lb=" << lit.elements.lb
+        << ", ub=" << lit.elements.ub
+        << ", element_size=" << lit.elements.element_size;
+    }
+
     void operator()(const ZeroLit&) const { o << "zero_aggregate{"; }
 
     void operator()(const UndefinedLit&) const { o << "undefined_aggregate{"; }
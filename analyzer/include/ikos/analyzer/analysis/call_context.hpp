@@ -48,15 +48,24 @@
 #include <boost/thread/shared_mutex.hpp>
 
 #include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
 
+#include <ikos/ar/semantic/function.hpp>
 #include <ikos/ar/semantic/statement.hpp>
 
+#include <ikos/analyzer/analysis/option.hpp>
 #include <ikos/analyzer/support/assert.hpp>
 
 namespace ikos {
 namespace analyzer {
 
 /// \brief Represents a calling context
+///
+/// A calling context is either empty (the context of an entry point), a call
+/// statement within a parent context, or the merged context of a function.
+///
+/// A merged context stands for any calling context of a function. It is used
+/// when the context policy stops inlining calls in full contexts.
 class CallContext {
 private:
   /// \brief Parent call context
@@ -65,17 +74,28 @@ private:
   /// \brief Call statement
   ar::CallBase* _call = nullptr;
 
+  /// \brief Function of a merged context, or null
+  ar::Function* _merged = nullptr;
+
+  /// \brief Number of call statements in the context
+  unsigned _depth = 0;
+
 private:
   /// \brief Create an empty call context
   CallContext() = default;
 
   /// \brief Create a call context
   CallContext(CallContext* parent, ar::CallBase* call)
-      : _parent(parent), _call(call) {
+      : _parent(parent), _call(call), _depth(parent->_depth + 1) {
     ikos_assert(this->_parent != nullptr);
     ikos_assert(this->_call != nullptr);
   }
 
+  /// \brief Create the merged call context of the given function
+  explicit CallContext(ar::Function* merged) : _merged(merged) {
+    ikos_assert(this->_merged != nullptr);
+  }
+
 public:
   /// \brief No copy constructor
   CallContext(const CallContext&) = delete;
@@ -93,20 +113,34 @@ public:
   ~CallContext() = default;
 
   /// \brief Return true if this is an empty calling context
-  bool empty() const { return this->_parent == nullptr; }
+  bool empty() const {
+    return this->_parent == nullptr && this->_merged == nullptr;
+  }
+
+  /// \brief Return true if this is the merged context of a function
+  bool is_merged() const { return this->_merged != nullptr; }
+
+  /// \brief Return the function of a merged context
+  ar::Function* merged_function() const {
+    ikos_assert_msg(this->is_merged(), "call context is not merged");
+    return this->_merged;
+  }
+
+  /// \brief Return the number of call statements in the context
+  unsigned depth() const { return this->_depth; }
 
   /// \brief Return true if the calling context has a parent context
   bool has_parent() const { return this->_parent != nullptr; }
 
   /// \brief Return the parent calling context
   CallContext* parent() const {
-    ikos_assert_msg(!this->empty(), "call context is empty");
+    ikos_assert_msg(this->has_parent(), "call context has no parent");
     return this->_parent;
   }
 
   /// \brief Return the call statement leading to this context
   ar::CallBase* call() const {
-    ikos_assert_msg(!this->empty(), "call context is empty");
+    ikos_assert_msg(this->has_parent(), "call context has no call");
     return this->_call;
   }
 
@@ -120,7 +154,7 @@ public:
       }
     }
 
-    return false;
+    return context->_merged == fun;
   }
 
 private:
@@ -129,6 +163,10 @@ private:
 }; // end class CallContext
 
 /// \brief Management of calling contexts
+///
+/// The factory also implements the context policy of the analysis: given the
+/// options, it decides whether a callee is analyzed in a full context or in its
+/// merged context (see `get_callee_context()`).
 class CallContextFactory {
 private:
   boost::shared_mutex _mutex;
@@ -137,11 +175,20 @@ private:
                   std::unique_ptr< CallContext > >
       _map;
 
+  llvm::DenseMap< ar::Function*, std::unique_ptr< CallContext > > _merged_map;
+
+  /// \brief Full call contexts in which each callee was analyzed
+  llvm::DenseMap< ar::Function*, llvm::DenseSet< CallContext* > >
+      _callee_contexts;
+
   std::unique_ptr< CallContext > _empty_call_context;
 
+  /// \brief Analysis options
+  const AnalysisOptions& _opts;
+
 public:
   /// \brief Constructor
-  CallContextFactory();
+  explicit CallContextFactory(const AnalysisOptions& opts);
 
   /// \brief No copy constructor
   CallContextFactory(const CallContextFactory&) = delete;
@@ -167,6 +214,30 @@ public:
   /// \param call Call statement
   CallContext* get_context(CallContext* parent, ar::CallBase* call);
 
+  /// \brief Get or Create the merged call context of the given function
+  CallContext* get_merged(ar::Function* fun);
+
+  /// \brief Return true if the context policy is enabled
+  bool has_context_policy() const {
+    return this->_opts.context_depth ||
+           !this->_opts.context_depth_functions.empty() ||
+           this->_opts.callee_contexts_limit;
+  }
+
+  /// \brief Get the call context of a callee, according to the context policy
+  ///
+  /// Returns the merged context of the callee if the caller context is merged,
+  /// if the depth limit of the callee is reached, or if the callee was already
+  /// analyzed in the maximum number of full contexts. Otherwise, returns the
+  /// full call context.
+  ///
+  /// \param parent Call context of the caller
+  /// \param call Call statement
+  /// \param callee Called function
+  CallContext* get_callee_context(CallContext* parent,
+                                  ar::CallBase* call,
+                                  ar::Function* callee);
+
 }; // end class CallContextFactory
 
 } // end namespace analyzer
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Compiled basic blocks for the value analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#include <ikos/core/domain/machine_int/operator.hpp>
+
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+
+#include <ikos/analyzer/analysis/literal.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Return the machine integer operator of a binary operation, or
+/// boost::none for a floating point operation
+boost::optional< core::machine_int::BinaryOperator > int_bin_operator(
+    ar::BinaryOperation* s);
+
+/// \brief Integer instruction of a compiled basic block
+///
+/// Either an assignment `result = left` or a binary operation
+/// `result = left op right`, on machine integer literals.
+struct IntInstruction {
+  /// \brief Kind of instruction
+  enum Kind { Assign, Apply };
+
+  /// \brief Kind of instruction
+  Kind kind;
+
+  /// \brief Operator, for a binary operation
+  core::machine_int::BinaryOperator op;
+
+  /// \brief Result, a machine integer variable
+  const ScalarLit* result;
+
+  /// \brief Left operand, a machine integer or machine integer variable
+  const ScalarLit* left;
+
+  /// \brief Right operand, or null for an assignment
+  const ScalarLit* right;
+};
+
+/// \brief Basic block compiled for the value analysis
+///
+/// The statements of the basic block are grouped into steps. A step is either
+/// a run of consecutive integer assignments and binary operations, with
+/// pre-resolved literals, or a single statement that goes through the generic
+/// transfer function. Without integer runs, every statement is a single step.
+class CompiledBlock {
+public:
+  /// \brief Step of a compiled basic block
+  struct Step {
+    /// \brief Statement, or null for a run of integer instructions
+    ar::Statement* stmt;
+
+    /// \brief Integer instructions, if `stmt` is null
+    std::vector< IntInstruction > instructions;
+  };
+
+private:
+  using StepList = std::vector< Step >;
+
+public:
+  using StepIterator = StepList::const_iterator;
+
+private:
+  /// \brief Steps
+  StepList _steps;
+
+public:
+  /// \brief Compile the given basic block
+  ///
+  /// \param bb The basic block
+  /// \param lit_factory The literal factory
+  /// \param int_runs True to group integer statements into runs
+  CompiledBlock(ar::BasicBlock* bb, LiteralFactory& lit_factory, bool int_runs);
+
+  /// \brief No copy constructor
+  CompiledBlock(const CompiledBlock&) = delete;
+
+  /// \brief No move constructor
+  CompiledBlock(CompiledBlock&&) = delete;
+
+  /// \brief No copy assignment operator
+  CompiledBlock& operator=(const CompiledBlock&) = delete;
+
+  /// \brief No move assignment operator
+  CompiledBlock& operator=(CompiledBlock&&) = delete;
+
+  /// \brief Destructor
+  ~CompiledBlock();
+
+  /// \brief Begin iterator over the steps
+  StepIterator begin() const { return this->_steps.cbegin(); }
+
+  /// \brief End iterator over the steps
+  StepIterator end() const { return this->_steps.cend(); }
+
+private:
+  /// \brief Compile a statement into an integer instruction, if possible
+  static boost::optional< IntInstruction > compile(ar::Statement* s,
+                                                   LiteralFactory& lit_factory);
+
+}; // end class CompiledBlock
+
+/// \brief Create and cache compiled basic blocks
+///
+/// Blocks are compiled on first use, so that each basic block is compiled
+/// once instead of at every fixpoint iteration and calling context.
+class CompiledBlockFactory {
+private:
+  /// \brief Map from ar::BasicBlock* to CompiledBlock
+  ///
+  /// Must be a data structure that does not invalidate references on
+  /// insertions.
+  using Map =
+      std::unordered_map< ar::BasicBlock*, std::unique_ptr< CompiledBlock > >;
+
+private:
+  /// \brief Mutex
+  boost::shared_mutex _mutex;
+
+  /// \brief Literal factory
+  LiteralFactory& _lit_factory;
+
+  /// \brief True to group integer statements into runs
+  bool _int_runs;
+
+  /// \brief Map from ar::BasicBlock* to CompiledBlock
+  Map _map;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param lit_factory The literal factory
+  /// \param int_runs True to group integer statements into runs, false to
+  /// execute basic blocks statement by statement
+  CompiledBlockFactory(LiteralFactory& lit_factory, bool int_runs);
+
+  /// \brief No copy constructor
+  CompiledBlockFactory(const CompiledBlockFactory&) = delete;
+
+  /// \brief No move constructor
+  CompiledBlockFactory(CompiledBlockFactory&&) = delete;
+
+  /// \brief No copy assignment operator
+  CompiledBlockFactory& operator=(const CompiledBlockFactory&) = delete;
+
+  /// \brief No move assignment operator
+  CompiledBlockFactory& operator=(CompiledBlockFactory&&) = delete;
+
+  /// \brief Destructor
+  ~CompiledBlockFactory();
+
+  /// \brief Get the compiled basic block
+  const CompiledBlock& get(ar::BasicBlock* bb);
+
+}; // end class CompiledBlockFactory
+
+} // end namespace analyzer
+} // end namespace ikos
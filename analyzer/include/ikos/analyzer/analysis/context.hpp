@@ -45,6 +45,8 @@
 
 #include <boost/filesystem.hpp>
 
+#include <ikos/core/domain/memory/value/cell_summarization.hpp>
+
 #include <ikos/ar/semantic/bundle.hpp>
 
 #include <ikos/analyzer/analysis/option.hpp>
@@ -57,10 +59,13 @@ class OutputDatabase;
 class MemoryFactory;
 class VariableFactory;
 class LiteralFactory;
+class CompiledBlockFactory;
 class CallContextFactory;
 class LivenessAnalysis;
 class FunctionPointerAnalysis;
 class PointerAnalysis;
+class Profiler;
+class SummaryStore;
 class FixpointParameters;
 
 /// \brief Global analysis context
@@ -89,6 +94,9 @@ public:
   /// \brief Literal factory
   LiteralFactory* lit_factory;
 
+  /// \brief Compiled basic block factory
+  CompiledBlockFactory* block_factory;
+
   /// \brief Call context factory
   CallContextFactory* call_context_factory;
 
@@ -104,6 +112,15 @@ public:
   /// \brief Pointer analysis, or null
   PointerAnalysis* pointer;
 
+  /// \brief Profiler of the value analysis, or null
+  Profiler* profiler;
+
+  /// \brief Cell summarization of the value analysis, or null
+  core::memory::CellSummarization* cell_summarization;
+
+  /// \brief Persistent store of function summaries, or null
+  SummaryStore* summary_store;
+
 public:
   /// \brief Constructor
   Context(ar::Bundle* bundle_,
@@ -113,6 +130,7 @@ public:
           MemoryFactory& mem_factory_,
           VariableFactory& var_factory_,
           LiteralFactory& lit_factory_,
+          CompiledBlockFactory& block_factory_,
           CallContextFactory& call_context_factory_,
           FixpointParameters& fixpoint_parameters_)
       : bundle(bundle_),
@@ -122,11 +140,15 @@ public:
         mem_factory(&mem_factory_),
         var_factory(&var_factory_),
         lit_factory(&lit_factory_),
+        block_factory(&block_factory_),
         call_context_factory(&call_context_factory_),
         fixpoint_parameters(&fixpoint_parameters_),
         liveness(nullptr),
         function_pointer(nullptr),
-        pointer(nullptr) {}
+        pointer(nullptr),
+        profiler(nullptr),
+        cell_summarization(nullptr),
+        summary_store(nullptr) {}
 
   /// \brief No copy constructor
   Context(const Context&) = delete;
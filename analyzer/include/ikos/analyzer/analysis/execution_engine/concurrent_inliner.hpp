@@ -53,6 +53,8 @@
 
 #include <llvm/ADT/Optional.h>
 
+#include <boost/optional.hpp>
+
 #include <ikos/ar/semantic/function.hpp>
 #include <ikos/ar/semantic/statement.hpp>
 #include <ikos/ar/verify/type.hpp>
@@ -61,6 +63,8 @@
 #include <ikos/analyzer/analysis/execution_engine/fixpoint_cache.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
 #include <ikos/analyzer/analysis/pointer/value.hpp>
+#include <ikos/analyzer/analysis/profiler.hpp>
+#include <ikos/analyzer/analysis/summary_store.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -196,6 +200,9 @@ private:
     /// \brief Call statement
     ar::CallBase* _call;
 
+    /// \brief True to check properties on the callees
+    bool _check_callees;
+
     /// \brief Analyses on callees
     std::vector< CalleeAnalysis >& _callee_analyses;
 
@@ -209,6 +216,7 @@ private:
                  FunctionFixpoint& caller,
                  FixpointCacheT& callees_cache,
                  ar::CallBase* call,
+                 bool check_callees,
                  std::vector< CalleeAnalysis >& callee_analyses,
                  AbstractDomain post)
         : _ctx(ctx),
@@ -216,6 +224,7 @@ private:
           _caller(caller),
           _callees_cache(callees_cache),
           _call(call),
+          _check_callees(check_callees),
           _callee_analyses(callee_analyses),
           _post(std::move(post)) {}
 
@@ -226,6 +235,7 @@ private:
           _caller(parent._caller),
           _callees_cache(parent._callees_cache),
           _call(parent._call),
+          _check_callees(parent._check_callees),
           _callee_analyses(parent._callee_analyses),
           _post(llvm::None) {}
 
@@ -260,8 +270,44 @@ private:
       // Assign parameters
       engine.match_down(this->_call, analysis.callee);
 
+      if (_ctx.profiler != nullptr) {
+        _ctx.profiler->count(analysis.callee,
+                             Profiler::FunctionOperation::InlinedCall);
+      }
+
       analysis.fixpoint = nullptr;
 
+      // Precondition of a summary of the callee, if it can be summarized
+      boost::optional< SummaryStore::Precondition > precondition =
+          summary_precondition(_ctx,
+                               this->_call,
+                               analysis.callee,
+                               engine.inv());
+
+      if (precondition && !this->_check_callees) {
+        // Apply a summary from a previous analysis, if any
+        //
+        // Callees are still analyzed when checking, to report their checks.
+        boost::optional< FunctionSummary > summary =
+            _ctx.summary_store->find(analysis.callee, _ctx.opts, *precondition);
+        if (summary) {
+          NumericalExecutionEngineT summary_engine = this->_engine.fork();
+          summary_engine.inv().ignore_exceptions();
+          apply_summary(_ctx, this->_call, *summary, summary_engine.inv());
+          this->post_join(std::move(summary_engine.inv()));
+          return;
+        }
+      }
+
+      if (precondition && !is_exact_precondition(_ctx,
+                                                 analysis.callee,
+                                                 *precondition,
+                                                 engine.inv())) {
+        // The result of the callee depends on more than the precondition (e.g,
+        // relations between parameters), it cannot be exported as a summary
+        precondition = boost::none;
+      }
+
       if (_ctx.opts.use_fixpoint_cache && this->_caller.converged()) {
         // Try to fetch the previously computed fix-point
         analysis.fixpoint =
@@ -283,6 +329,23 @@ private:
 
         // Run analysis on callee
         analysis.fixpoint->run(std::move(engine.inv()));
+      } else if (_ctx.profiler != nullptr) {
+        _ctx.profiler->count(analysis.callee,
+                             Profiler::FunctionOperation::CacheHit);
+      }
+
+      if (precondition) {
+        // Export the summary of the callee
+        boost::optional< FunctionSummary > summary =
+            make_summary(_ctx,
+                         std::move(*precondition),
+                         analysis.fixpoint->exit_invariant(),
+                         analysis.fixpoint->return_stmt());
+        if (summary) {
+          _ctx.summary_store->insert(analysis.callee,
+                                     _ctx.opts,
+                                     std::move(*summary));
+        }
       }
 
       // Return statement in the callee, or null
@@ -470,6 +533,12 @@ private:
         return;
       }
 
+      if (!this->_caller.inline_calls()) {
+        // Inlining disabled by the memory or time budget
+        this->_engine.exec_unknown_intern_call(call);
+        return;
+      }
+
       //
       // Analyze recursively the callee
       //
@@ -482,6 +551,7 @@ private:
                         this->_caller,
                         this->_callees_cache,
                         call,
+                        this->_check_callees,
                         callee_analyses,
                         std::move(post));
     tbb::blocked_range< size_t > range(0, callee_analyses.size());
@@ -489,6 +559,11 @@ private:
 
     // Non-thread safe
     for (CalleeAnalysis& analysis : callee_analyses) {
+      if (analysis.fixpoint == nullptr) {
+        // A summary was applied
+        continue;
+      }
+
       if (this->_check_callees) {
         // Run the checks on the callee
         analysis.fixpoint->run_checks();
@@ -132,6 +132,12 @@ public:
     this->_call_map[call][callee] = std::move(fixpoint);
   }
 
+  /// \brief Remove all the fixpoints, to release memory
+  void clear() {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    this->_call_map.clear();
+  }
+
 }; // end class FixpointCache
 
 } // end namespace analyzer
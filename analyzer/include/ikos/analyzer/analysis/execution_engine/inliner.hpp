@@ -46,7 +46,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
+#include <vector>
+
+#include <boost/optional.hpp>
 
 #include <ikos/ar/semantic/function.hpp>
 #include <ikos/ar/semantic/statement.hpp>
@@ -54,8 +58,11 @@
 
 #include <ikos/analyzer/analysis/execution_engine/engine.hpp>
 #include <ikos/analyzer/analysis/execution_engine/fixpoint_cache.hpp>
+#include <ikos/analyzer/analysis/execution_engine/merged_callees.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
 #include <ikos/analyzer/analysis/pointer/value.hpp>
+#include <ikos/analyzer/analysis/profiler.hpp>
+#include <ikos/analyzer/analysis/summary_store.hpp>
 #include <ikos/analyzer/util/demangle.hpp>
 #include <ikos/analyzer/util/log.hpp>
 
@@ -69,6 +76,10 @@ namespace analyzer {
 /// the callee returns by simulating call-by-ref and updating the return value
 /// at the call site. The inlining also supports function pointers by resolving
 /// first the set of possible callees and joining the results.
+///
+/// Depending on the context policy (see CallContextFactory), a callee might be
+/// analyzed in its merged context instead, with an entry invariant shared by
+/// all its merged calls.
 template < typename FunctionFixpoint, typename AbstractDomain >
 class InlineCallExecutionEngine final : public CallExecutionEngine {
 public:
@@ -76,6 +87,7 @@ public:
       InlineCallExecutionEngine< FunctionFixpoint, AbstractDomain >;
   using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
   using FixpointCacheT = FixpointCache< FunctionFixpoint, AbstractDomain >;
+  using MergedCalleesT = MergedCallees< FunctionFixpoint, AbstractDomain >;
 
 private:
   /// \brief Analysis context
@@ -268,7 +280,8 @@ private:
       ikos_assert(callee->is_definition());
 
       if (this->_caller.function() == callee ||
-          this->_caller.call_context()->contains(callee)) {
+          this->_caller.call_context()->contains(callee) ||
+          this->_caller.merged_callees().is_active(callee)) {
         // Recursive function call
         //
         // TODO(jnavas): we can be more precise by making top only lhs of
@@ -278,6 +291,23 @@ private:
         return;
       }
 
+      if (!this->_caller.inline_calls()) {
+        // Inlining disabled by the memory or time budget
+        this->_engine.exec_unknown_intern_call(call);
+        return;
+      }
+
+      if (_ctx.profiler != nullptr) {
+        _ctx.profiler->count(callee, Profiler::FunctionOperation::InlinedCall);
+      }
+
+      // Call context of the callee, according to the context policy
+      CallContextFactory* factory = _ctx.call_context_factory;
+      CallContext* callee_context =
+          factory->get_callee_context(this->_caller.call_context(),
+                                      call,
+                                      callee);
+
       NumericalExecutionEngineT engine = this->_engine.fork();
 
       // Do not propagate exceptions from the caller to the callee
@@ -286,50 +316,101 @@ private:
       // Assign parameters
       engine.match_down(call, callee);
 
-      //
-      // Analyze recursively the callee
-      //
+      // Return statement in the callee, or null
+      ar::ReturnValue* return_stmt = nullptr;
+
+      if (callee_context->is_merged()) {
+        // Analyze the callee in its merged context
+        const FunctionFixpoint& callee_fixpoint =
+            this->analyze_merged(callee_context, callee, engine.inv());
+        return_stmt = callee_fixpoint.return_stmt();
+        engine.set_inv(callee_fixpoint.exit_invariant());
+      } else {
+        // Precondition of a summary of the callee, if it can be summarized
+        boost::optional< SummaryStore::Precondition > precondition =
+            summary_precondition(_ctx, call, callee, engine.inv());
+
+        if (precondition && !this->_check_callees) {
+          // Apply a summary from a previous analysis, if any
+          //
+          // Callees are still analyzed when checking, to report their checks.
+          boost::optional< FunctionSummary > summary =
+              _ctx.summary_store->find(callee, _ctx.opts, *precondition);
+          if (summary) {
+            NumericalExecutionEngineT summary_engine = this->_engine.fork();
+            summary_engine.inv().ignore_exceptions();
+            apply_summary(_ctx, call, *summary, summary_engine.inv());
+            post.join_with(std::move(summary_engine.inv()));
+            continue;
+          }
+        }
 
-      std::unique_ptr< FunctionFixpoint > callee_fixpoint = nullptr;
+        if (precondition &&
+            !is_exact_precondition(_ctx, callee, *precondition, engine.inv())) {
+          // The result of the callee depends on more than the precondition
+          // (e.g, relations between parameters), it cannot be exported as a
+          // summary
+          precondition = boost::none;
+        }
 
-      if (_ctx.opts.use_fixpoint_cache && this->_caller.converged()) {
-        // Try to fetch the previously computed fix-point
-        callee_fixpoint = this->_callees_cache.try_fetch(call, callee);
-      }
+        //
+        // Analyze recursively the callee
+        //
 
-      if (callee_fixpoint == nullptr) {
-        if (_ctx.opts.use_fixpoint_cache) {
-          // Erase the previous fix-point on the callee
-          this->_callees_cache.erase(call, callee);
+        std::unique_ptr< FunctionFixpoint > callee_fixpoint = nullptr;
+
+        if (_ctx.opts.use_fixpoint_cache && this->_caller.converged()) {
+          // Try to fetch the previously computed fix-point
+          callee_fixpoint = this->_callees_cache.try_fetch(call, callee);
         }
 
-        // Create a fixpoint on the callee
-        callee_fixpoint = std::make_unique< FunctionFixpoint >(_ctx,
-                                                               this->_caller,
-                                                               call,
-                                                               callee);
+        if (callee_fixpoint == nullptr) {
+          if (_ctx.opts.use_fixpoint_cache) {
+            // Erase the previous fix-point on the callee
+            this->_callees_cache.erase(call, callee);
+          }
+
+          // Create a fixpoint on the callee
+          callee_fixpoint = std::make_unique< FunctionFixpoint >(_ctx,
+                                                                 this->_caller,
+                                                                 callee_context,
+                                                                 callee);
+
+          // Run analysis on callee
+          log::debug("Analyzing function '" + demangle(callee->name()) + "'");
+          callee_fixpoint->run(std::move(engine.inv()));
+        } else if (_ctx.profiler != nullptr) {
+          _ctx.profiler->count(callee, Profiler::FunctionOperation::CacheHit);
+        }
 
-        // Run analysis on callee
-        log::debug("Analyzing function '" + demangle(callee->name()) + "'");
-        callee_fixpoint->run(std::move(engine.inv()));
-      }
+        if (this->_check_callees) {
+          // Run the checks on the callee
+          callee_fixpoint->run_checks();
+        }
 
-      if (this->_check_callees) {
-        // Run the checks on the callee
-        callee_fixpoint->run_checks();
-      }
+        if (precondition) {
+          // Export the summary of the callee
+          boost::optional< FunctionSummary > summary =
+              make_summary(_ctx,
+                           std::move(*precondition),
+                           callee_fixpoint->exit_invariant(),
+                           callee_fixpoint->return_stmt());
+          if (summary) {
+            _ctx.summary_store->insert(callee, _ctx.opts, std::move(*summary));
+          }
+        }
 
-      // Return statement in the callee, or null
-      ar::ReturnValue* return_stmt = callee_fixpoint->return_stmt();
+        return_stmt = callee_fixpoint->return_stmt();
 
-      engine.set_inv(callee_fixpoint->exit_invariant());
+        engine.set_inv(callee_fixpoint->exit_invariant());
 
-      if (_ctx.opts.use_fixpoint_cache) {
-        // Save the fix-point for later
-        this->_callees_cache.store(call, callee, std::move(callee_fixpoint));
-      } else {
-        // Delete the callee fix-point
-        callee_fixpoint.reset();
+        if (_ctx.opts.use_fixpoint_cache) {
+          // Save the fix-point for later
+          this->_callees_cache.store(call, callee, std::move(callee_fixpoint));
+        } else {
+          // Delete the callee fix-point
+          callee_fixpoint.reset();
+        }
       }
 
       // Merge exceptions in caught_exceptions, in case it's an invoke
@@ -342,12 +423,162 @@ private:
       }
 
       engine.match_up(call, return_stmt);
+
+      if (callee_context->is_merged()) {
+        this->restore_caller_registers(engine.inv(), call);
+      }
+
       post.join_with(std::move(engine.inv()));
     }
 
     this->_engine.set_inv(std::move(post));
   }
 
+  /// \brief Analyze a callee in its merged context
+  ///
+  /// Joins the invariant at the call in the entry invariant of the callee, and
+  /// analyzes the callee again if the entry invariant changed.
+  ///
+  /// Checks are not run here: the fixpoint might still change with other
+  /// calls. They are run once all entry points have been analyzed.
+  ///
+  /// \param callee_context The merged context of the callee
+  /// \param callee The called function
+  /// \param inv The invariant after the matching of parameters
+  const FunctionFixpoint& analyze_merged(CallContext* callee_context,
+                                         ar::Function* callee,
+                                         AbstractDomain& inv) {
+    MergedCalleesT& merged_callees = this->_caller.merged_callees();
+    inv.normalize();
+
+    typename MergedCalleesT::Entry& entry = merged_callees.get(callee, inv);
+
+    if (inv.leq(entry.entry_inv) && merged_callees.is_reusable(entry)) {
+      if (_ctx.profiler != nullptr) {
+        _ctx.profiler->count(callee, Profiler::FunctionOperation::CacheHit);
+      }
+      merged_callees.reuse(entry);
+      return *entry.fixpoint;
+    }
+
+    entry.entry_inv.join_with(inv);
+
+    // Create a fixpoint on the callee
+    auto callee_fixpoint = std::make_unique< FunctionFixpoint >(_ctx,
+                                                                this->_caller,
+                                                                callee_context,
+                                                                callee);
+
+    // Run analysis on callee
+    log::debug("Analyzing function '" + demangle(callee->name()) +
+               "' in its merged context");
+    merged_callees.start_fixpoint();
+    callee_fixpoint->run(entry.entry_inv);
+    merged_callees.end_fixpoint(entry);
+
+    entry.fixpoint = std::move(callee_fixpoint);
+    return *entry.fixpoint;
+  }
+
+  /// \brief Restore the internal variables of the callers after a call in a
+  /// merged context
+  ///
+  /// The entry invariant of a merged callee is shared with other callers, so
+  /// its exit invariant loses the information on the internal variables of
+  /// the current call stack. Since the callee cannot update them, refine the
+  /// ones that can still be read with their values before the call.
+  void restore_caller_registers(AbstractDomain& inv, ar::CallBase* call) {
+    inv.normal().normalize();
+
+    if (inv.is_normal_flow_bottom()) {
+      return;
+    }
+
+    const AbstractDomain& pre = this->inv();
+    ar::Value* result = call->has_result() ? call->result() : nullptr;
+
+    // Calls of the current call stack, starting with `call`
+    std::vector< ar::CallBase* > stack = {call};
+    for (CallContext* context = this->_caller.call_context();
+         context->has_parent();
+         context = context->parent()) {
+      stack.push_back(context->call());
+    }
+
+    for (ar::CallBase* stack_call : stack) {
+      for (ar::InternalVariable* iv : this->registers_live_after(stack_call)) {
+        ar::Type* type = iv->type();
+
+        if (iv == result ||
+            !(type->is_integer() || type->is_float() || type->is_pointer())) {
+          continue;
+        }
+
+        // The value after the call is the join of the values of all the
+        // callers, which includes the value before the call
+        Variable* var = _ctx.var_factory->get_internal(iv);
+        inv.normal().uninit_refine(var,
+                                   pre.normal().uninit_to_uninitialized(var));
+        if (type->is_integer()) {
+          inv.normal().int_refine(var, pre.normal().int_to_interval(var));
+        } else if (type->is_pointer()) {
+          inv.normal().pointer_refine(var,
+                                      pre.normal().pointer_to_pointer(var));
+        }
+      }
+    }
+  }
+
+  /// \brief Return the internal variables of the function containing `call`
+  /// that can be read after it
+  ///
+  /// Without liveness information, return all its internal variables.
+  std::vector< ar::InternalVariable* > registers_live_after(
+      ar::CallBase* call) const {
+    std::vector< ar::InternalVariable* > registers;
+    ar::BasicBlock* bb = call->parent();
+
+    // Variables live at the end of the basic block
+    bool has_liveness = (_ctx.liveness != nullptr);
+    for (auto it = bb->successor_begin(), et = bb->successor_end();
+         has_liveness && it != et;
+         ++it) {
+      auto live = _ctx.liveness->live_at_entry(*it);
+      if (!live) {
+        has_liveness = false;
+        break;
+      }
+      for (Variable* var : *live) {
+        if (auto iv = dyn_cast< InternalVariable >(var)) {
+          registers.push_back(iv->internal_var());
+        }
+      }
+    }
+
+    if (!has_liveness) {
+      ar::Code* body = bb->code();
+      return {body->internal_variable_begin(), body->internal_variable_end()};
+    }
+
+    // Variables used by the statements after the call
+    auto it = std::find(bb->begin(), bb->end(), call);
+    ikos_assert(it != bb->end());
+    for (++it; it != bb->end(); ++it) {
+      ar::Statement* stmt = *it;
+      for (auto op = stmt->op_begin(), op_et = stmt->op_end(); op != op_et;
+           ++op) {
+        if (auto iv = dyn_cast< ar::InternalVariable >(*op)) {
+          registers.push_back(iv);
+        }
+      }
+    }
+
+    std::sort(registers.begin(), registers.end());
+    registers.erase(std::unique(registers.begin(), registers.end()),
+                    registers.end());
+    return registers;
+  }
+
 }; // end class InlineCallExecutionEngine
 
 } // end namespace analyzer
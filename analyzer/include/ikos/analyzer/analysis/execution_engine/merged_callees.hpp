@@ -0,0 +1,207 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Fixpoints of functions analyzed in merged call contexts
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+
+#include <ikos/ar/semantic/function.hpp>
+
+#include <ikos/analyzer/support/assert.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Fixpoints of functions analyzed in their merged call context
+///
+/// A function analyzed in its merged context has a single entry invariant,
+/// the join of the invariants at all its merged calls, and a single fixpoint
+/// on that invariant. The inliner reuses the fixpoint as long as the invariant
+/// at a call is included in the entry invariant.
+///
+/// This class also keeps track of the functions currently being analyzed, to
+/// detect recursive calls that go through merged contexts.
+///
+/// It is only meant for the sequential analysis.
+template < typename FunctionFixpoint, typename AbstractDomain >
+class MergedCallees {
+public:
+  /// \brief Analysis of a function in its merged context
+  struct Entry {
+    /// \brief Join of the invariants at the calls
+    AbstractDomain entry_inv;
+
+    /// \brief Fixpoint on the entry invariant, or null
+    std::unique_ptr< FunctionFixpoint > fixpoint;
+
+    /// \brief Functions analyzed during the computation of the fixpoint
+    llvm::DenseSet< ar::Function* > footprint;
+
+    explicit Entry(AbstractDomain inv) : entry_inv(std::move(inv)) {}
+  };
+
+private:
+  /// \brief Map from function to entry
+  llvm::DenseMap< ar::Function*, std::unique_ptr< Entry > > _map;
+
+  /// \brief Functions in the order of creation of their entries
+  std::vector< ar::Function* > _functions;
+
+  /// \brief Number of active analyses for each function
+  llvm::DenseMap< ar::Function*, unsigned > _active;
+
+  /// \brief Footprints of the merged fixpoints being computed
+  std::vector< llvm::DenseSet< ar::Function* > > _footprints;
+
+public:
+  /// \brief Constructor
+  MergedCallees() = default;
+
+  /// \brief No copy constructor
+  MergedCallees(const MergedCallees&) = delete;
+
+  /// \brief No move constructor
+  MergedCallees(MergedCallees&&) = delete;
+
+  /// \brief No copy assignment operator
+  MergedCallees& operator=(const MergedCallees&) = delete;
+
+  /// \brief No move assignment operator
+  MergedCallees& operator=(MergedCallees&&) = delete;
+
+  /// \brief Destructor
+  ~MergedCallees() = default;
+
+  /// \brief Return the entry of the given function, creating it if needed
+  ///
+  /// \param fun The function
+  /// \param inv The entry invariant of a new entry
+  Entry& get(ar::Function* fun, const AbstractDomain& inv) {
+    auto it = this->_map.find(fun);
+    if (it != this->_map.end()) {
+      return *it->second;
+    }
+    this->_functions.push_back(fun);
+    auto res = this->_map.try_emplace(fun, std::make_unique< Entry >(inv));
+    return *res.first->second;
+  }
+
+  /// \brief Return the functions with an entry, in order of creation
+  const std::vector< ar::Function* >& functions() const {
+    return this->_functions;
+  }
+
+  /// \brief Return the entry of the given function, or null
+  Entry* find(ar::Function* fun) const {
+    auto it = this->_map.find(fun);
+    if (it != this->_map.end()) {
+      return it->second.get();
+    }
+    return nullptr;
+  }
+
+  /// \brief Notify the beginning of the analysis of a function
+  void enter(ar::Function* fun) {
+    this->_active[fun]++;
+    if (!this->_footprints.empty()) {
+      this->_footprints.back().insert(fun);
+    }
+  }
+
+  /// \brief Notify the end of the analysis of a function
+  void leave(ar::Function* fun) {
+    auto it = this->_active.find(fun);
+    ikos_assert(it != this->_active.end() && it->second > 0);
+    it->second--;
+  }
+
+  /// \brief Return true if the given function is being analyzed
+  bool is_active(ar::Function* fun) const {
+    auto it = this->_active.find(fun);
+    return it != this->_active.end() && it->second > 0;
+  }
+
+  /// \brief Return true if the fixpoint of the given entry can be reused
+  ///
+  /// The fixpoint cannot be reused if a function analyzed during its
+  /// computation is currently being analyzed. The fixpoint would then contain
+  /// the effects of a recursive call.
+  bool is_reusable(const Entry& entry) const {
+    if (entry.fixpoint == nullptr) {
+      return false;
+    }
+    for (ar::Function* fun : entry.footprint) {
+      if (this->is_active(fun)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Notify the reuse of the fixpoint of the given entry
+  void reuse(const Entry& entry) {
+    if (!this->_footprints.empty()) {
+      this->_footprints.back().insert(entry.footprint.begin(),
+                                      entry.footprint.end());
+    }
+  }
+
+  /// \brief Notify the beginning of the computation of a merged fixpoint
+  void start_fixpoint() { this->_footprints.emplace_back(); }
+
+  /// \brief Notify the end of the computation of a merged fixpoint
+  void end_fixpoint(Entry& entry) {
+    ikos_assert(!this->_footprints.empty());
+    entry.footprint = std::move(this->_footprints.back());
+    this->_footprints.pop_back();
+    this->reuse(entry);
+  }
+
+}; // end class MergedCallees
+
+} // end namespace analyzer
+} // end namespace ikos
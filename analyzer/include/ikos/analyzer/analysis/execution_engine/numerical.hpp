@@ -53,6 +53,7 @@
 #include <ikos/core/domain/exception/abstract_domain.hpp>
 #include <ikos/core/domain/memory/abstract_domain.hpp>
 
+#include <ikos/analyzer/analysis/compiled_block.hpp>
 #include <ikos/analyzer/analysis/context.hpp>
 #include <ikos/analyzer/analysis/execution_engine/engine.hpp>
 #include <ikos/analyzer/analysis/literal.hpp>
@@ -92,6 +93,7 @@ public:
 
 private:
   using IntInterval = core::machine_int::Interval;
+  using IntCongruence = core::machine_int::Congruence;
   using IntIntervalCongruence = core::machine_int::IntervalCongruence;
   using IntVariable = core::VariableExpression< MachineInt, Variable* >;
   using IntLinearExpression = core::LinearExpression< MachineInt, Variable* >;
@@ -737,6 +739,25 @@ private:
 
       // Clean-up
       this->_inv.normal().pointer_forget(write_ptr);
+    } else if (aggregate.is_summarized()) {
+      const auto& elements = aggregate.elements();
+
+      // Value of the elements
+      Variable* value = this->_var_factory.get_named_shadow(
+          ar::IntegerType::get(this->_ctx.bundle->context(),
+                               elements.lb.bit_width(),
+                               elements.lb.sign()),
+          "shadow.mem_write_aggregate.value");
+      this->_inv.normal().int_set(value, IntInterval(elements.lb, elements.ub));
+
+      // Write all the elements at once
+      this->_inv.normal().mem_write_array(ptr,
+                                          ScalarLit::machine_int_var(value),
+                                          elements.element_size,
+                                          aggregate.size());
+
+      // Clean-up
+      this->_inv.normal().int_forget(value);
     } else if (aggregate.is_zero() || aggregate.is_undefined()) {
       // aggregate.size() is in bytes, compute bit-width, and check
       // if the bit-width fits in an unsigned int
@@ -1183,94 +1204,38 @@ public:
     const ScalarLit& left = this->_lit_factory.get_scalar(s->left());
     const ScalarLit& right = this->_lit_factory.get_scalar(s->right());
 
-    switch (s->op()) {
-      case ar::BinaryOperation::UAdd:
-      case ar::BinaryOperation::SAdd: {
-        this->exec_int_bin_operation(lhs,
-                                     s->has_no_wrap()
-                                         ? IntBinaryOperator::AddNoWrap
-                                         : IntBinaryOperator::Add,
-                                     left,
-                                     right);
-      } break;
-      case ar::BinaryOperation::USub:
-      case ar::BinaryOperation::SSub: {
-        this->exec_int_bin_operation(lhs,
-                                     s->has_no_wrap()
-                                         ? IntBinaryOperator::SubNoWrap
-                                         : IntBinaryOperator::Sub,
-                                     left,
-                                     right);
-      } break;
-      case ar::BinaryOperation::UMul:
-      case ar::BinaryOperation::SMul: {
-        this->exec_int_bin_operation(lhs,
-                                     s->has_no_wrap()
-                                         ? IntBinaryOperator::MulNoWrap
-                                         : IntBinaryOperator::Mul,
-                                     left,
-                                     right);
-      } break;
-      case ar::BinaryOperation::UDiv:
-      case ar::BinaryOperation::SDiv: {
-        this->exec_int_bin_operation(lhs,
-                                     s->is_exact() ? IntBinaryOperator::DivExact
-                                                   : IntBinaryOperator::Div,
-                                     left,
-                                     right);
-      } break;
-      case ar::BinaryOperation::URem:
-      case ar::BinaryOperation::SRem: {
-        this->exec_int_bin_operation(lhs, IntBinaryOperator::Rem, left, right);
-      } break;
-      case ar::BinaryOperation::UShl:
-      case ar::BinaryOperation::SShl: {
-        this->exec_int_bin_operation(lhs,
-                                     s->has_no_wrap()
-                                         ? IntBinaryOperator::ShlNoWrap
-                                         : IntBinaryOperator::Shl,
-                                     left,
-                                     right);
-      } break;
-      case ar::BinaryOperation::ULShr:
-      case ar::BinaryOperation::SLShr: {
-        this->exec_int_bin_operation(lhs,
-                                     s->is_exact()
-                                         ? IntBinaryOperator::LShrExact
-                                         : IntBinaryOperator::LShr,
-                                     left,
-                                     right);
-      } break;
-      case ar::BinaryOperation::UAShr:
-      case ar::BinaryOperation::SAShr: {
-        this->exec_int_bin_operation(lhs,
-                                     s->is_exact()
-                                         ? IntBinaryOperator::AShrExact
-                                         : IntBinaryOperator::AShr,
-                                     left,
-                                     right);
-      } break;
-      case ar::BinaryOperation::UAnd:
-      case ar::BinaryOperation::SAnd: {
-        this->exec_int_bin_operation(lhs, IntBinaryOperator::And, left, right);
-      } break;
-      case ar::BinaryOperation::UOr:
-      case ar::BinaryOperation::SOr: {
-        this->exec_int_bin_operation(lhs, IntBinaryOperator::Or, left, right);
-      } break;
-      case ar::BinaryOperation::UXor:
-      case ar::BinaryOperation::SXor: {
-        this->exec_int_bin_operation(lhs, IntBinaryOperator::Xor, left, right);
-      } break;
-      case ar::BinaryOperation::FAdd:
-      case ar::BinaryOperation::FSub:
-      case ar::BinaryOperation::FMul:
-      case ar::BinaryOperation::FDiv:
-      case ar::BinaryOperation::FRem: {
-        this->exec_float_bin_operation(lhs, left, right);
-      } break;
-      default: {
-        ikos_unreachable("unreachable");
+    if (boost::optional< IntBinaryOperator > op = int_bin_operator(s)) {
+      this->exec_int_bin_operation(lhs, *op, left, right);
+    } else {
+      this->exec_float_bin_operation(lhs, left, right);
+    }
+  }
+
+  /// \brief Execute a run of integer instructions of a compiled basic block
+  ///
+  /// The literals are resolved at compilation, and the instructions only
+  /// update the normal flow.
+  void exec(const std::vector< IntInstruction >& instructions) {
+    for (const IntInstruction& inst : instructions) {
+      switch (inst.kind) {
+        case IntInstruction::Assign: {
+          if (inst.left->is_machine_int()) {
+            this->_inv.normal().int_assign(inst.result->var(),
+                                           inst.left->machine_int());
+          } else {
+            this->_inv.normal().int_assign(inst.result->var(),
+                                           inst.left->var());
+          }
+        } break;
+        case IntInstruction::Apply: {
+          this->exec_int_bin_operation(*inst.result,
+                                       inst.op,
+                                       *inst.left,
+                                       *inst.right);
+        } break;
+        default: {
+          ikos_unreachable("unreachable");
+        }
       }
     }
   }
@@ -3766,5 +3731,19 @@ public:
 
 }; // end class NumericalExecutionEngine
 
+/// \brief Execute the transfer function for a compiled basic block
+template < typename ExecEngine, typename CallExecEngine >
+inline void transfer_function(ExecEngine& exec_engine,
+                              CallExecEngine& call_exec_engine,
+                              const CompiledBlock& block) {
+  for (const CompiledBlock::Step& step : block) {
+    if (step.stmt != nullptr) {
+      transfer_function(exec_engine, call_exec_engine, step.stmt);
+    } else {
+      exec_engine.exec(step.instructions);
+    }
+  }
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -45,6 +45,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iosfwd>
 #include <vector>
 
@@ -110,11 +111,17 @@ public:
       ar::BasicBlock* bb) const;
 
   /// \brief Run the analysis
+  ///
+  /// Codes are analyzed in parallel, using `opts.num_threads` threads.
   void run();
 
-private:
-  /// \brief Run the analysis on the given code
-  void run(ar::Code* code);
+  /// \brief Check the results against a reference solver
+  ///
+  /// The reference solves the same equations on sets of variables. This is
+  /// slow and only meant for testing.
+  ///
+  /// Returns the number of basic blocks with different results.
+  std::size_t check() const;
 
 public:
   /// \brief Dump the liveness analysis results, for debugging purpose
@@ -64,6 +64,7 @@ class SettingsTable;
 /// \brief Machine integer abstract domain
 enum class MachineIntDomainOption {
   Interval,
+  CompactInterval,
   Congruence,
   IntervalCongruence,
   DBM,
@@ -91,6 +92,8 @@ inline const char* machine_int_domain_option_str(MachineIntDomainOption d) {
   switch (d) {
     case MachineIntDomainOption::Interval:
       return "interval";
+    case MachineIntDomainOption::CompactInterval:
+      return "compact-interval";
     case MachineIntDomainOption::Congruence:
       return "congruence";
     case MachineIntDomainOption::IntervalCongruence:
@@ -329,15 +332,72 @@ public:
   /// \brief Wether we should use the partitioning abstract domain or not
   bool use_partitioning_domain;
 
+  /// \brief Wether we should use the fused scalar abstract domain or not
+  ///
+  /// The fused scalar domain keeps the initialization, nullity and points-to
+  /// set of a variable in a single record.
+  bool use_fused_scalar_domain;
+
+  /// \brief Maximum number of cells per memory location
+  ///
+  /// Past it, the cells of the memory location are summarized.
+  /// boost::none for no limit.
+  boost::optional< unsigned > max_cells_per_location;
+
+  /// \brief Wether we should run a cheap pre-pass before the numerical domain
+  ///
+  /// Only for the intraprocedural analysis. Functions are first analyzed with
+  /// intervals. Only functions with cycles or unproven checks are analyzed
+  /// again with `machine_int_domain`.
+  bool use_domain_prepass;
+
+  /// \brief Wether fixpoints should only keep invariants at cycle heads
+  ///
+  /// Other invariants are recomputed when checking. Only for the sequential
+  /// analyses.
+  bool use_sparse_invariants;
+
   /// \brief Wether we should save fixpoints on called functions or not
   bool use_fixpoint_cache;
 
   /// \brief Wether we should perform checks or not
   bool use_checks;
 
+  /// \brief Memory budget of the value analysis, in megabytes
+  ///
+  /// When the abstract values exceed it, the analysis degrades its precision.
+  /// boost::none for no budget.
+  boost::optional< unsigned > mem_budget;
+
+  /// \brief Time budget of the fixpoint on a function, in seconds
+  ///
+  /// When a fixpoint exceeds it, the analysis degrades its precision.
+  /// boost::none for no budget.
+  boost::optional< unsigned > function_time_budget;
+
+  /// \brief Maximum depth of fully inlined call contexts
+  ///
+  /// Calls deeper than this are analyzed in a merged context per callee.
+  /// boost::none for no limit.
+  boost::optional< unsigned > context_depth;
+
+  /// \brief Maximum depth of fully inlined call contexts for specific callees
+  boost::container::flat_map< ar::Function*, unsigned >
+      context_depth_functions;
+
+  /// \brief Maximum number of fully inlined call contexts per callee
+  ///
+  /// Once reached, further calls use the merged context of the callee.
+  /// boost::none for no limit.
+  boost::optional< unsigned > callee_contexts_limit;
+
   /// \brief Policy of initialization for global variables
   GlobalsInitPolicy globals_init_policy;
 
+  /// \brief Only initialize the global variables accessible from the analyzed
+  /// code
+  bool use_prune_globals_init;
+
   /// \brief Option to show the progress of the analysis
   ProgressOption progress;
 
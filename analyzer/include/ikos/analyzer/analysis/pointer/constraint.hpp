@@ -335,7 +335,8 @@ private:
                                  VarOp::create(field.value.var(), zero())));
           }
         }
-      } else if (aggregate.is_zero() || aggregate.is_undefined()) {
+      } else if (aggregate.is_summarized() || aggregate.is_zero() ||
+                 aggregate.is_undefined()) {
         return; // nothing to do
       } else if (aggregate.is_var()) {
         this->mem_copy(ptr, this->aggregate_pointer(aggregate));
@@ -0,0 +1,397 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Profiler of the hot paths of the value analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/function.hpp>
+
+#include <ikos/analyzer/analysis/option.hpp>
+#include <ikos/analyzer/support/assert.hpp>
+#include <ikos/analyzer/util/timer.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+// forward declaration
+class OutputDatabase;
+
+/// \brief Profiler of the value analysis
+///
+/// Counts and times the operations on the hot paths of the fixpoint iterators,
+/// per function and per cycle head. Operations on the abstract domain are also
+/// counted and timed per numerical domain.
+///
+/// Counters are thread-local: each thread updates its own counters without
+/// synchronization, and counters are merged when saved in the database.
+class Profiler {
+public:
+  /// \brief Counters of a function
+  struct FunctionCounters {
+    /// \brief Number of fixpoint computations on the function
+    std::uint64_t analyses = 0;
+
+    /// \brief Time spent computing fixpoints, including callees
+    Timer::Duration time = Timer::Duration::zero();
+
+    /// \brief Number of calls inlined to the function
+    std::uint64_t inlined_calls = 0;
+
+    /// \brief Number of fixpoints fetched from the fixpoint cache
+    std::uint64_t cache_hits = 0;
+
+    /// \brief Number of normalizations of invariants, before checks
+    std::uint64_t normalizations = 0;
+
+    /// \brief Time spent normalizing invariants
+    Timer::Duration normalize_time = Timer::Duration::zero();
+  };
+
+  /// \brief Counters of a cycle head
+  struct CycleCounters {
+    /// \brief Number of increasing iterations
+    std::uint64_t increasing_iterations = 0;
+
+    /// \brief Number of decreasing iterations
+    std::uint64_t decreasing_iterations = 0;
+
+    /// \brief Number of joins
+    std::uint64_t joins = 0;
+
+    /// \brief Number of widenings
+    std::uint64_t widenings = 0;
+
+    /// \brief Number of narrowings
+    std::uint64_t narrowings = 0;
+
+    /// \brief Number of meets
+    std::uint64_t meets = 0;
+
+    /// \brief Number of inclusion checks
+    std::uint64_t leqs = 0;
+
+    /// \brief Time spent in extrapolations, refinements and inclusion checks
+    Timer::Duration time = Timer::Duration::zero();
+  };
+
+  /// \brief Counters of an operation on the abstract domain
+  struct DomainCounters {
+    /// \brief Number of operations
+    std::uint64_t count = 0;
+
+    /// \brief Time spent in the operations
+    Timer::Duration time = Timer::Duration::zero();
+  };
+
+  /// \brief Operation on a function
+  enum class FunctionOperation {
+    Analysis,
+    InlinedCall,
+    CacheHit,
+    Normalization,
+  };
+
+  /// \brief Operation on a cycle head
+  enum class CycleOperation {
+    IncreasingIteration,
+    DecreasingIteration,
+    Join,
+    Widening,
+    Narrowing,
+    Meet,
+    Leq,
+  };
+
+  /// \brief Operation on the abstract domain
+  enum class DomainOperation {
+    Join,
+    Widening,
+    Narrowing,
+    Meet,
+    Leq,
+  };
+
+  /// \brief Profile of an operation on a function over a scope
+  ///
+  /// Does nothing if the given profiler is null.
+  class FunctionScope {
+  private:
+    /// \brief Profiler, or null
+    Profiler* _profiler;
+
+    /// \brief Function
+    ar::Function* _function;
+
+    /// \brief Timed operation
+    FunctionOperation _op;
+
+    /// \brief Timer
+    Timer _timer;
+
+  public:
+    /// \brief Constructor
+    ///
+    /// \param profiler The profiler, or null
+    /// \param fun The function
+    /// \param op The operation, either Analysis or Normalization
+    FunctionScope(Profiler* profiler, ar::Function* fun, FunctionOperation op)
+        : _profiler(profiler), _function(fun), _op(op) {
+      if (this->_profiler != nullptr) {
+        this->_timer.start();
+      }
+    }
+
+    /// \brief No copy constructor
+    FunctionScope(const FunctionScope&) = delete;
+
+    /// \brief No move constructor
+    FunctionScope(FunctionScope&&) = delete;
+
+    /// \brief No copy assignment operator
+    FunctionScope& operator=(const FunctionScope&) = delete;
+
+    /// \brief No move assignment operator
+    FunctionScope& operator=(FunctionScope&&) = delete;
+
+    /// \brief Destructor
+    ~FunctionScope() {
+      if (this->_profiler != nullptr) {
+        this->_timer.stop();
+        this->_profiler->count(this->_function,
+                               this->_op,
+                               this->_timer.elapsed());
+      }
+    }
+
+  }; // end class FunctionScope
+
+  /// \brief Profile of the operations on a cycle head over a scope
+  ///
+  /// Does nothing if the given profiler is null.
+  class CycleScope {
+  private:
+    /// \brief Profiler, or null
+    Profiler* _profiler;
+
+    /// \brief Cycle head
+    ar::BasicBlock* _head;
+
+    /// \brief Numerical domain of the invariants
+    MachineIntDomainOption _domain;
+
+    /// \brief Operation on the abstract domain, if any
+    boost::optional< DomainOperation > _operation;
+
+    /// \brief Timer
+    Timer _timer;
+
+  public:
+    /// \brief Constructor
+    ///
+    /// \param profiler The profiler, or null
+    /// \param head The cycle head
+    /// \param domain The numerical domain of the invariants
+    CycleScope(Profiler* profiler,
+               ar::BasicBlock* head,
+               MachineIntDomainOption domain)
+        : _profiler(profiler), _head(head), _domain(domain) {
+      if (this->_profiler != nullptr) {
+        this->_timer.start();
+      }
+    }
+
+    /// \brief No copy constructor
+    CycleScope(const CycleScope&) = delete;
+
+    /// \brief No move constructor
+    CycleScope(CycleScope&&) = delete;
+
+    /// \brief No copy assignment operator
+    CycleScope& operator=(const CycleScope&) = delete;
+
+    /// \brief No move assignment operator
+    CycleScope& operator=(CycleScope&&) = delete;
+
+    /// \brief Count an operation
+    ///
+    /// The scope is timed as an operation on the abstract domain if `op` is
+    /// one.
+    void count(CycleOperation op) {
+      if (this->_profiler != nullptr) {
+        this->_profiler->count(this->_head, op);
+        if (auto operation = domain_operation(op)) {
+          this->_operation = operation;
+        }
+      }
+    }
+
+    /// \brief Destructor
+    ~CycleScope() {
+      if (this->_profiler != nullptr) {
+        this->_timer.stop();
+        this->_profiler->cycle(this->_head).time += this->_timer.elapsed();
+        if (this->_operation) {
+          this->_profiler->count(this->_domain,
+                                 *this->_operation,
+                                 this->_timer.elapsed());
+        }
+      }
+    }
+
+  }; // end class CycleScope
+
+private:
+  /// \brief Numerical domain and operation on the abstract domain
+  using DomainKey = std::pair< MachineIntDomainOption, DomainOperation >;
+
+  /// \brief Counters of a thread
+  struct ThreadCounters {
+    llvm::DenseMap< ar::Function*, FunctionCounters > functions;
+    llvm::DenseMap< ar::BasicBlock*, CycleCounters > cycles;
+    std::map< DomainKey, DomainCounters > operations;
+  };
+
+private:
+  /// \brief Unique identifier of the profiler
+  std::uint64_t _id;
+
+  /// \brief Mutex protecting the list of thread counters
+  std::mutex _mutex;
+
+  /// \brief Counters of all threads
+  std::vector< std::unique_ptr< ThreadCounters > > _threads;
+
+public:
+  /// \brief Constructor
+  Profiler();
+
+  /// \brief No copy constructor
+  Profiler(const Profiler&) = delete;
+
+  /// \brief No move constructor
+  Profiler(Profiler&&) = delete;
+
+  /// \brief No copy assignment operator
+  Profiler& operator=(const Profiler&) = delete;
+
+  /// \brief No move assignment operator
+  Profiler& operator=(Profiler&&) = delete;
+
+  /// \brief Destructor
+  ~Profiler();
+
+  /// \brief Return the counters of the given function, for the current thread
+  ///
+  /// The reference is invalidated by the next call on the current thread.
+  FunctionCounters& function(ar::Function* fun) {
+    return this->local().functions[fun];
+  }
+
+  /// \brief Return the counters of the given cycle head, for the current
+  /// thread
+  ///
+  /// The reference is invalidated by the next call on the current thread.
+  CycleCounters& cycle(ar::BasicBlock* head) {
+    return this->local().cycles[head];
+  }
+
+  /// \brief Count an operation on the given function
+  void count(ar::Function* fun,
+             FunctionOperation op,
+             Timer::Duration elapsed = Timer::Duration::zero());
+
+  /// \brief Count an operation on the given cycle head
+  void count(ar::BasicBlock* head, CycleOperation op);
+
+  /// \brief Count an operation on the abstract domain, using the given
+  /// numerical domain
+  void count(MachineIntDomainOption domain,
+             DomainOperation op,
+             Timer::Duration elapsed);
+
+  /// \brief Return the operation on the abstract domain of the given
+  /// operation on a cycle head, if any
+  static boost::optional< DomainOperation > domain_operation(CycleOperation op);
+
+  /// \brief Save the merged counters of all threads in the database
+  ///
+  /// This is not thread-safe: all threads must be done with the analysis.
+  void save(OutputDatabase& db);
+
+private:
+  /// \brief Return the counters of the current thread
+  ThreadCounters& local();
+
+}; // end class Profiler
+
+/// \brief Return a string representing an operation on the abstract domain
+inline const char* domain_operation_str(Profiler::DomainOperation op) {
+  switch (op) {
+    case Profiler::DomainOperation::Join:
+      return "join";
+    case Profiler::DomainOperation::Widening:
+      return "widening";
+    case Profiler::DomainOperation::Narrowing:
+      return "narrowing";
+    case Profiler::DomainOperation::Meet:
+      return "meet";
+    case Profiler::DomainOperation::Leq:
+      return "leq";
+    default:
+      ikos_unreachable("unreachable");
+  }
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -0,0 +1,319 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Persistent store of function summaries
+ *
+ * A function summary describes the return value of a function on machine
+ * integers, for any call where the parameters are within its precondition.
+ * Summaries are keyed by a hash of the function body and of the analysis
+ * settings, and saved on disk so that later runs, on any bundle linking the
+ * same function, apply them at call sites instead of inlining the function.
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/core/value/machine_int/interval_congruence.hpp>
+
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/literal.hpp>
+#include <ikos/analyzer/analysis/option.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Summary of a function on machine integers
+struct FunctionSummary {
+  /// \brief Values of the parameters
+  std::vector< core::machine_int::IntervalCongruence > precondition;
+
+  /// \brief True if the function might return
+  bool returns = false;
+
+  /// \brief Return value, or boost::none if the function returns void
+  boost::optional< core::machine_int::IntervalCongruence > return_value;
+};
+
+/// \brief Persistent store of function summaries
+///
+/// Only functions on machine integers without side effects are summarized:
+/// parameters and return value of integer type, and a body made of integer
+/// assignments, unary and binary operations and comparisons.
+///
+/// This class is thread-safe.
+class SummaryStore {
+public:
+  /// \brief Precondition of a summary
+  using Precondition = std::vector< core::machine_int::IntervalCongruence >;
+
+  /// \brief Maximum number of summaries per function and analysis settings
+  static constexpr std::size_t MaxSummaries = 8;
+
+private:
+  /// \brief Information on a function
+  struct FunctionInfo {
+    /// \brief True if the function can be summarized
+    bool summarizable;
+
+    /// \brief Hash of the function body
+    std::uint64_t hash;
+  };
+
+  /// \brief Map from key to summaries
+  using SummaryMap =
+      std::unordered_map< std::uint64_t, std::vector< FunctionSummary > >;
+
+private:
+  /// \brief Path of the store on disk
+  boost::filesystem::path _path;
+
+  /// \brief Mutex
+  std::mutex _mutex;
+
+  /// \brief Summaries
+  SummaryMap _summaries;
+
+  /// \brief Cache of information on functions
+  llvm::DenseMap< ar::Function*, FunctionInfo > _functions;
+
+  /// \brief Number of summaries applied
+  std::size_t _num_hits = 0;
+
+  /// \brief Number of summaries inserted
+  std::size_t _num_insertions = 0;
+
+public:
+  /// \brief Constructor
+  explicit SummaryStore(boost::filesystem::path path);
+
+  /// \brief No copy constructor
+  SummaryStore(const SummaryStore&) = delete;
+
+  /// \brief No move constructor
+  SummaryStore(SummaryStore&&) = delete;
+
+  /// \brief No copy assignment operator
+  SummaryStore& operator=(const SummaryStore&) = delete;
+
+  /// \brief No move assignment operator
+  SummaryStore& operator=(SummaryStore&&) = delete;
+
+  /// \brief Destructor
+  ~SummaryStore() = default;
+
+  /// \brief Load the summaries from disk
+  ///
+  /// A missing, corrupted or outdated store is ignored with a warning.
+  void load();
+
+  /// \brief Save the summaries on disk
+  ///
+  /// Summaries written by other runs in the meantime are kept.
+  void save();
+
+  /// \brief Return true if the given function can be summarized
+  bool is_summarizable(ar::Function* fun);
+
+  /// \brief Find a summary of the given function covering the precondition
+  ///
+  /// Returns the most precise summary whose precondition includes the given
+  /// one, or boost::none.
+  boost::optional< FunctionSummary > find(ar::Function* fun,
+                                          const AnalysisOptions& opts,
+                                          const Precondition& precondition);
+
+  /// \brief Insert a summary of the given function
+  void insert(ar::Function* fun,
+              const AnalysisOptions& opts,
+              FunctionSummary summary);
+
+  /// \brief Return the number of summaries applied
+  std::size_t num_hits();
+
+  /// \brief Return the number of summaries inserted
+  std::size_t num_insertions();
+
+private:
+  /// \brief Return the information on the given function
+  ///
+  /// The mutex must be locked.
+  const FunctionInfo& info(ar::Function* fun);
+
+  /// \brief Return the key of the given function and analysis settings
+  ///
+  /// The mutex must be locked.
+  std::uint64_t key(ar::Function* fun, const AnalysisOptions& opts);
+
+}; // end class SummaryStore
+
+/// \brief Return the precondition of a summary of the callee at a call site
+///
+/// Returns boost::none if there is no summary store, if the callee cannot be
+/// summarized or if one of the parameters might be uninitialized.
+///
+/// \param ctx The analysis context
+/// \param call The call statement
+/// \param callee The called function
+/// \param inv The invariant after the matching of parameters
+template < typename AbstractDomain >
+inline boost::optional< SummaryStore::Precondition > summary_precondition(
+    Context& ctx,
+    ar::CallBase* call,
+    ar::Function* callee,
+    const AbstractDomain& inv) {
+  if (ctx.summary_store == nullptr ||
+      !ctx.summary_store->is_summarizable(callee) ||
+      inv.is_normal_flow_bottom()) {
+    return boost::none;
+  }
+  if (call->has_result() &&
+      call->result()->type() != callee->type()->return_type()) {
+    return boost::none;
+  }
+
+  SummaryStore::Precondition precondition;
+  precondition.reserve(callee->num_parameters());
+  for (auto it = callee->param_begin(), et = callee->param_end(); it != et;
+       ++it) {
+    Variable* x = ctx.var_factory->get_internal(*it);
+    if (!inv.normal().uninit_is_initialized(x)) {
+      return boost::none;
+    }
+    precondition.push_back(inv.normal().int_to_interval_congruence(x));
+  }
+  return precondition;
+}
+
+/// \brief Return true if the invariant holds no more than the precondition on
+/// the parameters of a summarized callee
+///
+/// This is the case if removing the relations on the parameters loses no
+/// information. The callee then computes the same result for any call within
+/// the precondition, and its result can be exported as a summary.
+template < typename AbstractDomain >
+inline bool is_exact_precondition(
+    Context& ctx,
+    ar::Function* callee,
+    const SummaryStore::Precondition& precondition,
+    const AbstractDomain& inv) {
+  AbstractDomain projection = inv;
+  auto it = callee->param_begin();
+  for (const auto& value : precondition) {
+    projection.normal().int_set(ctx.var_factory->get_internal(*it), value);
+    ++it;
+  }
+  return projection.leq(inv);
+}
+
+/// \brief Build the summary of a callee from its exit invariant
+///
+/// Returns boost::none if the return value might be uninitialized.
+///
+/// \param ctx The analysis context
+/// \param precondition The precondition used to analyze the callee
+/// \param exit_inv The exit invariant of the callee
+/// \param return_stmt The return statement of the callee, or null
+template < typename AbstractDomain >
+inline boost::optional< FunctionSummary > make_summary(
+    Context& ctx,
+    SummaryStore::Precondition precondition,
+    const AbstractDomain& exit_inv,
+    ar::ReturnValue* return_stmt) {
+  FunctionSummary summary;
+  summary.precondition = std::move(precondition);
+  summary.returns = !exit_inv.is_normal_flow_bottom();
+
+  if (!summary.returns || return_stmt == nullptr ||
+      !return_stmt->has_operand()) {
+    return summary;
+  }
+
+  const ScalarLit& ret = ctx.lit_factory->get_scalar(return_stmt->operand());
+  if (ret.is_machine_int()) {
+    summary.return_value =
+        core::machine_int::IntervalCongruence(ret.machine_int());
+  } else if (ret.is_machine_int_var()) {
+    if (!exit_inv.normal().uninit_is_initialized(ret.var())) {
+      return boost::none;
+    }
+    summary.return_value =
+        exit_inv.normal().int_to_interval_congruence(ret.var());
+  } else {
+    return boost::none;
+  }
+  return summary;
+}
+
+/// \brief Apply the summary of a callee on the invariant of the caller
+///
+/// \param ctx The analysis context
+/// \param call The call statement
+/// \param summary The summary of the callee
+/// \param inv The invariant of the caller, without exceptions
+template < typename AbstractDomain >
+inline void apply_summary(Context& ctx,
+                          ar::CallBase* call,
+                          const FunctionSummary& summary,
+                          AbstractDomain& inv) {
+  if (!summary.returns) {
+    inv.set_normal_flow_to_bottom();
+    return;
+  }
+  if (call->has_result() && summary.return_value) {
+    inv.normal().int_set(ctx.var_factory->get_internal(call->result()),
+                         *summary.return_value);
+  }
+}
+
+} // end namespace analyzer
+} // end namespace ikos
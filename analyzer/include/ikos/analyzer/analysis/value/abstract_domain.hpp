@@ -64,9 +64,17 @@ using AbstractDomain = core::exception::ExceptionDomain< MemoryAbstractDomain >;
 /// \brief Create the bottom abstract value
 AbstractDomain make_bottom_abstract_value(Context& ctx);
 
+/// \brief Create the bottom abstract value, using the given numerical domain
+AbstractDomain make_bottom_abstract_value(Context& ctx,
+                                          MachineIntDomainOption domain);
+
 /// \brief Create the initial abstract value
 AbstractDomain make_initial_abstract_value(Context& ctx);
 
+/// \brief Create the initial abstract value, using the given numerical domain
+AbstractDomain make_initial_abstract_value(Context& ctx,
+                                           MachineIntDomainOption domain);
+
 } // end namespace value
 } // end namespace analyzer
 } // end namespace ikos
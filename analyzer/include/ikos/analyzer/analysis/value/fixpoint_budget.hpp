@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Memory and time budgets of a function fixpoint
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/ar/semantic/function.hpp>
+
+#include <ikos/analyzer/analysis/call_context.hpp>
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/value/memory_budget.hpp>
+#include <ikos/analyzer/analysis/value/time_budget.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+
+/// \brief Memory and time budgets of a function fixpoint
+///
+/// Combines the degradations of the MemoryBudget and the TimeBudget, so that
+/// fixpoint iterators only ask what they should do.
+///
+/// This class is thread-safe.
+class FixpointBudget {
+private:
+  /// \brief Memory budget
+  MemoryBudget _memory_budget;
+
+  /// \brief Time budget
+  TimeBudget _time_budget;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param ctx Analysis context
+  /// \param function Analyzed function
+  /// \param call_context Call context
+  /// \param inlining Whether the analysis inlines calls
+  /// \param restart Whether the fixpoint can be restarted with intervals
+  /// \param memory_degradation Initial memory degradation, inherited from the
+  ///   caller
+  FixpointBudget(
+      Context& ctx,
+      ar::Function* function,
+      CallContext* call_context,
+      bool inlining,
+      bool restart,
+      MemoryDegradation memory_degradation = MemoryDegradation::None)
+      : _memory_budget(
+            ctx, function, call_context, inlining, memory_degradation),
+        _time_budget(ctx, function, call_context, inlining, restart) {}
+
+  /// \brief Start the clock, at the beginning of the fixpoint computation
+  void start() { this->_time_budget.start(); }
+
+  /// \brief Check the memory usage and the elapsed time, and escalate the
+  /// degradations if needed
+  ///
+  /// \returns true if a degradation changed
+  bool update() {
+    bool memory = this->_memory_budget.update();
+    bool time = this->_time_budget.update();
+    return memory || time;
+  }
+
+  /// \brief Return the current memory degradation
+  MemoryDegradation memory_degradation() const {
+    return this->_memory_budget.degradation();
+  }
+
+  /// \brief Return true if the cached fixpoints of callees should be evicted
+  bool evict_fixpoint_cache() const {
+    return this->_memory_budget.evict_fixpoint_cache();
+  }
+
+  /// \brief Return true if calls should be inlined
+  bool inline_calls() const {
+    return this->_memory_budget.inline_calls() &&
+           this->_time_budget.inline_calls();
+  }
+
+  /// \brief Return true if the convergence should be accelerated
+  ///
+  /// Loops are widened on every increasing iteration, and the decreasing
+  /// iterations are skipped.
+  bool accelerate() const {
+    return this->_memory_budget.accelerate() ||
+           this->_time_budget.accelerate();
+  }
+
+  /// \brief Return true if the fixpoint should be aborted and restarted with
+  /// the interval domain
+  bool restart() const { return this->_time_budget.restart(); }
+
+}; // end class FixpointBudget
+
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
@@ -43,6 +43,7 @@
 
 #pragma once
 
+#include <unordered_set>
 #include <vector>
 
 #include <ikos/core/support/compiler.hpp>
@@ -63,6 +64,13 @@ namespace value {
 /// according to the given policy
 bool is_initialized(ar::GlobalVariable* gv, GlobalsInitPolicy policy);
 
+/// \brief Return true if the initializer of the given global variable does
+/// not reference any other global variable
+///
+/// Such an initializer only writes the memory of its global variable, it can
+/// be computed independently of the other initializers.
+bool has_independent_initializer(ar::GlobalVariable* gv);
+
 /// \brief Return the global constructors, in call order, given the
 /// ar.global_ctors variable
 std::vector< std::pair< ar::Function*, MachineInt > > global_ctors(
@@ -73,6 +81,16 @@ std::vector< std::pair< ar::Function*, MachineInt > > global_ctors(
 std::vector< std::pair< ar::Function*, MachineInt > > global_dtors(
     ar::GlobalVariable* gv);
 
+/// \brief Return the global variables accessible from the analyzed code
+///
+/// This is the set of global variables referenced by the code reachable from
+/// the entry points and the global constructors and destructors, either
+/// through direct calls or through function pointers, and by the initializers
+/// of these global variables. The other global variables are never read nor
+/// written during the analysis.
+std::unordered_set< ar::GlobalVariable* > accessible_globals(
+    ar::Bundle* bundle, const std::vector< ar::Function* >& entry_points);
+
 /// \brief Call execution engine for global variable initializer
 class GlobalVarCallExecutionEngine final : public CallExecutionEngine {
 public:
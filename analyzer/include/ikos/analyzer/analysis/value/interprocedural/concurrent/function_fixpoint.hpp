@@ -55,6 +55,7 @@
 #include <ikos/analyzer/analysis/execution_engine/fixpoint_cache.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/analysis/value/fixpoint_budget.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
 
 namespace ikos {
@@ -104,6 +105,9 @@ private:
   /// \brief Function fixpoint cache of callees
   FixpointCacheT _callees_cache;
 
+  /// \brief Memory and time budgets
+  FixpointBudget _budget;
+
 public:
   /// \brief Constructor for an entry point
   ///
@@ -128,6 +132,11 @@ public:
   /// \brief Compute the fixpoint
   void run(AbstractDomain inv) override;
 
+private:
+  /// \brief Check the budget, and evict the callees cache if needed
+  void check_budget();
+
+public:
   /// \brief Extrapolate the new state after an increasing iteration
   AbstractDomain extrapolate(ar::BasicBlock* head,
                              unsigned iteration,
@@ -140,6 +149,12 @@ public:
                         const AbstractDomain& before,
                         const AbstractDomain& after) override;
 
+  /// \brief Check if the increasing iterations fixpoint is reached
+  bool is_increasing_iterations_fixpoint(ar::BasicBlock* head,
+                                         unsigned iteration,
+                                         const AbstractDomain& before,
+                                         const AbstractDomain& after) override;
+
   /// \brief Check if the decreasing iterations fixpoint is reached
   bool is_decreasing_iterations_fixpoint(ar::BasicBlock* head,
                                          unsigned iteration,
@@ -161,8 +176,16 @@ public:
   void process_post(ar::BasicBlock* bb, const AbstractDomain& post) override;
 
   /// \brief Run the checks with the previously computed fix-point
+  ///
+  /// Basic blocks are checked in parallel. Results are inserted in the
+  /// database in the same order as a sequential traversal.
   void run_checks();
 
+private:
+  /// \brief Run the checks on the given basic block
+  void run_checks(ar::BasicBlock* bb);
+
+public:
   /// \name Required by InlineCallExecutionEngine
   /// @{
 
@@ -172,6 +195,9 @@ public:
   /// \brief Return the call context
   CallContext* call_context() const { return this->_call_context; }
 
+  /// \brief Return true if calls should be inlined
+  bool inline_calls() const { return this->_budget.inline_calls(); }
+
   /// \brief Return the exit invariant, or bottom
   const AbstractDomain& exit_invariant() const { return this->_exit_invariant; }
 
@@ -51,9 +51,11 @@
 #include <ikos/analyzer/analysis/call_context.hpp>
 #include <ikos/analyzer/analysis/context.hpp>
 #include <ikos/analyzer/analysis/execution_engine/fixpoint_cache.hpp>
+#include <ikos/analyzer/analysis/execution_engine/merged_callees.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/progress.hpp>
+#include <ikos/analyzer/analysis/value/fixpoint_budget.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
 
 namespace ikos {
@@ -73,6 +75,10 @@ private:
   /// \brief Function fixpoint cache of callees
   using FixpointCacheT = FixpointCache< FunctionFixpoint, AbstractDomain >;
 
+public:
+  /// \brief Fixpoints of callees analyzed in merged contexts
+  using MergedCalleesT = MergedCallees< FunctionFixpoint, AbstractDomain >;
+
 private:
   /// \brief Analysis context
   Context& _ctx;
@@ -98,34 +104,48 @@ private:
   /// \brief Function fixpoint cache of callees
   FixpointCacheT _callees_cache;
 
+  /// \brief Memory and time budgets
+  FixpointBudget _budget;
+
   /// \brief Progress logger
   ProgressLogger& _logger;
 
+  /// \brief Fixpoints of callees analyzed in merged contexts
+  MergedCalleesT& _merged_callees;
+
 public:
   /// \brief Constructor for an entry point
   ///
   /// \param ctx Analysis context
   /// \param checkers List of checkers to run
+  /// \param logger Progress logger
+  /// \param merged_callees Fixpoints of callees analyzed in merged contexts
   /// \param entry_point Function to analyze
   FunctionFixpoint(Context& ctx,
                    const std::vector< std::unique_ptr< Checker > >& checkers,
                    ProgressLogger& logger,
+                   MergedCalleesT& merged_callees,
                    ar::Function* entry_point);
 
   /// \brief Constructor for a callee
   ///
   /// \param ctx Analysis context
   /// \param caller Parent function fixpoint
-  /// \param call Call statement
+  /// \param call_context Call context of the callee
   /// \param callee Called function
   FunctionFixpoint(Context& ctx,
                    const FunctionFixpoint& caller,
-                   ar::CallBase* call,
+                   CallContext* call_context,
                    ar::Function* callee);
 
   /// \brief Compute the fixpoint
   void run(AbstractDomain inv) override;
 
+private:
+  /// \brief Check the budget, and evict the callees cache if needed
+  void check_budget();
+
+public:
   /// \brief Extrapolate the new state after an increasing iteration
   AbstractDomain extrapolate(ar::BasicBlock* head,
                              unsigned iteration,
@@ -138,6 +158,12 @@ public:
                         const AbstractDomain& before,
                         const AbstractDomain& after) override;
 
+  /// \brief Check if the increasing iterations fixpoint is reached
+  bool is_increasing_iterations_fixpoint(ar::BasicBlock* head,
+                                         unsigned iteration,
+                                         const AbstractDomain& before,
+                                         const AbstractDomain& after) override;
+
   /// \brief Check if the decreasing iterations fixpoint is reached
   bool is_decreasing_iterations_fixpoint(ar::BasicBlock* head,
                                          unsigned iteration,
@@ -181,6 +207,12 @@ public:
   /// \brief Return the call context
   CallContext* call_context() const { return this->_call_context; }
 
+  /// \brief Return the fixpoints of callees analyzed in merged contexts
+  MergedCalleesT& merged_callees() const { return this->_merged_callees; }
+
+  /// \brief Return true if calls should be inlined
+  bool inline_calls() const { return this->_budget.inline_calls(); }
+
   /// \brief Return the exit invariant, or bottom
   const AbstractDomain& exit_invariant() const { return this->_exit_invariant; }
 
@@ -202,6 +234,12 @@ public:
 
   /// @}
 
+private:
+  /// \brief Run the checks on the given basic block
+  ///
+  /// Returns the post invariant of the basic block.
+  AbstractDomain run_checks(ar::BasicBlock* bb, AbstractDomain pre);
+
 }; // end class FunctionFixpoint
 
 } // end namespace sequential
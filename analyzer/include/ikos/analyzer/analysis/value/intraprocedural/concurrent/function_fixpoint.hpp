@@ -54,6 +54,7 @@
 #include <ikos/analyzer/analysis/context.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/analysis/value/fixpoint_budget.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
 
 namespace ikos {
@@ -79,16 +80,30 @@ private:
   /// \brief Empty call context
   CallContext* _empty_call_context;
 
+  /// \brief Numerical abstract domain
+  MachineIntDomainOption _domain;
+
   /// \brief Fixpoint parameters
   const CodeFixpointParameters& _fixpoint_parameters;
 
+  /// \brief Memory and time budgets
+  FixpointBudget _budget;
+
 public:
   /// \brief Create a function fixpoint iterator
-  FunctionFixpoint(Context& ctx, ar::Function* function);
+  ///
+  /// \param domain The numerical abstract domain
+  FunctionFixpoint(Context& ctx,
+                   ar::Function* function,
+                   MachineIntDomainOption domain);
 
   /// \brief Compute the fixpoint
   void run(AbstractDomain inv) override;
 
+  /// \brief Return true if the fixpoint was aborted by the time budget, and
+  /// the function should be analyzed again with the interval domain
+  bool restart() const { return this->_budget.restart(); }
+
   /// \brief Extrapolate the new state after an increasing iteration
   AbstractDomain extrapolate(ar::BasicBlock* head,
                              unsigned iteration,
@@ -101,6 +116,12 @@ public:
                         const AbstractDomain& before,
                         const AbstractDomain& after) override;
 
+  /// \brief Check if the increasing iterations fixpoint is reached
+  bool is_increasing_iterations_fixpoint(ar::BasicBlock* head,
+                                         unsigned iteration,
+                                         const AbstractDomain& before,
+                                         const AbstractDomain& after) override;
+
   /// \brief Check if the decreasing iterations fixpoint is reached
   bool is_decreasing_iterations_fixpoint(ar::BasicBlock* head,
                                          unsigned iteration,
@@ -122,8 +143,16 @@ public:
   void process_post(ar::BasicBlock* bb, const AbstractDomain& post) override;
 
   /// \brief Run the checks with the previously computed fix-point
+  ///
+  /// Basic blocks are checked in parallel. Results are inserted in the
+  /// database in the same order as a sequential traversal.
   void run_checks(const std::vector< std::unique_ptr< Checker > >& checkers);
 
+private:
+  /// \brief Run the checks on the given basic block
+  void run_checks(const std::vector< std::unique_ptr< Checker > >& checkers,
+                  ar::BasicBlock* bb);
+
 }; // end class FunctionFixpoint
 
 } // end namespace concurrent
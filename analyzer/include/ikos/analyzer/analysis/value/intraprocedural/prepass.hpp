@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Cheap numerical pre-pass for the intraprocedural analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/ar/semantic/function.hpp>
+
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/option.hpp>
+#include <ikos/analyzer/database/table/checks.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+namespace intraprocedural {
+
+/// \brief Numerical abstract domain of the pre-pass
+constexpr MachineIntDomainOption PrepassMachineIntDomain =
+    MachineIntDomainOption::Interval;
+
+/// \brief Return true if functions should be analyzed with the pre-pass first
+///
+/// The pre-pass is pointless if the numerical domain is already intervals,
+/// and it would display checks and invariants twice.
+bool use_prepass(const Context& ctx);
+
+/// \brief Return true if the function needs to be analyzed again with the
+/// numerical domain, given the checks of the pre-pass
+///
+/// This is the case for functions with cycles, or with unproven checks.
+bool needs_precise_analysis(ar::Function* function,
+                            const ChecksTable::Buffer& prepass_checks);
+
+/// \brief Replace the unproven checks of the precise analysis by the checks
+/// proven by the pre-pass
+///
+/// Both analyses are sound, hence a check proven by the pre-pass is proven,
+/// even if the numerical domain fails to prove it.
+void merge_proven_checks(const ChecksTable::Buffer& prepass_checks,
+                         ChecksTable::Buffer& checks);
+
+} // end namespace intraprocedural
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
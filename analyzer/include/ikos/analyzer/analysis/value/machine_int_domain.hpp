@@ -62,6 +62,9 @@ using MachineIntAbstractDomain =
 MachineIntAbstractDomain make_top_machine_int_interval();
 MachineIntAbstractDomain make_bottom_machine_int_interval();
 
+MachineIntAbstractDomain make_top_machine_int_compact_interval();
+MachineIntAbstractDomain make_bottom_machine_int_compact_interval();
+
 MachineIntAbstractDomain make_top_machine_int_congruence();
 MachineIntAbstractDomain make_bottom_machine_int_congruence();
 
@@ -0,0 +1,163 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Memory budget of the value analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+
+#include <ikos/ar/semantic/function.hpp>
+
+#include <ikos/analyzer/analysis/call_context.hpp>
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/support/assert.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+
+/// \brief Precision loss applied when running out of memory
+///
+/// Degradations are ordered: a degradation implies all the previous ones.
+enum class MemoryDegradation {
+  /// \brief Full precision
+  None = 0,
+
+  /// \brief Evict the cached fixpoints of the callees
+  EvictFixpointCache = 1,
+
+  /// \brief Stop inlining calls, use the unknown call semantic instead
+  NoInlining = 2,
+
+  /// \brief Widen on every iteration and skip the decreasing iterations
+  Accelerate = 3,
+};
+
+/// \brief Return a textual representation of a MemoryDegradation
+inline const char* memory_degradation_str(MemoryDegradation degradation) {
+  switch (degradation) {
+    case MemoryDegradation::None:
+      return "none";
+    case MemoryDegradation::EvictFixpointCache:
+      return "evict-fixpoint-cache";
+    case MemoryDegradation::NoInlining:
+      return "no-inlining";
+    case MemoryDegradation::Accelerate:
+      return "accelerate";
+    default: {
+      ikos_unreachable("unreachable");
+    }
+  }
+}
+
+/// \brief Memory budget of a function fixpoint
+///
+/// Compares the memory held by abstract values against the budget given by the
+/// `mem_budget` option, and escalates the degradation of the analysis of the
+/// function when the usage exceeds 75%, 90% and 100% of the budget.
+///
+/// Escalations are recorded in the degradations table of the output database.
+///
+/// This class is thread-safe.
+class MemoryBudget {
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Analyzed function
+  ar::Function* _function;
+
+  /// \brief Call context
+  CallContext* _call_context;
+
+  /// \brief Whether the analysis inlines calls
+  ///
+  /// If false, only MemoryDegradation::Accelerate is applicable.
+  bool _inlining;
+
+  /// \brief Current degradation
+  std::atomic< MemoryDegradation > _degradation;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param ctx Analysis context
+  /// \param function Analyzed function
+  /// \param call_context Call context
+  /// \param inlining Whether the analysis inlines calls
+  /// \param degradation Initial degradation, inherited from the caller
+  MemoryBudget(Context& ctx,
+               ar::Function* function,
+               CallContext* call_context,
+               bool inlining,
+               MemoryDegradation degradation = MemoryDegradation::None);
+
+  /// \brief Check the memory usage and escalate the degradation if needed
+  ///
+  /// \returns true if the degradation changed
+  bool update();
+
+  /// \brief Return the current degradation
+  MemoryDegradation degradation() const {
+    return this->_degradation.load(std::memory_order_relaxed);
+  }
+
+  /// \brief Return true if the cached fixpoints of callees should be evicted
+  bool evict_fixpoint_cache() const {
+    return this->degradation() >= MemoryDegradation::EvictFixpointCache;
+  }
+
+  /// \brief Return true if calls should be inlined
+  bool inline_calls() const {
+    return this->degradation() < MemoryDegradation::NoInlining;
+  }
+
+  /// \brief Return true if the convergence should be accelerated
+  bool accelerate() const {
+    return this->degradation() >= MemoryDegradation::Accelerate;
+  }
+
+}; // end class MemoryBudget
+
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
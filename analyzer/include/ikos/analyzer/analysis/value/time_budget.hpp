@@ -0,0 +1,181 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Time budget of the value analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include <ikos/ar/semantic/function.hpp>
+
+#include <ikos/analyzer/analysis/call_context.hpp>
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/support/assert.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+
+/// \brief Precision loss applied when running out of time
+///
+/// Degradations are ordered: a degradation implies all the previous ones.
+enum class TimeDegradation {
+  /// \brief Full precision
+  None = 0,
+
+  /// \brief Widen on every iteration and skip the decreasing iterations
+  Accelerate = 1,
+
+  /// \brief Stop inlining calls, use the unknown call semantic instead
+  NoInlining = 2,
+
+  /// \brief Abort the fixpoint, and analyze the function again with the
+  /// interval domain
+  Restart = 3,
+};
+
+/// \brief Return a textual representation of a TimeDegradation
+inline const char* time_degradation_str(TimeDegradation degradation) {
+  switch (degradation) {
+    case TimeDegradation::None:
+      return "none";
+    case TimeDegradation::Accelerate:
+      return "accelerate";
+    case TimeDegradation::NoInlining:
+      return "no-inlining";
+    case TimeDegradation::Restart:
+      return "restart-interval";
+    default: {
+      ikos_unreachable("unreachable");
+    }
+  }
+}
+
+/// \brief Time budget of a function fixpoint
+///
+/// Compares the time spent computing the fixpoint of a function, in a given
+/// call context, against the budget given by the `function_time_budget`
+/// option. Past the budget, the convergence is accelerated. Past twice the
+/// budget, the remaining calls are no longer inlined, or the fixpoint is
+/// restarted with the interval domain if the analysis allows it.
+///
+/// Escalations are recorded in the degradations table of the output database.
+///
+/// This class is thread-safe.
+class TimeBudget {
+private:
+  using Clock = std::chrono::steady_clock;
+
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Analyzed function
+  ar::Function* _function;
+
+  /// \brief Call context
+  CallContext* _call_context;
+
+  /// \brief Whether the analysis inlines calls
+  ///
+  /// If false, TimeDegradation::NoInlining is not applicable.
+  bool _inlining;
+
+  /// \brief Whether the fixpoint can be restarted with the interval domain
+  ///
+  /// If false, TimeDegradation::Restart is not applicable.
+  bool _restart;
+
+  /// \brief Start of the fixpoint computation
+  Clock::time_point _start;
+
+  /// \brief Current degradation
+  std::atomic< TimeDegradation > _degradation;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param ctx Analysis context
+  /// \param function Analyzed function
+  /// \param call_context Call context
+  /// \param inlining Whether the analysis inlines calls
+  /// \param restart Whether the fixpoint can be restarted with intervals
+  TimeBudget(Context& ctx,
+             ar::Function* function,
+             CallContext* call_context,
+             bool inlining,
+             bool restart);
+
+  /// \brief Start the clock, at the beginning of the fixpoint computation
+  void start() { this->_start = Clock::now(); }
+
+  /// \brief Check the elapsed time and escalate the degradation if needed
+  ///
+  /// \returns true if the degradation changed
+  bool update();
+
+  /// \brief Return the current degradation
+  TimeDegradation degradation() const {
+    return this->_degradation.load(std::memory_order_relaxed);
+  }
+
+  /// \brief Return true if the convergence should be accelerated
+  bool accelerate() const {
+    return this->degradation() >= TimeDegradation::Accelerate;
+  }
+
+  /// \brief Return true if calls should be inlined
+  bool inline_calls() const {
+    return this->degradation() < TimeDegradation::NoInlining;
+  }
+
+  /// \brief Return true if the fixpoint should be restarted with intervals
+  bool restart() const {
+    return this->degradation() >= TimeDegradation::Restart;
+  }
+
+}; // end class TimeBudget
+
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
@@ -116,6 +116,11 @@ public:
   virtual const char* description() const = 0;
 
   /// \brief Check a statement
+  ///
+  /// The same checker is used concurrently by the tasks of the concurrent
+  /// analyses (basic blocks, entry points and global destructors), which can
+  /// check the same statement at the same time. Implementations must not keep
+  /// state between calls.
   virtual void check(ar::Statement* stmt,
                      const value::AbstractDomain& inv,
                      CallContext* call_context) = 0;
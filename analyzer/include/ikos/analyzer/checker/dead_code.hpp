@@ -43,7 +43,8 @@
 
 #pragma once
 
-#include <llvm/ADT/DenseMap.h>
+#include <mutex>
+#include <unordered_map>
 
 #include <ikos/analyzer/checker/checker.hpp>
 
@@ -53,11 +54,19 @@ namespace analyzer {
 /// \brief Dead code checker
 class DeadCodeChecker final : public Checker {
 private:
-  /// \brief Previous statement for each basic block currently analyzed
+  /// \brief Map from a statement to the previous checked statement in its
+  /// basic block, or null
+  using PreviousMap = std::unordered_map< ar::Statement*, ar::Statement* >;
+
+private:
+  /// \brief Previous checked statements, per basic block
+  std::unordered_map< ar::BasicBlock*, PreviousMap > _previous;
+
+  /// \brief Mutex for _previous
   ///
-  /// Since we cannot get the previous statement of an `ar::Statement` in O(1),
-  /// we use this map to store the previously analyzed statement.
-  llvm::DenseMap< ar::BasicBlock*, ar::Statement* > _prev_stmts;
+  /// The same basic block can be checked concurrently by several tasks (e.g,
+  /// an inlined callee called from different basic blocks).
+  std::mutex _mutex;
 
 public:
   /// \brief Constructor
@@ -75,11 +84,11 @@ public:
              CallContext* call_context) override;
 
 private:
-  /// \brief Return the previous statement
-  ar::Statement* previous_statement(ar::Statement* stmt) const;
-
-  /// \brief Save the current statement
-  void save_current_statement(ar::Statement* stmt);
+  /// \brief Return the previous checked statement in the basic block, or null
+  ///
+  /// The basic block is walked once, on the first check of one of its
+  /// statements.
+  ar::Statement* previous_statement(ar::Statement* stmt);
 
   /// \brief Return true if we need to skip the check for the given statement
   static bool skip_check(ar::Statement* stmt);
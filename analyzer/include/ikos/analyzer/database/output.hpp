@@ -46,10 +46,14 @@
 #include <ikos/analyzer/database/sqlite.hpp>
 #include <ikos/analyzer/database/table/call_contexts.hpp>
 #include <ikos/analyzer/database/table/checks.hpp>
+#include <ikos/analyzer/database/table/degradations.hpp>
 #include <ikos/analyzer/database/table/files.hpp>
 #include <ikos/analyzer/database/table/functions.hpp>
 #include <ikos/analyzer/database/table/memory_locations.hpp>
 #include <ikos/analyzer/database/table/operands.hpp>
+#include <ikos/analyzer/database/table/profile_cycles.hpp>
+#include <ikos/analyzer/database/table/profile_functions.hpp>
+#include <ikos/analyzer/database/table/profile_operations.hpp>
 #include <ikos/analyzer/database/table/settings.hpp>
 #include <ikos/analyzer/database/table/statements.hpp>
 #include <ikos/analyzer/database/table/times.hpp>
@@ -70,6 +74,10 @@ public:
   CallContextsTable call_contexts;
   MemoryLocationsTable memory_locations;
   ChecksTable checks;
+  DegradationsTable degradations;
+  ProfileFunctionsTable profile_functions;
+  ProfileCyclesTable profile_cycles;
+  ProfileOperationsTable profile_operations;
 
 public:
   /// \brief Constructor
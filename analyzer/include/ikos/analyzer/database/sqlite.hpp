@@ -46,6 +46,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <sqlite3.h>
@@ -167,6 +168,9 @@ private:
   /// \brief Number of inserted rows, in CommitPolicy::Auto
   std::size_t _inserted_rows = 0;
 
+  /// \brief Mutex for tables sharing this connection
+  std::recursive_mutex _mutex;
+
 public:
   /// \brief No default constructor
   DbConnection() = delete;
@@ -213,6 +217,11 @@ public:
   /// \brief Return the current commit policy
   CommitPolicy commit_policy() const { return this->_commit_policy; }
 
+  /// \brief Return the mutex used to serialize insertions
+  ///
+  /// Tables lock it on insertion, which allows checkers to run concurrently.
+  std::recursive_mutex& mutex() { return this->_mutex; }
+
 private:
   /// \brief Called upon a row insertion
   void row_inserted();
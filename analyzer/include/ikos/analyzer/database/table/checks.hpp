@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <ikos/analyzer/analysis/result.hpp>
 #include <ikos/analyzer/checker/kind.hpp>
 #include <ikos/analyzer/checker/name.hpp>
@@ -57,6 +59,56 @@ namespace analyzer {
 
 /// \brief Checks table
 class ChecksTable : public DatabaseTable {
+public:
+  /// \brief Check waiting to be inserted in the database
+  struct PendingCheck {
+    CheckKind kind;
+    CheckerName checker;
+    Result status;
+    ar::Statement* stmt;
+    CallContext* call_context;
+    std::vector< ar::Value* > operands;
+    JsonDict info;
+  };
+
+  /// \brief Buffer of checks
+  using Buffer = std::vector< PendingCheck >;
+
+  /// \brief Redirect the checks of the current thread in a buffer
+  ///
+  /// While the object is alive, checks inserted by the current thread are
+  /// appended to the given buffer instead of being written in the database.
+  /// Scopes can be nested, the innermost one is used.
+  class ScopeBuffer {
+  private:
+    /// \brief Previous buffer of the current thread, or null
+    Buffer* _prev;
+
+  public:
+    /// \brief Constructor
+    explicit ScopeBuffer(Buffer& buffer);
+
+    /// \brief No copy constructor
+    ScopeBuffer(const ScopeBuffer&) = delete;
+
+    /// \brief No move constructor
+    ScopeBuffer(ScopeBuffer&&) = delete;
+
+    /// \brief No copy assignment operator
+    ScopeBuffer& operator=(const ScopeBuffer&) = delete;
+
+    /// \brief No move assignment operator
+    ScopeBuffer& operator=(ScopeBuffer&&) = delete;
+
+    /// \brief Destructor
+    ~ScopeBuffer();
+
+  }; // end class ScopeBuffer
+
+private:
+  /// \brief Buffer of the current thread, or null
+  static thread_local Buffer* CurrentBuffer;
+
 private:
   /// \brief Statements table
   StatementsTable& _statements;
@@ -89,6 +141,21 @@ public:
               llvm::ArrayRef< ar::Value* > operands = {},
               const JsonDict& info = {});
 
+  /// \brief Insert the checks of the given buffer, in order
+  ///
+  /// If the current thread has a buffer, checks are appended to it instead.
+  void insert(Buffer&& buffer);
+
+private:
+  /// \brief Write a check in the database
+  void insert_row(CheckKind kind,
+                  CheckerName checker,
+                  Result status,
+                  ar::Statement* stmt,
+                  CallContext* call_context,
+                  llvm::ArrayRef< ar::Value* > operands,
+                  const JsonDict& info);
+
 }; // end class ChecksTable
 
 } // end namespace analyzer
@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <boost/thread/shared_mutex.hpp>
+
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/IR/Constant.h>
 #include <llvm/IR/Type.h>
@@ -64,6 +66,12 @@ private:
   /// \brief Map from ar::Value* to id
   llvm::DenseMap< ar::Value*, sqlite::DbInt64 > _map;
 
+  /// \brief Mutex for the map
+  ///
+  /// Writers hold both the database mutex and this mutex, so that lookups only
+  /// need a shared lock on this mutex.
+  boost::shared_mutex _map_mutex;
+
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
@@ -72,6 +80,9 @@ public:
   explicit OperandsTable(sqlite::DbConnection& db);
 
   /// \brief Insert the given operand in the database and return the id
+  ///
+  /// Each operand is inserted once. The textual representation is computed
+  /// outside of the database lock.
   sqlite::DbInt64 insert(ar::Value* value);
 
   /// \brief Return a textual representation of a llvm::Type
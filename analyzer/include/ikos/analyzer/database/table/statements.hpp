@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <boost/thread/shared_mutex.hpp>
+
 #include <llvm/ADT/DenseMap.h>
 
 #include <ikos/ar/semantic/statement.hpp>
@@ -69,6 +71,12 @@ private:
   /// \brief Map from ar::Statement* to id
   llvm::DenseMap< ar::Statement*, sqlite::DbInt64 > _map;
 
+  /// \brief Mutex for the map
+  ///
+  /// Writers hold both the database mutex and this mutex, so that lookups only
+  /// need a shared lock on this mutex.
+  boost::shared_mutex _map_mutex;
+
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
@@ -79,6 +87,9 @@ public:
                   FunctionsTable& functions);
 
   /// \brief Insert the given statement in the database and return the id
+  ///
+  /// Each statement is inserted once. The source location is computed outside
+  /// of the database lock.
   sqlite::DbInt64 insert(ar::Statement* stmt);
 
 }; // end class StatementsTable
@@ -223,15 +223,49 @@ public:
 
 }; // end class ScopeLogger
 
+/// \brief Setup a logger for the current thread, for a given scope
+///
+/// Within the scope, the loggers set on the current thread, for instance by
+/// ScopeLogger, do not affect the other threads. This allows several analyses
+/// to run concurrently, each one with its own logger.
+class ThreadScopeLogger {
+private:
+  /// \brief Previous logger of the current thread, or null
+  Logger* _previous_logger;
+
+public:
+  /// \brief Constructor
+  explicit ThreadScopeLogger(Logger& logger);
+
+  /// \brief No copy constructor
+  ThreadScopeLogger(const ThreadScopeLogger&) = delete;
+
+  /// \brief No move constructor
+  ThreadScopeLogger(ThreadScopeLogger&&) = delete;
+
+  /// \brief No copy assignment operator
+  ThreadScopeLogger& operator=(const ThreadScopeLogger&) = delete;
+
+  /// \brief No move assignment operator
+  ThreadScopeLogger& operator=(ThreadScopeLogger&&) = delete;
+
+  /// \brief Destructor
+  ~ThreadScopeLogger();
+
+}; // end class ThreadScopeLogger
+
 namespace log {
 
 /// \brief Global logging level
 extern LogLevel Level;
 
 /// \brief Set the logger
+///
+/// This sets the logger of the current thread if it has one, see
+/// ThreadScopeLogger, otherwise the global logger.
 void set_logger(Logger&);
 
-/// \brief Get the logger
+/// \brief Get the logger of the current thread, or the global logger
 Logger& get_logger();
 
 /// \brief Logging output stream
@@ -65,7 +65,7 @@ from ikos.output_db import OutputDatabase
 
 
 def parse_arguments(argv):
-    usage = '%(prog)s [options] file[.c|.cpp|.bc|.ll]'
+    usage = '%(prog)s [options] file[.c|.cpp|.bc|.ll]...'
     description = 'ikos static analyzer'
     formatter_class = argparse.RawTextHelpFormatter
     parser = argparse.ArgumentParser(usage=usage,
@@ -73,16 +73,19 @@ def parse_arguments(argv):
                                      formatter_class=formatter_class)
 
     # Positional arguments
-    parser.add_argument('file',
+    parser.add_argument('files',
                         metavar='file[.c|.cpp|.bc|.ll]',
-                        help='File to analyze')
+                        nargs='+',
+                        help='Files to analyze')
 
     # Optional arguments
     parser.add_argument('-o', '--output-db',
-                        dest='output_db',
+                        dest='output_dbs',
                         metavar='<file>',
-                        help='Output database file (default: output.db)',
-                        default='output.db')
+                        help='Output database file, once per input file '
+                             '(default: output.db, or <file>.db with '
+                             'several input files)',
+                        action='append')
     parser.add_argument('-v',
                         dest='verbosity',
                         help='Increase verbosity',
@@ -129,6 +132,12 @@ def parse_arguments(argv):
                               args.default_globals_init_policy),
                           choices=args.choices(args.globals_init_policies),
                           default=args.default_globals_init_policy)
+    analysis.add_argument('--prune-globals-init',
+                          dest='prune_globals_init',
+                          help='Only initialize the global variables '
+                               'accessible from the analyzed code',
+                          action='store_true',
+                          default=False)
     analysis.add_argument('--no-init-globals',
                           dest='no_init_globals',
                           metavar='<function>',
@@ -140,6 +149,12 @@ def parse_arguments(argv):
                           help='Disable the liveness analysis',
                           action='store_true',
                           default=False)
+    analysis.add_argument('--no-compiled-blocks',
+                          dest='no_compiled_blocks',
+                          help='Execute basic blocks statement by statement,'
+                               ' without runs of integer instructions',
+                          action='store_true',
+                          default=False)
     analysis.add_argument('--no-pointer',
                           dest='no_pointer',
                           help='Disable the pointer analysis',
@@ -150,11 +165,51 @@ def parse_arguments(argv):
                           help='Disable the widening hint analysis',
                           action='store_true',
                           default=False)
+    analysis.add_argument('--no-prune-unreachable',
+                          dest='no_prune_unreachable',
+                          help='Do not skip the functions unreachable from '
+                               'the entry points',
+                          action='store_true',
+                          default=False)
+    analysis.add_argument('--fused-scalar-domain',
+                          dest='fused_scalar_domain',
+                          help='Keep the uninitialized, nullity and points-to'
+                               ' information of a variable in a single record',
+                          action='store_true',
+                          default=False)
+    analysis.add_argument('--max-cells-per-location',
+                          dest='max_cells_per_location',
+                          metavar='',
+                          help='Maximum number of memory cells per memory'
+                               ' location. Past it, the cells of the memory'
+                               ' location are summarized',
+                          type=args.Integer(min=1))
+    analysis.add_argument('--domain-prepass',
+                          dest='domain_prepass',
+                          help='Analyze functions with intervals first, and'
+                               ' only use the numerical domain on functions'
+                               ' with cycles or unproven checks'
+                               ' (intraprocedural only)',
+                          action='store_true',
+                          default=False)
+    analysis.add_argument('--sparse-invariants',
+                          dest='sparse_invariants',
+                          help='Only keep invariants at cycle heads, and'
+                               ' recompute the others when checking'
+                               ' (sequential analysis only)',
+                          action='store_true',
+                          default=False)
     analysis.add_argument('--no-fixpoint-cache',
                           dest='no_fixpoint_cache',
                           help='Disable the cache of fixpoints',
                           action='store_true',
                           default=False)
+    analysis.add_argument('--summary-store',
+                          dest='summary_store',
+                          metavar='<file>',
+                          help='Load and save function summaries in the given'
+                               ' file, to reuse them across runs'
+                               ' (interprocedural only)')
     analysis.add_argument('--no-checks',
                           dest='no_checks',
                           help='Disable all the checks',
@@ -219,6 +274,25 @@ def parse_arguments(argv):
                           help='Perform a fixed number of narrowing'
                                ' iterations',
                           type=args.Integer(min=0))
+    analysis.add_argument('--context-depth',
+                          dest='context_depth',
+                          metavar='',
+                          help='Maximum depth of fully inlined call contexts.'
+                               ' Deeper calls are analyzed in a merged'
+                               ' context per callee',
+                          type=args.Integer(min=0))
+    analysis.add_argument('--context-depth-functions',
+                          dest='context_depth_functions',
+                          metavar='<function:int>',
+                          help='Maximum depth of fully inlined call contexts'
+                               ' for specific callees',
+                          action='append')
+    analysis.add_argument('--callee-contexts-limit',
+                          dest='callee_contexts_limit',
+                          metavar='',
+                          help='Maximum number of fully inlined call contexts'
+                               ' per callee',
+                          type=args.Integer(min=1))
     analysis.add_argument('--partitioning',
                           dest='partitioning',
                           metavar='',
@@ -350,6 +424,12 @@ def parse_arguments(argv):
                        help='Display liveness analysis results',
                        action='store_true',
                        default=False)
+    debug.add_argument('--check-liveness',
+                       dest='check_liveness',
+                       help='Check the liveness analysis results against a '
+                            'reference solver',
+                       action='store_true',
+                       default=False)
     debug.add_argument('--display-function-pointer',
                        dest='display_function_pointer',
                        help='Display function pointer analysis results',
@@ -386,6 +466,11 @@ def parse_arguments(argv):
                        help='Display analysis raw checks',
                        action='store_true',
                        default=False)
+    debug.add_argument('--profile',
+                       dest='profile',
+                       help='Profile the hot paths of the value analysis',
+                       action='store_true',
+                       default=False)
     debug.add_argument('--generate-dot',
                        dest='generate_dot',
                        help='Generate a .dot file for each function',
@@ -494,9 +579,36 @@ def parse_arguments(argv):
                           dest='mem',
                           help='MEM limit (MB)',
                           type=args.Integer(min=1))
+    resource.add_argument('--mem-budget',
+                          dest='mem_budget',
+                          help='Memory budget of the value analysis (MB). '
+                               'Past it, the analysis degrades its precision '
+                               'instead of running out of memory',
+                          type=args.Integer(min=1))
+    resource.add_argument('--function-time-budget',
+                          dest='function_time_budget',
+                          help='Time budget of the analysis of a function, '
+                               'per calling context (seconds). Past it, the '
+                               'analysis degrades its precision on that '
+                               'function',
+                          type=args.Integer(min=1))
 
     opt = parser.parse_args(argv)
 
+    # one output database per input file
+    if not opt.output_dbs:
+        if len(opt.files) == 1:
+            opt.output_dbs = ['output.db']
+        else:
+            opt.output_dbs = ['%s.db' % os.path.basename(path)
+                              for path in opt.files]
+    if len(opt.output_dbs) != len(opt.files):
+        parser.error('expected one output database per input file')
+    if len(set(map(os.path.abspath, opt.output_dbs))) != len(opt.files):
+        parser.error('expected distinct output databases')
+    if len(opt.files) > 1 and opt.format == 'web':
+        parser.error('the web format only supports one input file')
+
     # parse --analyses
     opt.analyses = args.parse_argument(parser,
                                        'analyses',
@@ -750,7 +862,7 @@ class AnalyzerError(Exception):
         self.returncode = returncode
 
 
-def ikos_analyzer(db_path, pp_path, opt):
+def ikos_analyzer(db_paths, pp_paths, opt):
     if settings.BUILD_MODE == 'Debug':
         log.warning('ikos was built in debug mode, the analysis might be slow')
     if is_apron_domain(opt.domain) and opt.jobs != 1:
@@ -758,8 +870,9 @@ def ikos_analyzer(db_path, pp_path, opt):
                     'the analysis might crash')
 
     # Fix huge slow down when ikos-analyzer uses DROP TABLE on an existing db
-    if os.path.isfile(db_path):
-        os.remove(db_path)
+    for db_path in db_paths:
+        if os.path.isfile(db_path):
+            os.remove(db_path)
 
     cmd = [settings.ikos_analyzer()]
 
@@ -793,18 +906,42 @@ def ikos_analyzer(db_path, pp_path, opt):
         cmd.append('-widening-delay-functions=%s'
                    % ','.join(opt.widening_delay_functions))
 
+    if opt.context_depth is not None:
+        cmd.append('-context-depth=%d' % opt.context_depth)
+    if opt.context_depth_functions:
+        cmd.append('-context-depth-functions=%s'
+                   % ','.join(opt.context_depth_functions))
+    if opt.callee_contexts_limit is not None:
+        cmd.append('-callee-contexts-limit=%d' % opt.callee_contexts_limit)
+
     if opt.no_init_globals:
         cmd.append('-no-init-globals=%s' % ','.join(opt.no_init_globals))
     if opt.no_liveness:
         cmd.append('-no-liveness')
+    if opt.no_compiled_blocks:
+        cmd.append('-no-compiled-blocks')
     if opt.no_pointer:
         cmd.append('-no-pointer')
     if opt.no_widening_hints:
         cmd.append('-no-widening-hints')
+    if opt.no_prune_unreachable:
+        cmd.append('-no-prune-unreachable')
     if opt.partitioning != 'no':
         cmd.append('-enable-partitioning-domain')
+    if opt.fused_scalar_domain:
+        cmd.append('-enable-fused-scalar-domain')
+    if opt.max_cells_per_location is not None:
+        cmd.append('-max-cells-per-location=%d' % opt.max_cells_per_location)
+    if opt.domain_prepass:
+        cmd.append('-enable-domain-prepass')
+    if opt.sparse_invariants:
+        cmd.append('-enable-sparse-invariants')
+    if opt.prune_globals_init:
+        cmd.append('-prune-globals-init')
     if opt.no_fixpoint_cache:
         cmd.append('-no-fixpoint-cache')
+    if opt.summary_store:
+        cmd.append('-summary-store=%s' % opt.summary_store)
     if opt.no_checks:
         cmd.append('-no-checks')
     if opt.hardware_addresses:
@@ -813,6 +950,10 @@ def ikos_analyzer(db_path, pp_path, opt):
         cmd.append('-hardware-addresses-file=%s' % opt.hardware_addresses_file)
     if opt.argc is not None:
         cmd.append('-argc=%d' % opt.argc)
+    if opt.mem_budget is not None:
+        cmd.append('-mem-budget=%d' % opt.mem_budget)
+    if opt.function_time_budget is not None:
+        cmd.append('-function-time-budget=%d' % opt.function_time_budget)
 
     # import options
     cmd.append('-allow-dbg-mismatch')
@@ -845,12 +986,16 @@ def ikos_analyzer(db_path, pp_path, opt):
         cmd.append('-display-ar')
     if opt.display_liveness:
         cmd.append('-display-liveness')
+    if opt.check_liveness:
+        cmd.append('-check-liveness')
     if opt.display_function_pointer:
         cmd.append('-display-function-pointer')
     if opt.display_pointer:
         cmd.append('-display-pointer')
     if opt.display_fixpoint_parameters:
         cmd.append('-display-fixpoint-parameters')
+    if opt.profile:
+        cmd.append('-profile')
     if opt.generate_dot:
         cmd += ['-generate-dot', '-generate-dot-dir', opt.generate_dot_dir]
 
@@ -874,7 +1019,9 @@ def ikos_analyzer(db_path, pp_path, opt):
     cmd.append('-progress=%s' % opt.progress)
 
     # input/output
-    cmd += [pp_path, '-o', db_path]
+    cmd += pp_paths
+    for db_path in db_paths:
+        cmd += ['-o', db_path]
 
     # set resource limit, if requested
     if opt.mem:
@@ -943,85 +1090,9 @@ def ikos_view(opt, db):
     v.serve()
 
 
-#################
-# main for ikos #
-#################
-
-def main(argv):
-    progname = os.path.basename(argv[0])
-
-    start_date = datetime.datetime.now()
-
-    # parse arguments
-    opt = parse_arguments(argv[1:])
-
-    # setup colors and logging
-    colors.setup(opt.color, file=log.out)
-    log.setup(opt.log_level)
-
-    if is_apron_domain(opt.domain) and not settings.HAS_APRON:
-        printf('%s: error: cannot use apron abstract domains.\n'
-               'ikos was compiled without apron support, '
-               'see analyzer/README.md\n',
-               progname, file=sys.stderr)
-        sys.exit(1)
-
-    # create working directory
-    wd = create_working_directory(opt.temp_dir, opt.save_temps)
-
-    input_path = opt.file
-
-    # compile c/c++ code
-    if path_ext(input_path) in c_extensions + cpp_extensions:
-        bc_path = namer(opt.file, '.bc', wd)
-
-        try:
-            with stats.timer('clang'):
-                clang(bc_path, input_path,
-                      opt.compiler_include_flags,
-                      opt.compiler_define_flags,
-                      opt.compiler_warning_flags,
-                      opt.compiler_disable_warnings,
-                      opt.compiler_machine_flags,
-                      colors.ENABLE)
-        except subprocess.CalledProcessError as e:
-            printf('%s: error while compiling %s, abort.\n',
-                   progname, input_path, file=sys.stderr)
-            sys.exit(e.returncode)
-
-        input_path = bc_path
-
-    if path_ext(input_path) not in llvm_extensions:
-        printf('%s: error: unexpected file extension.\n',
-               progname, file=sys.stderr)
-        sys.exit(1)
-
-    # ikos-pp: preprocess llvm bitcode
-    pp_path = namer(opt.file, '.pp.bc', wd)
-    try:
-        with stats.timer('ikos-pp'):
-            ikos_pp(pp_path, input_path,
-                    opt.entry_points, opt.opt_level,
-                    opt.inline_all, not opt.no_bc_verify)
-    except subprocess.CalledProcessError as e:
-        printf('%s: error while preprocessing llvm bitcode, abort.\n',
-               progname, file=sys.stderr)
-        sys.exit(e.returncode)
-
-    # display the llvm bitcode, if requested
-    if opt.display_llvm:
-        display_llvm(pp_path)
-
-    # ikos-analyzer: analyze llvm bitcode
-    try:
-        with stats.timer('ikos-analyzer'):
-            ikos_analyzer(opt.output_db, pp_path, opt)
-    except AnalyzerError as e:
-        printf('%s: error: %s\n', progname, e, file=sys.stderr)
-        sys.exit(e.returncode)
-
+def report_database(opt, db_path, input_rows, start_date, end_date, wd):
     # open output database
-    db = OutputDatabase(path=opt.output_db)
+    db = OutputDatabase(path=db_path)
 
     # insert timing results in the database
     db.insert_timing_results(stats.rows())
@@ -1030,11 +1101,11 @@ def main(argv):
     settings_rows = [
         ('version', settings.VERSION),
         ('start-date', start_date.isoformat(' ')),
-        ('end-date', datetime.datetime.now().isoformat(' ')),
+        ('end-date', end_date.isoformat(' ')),
         ('working-directory', wd),
-        ('input', opt.file),
-        ('bc-file', input_path),
-        ('pp-bc-file', pp_path),
+    ]
+    settings_rows += input_rows
+    settings_rows += [
         ('clang', settings.clang()),
         ('ikos-pp', settings.ikos_pp()),
         ('opt-level', opt.opt_level),
@@ -1075,6 +1146,13 @@ def main(argv):
         report.print_raw_checks(db, opt.procedural == 'inter')
         first = False
 
+    # display profile
+    if opt.profile:
+        if not first:
+            printf('\n')
+        report.print_profile(db)
+        first = False
+
     # start ikos-view
     if opt.format == 'web':
         ikos_view(opt, db)
@@ -1103,4 +1181,118 @@ def main(argv):
     db.close()
 
     if opt.remove_db:
-        os.remove(opt.output_db)
+        os.remove(db_path)
+
+
+#################
+# main for ikos #
+#################
+
+def main(argv):
+    progname = os.path.basename(argv[0])
+
+    start_date = datetime.datetime.now()
+
+    # parse arguments
+    opt = parse_arguments(argv[1:])
+
+    # setup colors and logging
+    colors.setup(opt.color, file=log.out)
+    log.setup(opt.log_level)
+
+    if is_apron_domain(opt.domain) and not settings.HAS_APRON:
+        printf('%s: error: cannot use apron abstract domains.\n'
+               'ikos was compiled without apron support, '
+               'see analyzer/README.md\n',
+               progname, file=sys.stderr)
+        sys.exit(1)
+
+    # create working directory
+    wd = create_working_directory(opt.temp_dir, opt.save_temps)
+
+    bc_paths = []
+    pp_paths = []
+    for i, file_path in enumerate(opt.files):
+        input_path = file_path
+
+        # with several input files, use one working directory per file, in
+        # case two files have the same name
+        file_wd = wd
+        if len(opt.files) > 1:
+            file_wd = os.path.join(wd, str(i))
+            if not os.path.isdir(file_wd):
+                os.mkdir(file_wd)
+
+        # compile c/c++ code
+        if path_ext(input_path) in c_extensions + cpp_extensions:
+            bc_path = namer(file_path, '.bc', file_wd)
+
+            try:
+                with stats.timer('clang'):
+                    clang(bc_path, input_path,
+                          opt.compiler_include_flags,
+                          opt.compiler_define_flags,
+                          opt.compiler_warning_flags,
+                          opt.compiler_disable_warnings,
+                          opt.compiler_machine_flags,
+                          colors.ENABLE)
+            except subprocess.CalledProcessError as e:
+                printf('%s: error while compiling %s, abort.\n',
+                       progname, input_path, file=sys.stderr)
+                sys.exit(e.returncode)
+
+            input_path = bc_path
+
+        if path_ext(input_path) not in llvm_extensions:
+            printf('%s: error: unexpected file extension.\n',
+                   progname, file=sys.stderr)
+            sys.exit(1)
+
+        # ikos-pp: preprocess llvm bitcode
+        pp_path = namer(file_path, '.pp.bc', file_wd)
+        try:
+            with stats.timer('ikos-pp'):
+                ikos_pp(pp_path, input_path,
+                        opt.entry_points, opt.opt_level,
+                        opt.inline_all, not opt.no_bc_verify)
+        except subprocess.CalledProcessError as e:
+            printf('%s: error while preprocessing llvm bitcode, abort.\n',
+                   progname, file=sys.stderr)
+            sys.exit(e.returncode)
+
+        # display the llvm bitcode, if requested
+        if opt.display_llvm:
+            display_llvm(pp_path)
+
+        bc_paths.append(input_path)
+        pp_paths.append(pp_path)
+
+    # ikos-analyzer: analyze llvm bitcode, all the files at once
+    try:
+        with stats.timer('ikos-analyzer'):
+            ikos_analyzer(opt.output_dbs, pp_paths, opt)
+    except AnalyzerError as e:
+        printf('%s: error: %s\n', progname, e, file=sys.stderr)
+        sys.exit(e.returncode)
+
+    end_date = datetime.datetime.now()
+
+    # with several input files, each database gets the timing results of the
+    # whole run
+    for i, file_path in enumerate(opt.files):
+        if len(opt.files) > 1:
+            if i > 0:
+                printf('\n')
+            printf(colors.bold('# %s' % file_path) + '\n\n')
+
+        report_database(opt,
+                        opt.output_dbs[i],
+                        [
+                            ('input', file_path),
+                            ('bc-file', bc_paths[i]),
+                            ('pp-bc-file', pp_paths[i]),
+                        ],
+                        start_date,
+                        end_date,
+                        wd)
+
@@ -200,6 +200,8 @@ default_analyses = (
 domains = (
     ('interval',
      'Interval domain'),
+    ('compact-interval',
+     'Interval domain with a compact storage'),
     ('congruence',
      'Congruence domain'),
     ('interval-congruence',
@@ -111,6 +111,55 @@ class OutputDatabase(object):
         c.executemany('INSERT INTO times VALUES (?, ?)', rows)
         self.con.commit()
 
+    def load_profile_functions(self, limit=None):
+        '''
+        Load the profile of the functions from the database, ranked by time,
+        as a list of tuples (name, demangled, analyses, time, inlined_calls,
+        cache_hits, normalizations, normalize_time)
+        '''
+        c = self.con.cursor()
+        c.execute('SELECT functions.name, functions.demangled, '
+                  'p.analyses, p.time, p.inlined_calls, p.cache_hits, '
+                  'p.normalizations, p.normalize_time '
+                  'FROM profile_functions p '
+                  'JOIN functions ON p.function_id = functions.id '
+                  'ORDER BY p.time DESC '
+                  'LIMIT ?', (limit if limit is not None else -1,))
+        return c.fetchall()
+
+    def load_profile_cycles(self, limit=None):
+        '''
+        Load the profile of the cycles from the database, ranked by time,
+        as a list of tuples (name, demangled, path, line, head,
+        increasing_iterations, decreasing_iterations, joins, widenings,
+        narrowings, meets, leqs, time)
+        '''
+        c = self.con.cursor()
+        c.execute('SELECT functions.name, functions.demangled, '
+                  'files.path, statements.line, p.head, '
+                  'p.increasing_iterations, p.decreasing_iterations, '
+                  'p.joins, p.widenings, p.narrowings, p.meets, p.leqs, '
+                  'p.time '
+                  'FROM profile_cycles p '
+                  'JOIN functions ON p.function_id = functions.id '
+                  'LEFT JOIN statements ON p.statement_id = statements.id '
+                  'LEFT JOIN files ON statements.file_id = files.id '
+                  'ORDER BY p.time DESC '
+                  'LIMIT ?', (limit if limit is not None else -1,))
+        return c.fetchall()
+
+    def load_profile_operations(self):
+        '''
+        Load the profile of the operations on the abstract domain from the
+        database, ranked by time, as a list of tuples (domain, operation,
+        count, time)
+        '''
+        c = self.con.cursor()
+        c.execute('SELECT domain, operation, count, time '
+                  'FROM profile_operations '
+                  'ORDER BY time DESC')
+        return c.fetchall()
+
     @CachedProperty
     def files(self):
         return self._fetch_table('files', File)
@@ -285,7 +334,16 @@ class CallContext(object):
         self.db = db
 
     def empty(self):
-        return self.call_id is None
+        ''' Return True if this is the context of an entry point '''
+        return self.call_id is None and self.function_id is None
+
+    def merged(self):
+        ''' Return True if this is the merged context of a function
+
+        A merged context stands for any calling context of the function,
+        given by function().
+        '''
+        return self.call_id is None and self.function_id is not None
 
     def call(self):
         ''' Return the call statement '''
@@ -307,7 +365,7 @@ class CallContext(object):
         call_context = self
         ctx = []
 
-        while not call_context.empty():
+        while not call_context.empty() and not call_context.merged():
             function = call_context.function()
             call = call_context.call()
 
@@ -318,7 +376,10 @@ class CallContext(object):
 
             call_context = call_context.parent()
 
-        ctx.append('.')
+        if call_context.merged():
+            ctx.append('*%s' % call_context.function().pretty_name())
+        else:
+            ctx.append('.')
         ctx.reverse()
         return '/'.join(ctx)
 
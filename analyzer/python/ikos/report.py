@@ -106,6 +106,53 @@ def print_timing_results(db, full=True, sort=True):
         printf('%s: %s\n', name.ljust(name_width), format_time(elapsed))
 
 
+###########
+# profile #
+###########
+
+
+def print_profile(db, limit=20):
+    ''' Print the profile of the value analysis, ranked by time '''
+    functions = db.load_profile_functions(limit)
+    cycles = db.load_profile_cycles(limit)
+    operations = db.load_profile_operations()
+
+    printf(bold('# Profile:') + '\n')
+
+    printf(bold('## Functions:') + '\n')
+    printf('%10s %9s %9s %9s %10s %10s  %s\n',
+           'time', 'analyses', 'inlined', 'cached', 'normalize',
+           'norm time', 'function')
+    for (name, demangled, analyses, elapsed, inlined_calls, cache_hits,
+         normalizations, normalize_time) in functions:
+        printf('%9.3fs %9d %9d %9d %10d %9.3fs  %s\n',
+               elapsed, analyses, inlined_calls, cache_hits,
+               normalizations, normalize_time, demangled or name)
+
+    printf('\n')
+    printf(bold('## Cycles:') + '\n')
+    printf('%10s %9s %9s %9s %9s %9s %9s %9s  %s\n',
+           'time', 'incr', 'decr', 'joins', 'widen', 'narrow', 'meets',
+           'leqs', 'cycle')
+    for (name, demangled, path, line, head, increasing_iterations,
+         decreasing_iterations, joins, widenings, narrowings, meets, leqs,
+         elapsed) in cycles:
+        location = demangled or name
+        if path is not None and line is not None:
+            location = '%s:%d: %s' % (path, line, location)
+        if head is not None:
+            location = '%s (%s)' % (location, head)
+        printf('%9.3fs %9d %9d %9d %9d %9d %9d %9d  %s\n',
+               elapsed, increasing_iterations, decreasing_iterations,
+               joins, widenings, narrowings, meets, leqs, location)
+
+    printf('\n')
+    printf(bold('## Operations:') + '\n')
+    printf('%10s %9s %10s  %s\n', 'time', 'count', 'operation', 'domain')
+    for domain, operation, count, elapsed in operations:
+        printf('%9.3fs %9d %10s  %s\n', elapsed, count, operation, domain)
+
+
 ###########
 # summary #
 ###########
@@ -723,11 +770,23 @@ class TextFormatter(Formatter):
                    function.pretty_name(), file=self.output)
             return
 
+        if call_context.merged():
+            function = call_context.function()
+            printf("called from any context of function '%s' (merged)\n",
+                   function.pretty_name(), file=self.output)
+            return
+
         printf('called from:\n', file=self.output)
         for _ in range(max_depth):
             if call_context.empty():
                 return
 
+            if call_context.merged():
+                function = call_context.function()
+                printf("any context of function '%s' (merged)\n",
+                       function.pretty_name(), file=self.output)
+                return
+
             call_statement = call_context.call()
             function = call_context.function()
 
@@ -1905,6 +1964,12 @@ def parse_arguments(argv):
                         help='Display analysis raw checks',
                         action='store_true',
                         default=False)
+    parser.add_argument('--profile',
+                        dest='display_profile',
+                        help='Display the profile of the value analysis, '
+                             'ranked by time (requires ikos --profile)',
+                        action='store_true',
+                        default=False)
     parser.add_argument('-f', '--format',
                         dest='format',
                         metavar='',
@@ -2028,6 +2093,13 @@ def main(argv):
             print_raw_checks(db, settings['procedural'] == 'interprocedural')
             first = False
 
+        # display profile
+        if opt.display_profile:
+            if not first:
+                printf('\n')
+            print_profile(db)
+            first = False
+
         # start ikos-view
         if opt.format == 'web':
             ikos_view(opt, db)
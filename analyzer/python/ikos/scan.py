@@ -923,7 +923,9 @@ def scan_main(argv):
     if not binaries:
         printf('Nothing to analyze.\n')
 
-    # analyze each binary
+    # ask which binaries to analyze
+    bc_paths = []
+    db_paths = []
     for binary in binaries:
         exe_path = os.path.relpath(binary['exe_path'])
         bc_path = os.path.relpath(binary['bc_path'])
@@ -932,14 +934,22 @@ def scan_main(argv):
         answer = sys.stdin.readline().strip().lower()
 
         if answer in ('', 'y', 'yes'):
-            cmd = ['ikos', bc_path, '-o', '%s.db' % exe_path]
-            log.info('Running %s' % colors.bold(command_string(cmd)))
-
-            cmd = [sys.executable,
-                   settings.ikos(),
-                   bc_path,
-                   '-o',
-                   '%s.db' % exe_path,
-                   '--color=%s' % opt.color,
-                   '--log=%s' % opt.log_level]
-            run(cmd)
+            bc_paths.append(bc_path)
+            db_paths.append('%s.db' % exe_path)
+
+    # analyze all the binaries in one run, so that they share the analyzer
+    # process and its caches
+    if bc_paths:
+        output_args = []
+        for db_path in db_paths:
+            output_args += ['-o', db_path]
+
+        cmd = ['ikos'] + bc_paths + output_args
+        log.info('Running %s' % colors.bold(command_string(cmd)))
+
+        cmd = ([sys.executable, settings.ikos()] +
+               bc_paths +
+               output_args +
+               ['--color=%s' % opt.color,
+                '--log=%s' % opt.log_level])
+        run(cmd)
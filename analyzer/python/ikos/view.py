@@ -522,6 +522,11 @@ class Formatter(HtmlFormatter):
 
         lines = []
         while not call_context.empty():
+            if call_context.merged():
+                lines.append("any context of function '%s' (merged)"
+                             % call_context.function().pretty_name())
+                break
+
             call_statement = call_context.call()
             function = call_context.function()
             line = "%s:%s:%s: function '%s'" % (
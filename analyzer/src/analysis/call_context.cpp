@@ -48,8 +48,8 @@
 namespace ikos {
 namespace analyzer {
 
-CallContextFactory::CallContextFactory()
-    : _empty_call_context(new CallContext()) {}
+CallContextFactory::CallContextFactory(const AnalysisOptions& opts)
+    : _empty_call_context(new CallContext()), _opts(opts) {}
 
 CallContextFactory::~CallContextFactory() = default;
 
@@ -75,5 +75,64 @@ CallContext* CallContextFactory::get_context(CallContext* parent,
   }
 }
 
+CallContext* CallContextFactory::get_merged(ar::Function* fun) {
+  ikos_assert(fun != nullptr);
+
+  {
+    boost::shared_lock< boost::shared_mutex > lock(this->_mutex);
+    auto it = this->_merged_map.find(fun);
+    if (it != this->_merged_map.end()) {
+      return it->second.get();
+    }
+  }
+
+  auto call_context = std::unique_ptr< CallContext >(new CallContext(fun));
+
+  {
+    boost::unique_lock< boost::shared_mutex > lock(this->_mutex);
+    auto res = this->_merged_map.try_emplace(fun, std::move(call_context));
+    return res.first->second.get();
+  }
+}
+
+CallContext* CallContextFactory::get_callee_context(CallContext* parent,
+                                                    ar::CallBase* call,
+                                                    ar::Function* callee) {
+  ikos_assert(parent != nullptr && call != nullptr && callee != nullptr);
+
+  if (parent->is_merged()) {
+    // Calls from a merged context are merged as well
+    return this->get_merged(callee);
+  }
+
+  // Depth limit
+  boost::optional< unsigned > depth = this->_opts.context_depth;
+  auto it = this->_opts.context_depth_functions.find(callee);
+  if (it != this->_opts.context_depth_functions.end()) {
+    depth = it->second;
+  }
+
+  if (depth && parent->depth() >= *depth) {
+    return this->get_merged(callee);
+  }
+
+  CallContext* context = this->get_context(parent, call);
+
+  // Limit of full contexts per callee
+  if (this->_opts.callee_contexts_limit) {
+    boost::unique_lock< boost::shared_mutex > lock(this->_mutex);
+    llvm::DenseSet< CallContext* >& contexts = this->_callee_contexts[callee];
+    if (contexts.count(context) == 0) {
+      if (contexts.size() >= *this->_opts.callee_contexts_limit) {
+        lock.unlock();
+        return this->get_merged(callee);
+      }
+      contexts.insert(context);
+    }
+  }
+
+  return context;
+}
+
 } // end namespace analyzer
 } // end namespace ikos
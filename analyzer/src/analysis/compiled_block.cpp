@@ -0,0 +1,212 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Compiled basic blocks for the value analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <boost/thread/locks.hpp>
+
+#include <ikos/analyzer/analysis/compiled_block.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+boost::optional< core::machine_int::BinaryOperator > int_bin_operator(
+    ar::BinaryOperation* s) {
+  using IntBinaryOperator = core::machine_int::BinaryOperator;
+
+  switch (s->op()) {
+    case ar::BinaryOperation::UAdd:
+    case ar::BinaryOperation::SAdd:
+      return s->has_no_wrap() ? IntBinaryOperator::AddNoWrap
+                              : IntBinaryOperator::Add;
+    case ar::BinaryOperation::USub:
+    case ar::BinaryOperation::SSub:
+      return s->has_no_wrap() ? IntBinaryOperator::SubNoWrap
+                              : IntBinaryOperator::Sub;
+    case ar::BinaryOperation::UMul:
+    case ar::BinaryOperation::SMul:
+      return s->has_no_wrap() ? IntBinaryOperator::MulNoWrap
+                              : IntBinaryOperator::Mul;
+    case ar::BinaryOperation::UDiv:
+    case ar::BinaryOperation::SDiv:
+      return s->is_exact() ? IntBinaryOperator::DivExact
+                           : IntBinaryOperator::Div;
+    case ar::BinaryOperation::URem:
+    case ar::BinaryOperation::SRem:
+      return IntBinaryOperator::Rem;
+    case ar::BinaryOperation::UShl:
+    case ar::BinaryOperation::SShl:
+      return s->has_no_wrap() ? IntBinaryOperator::ShlNoWrap
+                              : IntBinaryOperator::Shl;
+    case ar::BinaryOperation::ULShr:
+    case ar::BinaryOperation::SLShr:
+      return s->is_exact() ? IntBinaryOperator::LShrExact
+                           : IntBinaryOperator::LShr;
+    case ar::BinaryOperation::UAShr:
+    case ar::BinaryOperation::SAShr:
+      return s->is_exact() ? IntBinaryOperator::AShrExact
+                           : IntBinaryOperator::AShr;
+    case ar::BinaryOperation::UAnd:
+    case ar::BinaryOperation::SAnd:
+      return IntBinaryOperator::And;
+    case ar::BinaryOperation::UOr:
+    case ar::BinaryOperation::SOr:
+      return IntBinaryOperator::Or;
+    case ar::BinaryOperation::UXor:
+    case ar::BinaryOperation::SXor:
+      return IntBinaryOperator::Xor;
+    default:
+      return boost::none;
+  }
+}
+
+namespace {
+
+/// \brief Return true if the literal is a machine integer variable
+bool is_int_var(const Literal& lit) {
+  return lit.is_scalar() && lit.scalar().is_machine_int_var();
+}
+
+/// \brief Return true if the literal is a machine integer constant or variable
+bool is_int_operand(const Literal& lit) {
+  return lit.is_scalar() &&
+         (lit.scalar().is_machine_int() || lit.scalar().is_machine_int_var());
+}
+
+} // end anonymous namespace
+
+CompiledBlock::CompiledBlock(ar::BasicBlock* bb,
+                             LiteralFactory& lit_factory,
+                             bool int_runs) {
+  for (ar::Statement* stmt : *bb) {
+    boost::optional< IntInstruction > inst;
+    if (int_runs) {
+      inst = compile(stmt, lit_factory);
+    }
+
+    if (!inst) {
+      this->_steps.push_back(Step{stmt, {}});
+    } else if (!this->_steps.empty() && this->_steps.back().stmt == nullptr) {
+      this->_steps.back().instructions.push_back(*inst);
+    } else {
+      this->_steps.push_back(Step{nullptr, {*inst}});
+    }
+  }
+}
+
+CompiledBlock::~CompiledBlock() = default;
+
+boost::optional< IntInstruction > CompiledBlock::compile(
+    ar::Statement* s, LiteralFactory& lit_factory) {
+  if (auto assign = dyn_cast< ar::Assignment >(s)) {
+    const Literal& result = lit_factory.get(assign->result());
+    const Literal& operand = lit_factory.get(assign->operand());
+
+    if (!is_int_var(result) || !is_int_operand(operand)) {
+      return boost::none;
+    }
+
+    return IntInstruction{IntInstruction::Assign,
+                          core::machine_int::BinaryOperator::Add,
+                          &result.scalar(),
+                          &operand.scalar(),
+                          nullptr};
+  } else if (auto bin = dyn_cast< ar::BinaryOperation >(s)) {
+    if (bin->has_undefined_constant_operand() ||
+        bin->result()->type()->is_vector()) {
+      return boost::none;
+    }
+
+    boost::optional< core::machine_int::BinaryOperator > op =
+        int_bin_operator(bin);
+    if (!op) {
+      return boost::none;
+    }
+
+    const Literal& result = lit_factory.get(bin->result());
+    const Literal& left = lit_factory.get(bin->left());
+    const Literal& right = lit_factory.get(bin->right());
+
+    if (!is_int_var(result) || !is_int_operand(left) ||
+        !is_int_operand(right)) {
+      return boost::none;
+    }
+
+    return IntInstruction{IntInstruction::Apply,
+                          *op,
+                          &result.scalar(),
+                          &left.scalar(),
+                          &right.scalar()};
+  } else {
+    return boost::none;
+  }
+}
+
+CompiledBlockFactory::CompiledBlockFactory(LiteralFactory& lit_factory,
+                                           bool int_runs)
+    : _lit_factory(lit_factory), _int_runs(int_runs) {}
+
+CompiledBlockFactory::~CompiledBlockFactory() = default;
+
+const CompiledBlock& CompiledBlockFactory::get(ar::BasicBlock* bb) {
+  {
+    boost::shared_lock< boost::shared_mutex > lock(this->_mutex);
+    auto it = this->_map.find(bb);
+    if (it != this->_map.end()) {
+      return *it->second;
+    }
+  }
+
+  auto block = std::make_unique< CompiledBlock >(bb,
+                                                 this->_lit_factory,
+                                                 this->_int_runs);
+
+  {
+    boost::unique_lock< boost::shared_mutex > lock(this->_mutex);
+    std::pair< Map::iterator, bool > res =
+        this->_map.emplace(bb, std::move(block));
+    return *res.first->second;
+  }
+}
+
+} // end namespace analyzer
+} // end namespace ikos
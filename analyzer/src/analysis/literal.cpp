@@ -110,6 +110,10 @@ MachineInt to_machine_int(const ZNumber& n, const ar::DataLayout& dl) {
   return MachineInt(n, dl.pointers.bit_width, Unsigned);
 }
 
+/// \brief Number of elements past which a constant data array is translated
+/// into a summarized aggregate literal, instead of one field per element
+constexpr std::size_t MaxDataArrayFields = 1024;
+
 /// \brief Add a Literal to a AggregateLit::Fields list
 class AddAggregateField : public Literal::Visitor<> {
 private:
@@ -150,6 +154,10 @@ public:
       this->_fields.push_back(AggregateLit::Field{this->_offset,
                                                   ScalarLit::undefined(),
                                                   this->_size});
+    } else if (aggregate.is_summarized()) {
+      throw LogicError(
+          "literal factory: unexpected summarized aggregate within a constant "
+          "aggregate");
     } else if (aggregate.is_var()) {
       throw LogicError(
           "literal factory: unexpected variable aggregate within a constant "
@@ -206,12 +214,20 @@ public:
     AggregateLit::Fields fields;
 
     for (auto it = c->field_begin(), et = c->field_end(); it != et; ++it) {
+      MachineInt offset = to_machine_int(it->offset, _dl);
+
+      // Nested data arrays are never summarized
+      if (auto data = dyn_cast< ar::DataArrayConstant >(it->value)) {
+        this->add_data_array_fields(fields, data, offset);
+        continue;
+      }
+
       // Translate element
       Literal value = ar::apply_visitor(*this, it->value);
 
       // Add in fields
       AddAggregateField vis(fields,
-                            /*offset = */ to_machine_int(it->offset, _dl),
+                            offset,
                             /*size = */
                             to_machine_int(_dl.store_size_in_bytes(
                                                it->value->type()),
@@ -235,13 +251,19 @@ public:
     std::size_t n = 0;
     for (auto it = c->element_begin(), et = c->element_end(); it != et;
          ++it, ++n) {
+      MachineInt offset = alloc_size * to_machine_int(n, _dl);
+
+      // Nested data arrays are never summarized
+      if (auto data = dyn_cast< ar::DataArrayConstant >(*it)) {
+        this->add_data_array_fields(fields, data, offset);
+        continue;
+      }
+
       // Translate element
       Literal value = ar::apply_visitor(*this, *it);
 
       // Add in fields
-      AddAggregateField vis(fields,
-                            /*offset = */ alloc_size * to_machine_int(n, _dl),
-                            /*size = */ alloc_size);
+      AddAggregateField vis(fields, offset, /*size = */ alloc_size);
       value.apply_visitor(vis);
     }
 
@@ -277,6 +299,40 @@ public:
                                          _dl)));
   }
 
+  Literal operator()(ar::DataArrayConstant* c) {
+    MachineInt size = to_machine_int(_dl.store_size_in_bytes(c->type()), _dl);
+
+    if (c->num_elements() > MaxDataArrayFields) {
+      // Only keep the bounds of the elements
+      MachineInt lb = c->element(0);
+      MachineInt ub = lb;
+      for (std::size_t n = 1; n < c->num_elements(); n++) {
+        MachineInt element = c->element(n);
+        if (element < lb) {
+          lb = element;
+        } else if (ub < element) {
+          ub = element;
+        }
+      }
+
+      return Literal(AggregateLit::summarized(
+          AggregateLit::Elements{std::move(lb),
+                                 std::move(ub),
+                                 /*element_size = */
+                                 to_machine_int(_dl.alloc_size_in_bytes(
+                                                    c->element_type()),
+                                                _dl)},
+          std::move(size)));
+    }
+
+    AggregateLit::Fields fields;
+    fields.reserve(c->num_elements());
+    this->add_data_array_fields(fields,
+                                c,
+                                /*offset = */ to_machine_int(0, _dl));
+    return Literal(AggregateLit::cst(std::move(fields), std::move(size)));
+  }
+
   Literal operator()(ar::AggregateZeroConstant* c) {
     return Literal(AggregateLit::zero(
         to_machine_int(_dl.store_size_in_bytes(c->type()), _dl)));
@@ -320,6 +376,22 @@ public:
     }
   }
 
+private:
+  /// \brief Add the elements of a data array at the given offset
+  void add_data_array_fields(AggregateLit::Fields& fields,
+                             ar::DataArrayConstant* c,
+                             const MachineInt& offset) {
+    MachineInt alloc_size =
+        to_machine_int(_dl.alloc_size_in_bytes(c->element_type()), _dl);
+
+    for (std::size_t n = 0; n < c->num_elements(); n++) {
+      fields.push_back(AggregateLit::Field{
+          /*offset = */ offset + alloc_size * to_machine_int(n, _dl),
+          ScalarLit::machine_int(c->element(n)),
+          /*size = */ alloc_size});
+    }
+  }
+
 }; // end class ValueVisitor
 
 } // end anonymous namespace
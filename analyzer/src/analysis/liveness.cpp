@@ -43,8 +43,17 @@
  *
  ******************************************************************************/
 
-#include <ikos/core/domain/discrete_domain.hpp>
-#include <ikos/core/fixpoint/fwd_fixpoint_iterator.hpp>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <llvm/ADT/BitVector.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 #include <ikos/ar/semantic/code.hpp>
 
@@ -58,337 +67,411 @@ namespace ikos {
 namespace analyzer {
 namespace {
 
-/// \brief Lattice of liveness
-///
-/// This is a small wrapper around core::DiscreteDomain, with a few changes:
-///   * The default constructor returns bottom
-///   * Has convenient operator+ and operator-
-template < typename VariableRef >
-class LivenessDomain final
-    : public core::AbstractDomain< LivenessDomain< VariableRef > > {
-private:
-  using DiscreteDomain = core::DiscreteDomain< VariableRef >;
-
-public:
-  using Iterator = typename DiscreteDomain::Iterator;
+/// \brief List of pairs (basic block, list of variables)
+using BlockVariableRefList =
+    std::vector< std::pair< ar::BasicBlock*,
+                            LivenessAnalysis::VariableRefList > >;
 
-private:
-  DiscreteDomain _inv;
-
-private:
-  /// \brief Private constructor
-  explicit LivenessDomain(DiscreteDomain inv) : _inv(std::move(inv)) {}
-
-public:
-  /// \brief Create the top liveness domain
-  static LivenessDomain top() { return LivenessDomain(DiscreteDomain::top()); }
-
-  /// \brief Create the bottom liveness domain
-  static LivenessDomain bottom() {
-    return LivenessDomain(DiscreteDomain::bottom());
+/// \brief Get the Variable* of an ar::Value
+///
+/// Returns nullptr if the value is not an internal or local variable
+Variable* variable_ref(VariableFactory& vfac, ar::Value* value) {
+  if (auto ptr = ar::dyn_cast< ar::FunctionPointerConstant >(value)) {
+    return vfac.get_function_ptr(ptr);
+  } else if (auto gv = ar::dyn_cast< ar::GlobalVariable >(value)) {
+    return vfac.get_global(gv);
+  } else if (auto lv = ar::dyn_cast< ar::LocalVariable >(value)) {
+    return vfac.get_local(lv);
+  } else if (auto iv = ar::dyn_cast< ar::InternalVariable >(value)) {
+    return vfac.get_internal(iv);
+  } else {
+    return nullptr;
   }
+}
 
-  /// \brief Create the empty liveness domain
-  static LivenessDomain empty() {
-    return LivenessDomain(DiscreteDomain::bottom());
-  }
+/// \brief Results of the liveness analysis on a code
+struct CodeLiveness {
+  BlockVariableRefList live_at_entry;
+  BlockVariableRefList dead_at_end;
+};
 
-  /// \brief Create the liveness domain with the given elements
-  LivenessDomain(std::initializer_list< VariableRef > elements)
-      : _inv(elements) {}
+/// \brief Liveness solver for a code
+///
+/// Variables of the code are numbered densely, so that sets of variables are
+/// bit vectors and the kill-gen equations are word-parallel operations.
+///
+/// The equations are solved with a worklist over the reverse control flow
+/// graph, starting from the exit block. Only the basic blocks that can reach
+/// the exit block get a result.
+class LivenessSolver {
+private:
+  /// \brief Liveness information of a basic block
+  struct BlockInfo {
+    /// \brief Variables defined in the block before being used
+    llvm::BitVector kill;
 
-  /// \brief Copy constructor
-  LivenessDomain(const LivenessDomain&) noexcept = default;
+    /// \brief Variables used in the block before being defined
+    llvm::BitVector gen;
 
-  /// \brief Move constructor
-  LivenessDomain(LivenessDomain&&) noexcept = default;
+    /// \brief Variables defined or used in the block
+    llvm::BitVector all;
 
-  /// \brief Copy assignment operator
-  LivenessDomain& operator=(const LivenessDomain&) noexcept = default;
+    /// \brief Live variables at the entry of the block
+    llvm::BitVector live_in;
 
-  /// \brief Move assignment operator
-  LivenessDomain& operator=(LivenessDomain&&) noexcept = default;
+    /// \brief Live variables at the end of the block
+    llvm::BitVector live_out;
+  };
 
-  /// \brief Destructor
-  ~LivenessDomain() override = default;
+private:
+  /// \brief Code
+  ar::Code* _code;
 
-  /// \brief Return the number of elements in the liveness domain
-  std::size_t size() const { return this->_inv.size(); }
+  /// \brief Variable factory
+  VariableFactory& _vfac;
 
-  /// \brief Begin iterator over the elements
-  Iterator begin() const { return this->_inv.begin(); }
+  /// \brief Basic blocks that can reach the exit block
+  std::vector< ar::BasicBlock* > _blocks;
 
-  /// \brief End iterator over the elements
-  Iterator end() const { return this->_inv.end(); }
+  /// \brief Map from basic block to its index in _blocks
+  llvm::DenseMap< ar::BasicBlock*, unsigned > _block_index;
 
-  void normalize() override {}
+  /// \brief Liveness information, indexed like _blocks
+  std::vector< BlockInfo > _infos;
 
-  bool is_bottom() const override { return this->_inv.is_bottom(); }
+  /// \brief Variables, indexed by their number
+  std::vector< Variable* > _vars;
 
-  bool is_top() const override { return this->_inv.is_top(); }
+  /// \brief Map from variable to its number
+  llvm::DenseMap< Variable*, unsigned > _var_index;
 
-  void set_to_bottom() override { this->_inv.set_to_bottom(); }
+public:
+  /// \brief Constructor
+  LivenessSolver(ar::Code* code, VariableFactory& vfac)
+      : _code(code), _vfac(vfac) {}
 
-  void set_to_top() override { this->_inv.set_to_top(); }
+  /// \brief Solve the liveness equations
+  void run() {
+    this->init_blocks();
 
-  bool leq(const LivenessDomain& other) const override {
-    return this->_inv.leq(other._inv);
-  }
+    this->_infos.resize(this->_blocks.size());
+    for (unsigned i = 0; i < this->_blocks.size(); i++) {
+      this->init_kill_gen(this->_blocks[i], this->_infos[i]);
+    }
 
-  bool equals(const LivenessDomain& other) const override {
-    return this->_inv.equals(other._inv);
-  }
+    // Now that all the variables are numbered, give all the bit vectors the
+    // same size
+    auto num_vars = static_cast< unsigned >(this->_vars.size());
+    for (BlockInfo& info : this->_infos) {
+      info.kill.resize(num_vars);
+      info.gen.resize(num_vars);
+      info.all.resize(num_vars);
+      info.live_in.resize(num_vars);
+      info.live_out.resize(num_vars);
+    }
 
-  void join_with(const LivenessDomain& other) override {
-    this->_inv.join_with(other._inv);
+    this->solve();
   }
 
-  void widen_with(const LivenessDomain& other) override {
-    this->_inv.widen_with(other._inv);
+  /// \brief Store the results in the given CodeLiveness
+  ///
+  /// There is one entry per basic block that can reach the exit block.
+  void results(CodeLiveness& result) const {
+    result.live_at_entry.reserve(this->_blocks.size());
+    result.dead_at_end.reserve(this->_blocks.size());
+
+    for (unsigned i = 0; i < this->_blocks.size(); i++) {
+      const BlockInfo& info = this->_infos[i];
+
+      // dead = all - live
+      llvm::BitVector dead(info.all);
+      dead.reset(info.live_out);
+
+      result.live_at_entry.emplace_back(this->_blocks[i],
+                                        this->to_variable_ref_list(
+                                            info.live_in));
+      result.dead_at_end.emplace_back(this->_blocks[i],
+                                      this->to_variable_ref_list(dead));
+    }
   }
 
-  void meet_with(const LivenessDomain& other) override {
-    this->_inv.meet_with(other._inv);
+private:
+  /// \brief Collect the basic blocks that can reach the exit block
+  void init_blocks() {
+    ar::BasicBlock* exit = this->_code->exit_block();
+    this->_blocks.push_back(exit);
+    this->_block_index.try_emplace(exit, 0);
+
+    // Breadth-first search on the reverse graph
+    for (unsigned i = 0; i < this->_blocks.size(); i++) {
+      ar::BasicBlock* bb = this->_blocks[i];
+      for (auto it = bb->predecessor_begin(), et = bb->predecessor_end();
+           it != et;
+           ++it) {
+        auto index = static_cast< unsigned >(this->_blocks.size());
+        if (this->_block_index.try_emplace(*it, index).second) {
+          this->_blocks.push_back(*it);
+        }
+      }
+    }
   }
 
-  void narrow_with(const LivenessDomain& other) override {
-    this->_inv.narrow_with(other._inv);
-  }
+  /// \brief Compute the kill/gen sets of the given basic block
+  void init_kill_gen(ar::BasicBlock* bb, BlockInfo& info) {
+    for (auto it = bb->rbegin(), et = bb->rend(); it != et; ++it) {
+      ar::Statement* stmt = *it;
 
-  void operator-=(const LivenessDomain& other) {
-    this->_inv.difference_with(other._inv);
-  }
+      // Process defs
+      if (stmt->has_result()) {
+        Variable* var = variable_ref(this->_vfac, stmt->result());
+        ikos_assert_msg(var != nullptr, "result is not a variable");
 
-  void operator-=(VariableRef v) { this->_inv.remove(v); }
+        unsigned v = this->number(var);
+        set(info.kill, v);
+        reset(info.gen, v);
+        set(info.all, v);
+      }
 
-  void operator+=(const LivenessDomain& other) {
-    this->_inv.join_with(other._inv);
+      // Process uses
+      for (auto op_it = stmt->op_begin(), op_et = stmt->op_end();
+           op_it != op_et;
+           ++op_it) {
+        Variable* var = variable_ref(this->_vfac, *op_it);
+        if (var != nullptr) {
+          unsigned v = this->number(var);
+          set(info.gen, v);
+          set(info.all, v);
+        }
+      }
+    }
   }
 
-  void operator+=(VariableRef v) { this->_inv.add(v); }
-
-  void dump(std::ostream& o) const override { this->_inv.dump(o); }
+  /// \brief Solve the kill-gen equations, until a fixpoint is reached
+  ///
+  /// OUT(B) = U { IN(S) | S successor of B }
+  /// IN(B) = (OUT(B) \ kill(B)) U gen(B)
+  void solve() {
+    std::deque< unsigned > worklist;
+    std::vector< bool > in_worklist(this->_blocks.size(), true);
+    for (unsigned i = 0; i < this->_blocks.size(); i++) {
+      worklist.push_back(i);
+    }
 
-  static std::string name() { return "liveness domain"; }
+    llvm::BitVector live_in;
+    while (!worklist.empty()) {
+      unsigned i = worklist.front();
+      worklist.pop_front();
+      in_worklist[i] = false;
+
+      ar::BasicBlock* bb = this->_blocks[i];
+      BlockInfo& info = this->_infos[i];
+
+      info.live_out.reset();
+      for (auto it = bb->successor_begin(), et = bb->successor_end(); it != et;
+           ++it) {
+        auto succ = this->_block_index.find(*it);
+        if (succ != this->_block_index.end()) {
+          info.live_out |= this->_infos[succ->second].live_in;
+        }
+      }
 
-}; // end class LivenessDomain
+      live_in = info.live_out;
+      live_in.reset(info.kill);
+      live_in |= info.gen;
 
-/// \brief Inverse an ar::Code* graph
-///
-/// The entry node is the exit node, and successors and predecessors are swapped
-struct ReverseCodeGraphTrait {
-  using NodeRef = ar::BasicBlock*;
-  using SuccessorNodeIterator = ar::BasicBlock::BasicBlockIterator;
-  using PredecessorNodeIterator = ar::BasicBlock::BasicBlockIterator;
-
-  static ar::BasicBlock* entry(ar::Code* code) {
-    ikos_assert_msg(code->has_exit_block(), "code graph cannot be inversed");
-    return code->exit_block();
+      if (live_in == info.live_in) {
+        continue;
+      }
+      info.live_in = live_in;
+
+      for (auto it = bb->predecessor_begin(), et = bb->predecessor_end();
+           it != et;
+           ++it) {
+        unsigned pred = this->_block_index.find(*it)->second;
+        if (!in_worklist[pred]) {
+          in_worklist[pred] = true;
+          worklist.push_back(pred);
+        }
+      }
+    }
   }
 
-  static SuccessorNodeIterator successor_begin(ar::BasicBlock* bb) {
-    return bb->predecessor_begin();
+  /// \brief Return the number of the given variable
+  unsigned number(Variable* var) {
+    auto index = static_cast< unsigned >(this->_vars.size());
+    auto res = this->_var_index.try_emplace(var, index);
+    if (res.second) {
+      this->_vars.push_back(var);
+    }
+    return res.first->second;
   }
 
-  static SuccessorNodeIterator successor_end(ar::BasicBlock* bb) {
-    return bb->predecessor_end();
+  /// \brief Add the variable `v` in the given bit vector
+  static void set(llvm::BitVector& bv, unsigned v) {
+    if (v >= bv.size()) {
+      bv.resize(v + 1);
+    }
+    bv.set(v);
   }
 
-  static PredecessorNodeIterator predecessor_begin(ar::BasicBlock* bb) {
-    return bb->successor_begin();
+  /// \brief Remove the variable `v` from the given bit vector
+  static void reset(llvm::BitVector& bv, unsigned v) {
+    if (v < bv.size()) {
+      bv.reset(v);
+    }
   }
 
-  static PredecessorNodeIterator predecessor_end(ar::BasicBlock* bb) {
-    return bb->successor_end();
+  /// \brief Convert a bit vector into a VariableRefList
+  LivenessAnalysis::VariableRefList to_variable_ref_list(
+      const llvm::BitVector& bv) const {
+    LivenessAnalysis::VariableRefList list;
+    list.reserve(bv.count());
+    for (unsigned v : bv.set_bits()) {
+      list.push_back(this->_vars[v]);
+    }
+    return list;
   }
 
-}; // end struct ReverseCodeGraphTrait
-
-/// \brief Liveness fixpoint iterator
-class LivenessFixpointIterator final
-    : public core::InterleavedFwdFixpointIterator< ar::Code*,
-                                                   LivenessDomain< Variable* >,
-                                                   ReverseCodeGraphTrait > {
-private:
-  /// \brief Parent class
-  using FwdFixpointIterator =
-      core::InterleavedFwdFixpointIterator< ar::Code*,
-                                            LivenessDomain< Variable* >,
-                                            ReverseCodeGraphTrait >;
-
-  /// \brief Liveness abstract domain
-  using LivenessDomainT = LivenessDomain< Variable* >;
-
-  /// \brief A pair (kill, gen)
-  struct KillGen {
-    LivenessDomainT kill;
-    LivenessDomainT gen;
-  };
-
-  /// \brief Map from basic block to a (kill, gen) pair
-  using KillGenMap = llvm::DenseMap< ar::BasicBlock*, KillGen >;
-
-  /// \brief Map from basic block to liveness domain
-  using LivenessMap = llvm::DenseMap< ar::BasicBlock*, LivenessDomainT >;
+}; // end class LivenessSolver
 
+/// \brief Reference liveness solver, used to check LivenessSolver
+///
+/// This solves the same kill-gen equations on sets of variables, with a
+/// round-robin iteration over the basic blocks that can reach the exit block.
+/// It is slow, but simple.
+class ReferenceLivenessSolver {
 public:
-  /// \brief Iterator on a map from basic block to liveness domain
-  using LivenessMapIterator = LivenessMap::const_iterator;
+  /// \brief Set of variables
+  using VariableSet = std::set< Variable* >;
 
 private:
-  /// \brief Variable factory
-  VariableFactory& _vfac;
+  /// \brief Map from basic block to a set of variables
+  using VariableSetMap = llvm::DenseMap< ar::BasicBlock*, VariableSet >;
 
-  /// \brief Store (kill, gen) sets for each basic block
-  KillGenMap _kg_map;
+private:
+  /// \brief Code
+  ar::Code* _code;
 
-  /// \brief Set of all variables (defined and used) for each basic blocks
-  LivenessMap _all_vars_map;
+  /// \brief Variable factory
+  VariableFactory& _vfac;
 
-  /// \brief Set of live variables at the **entry** of a basic block
-  LivenessMap _live_at_entry_map;
+  /// \brief Live variables at the entry of the basic blocks that can reach
+  /// the exit block
+  VariableSetMap _live_in;
 
-  /// \brief Set of dead variables at the **end** of a basic block
-  LivenessMap _dead_at_end_map;
+  /// \brief Dead variables at the end of the basic blocks that can reach the
+  /// exit block
+  VariableSetMap _dead_out;
 
 public:
-  LivenessFixpointIterator(ar::Code* code, VariableFactory& vfac)
-      : FwdFixpointIterator(code, LivenessDomainT::bottom()), _vfac(vfac) {
-    this->init();
-  }
-
-  LivenessMapIterator live_at_entry_begin() const {
-    return this->_live_at_entry_map.begin();
-  }
-
-  LivenessMapIterator live_at_entry_end() const {
-    return this->_live_at_entry_map.end();
-  }
-
-  LivenessMapIterator dead_at_end_begin() const {
-    return this->_dead_at_end_map.begin();
-  }
-
-  LivenessMapIterator dead_at_end_end() const {
-    return this->_dead_at_end_map.end();
-  }
-
-  /// \brief Compute the set of dead and live variables
-  void run(LivenessDomainT inv) override {
-    FwdFixpointIterator::run(std::move(inv));
-  }
-
-  /// \brief Apply the kill-gen equation
-  ///
-  /// IN(B) = (OUT(B) \ kill (B)) U gen (B)
-  LivenessDomainT analyze_node(ar::BasicBlock* bb,
-                               LivenessDomainT post) override {
-    auto it = this->_kg_map.find(bb);
-    ikos_assert(it != this->_kg_map.end());
-
-    LivenessDomainT pre(post);
-    pre -= it->second.kill; // delete kill set
-    pre += it->second.gen;  // add gen set
-    return pre;
-  }
-
-  LivenessDomainT analyze_edge(ar::BasicBlock*,
-                               ar::BasicBlock*,
-                               LivenessDomainT pre) override {
-    return pre;
-  }
-
-  /// \brief Store the set of dead variables at the exit of `bb`
-  ///
-  /// Note: this is the post invariant, because we reversed the graph
-  void process_pre(ar::BasicBlock* bb,
-                   const LivenessDomainT& post_live) override {
-    ikos_assert(!post_live.is_top());
-
-    auto it = this->_all_vars_map.find(bb);
-    ikos_assert(it != this->_all_vars_map.end());
-    LivenessDomainT all = it->second;
-
-    // dead = all - live
-    LivenessDomainT dead(all);
-    dead -= post_live;
-
-    this->_dead_at_end_map.try_emplace(bb, dead);
-  }
-
-  /// \brief Store the set of live variables at the entry of `bb`
-  ///
-  /// Note: this is the pre invariant, because we reversed the graph
-  void process_post(ar::BasicBlock* bb,
-                    const LivenessDomainT& pre_live) override {
-    ikos_assert(!pre_live.is_top());
-
-    this->_live_at_entry_map.try_emplace(bb, pre_live);
-  }
-
-private:
-  /// \brief Compute kill/gen sets for each basic blocks
-  void init() {
-    ar::Code* code = this->cfg();
-
-    for (auto it = code->begin(), et = code->end(); it != et; ++it) {
-      this->init(*it);
+  /// \brief Constructor
+  ReferenceLivenessSolver(ar::Code* code, VariableFactory& vfac)
+      : _code(code), _vfac(vfac) {}
+
+  /// \brief Solve the liveness equations
+  void run() {
+    // Collect the basic blocks that can reach the exit block
+    std::vector< ar::BasicBlock* > blocks{this->_code->exit_block()};
+    this->_live_in.try_emplace(this->_code->exit_block());
+    for (std::size_t i = 0; i < blocks.size(); i++) {
+      for (auto it = blocks[i]->predecessor_begin(),
+                et = blocks[i]->predecessor_end();
+           it != et;
+           ++it) {
+        if (this->_live_in.try_emplace(*it).second) {
+          blocks.push_back(*it);
+        }
+      }
     }
-  }
 
-  /// \brief Compute kill/gen sets for the given basic block
-  void init(ar::BasicBlock* bb) {
-    auto kill = LivenessDomainT::empty();
-    auto gen = LivenessDomainT::empty();
-    auto all = LivenessDomainT::empty();
+    // Compute the kill, gen and all sets
+    VariableSetMap kill, gen, all;
+    for (ar::BasicBlock* bb : blocks) {
+      for (auto it = bb->rbegin(), et = bb->rend(); it != et; ++it) {
+        ar::Statement* stmt = *it;
+        if (stmt->has_result()) {
+          Variable* var = variable_ref(this->_vfac, stmt->result());
+          kill[bb].insert(var);
+          gen[bb].erase(var);
+          all[bb].insert(var);
+        }
+        for (auto op_it = stmt->op_begin(), op_et = stmt->op_end();
+             op_it != op_et;
+             ++op_it) {
+          if (Variable* var = variable_ref(this->_vfac, *op_it)) {
+            gen[bb].insert(var);
+            all[bb].insert(var);
+          }
+        }
+      }
+    }
 
-    for (auto it = bb->rbegin(), et = bb->rend(); it != et; ++it) {
-      ar::Statement* stmt = *it;
+    // Iterate until nothing changes
+    VariableSetMap live_out;
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (ar::BasicBlock* bb : blocks) {
+        VariableSet out;
+        for (auto it = bb->successor_begin(), et = bb->successor_end();
+             it != et;
+             ++it) {
+          auto succ = this->_live_in.find(*it);
+          if (succ != this->_live_in.end()) {
+            out.insert(succ->second.begin(), succ->second.end());
+          }
+        }
 
-      // Process defs
-      if (stmt->has_result()) {
-        Variable* var = this->variable_ref(stmt->result());
-        ikos_assert_msg(var != nullptr, "result is not a variable");
+        VariableSet in = gen[bb];
+        for (Variable* var : out) {
+          if (kill[bb].count(var) == 0) {
+            in.insert(var);
+          }
+        }
 
-        kill += var;
-        gen -= var;
-        all += var;
+        if (in != this->_live_in[bb]) {
+          this->_live_in[bb] = std::move(in);
+          changed = true;
+        }
+        live_out[bb] = std::move(out);
       }
+    }
 
-      // Process uses
-      for (auto op_it = stmt->op_begin(), op_et = stmt->op_end();
-           op_it != op_et;
-           ++op_it) {
-        Variable* var = this->variable_ref(*op_it);
-        if (var != nullptr) {
-          gen += var;
-          all += var;
+    // dead = all - live
+    for (ar::BasicBlock* bb : blocks) {
+      VariableSet& dead = this->_dead_out[bb];
+      for (Variable* var : all[bb]) {
+        if (live_out[bb].count(var) == 0) {
+          dead.insert(var);
         }
       }
     }
+  }
 
-    this->_kg_map.try_emplace(bb, KillGen{kill, gen});
-    this->_all_vars_map.try_emplace(bb, all);
+  /// \brief Return true if the given results match the reference
+  bool check(ar::BasicBlock* bb,
+             boost::optional< const LivenessAnalysis::VariableRefList& >
+                 live_at_entry,
+             boost::optional< const LivenessAnalysis::VariableRefList& >
+                 dead_at_end) const {
+    return equals(this->_live_in, bb, live_at_entry) &&
+           equals(this->_dead_out, bb, dead_at_end);
   }
 
-  /// \brief Get the Variable* of an ar::Value
-  ///
-  /// Returns nullptr if the value is not an internal or local variable
-  Variable* variable_ref(ar::Value* value) {
-    if (auto ptr = ar::dyn_cast< ar::FunctionPointerConstant >(value)) {
-      return this->_vfac.get_function_ptr(ptr);
-    } else if (auto gv = ar::dyn_cast< ar::GlobalVariable >(value)) {
-      return this->_vfac.get_global(gv);
-    } else if (auto lv = ar::dyn_cast< ar::LocalVariable >(value)) {
-      return this->_vfac.get_local(lv);
-    } else if (auto iv = ar::dyn_cast< ar::InternalVariable >(value)) {
-      return this->_vfac.get_internal(iv);
-    } else {
-      return nullptr;
+private:
+  /// \brief Return true if the given list matches the set of `bb` in `map`
+  static bool equals(
+      const VariableSetMap& map,
+      ar::BasicBlock* bb,
+      boost::optional< const LivenessAnalysis::VariableRefList& > list) {
+    auto it = map.find(bb);
+    if (it == map.end() || !list) {
+      return it == map.end() && !list;
     }
+    return it->second == VariableSet(list->begin(), list->end());
   }
 
-}; // end class LivenessFixpointIterator
+}; // end class ReferenceLivenessSolver
 
 } // end anonymous namespace
 
@@ -419,31 +502,17 @@ boost::optional< const LivenessAnalysis::VariableRefList& > LivenessAnalysis::
 void LivenessAnalysis::run() {
   ar::Bundle* bundle = _ctx.bundle;
 
-  // Setup a progress logger
-  std::unique_ptr< ProgressLogger > progress =
-      make_progress_logger(_ctx.opts.progress,
-                           LogLevel::Info,
-                           /* num_tasks = */
-                           std::count_if(bundle->global_begin(),
-                                         bundle->global_end(),
-                                         [](ar::GlobalVariable* gv) {
-                                           return gv->is_definition();
-                                         }) +
-                               std::count_if(bundle->function_begin(),
-                                             bundle->function_end(),
-                                             [](ar::Function* fun) {
-                                               return fun->is_definition();
-                                             }));
-  ScopeLogger scope(*progress);
+  // Collect the codes, with their progress message
+  std::vector< std::pair< ar::Code*, std::string > > codes;
 
   for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
        ++it) {
     ar::GlobalVariable* gv = *it;
     if (gv->is_definition()) {
-      progress->start_task(
+      std::string status =
           "Running liveness analysis on initializer of global variable '" +
-          demangle(gv->name()) + "'");
-      this->run(gv->initializer());
+          demangle(gv->name()) + "'";
+      codes.emplace_back(gv->initializer(), std::move(status));
     }
   }
 
@@ -452,50 +521,106 @@ void LivenessAnalysis::run() {
        ++it) {
     ar::Function* fun = *it;
     if (fun->is_definition()) {
-      progress->start_task("Running liveness analysis on function '" +
-                           demangle(fun->name()) + "'");
-      this->run(fun->body());
+      std::string status = "Running liveness analysis on function '" +
+                           demangle(fun->name()) + "'";
+      codes.emplace_back(fun->body(), std::move(status));
     }
   }
-}
 
-/// \brief Convert a LivenessDomain into a VariableRefList
-static LivenessAnalysis::VariableRefList to_variable_ref_list(
-    const LivenessDomain< Variable* >& value) {
-  LivenessAnalysis::VariableRefList list;
+  // Setup a progress logger
+  std::unique_ptr< ProgressLogger > progress =
+      make_progress_logger(_ctx.opts.progress,
+                           LogLevel::Info,
+                           /* num_tasks = */ codes.size());
+  ScopeLogger scope(*progress);
+  std::mutex progress_mutex;
+
+  // Codes are independent, analyze them in parallel
+  //
+  // The task scheduler is initialized by the caller, see ikos-analyzer
+  std::vector< CodeLiveness > results(codes.size());
+
+  tbb::parallel_for(
+      tbb::blocked_range< std::size_t >(0, codes.size(), /* grainsize = */ 1),
+      [&](const tbb::blocked_range< std::size_t >& r) {
+        for (std::size_t i = r.begin(); i != r.end(); ++i) {
+          {
+            std::lock_guard< std::mutex > lock(progress_mutex);
+            progress->start_task(codes[i].second);
+          }
+          ar::Code* code = codes[i].first;
+
+          // If the code has no exit block, do nothing
+          if (!code->has_exit_block()) {
+            continue;
+          }
+
+          LivenessSolver solver(code, *_ctx.var_factory);
+          solver.run();
+          solver.results(results[i]);
+        }
+      });
 
-  if (!value.is_bottom()) {
-    list.reserve(value.size());
-    std::copy(value.begin(), value.end(), std::back_inserter(list));
+  // Store the results
+  for (CodeLiveness& result : results) {
+    for (auto& entry : result.live_at_entry) {
+      this->_live_at_entry_map.try_emplace(entry.first,
+                                           std::move(entry.second));
+    }
+    for (auto& entry : result.dead_at_end) {
+      this->_dead_at_end_map.try_emplace(entry.first, std::move(entry.second));
+    }
   }
-
-  return list;
 }
 
-void LivenessAnalysis::run(ar::Code* code) {
-  // If the code has no exit block, do nothing
-  if (!code->has_exit_block()) {
-    return;
-  }
-
-  // Run the liveness fixpoint iterator
-  LivenessFixpointIterator fixpoint(code, *_ctx.var_factory);
-  fixpoint.run(LivenessDomain< Variable* >::bottom());
+std::size_t LivenessAnalysis::check() const {
+  ar::Bundle* bundle = _ctx.bundle;
+  std::vector< ar::Code* > codes;
 
-  // Store the results
-  for (auto it = fixpoint.live_at_entry_begin(),
-            et = fixpoint.live_at_entry_end();
-       it != et;
+  for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
        ++it) {
-    this->_live_at_entry_map.try_emplace(it->first,
-                                         to_variable_ref_list(it->second));
+    ar::GlobalVariable* gv = *it;
+    if (gv->is_definition()) {
+      codes.push_back(gv->initializer());
+    }
   }
-  for (auto it = fixpoint.dead_at_end_begin(), et = fixpoint.dead_at_end_end();
+
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
        it != et;
        ++it) {
-    this->_dead_at_end_map.try_emplace(it->first,
-                                       to_variable_ref_list(it->second));
+    ar::Function* fun = *it;
+    if (fun->is_definition()) {
+      codes.push_back(fun->body());
+    }
+  }
+
+  std::size_t num_mismatches = 0;
+  for (ar::Code* code : codes) {
+    if (!code->has_exit_block()) {
+      continue;
+    }
+
+    ReferenceLivenessSolver reference(code, *_ctx.var_factory);
+    reference.run();
+
+    for (ar::BasicBlock* bb : *code) {
+      if (!reference.check(bb,
+                           this->live_at_entry(bb),
+                           this->dead_at_end(bb))) {
+        std::string where =
+            code->is_global_var_initializer()
+                ? ("initializer of global variable '" +
+                   demangle(code->global_var()->name()) + "'")
+                : ("function '" + demangle(code->function()->name()) + "'");
+        log::error("Liveness results differ from the reference solver on "
+                   "basic block '" +
+                   bb->name_or_empty() + "' of " + where);
+        num_mismatches++;
+      }
+    }
   }
+
+  return num_mismatches;
 }
 
 void LivenessAnalysis::dump(std::ostream& o) const {
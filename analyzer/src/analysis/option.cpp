@@ -109,13 +109,50 @@ void AnalysisOptions::save(SettingsTable& table) {
 
   table.insert("use-partitioning-domain", this->use_partitioning_domain);
 
+  table.insert("use-fused-scalar-domain", this->use_fused_scalar_domain);
+
+  if (this->max_cells_per_location) {
+    table.insert("max-cells-per-location",
+                 std::to_string(*this->max_cells_per_location));
+  }
+
+  table.insert("use-domain-prepass", this->use_domain_prepass);
+
+  table.insert("use-sparse-invariants", this->use_sparse_invariants);
+
   table.insert("use-fixpoint-cache", this->use_fixpoint_cache);
 
   table.insert("use-checks", this->use_checks);
 
+  if (this->mem_budget) {
+    table.insert("mem-budget", std::to_string(*this->mem_budget));
+  }
+
+  if (this->function_time_budget) {
+    table.insert("function-time-budget",
+                 std::to_string(*this->function_time_budget));
+  }
+
+  if (this->context_depth) {
+    table.insert("context-depth", std::to_string(*this->context_depth));
+  }
+
+  JsonDict context_depth_dict;
+  for (const auto& p : this->context_depth_functions) {
+    context_depth_dict.put(p.first->name(), p.second);
+  }
+  table.insert("context-depth-functions", context_depth_dict);
+
+  if (this->callee_contexts_limit) {
+    table.insert("callee-contexts-limit",
+                 std::to_string(*this->callee_contexts_limit));
+  }
+
   table.insert("globals-init-policy",
                globals_init_policy_str(this->globals_init_policy));
 
+  table.insert("use-prune-globals-init", this->use_prune_globals_init);
+
   table.insert("hardware-addresses",
                hardware_addresses_str(this->hardware_addresses));
 
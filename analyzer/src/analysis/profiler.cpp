@@ -0,0 +1,262 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Implementation of the profiler of the value analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <string>
+
+#include <ikos/analyzer/analysis/profiler.hpp>
+#include <ikos/analyzer/database/output.hpp>
+#include <ikos/analyzer/support/assert.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+namespace {
+
+/// \brief Next profiler identifier
+std::atomic< std::uint64_t > NextProfilerId{1};
+
+/// \brief Add the function counters `b` to `a`
+void merge(Profiler::FunctionCounters& a, const Profiler::FunctionCounters& b) {
+  a.analyses += b.analyses;
+  a.time += b.time;
+  a.inlined_calls += b.inlined_calls;
+  a.cache_hits += b.cache_hits;
+  a.normalizations += b.normalizations;
+  a.normalize_time += b.normalize_time;
+}
+
+/// \brief Add the cycle counters `b` to `a`
+void merge(Profiler::CycleCounters& a, const Profiler::CycleCounters& b) {
+  a.increasing_iterations += b.increasing_iterations;
+  a.decreasing_iterations += b.decreasing_iterations;
+  a.joins += b.joins;
+  a.widenings += b.widenings;
+  a.narrowings += b.narrowings;
+  a.meets += b.meets;
+  a.leqs += b.leqs;
+  a.time += b.time;
+}
+
+/// \brief Add the domain counters `b` to `a`
+void merge(Profiler::DomainCounters& a, const Profiler::DomainCounters& b) {
+  a.count += b.count;
+  a.time += b.time;
+}
+
+/// \brief Return the position of the given basic block in its code
+std::ptrdiff_t block_index(ar::BasicBlock* bb) {
+  ar::Code* code = bb->code();
+  return std::distance(code->begin(),
+                       std::find(code->begin(), code->end(), bb));
+}
+
+} // end anonymous namespace
+
+Profiler::Profiler() : _id(NextProfilerId++) {}
+
+Profiler::~Profiler() = default;
+
+Profiler::ThreadCounters& Profiler::local() {
+  // Identifier of the profiler owning the counters of the current thread
+  thread_local std::uint64_t LocalProfilerId = 0;
+
+  // Counters of the current thread, owned by the profiler
+  thread_local ThreadCounters* LocalCounters = nullptr;
+
+  if (LocalProfilerId != this->_id) {
+    // First operation of the current thread on this profiler
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    this->_threads.push_back(std::make_unique< ThreadCounters >());
+    LocalProfilerId = this->_id;
+    LocalCounters = this->_threads.back().get();
+  }
+
+  return *LocalCounters;
+}
+
+void Profiler::count(ar::Function* fun,
+                     FunctionOperation op,
+                     Timer::Duration elapsed) {
+  FunctionCounters& counters = this->function(fun);
+
+  switch (op) {
+    case FunctionOperation::Analysis: {
+      counters.analyses++;
+      counters.time += elapsed;
+    } break;
+    case FunctionOperation::InlinedCall: {
+      counters.inlined_calls++;
+    } break;
+    case FunctionOperation::CacheHit: {
+      counters.cache_hits++;
+    } break;
+    case FunctionOperation::Normalization: {
+      counters.normalizations++;
+      counters.normalize_time += elapsed;
+    } break;
+    default: {
+      ikos_unreachable("unreachable");
+    }
+  }
+}
+
+void Profiler::count(ar::BasicBlock* head, CycleOperation op) {
+  CycleCounters& counters = this->cycle(head);
+
+  switch (op) {
+    case CycleOperation::IncreasingIteration: {
+      counters.increasing_iterations++;
+    } break;
+    case CycleOperation::DecreasingIteration: {
+      counters.decreasing_iterations++;
+    } break;
+    case CycleOperation::Join: {
+      counters.joins++;
+    } break;
+    case CycleOperation::Widening: {
+      counters.widenings++;
+    } break;
+    case CycleOperation::Narrowing: {
+      counters.narrowings++;
+    } break;
+    case CycleOperation::Meet: {
+      counters.meets++;
+    } break;
+    case CycleOperation::Leq: {
+      counters.leqs++;
+    } break;
+    default: {
+      ikos_unreachable("unreachable");
+    }
+  }
+}
+
+void Profiler::count(MachineIntDomainOption domain,
+                     DomainOperation op,
+                     Timer::Duration elapsed) {
+  DomainCounters& counters = this->local().operations[DomainKey(domain, op)];
+  counters.count++;
+  counters.time += elapsed;
+}
+
+boost::optional< Profiler::DomainOperation > Profiler::domain_operation(
+    CycleOperation op) {
+  switch (op) {
+    case CycleOperation::IncreasingIteration:
+    case CycleOperation::DecreasingIteration:
+      return boost::none;
+    case CycleOperation::Join:
+      return DomainOperation::Join;
+    case CycleOperation::Widening:
+      return DomainOperation::Widening;
+    case CycleOperation::Narrowing:
+      return DomainOperation::Narrowing;
+    case CycleOperation::Meet:
+      return DomainOperation::Meet;
+    case CycleOperation::Leq:
+      return DomainOperation::Leq;
+    default: {
+      ikos_unreachable("unreachable");
+    }
+  }
+}
+
+void Profiler::save(OutputDatabase& db) {
+  llvm::DenseMap< ar::Function*, FunctionCounters > functions;
+  llvm::DenseMap< ar::BasicBlock*, CycleCounters > cycles;
+  std::map< DomainKey, DomainCounters > operations;
+
+  // Merge the counters of all threads
+  for (const auto& thread : this->_threads) {
+    for (const auto& entry : thread->functions) {
+      merge(functions[entry.first], entry.second);
+    }
+    for (const auto& entry : thread->cycles) {
+      merge(cycles[entry.first], entry.second);
+    }
+    for (const auto& entry : thread->operations) {
+      merge(operations[entry.first], entry.second);
+    }
+  }
+
+  // Insert the rows in a deterministic order, sorted by function name and by
+  // position of the cycle head in the function body
+  std::vector< std::pair< ar::Function*, FunctionCounters > >
+      sorted_functions(functions.begin(), functions.end());
+  std::sort(sorted_functions.begin(),
+            sorted_functions.end(),
+            [](const auto& a, const auto& b) {
+              return a.first->name() < b.first->name();
+            });
+
+  std::vector< std::pair< ar::BasicBlock*, CycleCounters > >
+      sorted_cycles(cycles.begin(), cycles.end());
+  std::sort(sorted_cycles.begin(),
+            sorted_cycles.end(),
+            [](const auto& a, const auto& b) {
+              const std::string& a_name = a.first->code()->function()->name();
+              const std::string& b_name = b.first->code()->function()->name();
+              if (a_name != b_name) {
+                return a_name < b_name;
+              }
+              return block_index(a.first) < block_index(b.first);
+            });
+
+  for (const auto& entry : sorted_functions) {
+    db.profile_functions.insert(entry.first, entry.second);
+  }
+  for (const auto& entry : sorted_cycles) {
+    db.profile_cycles.insert(entry.first, entry.second);
+  }
+  for (const auto& entry : operations) {
+    db.profile_operations.insert(entry.first.first,
+                                 entry.first.second,
+                                 entry.second);
+  }
+}
+
+} // end namespace analyzer
+} // end namespace ikos
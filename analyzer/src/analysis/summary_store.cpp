@@ -0,0 +1,379 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Persistent store of function summaries
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <fstream>
+#include <sstream>
+
+#include <ikos/core/support/serialization.hpp>
+#include <ikos/core/value/machine_int/serialization.hpp>
+
+#include <ikos/ar/format/text.hpp>
+
+#include <ikos/analyzer/analysis/summary_store.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/log.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+namespace {
+
+/// \brief Return the 64-bit FNV-1a hash of the given string
+std::uint64_t fnv1a(const std::string& str,
+                    std::uint64_t hash = 0xcbf29ce484222325ULL) {
+  for (char c : str) {
+    hash ^= static_cast< unsigned char >(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+/// \brief Return true if the value is a machine integer constant or variable
+bool is_int_operand(ar::Value* value) {
+  return isa< ar::IntegerType >(value->type()) &&
+         (isa< ar::IntegerConstant >(value) ||
+          isa< ar::InternalVariable >(value));
+}
+
+/// \brief Return true if the statement only operates on machine integers
+bool is_int_statement(ar::Statement* stmt) {
+  switch (stmt->kind()) {
+    case ar::Statement::AssignmentKind:
+    case ar::Statement::UnaryOperationKind:
+    case ar::Statement::BinaryOperationKind:
+    case ar::Statement::ComparisonKind:
+    case ar::Statement::ReturnValueKind:
+    case ar::Statement::UnreachableKind:
+      break;
+    default:
+      return false;
+  }
+
+  if (stmt->has_result() && !isa< ar::IntegerType >(stmt->result()->type())) {
+    return false;
+  }
+  for (auto it = stmt->op_begin(), et = stmt->op_end(); it != et; ++it) {
+    if (!is_int_operand(*it)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Return true if the function can be summarized
+bool is_summarizable_function(ar::Function* fun) {
+  if (!fun->is_definition() || fun->is_var_arg()) {
+    return false;
+  }
+
+  ar::FunctionType* type = fun->type();
+  if (!isa< ar::VoidType >(type->return_type()) &&
+      !isa< ar::IntegerType >(type->return_type())) {
+    return false;
+  }
+  for (auto it = type->param_begin(), et = type->param_end(); it != et;
+       ++it) {
+    if (!isa< ar::IntegerType >(*it)) {
+      return false;
+    }
+  }
+
+  for (ar::BasicBlock* bb : *fun->body()) {
+    for (ar::Statement* stmt : *bb) {
+      if (!is_int_statement(stmt)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// \brief Return true if the precondition `a` is included in `b`
+bool precondition_leq(const SummaryStore::Precondition& a,
+                      const SummaryStore::Precondition& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.size(); i++) {
+    if (a[i].bit_width() != b[i].bit_width() || a[i].sign() != b[i].sign() ||
+        !a[i].leq(b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Insert a summary in a list of summaries
+///
+/// Returns false if an equivalent summary is already known.
+bool insert_summary(std::vector< FunctionSummary >& summaries,
+                    FunctionSummary summary) {
+  for (const FunctionSummary& other : summaries) {
+    if (precondition_leq(summary.precondition, other.precondition) &&
+        precondition_leq(other.precondition, summary.precondition)) {
+      return false;
+    }
+  }
+  if (summaries.size() >= SummaryStore::MaxSummaries) {
+    // Drop the oldest summary
+    summaries.erase(summaries.begin());
+  }
+  summaries.push_back(std::move(summary));
+  return true;
+}
+
+/// \brief Read summaries from a file, and insert them in the given map
+///
+/// Throws a core::SerializationError if the file is invalid.
+template < typename SummaryMap >
+void read_summaries(std::istream& stream, SummaryMap& map) {
+  using core::machine_int::IntervalCongruence;
+
+  core::InputArchive ar(stream);
+  for (auto num_keys = ar.read_uint(); num_keys > 0; num_keys--) {
+    std::uint64_t key = ar.read_uint();
+    std::vector< FunctionSummary >& summaries = map[key];
+    for (auto num_summaries = ar.read_uint(); num_summaries > 0;
+         num_summaries--) {
+      FunctionSummary summary;
+      for (auto num_params = ar.read_uint(); num_params > 0; num_params--) {
+        summary.precondition.push_back(
+            core::load< IntervalCongruence >(ar));
+      }
+      summary.returns = ar.read_bool();
+      if (ar.read_bool()) {
+        summary.return_value = core::load< IntervalCongruence >(ar);
+      }
+      insert_summary(summaries, std::move(summary));
+    }
+  }
+}
+
+/// \brief Write summaries in a file
+template < typename SummaryMap >
+void write_summaries(std::ostream& stream, const SummaryMap& map) {
+  core::OutputArchive ar(stream);
+  ar.write_uint(map.size());
+  for (const auto& entry : map) {
+    ar.write_uint(entry.first);
+    ar.write_uint(entry.second.size());
+    for (const FunctionSummary& summary : entry.second) {
+      ar.write_uint(summary.precondition.size());
+      for (const auto& value : summary.precondition) {
+        core::save(ar, value);
+      }
+      ar.write_bool(summary.returns);
+      ar.write_bool(static_cast< bool >(summary.return_value));
+      if (summary.return_value) {
+        core::save(ar, *summary.return_value);
+      }
+    }
+  }
+}
+
+} // end anonymous namespace
+
+SummaryStore::SummaryStore(boost::filesystem::path path)
+    : _path(std::move(path)) {}
+
+void SummaryStore::load() {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+
+  std::ifstream stream(this->_path.string(), std::ios::binary);
+  if (!stream.is_open()) {
+    // No store yet
+    return;
+  }
+
+  try {
+    read_summaries(stream, this->_summaries);
+  } catch (const core::SerializationError& err) {
+    log::warning("ignoring summary store '" + this->_path.string() +
+                 "': " + err.what());
+    this->_summaries.clear();
+  }
+}
+
+void SummaryStore::save() {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+
+  // Merge the summaries written by other runs in the meantime
+  {
+    std::ifstream stream(this->_path.string(), std::ios::binary);
+    if (stream.is_open()) {
+      SummaryMap others;
+      try {
+        read_summaries(stream, others);
+      } catch (const core::SerializationError&) {
+        others.clear();
+      }
+      for (auto& entry : others) {
+        for (FunctionSummary& summary : entry.second) {
+          insert_summary(this->_summaries[entry.first], std::move(summary));
+        }
+      }
+    }
+  }
+
+  // Write in a temporary file, then rename it, so that concurrent runs never
+  // read a partially written store
+  boost::filesystem::path tmp_path = this->_path;
+  tmp_path += ".tmp";
+  {
+    std::ofstream stream(tmp_path.string(), std::ios::binary);
+    if (!stream.is_open()) {
+      log::warning("could not write summary store '" + tmp_path.string() +
+                   "'");
+      return;
+    }
+    write_summaries(stream, this->_summaries);
+  }
+
+  boost::system::error_code err;
+  boost::filesystem::rename(tmp_path, this->_path, err);
+  if (err) {
+    log::warning("could not write summary store '" + this->_path.string() +
+                 "': " + err.message());
+  }
+}
+
+bool SummaryStore::is_summarizable(ar::Function* fun) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  return this->info(fun).summarizable;
+}
+
+boost::optional< FunctionSummary > SummaryStore::find(
+    ar::Function* fun,
+    const AnalysisOptions& opts,
+    const Precondition& precondition) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+
+  auto it = this->_summaries.find(this->key(fun, opts));
+  if (it == this->_summaries.end()) {
+    return boost::none;
+  }
+
+  const FunctionSummary* best = nullptr;
+  for (const FunctionSummary& summary : it->second) {
+    if (precondition_leq(precondition, summary.precondition) &&
+        (best == nullptr ||
+         precondition_leq(summary.precondition, best->precondition))) {
+      best = &summary;
+    }
+  }
+  if (best == nullptr) {
+    return boost::none;
+  }
+
+  // The summary might come from a corrupted store
+  if (static_cast< bool >(best->return_value) ==
+      isa< ar::VoidType >(fun->type()->return_type())) {
+    return boost::none;
+  }
+
+  this->_num_hits++;
+  return *best;
+}
+
+void SummaryStore::insert(ar::Function* fun,
+                          const AnalysisOptions& opts,
+                          FunctionSummary summary) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  if (insert_summary(this->_summaries[this->key(fun, opts)],
+                     std::move(summary))) {
+    this->_num_insertions++;
+  }
+}
+
+std::size_t SummaryStore::num_hits() {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  return this->_num_hits;
+}
+
+std::size_t SummaryStore::num_insertions() {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  return this->_num_insertions;
+}
+
+const SummaryStore::FunctionInfo& SummaryStore::info(ar::Function* fun) {
+  auto it = this->_functions.find(fun);
+  if (it != this->_functions.end()) {
+    return it->second;
+  }
+
+  FunctionInfo info{is_summarizable_function(fun), 0};
+  if (info.summarizable) {
+    std::ostringstream buf;
+    ar::TextFormatter().format(buf, fun);
+    info.hash = fnv1a(buf.str());
+  }
+  return this->_functions.insert({fun, info}).first->second;
+}
+
+std::uint64_t SummaryStore::key(ar::Function* fun,
+                                const AnalysisOptions& opts) {
+  // Analysis settings with an impact on the result of a function on machine
+  // integers
+  std::ostringstream buf;
+  buf << core::SerializationFormatVersion << ';'
+      << machine_int_domain_option_str(opts.machine_int_domain) << ';'
+      << widening_strategy_str(opts.widening_strategy) << ';'
+      << narrowing_strategy_str(opts.narrowing_strategy) << ';';
+  auto delay_it = opts.widening_delay_functions.find(fun);
+  if (delay_it != opts.widening_delay_functions.end()) {
+    buf << delay_it->second << ';';
+  } else {
+    buf << opts.widening_delay << ';';
+  }
+  buf << opts.widening_period << ';';
+  if (opts.narrowing_iterations) {
+    buf << *opts.narrowing_iterations;
+  }
+  buf << ';' << opts.use_liveness << opts.use_widening_hints
+      << opts.use_partitioning_domain << opts.use_fused_scalar_domain;
+
+  return fnv1a(buf.str(), this->info(fun).hash);
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -46,6 +46,7 @@
 #include <ikos/core/domain/memory/value.hpp>
 #include <ikos/core/domain/nullity/separate_domain.hpp>
 #include <ikos/core/domain/scalar/composite.hpp>
+#include <ikos/core/domain/scalar/fused.hpp>
 #include <ikos/core/domain/uninitialized/separate_domain.hpp>
 
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
@@ -72,73 +73,114 @@ using ScalarAbstractDomain =
                                    MachineIntAbstractDomain,
                                    NullityAbstractDomain >;
 
+/// \brief Scalar abstract domain with a fused per-variable record
+using FusedScalarAbstractDomain =
+    core::scalar::FusedDomain< Variable*,
+                               MemoryLocation*,
+                               MachineIntAbstractDomain >;
+
 /// \brief Lifetime abstract domain
 using LifetimeAbstractDomain =
     core::lifetime::SeparateDomain< MemoryLocation* >;
 
 /// \brief Value abstract domain
+template < typename ScalarDomain >
 using ValueAbstractDomain = core::memory::ValueDomain< Variable*,
                                                        MemoryLocation*,
                                                        VariableFactory*,
-                                                       ScalarAbstractDomain,
+                                                       ScalarDomain,
                                                        LifetimeAbstractDomain >;
 
 /// \brief Partitioning abstract domain
-using PartitioningAbstractDomain = core::memory::
-    PartitioningDomain< Variable*, MemoryLocation*, ValueAbstractDomain >;
-
-/// \brief Create the bottom memory abstract value
-MemoryAbstractDomain make_bottom_memory_abstract_value(Context& ctx) {
-  auto inv = ValueAbstractDomain(
-      ctx.var_factory,
-      ScalarAbstractDomain(UninitializedAbstractDomain::bottom(),
-                           make_bottom_machine_int_abstract_value(
-                               ctx.opts.machine_int_domain),
-                           NullityAbstractDomain::bottom()),
-      LifetimeAbstractDomain::bottom());
+template < typename ScalarDomain >
+using PartitioningAbstractDomain =
+    core::memory::PartitioningDomain< Variable*,
+                                      MemoryLocation*,
+                                      ValueAbstractDomain< ScalarDomain > >;
+
+/// \brief Create a memory abstract value from the given scalar and lifetime
+/// abstract values
+template < typename ScalarDomain >
+MemoryAbstractDomain make_memory_abstract_value(
+    Context& ctx, ScalarDomain scalar, LifetimeAbstractDomain lifetime) {
+  auto inv = ValueAbstractDomain< ScalarDomain >(ctx.var_factory,
+                                                 std::move(scalar),
+                                                 std::move(lifetime),
+                                                 ctx.cell_summarization);
 
   if (ctx.opts.use_partitioning_domain) {
-    return MemoryAbstractDomain(PartitioningAbstractDomain(inv));
+    return MemoryAbstractDomain(
+        PartitioningAbstractDomain< ScalarDomain >(std::move(inv)));
   } else {
-    return MemoryAbstractDomain(inv);
+    return MemoryAbstractDomain(std::move(inv));
   }
 }
 
-/// \brief Create the top memory abstract value
-MemoryAbstractDomain make_top_memory_abstract_value(Context& ctx) {
-  auto inv = ValueAbstractDomain(
-      ctx.var_factory,
-      ScalarAbstractDomain(UninitializedAbstractDomain::top(),
-                           make_top_machine_int_abstract_value(
-                               ctx.opts.machine_int_domain),
-                           NullityAbstractDomain::top()),
-      LifetimeAbstractDomain::top());
+/// \brief Create the bottom memory abstract value
+MemoryAbstractDomain make_bottom_memory_abstract_value(
+    Context& ctx, MachineIntDomainOption domain) {
+  if (ctx.opts.use_fused_scalar_domain) {
+    return make_memory_abstract_value(
+        ctx,
+        FusedScalarAbstractDomain(
+            make_bottom_machine_int_abstract_value(domain)),
+        LifetimeAbstractDomain::bottom());
+  } else {
+    return make_memory_abstract_value(
+        ctx,
+        ScalarAbstractDomain(UninitializedAbstractDomain::bottom(),
+                             make_bottom_machine_int_abstract_value(domain),
+                             NullityAbstractDomain::bottom()),
+        LifetimeAbstractDomain::bottom());
+  }
+}
 
-  if (ctx.opts.use_partitioning_domain) {
-    return MemoryAbstractDomain(PartitioningAbstractDomain(inv));
+/// \brief Create the top memory abstract value
+MemoryAbstractDomain make_top_memory_abstract_value(
+    Context& ctx, MachineIntDomainOption domain) {
+  if (ctx.opts.use_fused_scalar_domain) {
+    return make_memory_abstract_value(
+        ctx,
+        FusedScalarAbstractDomain(make_top_machine_int_abstract_value(domain)),
+        LifetimeAbstractDomain::top());
   } else {
-    return MemoryAbstractDomain(inv);
+    return make_memory_abstract_value(
+        ctx,
+        ScalarAbstractDomain(UninitializedAbstractDomain::top(),
+                             make_top_machine_int_abstract_value(domain),
+                             NullityAbstractDomain::top()),
+        LifetimeAbstractDomain::top());
   }
 }
 
 } // end anonymous namespace
 
 AbstractDomain make_bottom_abstract_value(Context& ctx) {
+  return make_bottom_abstract_value(ctx, ctx.opts.machine_int_domain);
+}
+
+AbstractDomain make_bottom_abstract_value(Context& ctx,
+                                          MachineIntDomainOption domain) {
   return AbstractDomain(/* normal = */
-                        make_bottom_memory_abstract_value(ctx),
+                        make_bottom_memory_abstract_value(ctx, domain),
                         /* caught_exceptions = */
-                        make_bottom_memory_abstract_value(ctx),
+                        make_bottom_memory_abstract_value(ctx, domain),
                         /* propagated_exceptions = */
-                        make_bottom_memory_abstract_value(ctx));
+                        make_bottom_memory_abstract_value(ctx, domain));
 }
 
 AbstractDomain make_initial_abstract_value(Context& ctx) {
+  return make_initial_abstract_value(ctx, ctx.opts.machine_int_domain);
+}
+
+AbstractDomain make_initial_abstract_value(Context& ctx,
+                                           MachineIntDomainOption domain) {
   return AbstractDomain(/* normal = */
-                        make_top_memory_abstract_value(ctx),
+                        make_top_memory_abstract_value(ctx, domain),
                         /* caught_exceptions = */
-                        make_bottom_memory_abstract_value(ctx),
+                        make_bottom_memory_abstract_value(ctx, domain),
                         /* propagated_exceptions = */
-                        make_bottom_memory_abstract_value(ctx));
+                        make_bottom_memory_abstract_value(ctx, domain));
 }
 
 } // end namespace value
@@ -41,6 +41,11 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
+
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/function.hpp>
+
 #include <ikos/analyzer/analysis/value/global_variable.hpp>
 #include <ikos/analyzer/support/cast.hpp>
 
@@ -78,6 +83,41 @@ bool is_initialized(ar::GlobalVariable* gv, GlobalsInitPolicy policy) {
   }
 }
 
+/// \brief Return true if the given value references a global variable other
+/// than `gv`
+static bool references_other_global(ar::Value* value, ar::GlobalVariable* gv) {
+  if (auto other = dyn_cast< ar::GlobalVariable >(value)) {
+    return other != gv;
+  } else if (auto struct_cst = dyn_cast< ar::StructConstant >(value)) {
+    return std::any_of(struct_cst->field_begin(),
+                       struct_cst->field_end(),
+                       [=](const ar::StructConstant::Field& field) {
+                         return references_other_global(field.value, gv);
+                       });
+  } else if (auto seq_cst = dyn_cast< ar::SequentialConstant >(value)) {
+    return std::any_of(seq_cst->element_begin(),
+                       seq_cst->element_end(),
+                       [=](ar::Value* element) {
+                         return references_other_global(element, gv);
+                       });
+  } else {
+    return false;
+  }
+}
+
+bool has_independent_initializer(ar::GlobalVariable* gv) {
+  for (ar::BasicBlock* bb : *gv->initializer()) {
+    for (ar::Statement* stmt : *bb) {
+      for (auto it = stmt->op_begin(), et = stmt->op_end(); it != et; ++it) {
+        if (references_other_global(*it, gv)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
 /// \brief Return the list of pair (function, priority) for arrays
 /// ar.global_ctors or ar.global_dtors, given the global variable
 static std::vector< std::pair< ar::Function*, MachineInt > > global_cdtors(
@@ -148,6 +188,97 @@ std::vector< std::pair< ar::Function*, MachineInt > > global_dtors(
   return entries;
 }
 
+namespace {
+
+/// \brief Collect the global variables and functions referenced by the code
+class AccessibleGlobals {
+private:
+  /// \brief Referenced global variables
+  std::unordered_set< ar::GlobalVariable* > _globals;
+
+  /// \brief Referenced functions
+  std::unordered_set< ar::Function* > _functions;
+
+  /// \brief Code left to scan
+  std::vector< ar::Code* > _worklist;
+
+public:
+  /// \brief Add a function
+  void add(ar::Function* fun) {
+    if (this->_functions.insert(fun).second && fun->is_definition()) {
+      this->_worklist.push_back(fun->body());
+    }
+  }
+
+  /// \brief Add the references of the given value
+  void add(ar::Value* value) {
+    if (auto gv = dyn_cast< ar::GlobalVariable >(value)) {
+      if (this->_globals.insert(gv).second && gv->is_definition()) {
+        this->_worklist.push_back(gv->initializer());
+      }
+    } else if (auto fun_ptr = dyn_cast< ar::FunctionPointerConstant >(value)) {
+      this->add(fun_ptr->function());
+    } else if (auto struct_cst = dyn_cast< ar::StructConstant >(value)) {
+      for (auto it = struct_cst->field_begin(), et = struct_cst->field_end();
+           it != et;
+           ++it) {
+        this->add(it->value);
+      }
+    } else if (auto seq_cst = dyn_cast< ar::SequentialConstant >(value)) {
+      for (auto it = seq_cst->element_begin(), et = seq_cst->element_end();
+           it != et;
+           ++it) {
+        this->add(*it);
+      }
+    }
+  }
+
+  /// \brief Scan the code until all the references are found
+  void run() {
+    while (!this->_worklist.empty()) {
+      ar::Code* code = this->_worklist.back();
+      this->_worklist.pop_back();
+
+      for (ar::BasicBlock* bb : *code) {
+        for (ar::Statement* stmt : *bb) {
+          for (auto it = stmt->op_begin(), et = stmt->op_end(); it != et;
+               ++it) {
+            this->add(*it);
+          }
+        }
+      }
+    }
+  }
+
+  /// \brief Return the referenced global variables
+  std::unordered_set< ar::GlobalVariable* >& globals() {
+    return this->_globals;
+  }
+
+}; // end class AccessibleGlobals
+
+} // end anonymous namespace
+
+std::unordered_set< ar::GlobalVariable* > accessible_globals(
+    ar::Bundle* bundle, const std::vector< ar::Function* >& entry_points) {
+  AccessibleGlobals visitor;
+
+  for (const auto& entry :
+       global_ctors(bundle->global_or_null("ar.global_ctors"))) {
+    visitor.add(entry.first);
+  }
+  for (ar::Function* entry_point : entry_points) {
+    visitor.add(entry_point);
+  }
+  for (const auto& entry :
+       global_dtors(bundle->global_or_null("ar.global_dtors"))) {
+    visitor.add(entry.first);
+  }
+
+  visitor.run();
+  return std::move(visitor.globals());
+}
+
 } // end namespace value
 } // end namespace analyzer
 } // end namespace ikos
@@ -44,8 +44,14 @@
  ******************************************************************************/
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
+#include <boost/optional.hpp>
+
+#include <ikos/analyzer/analysis/call_context.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/global_variable.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/concurrent/analysis.hpp>
@@ -58,7 +64,9 @@
 #include <ikos/analyzer/util/progress.hpp>
 #include <ikos/analyzer/util/timer.hpp>
 
-#include <tbb/task_scheduler_init.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
 
 namespace ikos {
 namespace analyzer {
@@ -74,6 +82,11 @@ void Analysis::run() {
   // Bundle
   ar::Bundle* bundle = _ctx.bundle;
 
+  if (_ctx.call_context_factory->has_context_policy()) {
+    log::warning("merged call contexts are not supported by the concurrent "
+                 "analysis, all calls are analyzed in full contexts");
+  }
+
   // Create checkers
   std::vector< std::unique_ptr< Checker > > checkers;
   if (_ctx.opts.use_checks) {
@@ -82,10 +95,7 @@ void Analysis::run() {
     }
   }
 
-  // Initialize the task scheduler
-  tbb::task_scheduler_init init(_ctx.opts.num_threads > 0
-                                    ? _ctx.opts.num_threads
-                                    : tbb::task_scheduler_init::automatic);
+  // The task scheduler is initialized by the caller, see ikos-analyzer
 
   // Initial invariant
   AbstractDomain init_inv = make_initial_abstract_value(_ctx);
@@ -96,29 +106,74 @@ void Analysis::run() {
 
     GlobalsInitPolicy policy = _ctx.opts.globals_init_policy;
 
+    // Global variables accessible from the analyzed code, or none to
+    // initialize all global variables
+    boost::optional< std::unordered_set< ar::GlobalVariable* > > accessible;
+    if (_ctx.opts.use_prune_globals_init) {
+      accessible = accessible_globals(bundle, _ctx.opts.entry_points);
+    }
+
+    auto needs_init = [&](ar::GlobalVariable* gv) {
+      return gv->is_definition() && is_initialized(gv, policy) &&
+             (!accessible || accessible->count(gv) > 0);
+    };
+
+    // Initializers that do not reference other global variables only write
+    // the memory of their global variable
+    std::vector< ar::GlobalVariable* > independent;
+    std::vector< ar::GlobalVariable* > dependent;
+    for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+         ++it) {
+      ar::GlobalVariable* gv = *it;
+      if (needs_init(gv)) {
+        if (has_independent_initializer(gv)) {
+          independent.push_back(gv);
+        } else {
+          dependent.push_back(gv);
+        }
+      }
+    }
+
+    // Compute the independent initializers in parallel, from the same
+    // invariant. Their footprints are disjoint, so the results are combined
+    // with a meet, in a deterministic tree reduction.
+    if (!independent.empty()) {
+      log::debug("Initializing " + std::to_string(independent.size()) +
+                 " independent global variables");
+      init_inv = tbb::parallel_deterministic_reduce(
+          tbb::blocked_range< std::size_t >(0,
+                                            independent.size(),
+                                            /* grainsize = */ 64),
+          init_inv,
+          [&](const tbb::blocked_range< std::size_t >& r, AbstractDomain inv) {
+            for (std::size_t i = r.begin(); i != r.end(); ++i) {
+              sequential::GlobalVarInitializerFixpoint fixpoint(_ctx,
+                                                                independent[i]);
+              fixpoint.run(std::move(inv));
+              inv = fixpoint.exit_invariant();
+            }
+            return inv;
+          },
+          [](AbstractDomain left, const AbstractDomain& right) {
+            left.meet_with(right);
+            return left;
+          });
+    }
+
     // Setup a progress logger
     std::unique_ptr< analyzer::ProgressLogger > logger =
         make_progress_logger(_ctx.opts.progress,
                              LogLevel::Debug,
-                             /* num_tasks = */
-                             std::count_if(bundle->global_begin(),
-                                           bundle->global_end(),
-                                           [=](ar::GlobalVariable* gv) {
-                                             return gv->is_definition() &&
-                                                    is_initialized(gv, policy);
-                                           }));
+                             /* num_tasks = */ dependent.size());
     ScopeLogger scope(*logger);
 
-    for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
-         ++it) {
-      ar::GlobalVariable* gv = *it;
-      if (gv->is_definition() && is_initialized(gv, policy)) {
-        logger->start_task("Initializing global variable '" +
-                           demangle(gv->name()) + "'");
-        sequential::GlobalVarInitializerFixpoint fixpoint(_ctx, gv);
-        fixpoint.run(init_inv);
-        init_inv = fixpoint.exit_invariant();
-      }
+    // Other initializers are computed in order
+    for (ar::GlobalVariable* gv : dependent) {
+      logger->start_task("Initializing global variable '" +
+                         demangle(gv->name()) + "'");
+      sequential::GlobalVarInitializerFixpoint fixpoint(_ctx, gv);
+      fixpoint.run(init_inv);
+      init_inv = fixpoint.exit_invariant();
     }
   }
 
@@ -175,14 +230,41 @@ void Analysis::run() {
     }
   }
 
-  // Analyze each entry point
+  // Entry points to analyze
+  std::vector< ar::Function* > entry_points;
   for (ar::Function* entry_point : _ctx.opts.entry_points) {
     if (!entry_point->is_definition()) {
       log::error("missing implementation of function '" + entry_point->name() +
                  "'");
       continue;
     }
+    entry_points.push_back(entry_point);
+  }
 
+  // Global destructors to analyze
+  std::vector< ar::Function* > dtors;
+  ar::GlobalVariable* gv_dtors = bundle->global_or_null("ar.global_dtors");
+  if (gv_dtors != nullptr) {
+    for (const auto& entry : global_dtors(gv_dtors)) {
+      ar::Function* dtor = entry.first;
+
+      if (dtor->is_declaration()) {
+        log::error("global destructor '" + dtor->name() + "' is extern");
+        continue;
+      }
+      dtors.push_back(dtor);
+    }
+  }
+
+  // Log messages of the tasks
+  std::mutex log_mutex;
+  auto log_info = [&](const std::string& msg) {
+    std::lock_guard< std::mutex > lock(log_mutex);
+    log::info(msg);
+  };
+
+  // Analyze an entry point
+  auto analyze_entry_point = [&](ar::Function* entry_point) {
     // Entry point initial invariant
     AbstractDomain entry_inv = make_bottom_abstract_value(_ctx);
 
@@ -204,60 +286,88 @@ void Analysis::run() {
     FunctionFixpoint fixpoint(_ctx, checkers, entry_point);
 
     {
-      log::info("Analyzing entry point '" + demangle(entry_point->name()) +
-                "'");
+      log_info("Analyzing entry point '" + demangle(entry_point->name()) +
+               "'");
       ScopeTimerDatabase t(_ctx.output_db->times,
                            "ikos-analyzer.value." + entry_point->name());
       fixpoint.run(entry_inv);
     }
 
     if (!checkers.empty()) {
-      log::info("Checking properties for entry point '" +
-                demangle(entry_point->name()) + "'");
+      log_info("Checking properties for entry point '" +
+               demangle(entry_point->name()) + "'");
       ScopeTimerDatabase t(_ctx.output_db->times,
                            "ikos-analyzer.check." + entry_point->name());
       fixpoint.run_checks();
     }
-  }
+  };
 
-  // Call global destructors
-  ar::GlobalVariable* gv_dtors = bundle->global_or_null("ar.global_dtors");
-  if (gv_dtors != nullptr) {
-    log::info("Analyzing global destructors");
-
-    std::vector< std::pair< ar::Function*, MachineInt > > dtors =
-        global_dtors(gv_dtors);
+  // Analyze the global destructors, in call order
+  auto analyze_global_dtors = [&]() {
+    log_info("Analyzing global destructors");
 
-    for (const auto& entry : dtors) {
-      ar::Function* dtor = entry.first;
-
-      if (dtor->is_declaration()) {
-        log::error("global destructor '" + dtor->name() + "' is extern");
-        continue;
-      }
+    // Note: We currently analyze destructors with the initial invariant
+    AbstractDomain inv = init_inv;
 
+    for (ar::Function* dtor : dtors) {
       // Create a function fixpoint
       FunctionFixpoint fixpoint(_ctx, checkers, dtor);
 
       {
-        log::info("Analyzing global destructor '" + demangle(dtor->name()) +
-                  "'");
+        log_info("Analyzing global destructor '" + demangle(dtor->name()) +
+                 "'");
         ScopeTimerDatabase t(_ctx.output_db->times,
                              "ikos-analyzer.value." + dtor->name());
-        // Note: We currently analyze destructors with the initial invariant
-        fixpoint.run(init_inv);
+        fixpoint.run(inv);
       }
 
       if (!checkers.empty()) {
-        log::info("Checking properties for global destructor: '" +
-                  demangle(dtor->name()) + "'");
+        log_info("Checking properties for global destructor: '" +
+                 demangle(dtor->name()) + "'");
         ScopeTimerDatabase t(_ctx.output_db->times,
                              "ikos-analyzer.check." + dtor->name());
         fixpoint.run_checks();
       }
 
-      init_inv = fixpoint.exit_invariant();
+      inv = fixpoint.exit_invariant();
     }
+  };
+
+  // Entry points and global destructors all start from the invariant after
+  // initialization, and are independent: one task per entry point, and one
+  // task for the chain of global destructors.
+  std::size_t num_tasks = entry_points.size() + (dtors.empty() ? 0 : 1);
+  std::vector< ChecksTable::Buffer > buffers(num_tasks);
+
+  auto run_task = [&](std::size_t i) {
+    ChecksTable::ScopeBuffer scope(buffers[i]);
+    if (i < entry_points.size()) {
+      analyze_entry_point(entry_points[i]);
+    } else {
+      analyze_global_dtors();
+    }
+  };
+
+  if (_ctx.opts.display_checks != DisplayOption::None ||
+      _ctx.opts.display_invariants != DisplayOption::None) {
+    // Analyze sequentially to keep the output readable
+    for (std::size_t i = 0; i < num_tasks; i++) {
+      run_task(i);
+    }
+  } else {
+    tbb::parallel_for(tbb::blocked_range< std::size_t >(0,
+                                                        num_tasks,
+                                                        /* grainsize = */ 1),
+                      [&](const tbb::blocked_range< std::size_t >& r) {
+                        for (std::size_t i = r.begin(); i != r.end(); ++i) {
+                          run_task(i);
+                        }
+                      });
+  }
+
+  // Insert the results in order, for a deterministic output
+  for (ChecksTable::Buffer& buffer : buffers) {
+    _ctx.output_db->checks.insert(std::move(buffer));
   }
 
   // Insert all functions in the database
@@ -43,10 +43,18 @@
  *
  ******************************************************************************/
 
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <ikos/analyzer/analysis/compiled_block.hpp>
 #include <ikos/analyzer/analysis/execution_engine/concurrent_inliner.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/profiler.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/concurrent/function_fixpoint.hpp>
+#include <ikos/analyzer/database/output.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -63,6 +71,12 @@ using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
 using ConcurrentInlineCallExecutionEngineT =
     ConcurrentInlineCallExecutionEngine< FunctionFixpoint, AbstractDomain >;
 
+/// \brief Operation on a function, for the profiler
+using FunctionOperation = Profiler::FunctionOperation;
+
+/// \brief Operation on a cycle head, for the profiler
+using CycleOperation = Profiler::CycleOperation;
+
 } // end anonymous namespace
 
 FunctionFixpoint::FunctionFixpoint(
@@ -76,7 +90,12 @@ FunctionFixpoint::FunctionFixpoint(
       _fixpoint_parameters(ctx.fixpoint_parameters->get(entry_point)),
       _checkers(checkers),
       _exit_invariant(make_bottom_abstract_value(ctx)),
-      _return_stmt(nullptr) {}
+      _return_stmt(nullptr),
+      _budget(ctx,
+              entry_point,
+              this->_call_context,
+              /* inlining = */ true,
+              /* restart = */ false) {}
 
 FunctionFixpoint::FunctionFixpoint(Context& ctx,
                                    const FunctionFixpoint& caller,
@@ -90,18 +109,52 @@ FunctionFixpoint::FunctionFixpoint(Context& ctx,
       _fixpoint_parameters(ctx.fixpoint_parameters->get(callee)),
       _checkers(caller._checkers),
       _exit_invariant(make_bottom_abstract_value(ctx)),
-      _return_stmt(nullptr) {}
+      _return_stmt(nullptr),
+      _budget(ctx,
+              callee,
+              this->_call_context,
+              /* inlining = */ true,
+              /* restart = */ false,
+              caller._budget.memory_degradation()) {}
 
 void FunctionFixpoint::run(AbstractDomain inv) {
+  Profiler::FunctionScope profile(this->_ctx.profiler,
+                                  this->_function,
+                                  FunctionOperation::Analysis);
+
+  this->_budget.start();
+  this->check_budget();
   FwdFixpointIterator::run(std::move(inv));
 }
 
+void FunctionFixpoint::check_budget() {
+  this->_budget.update();
+
+  if (this->_budget.evict_fixpoint_cache()) {
+    this->_callees_cache.clear();
+  }
+}
+
 AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
                                              unsigned iteration,
                                              const AbstractDomain& before,
                                              const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler,
+                               head,
+                               this->_ctx.opts.machine_int_domain);
+  profile.count(CycleOperation::IncreasingIteration);
+
+  this->check_budget();
+
+  if (this->_budget.accelerate()) {
+    // Over budget, iterations using widening
+    profile.count(CycleOperation::Widening);
+    return before.widening(after);
+  }
+
   if (iteration <= this->_fixpoint_parameters.widening_delay) {
     // Fixed number of iterations using join
+    profile.count(CycleOperation::Join);
     return before.join_iter(after);
   }
 
@@ -110,6 +163,7 @@ AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
 
   if (iteration % this->_fixpoint_parameters.widening_period != 0) {
     // Not the period, iteration using join
+    profile.count(CycleOperation::Join);
     return before.join_iter(after);
   }
 
@@ -119,15 +173,18 @@ AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
         if (auto threshold =
                 this->_fixpoint_parameters.widening_hints.get(head)) {
           // One iteration using widening with threshold
+          profile.count(CycleOperation::Widening);
           return before.widening_threshold(after, *threshold);
         }
       }
 
       // Iterations using widening until convergence
+      profile.count(CycleOperation::Widening);
       return before.widening(after);
     }
     case WideningStrategy::Join: {
       // Iterations using join until convergence
+      profile.count(CycleOperation::Join);
       return before.join_iter(after);
     }
     default: {
@@ -140,21 +197,34 @@ AbstractDomain FunctionFixpoint::refine(ar::BasicBlock* head,
                                         unsigned iteration,
                                         const AbstractDomain& before,
                                         const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler,
+                               head,
+                               this->_ctx.opts.machine_int_domain);
+  profile.count(CycleOperation::DecreasingIteration);
+
+  if (this->_budget.accelerate()) {
+    // Over budget, skip the decreasing iterations
+    return before;
+  }
+
   switch (this->_fixpoint_parameters.narrowing_strategy) {
     case NarrowingStrategy::Narrow: {
       if (iteration == 1) {
         if (auto threshold =
                 this->_fixpoint_parameters.widening_hints.get(head)) {
           // First iteration using narrowing with threshold
+          profile.count(CycleOperation::Narrowing);
           return before.narrowing_threshold(after, *threshold);
         }
       }
 
       // Iterations using narrowing
+      profile.count(CycleOperation::Narrowing);
       return before.narrowing(after);
     }
     case NarrowingStrategy::Meet: {
       // Iterations using meet
+      profile.count(CycleOperation::Meet);
       return before.meet(after);
     }
     default: {
@@ -163,15 +233,40 @@ AbstractDomain FunctionFixpoint::refine(ar::BasicBlock* head,
   }
 }
 
+bool FunctionFixpoint::is_increasing_iterations_fixpoint(
+    ar::BasicBlock* head,
+    unsigned /*iteration*/,
+    const AbstractDomain& before,
+    const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler,
+                               head,
+                               this->_ctx.opts.machine_int_domain);
+  profile.count(CycleOperation::Leq);
+  return after.leq(before);
+}
+
 bool FunctionFixpoint::is_decreasing_iterations_fixpoint(
-    ar::BasicBlock* /*head*/,
+    ar::BasicBlock* head,
     unsigned iteration,
     const AbstractDomain& before,
     const AbstractDomain& after) {
-  // Check if we reached the number of requested iterations, or convergence
-  return (this->_fixpoint_parameters.narrowing_iterations &&
-          iteration >= *this->_fixpoint_parameters.narrowing_iterations) ||
-         before.leq(after);
+  if (this->_budget.accelerate()) {
+    // Over budget, skip the decreasing iterations
+    return true;
+  }
+
+  if (this->_fixpoint_parameters.narrowing_iterations &&
+      iteration >= *this->_fixpoint_parameters.narrowing_iterations) {
+    // Reached the number of requested iterations
+    return true;
+  }
+
+  // Check for convergence
+  Profiler::CycleScope profile(this->_ctx.profiler,
+                               head,
+                               this->_ctx.opts.machine_int_domain);
+  profile.count(CycleOperation::Leq);
+  return before.leq(after);
 }
 
 AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
@@ -190,9 +285,9 @@ AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
                                                         *this,
                                                         this->_callees_cache);
   exec_engine.exec_enter(bb);
-  for (ar::Statement* stmt : *bb) {
-    transfer_function(exec_engine, call_exec_engine, stmt);
-  }
+  transfer_function(exec_engine,
+                    call_exec_engine,
+                    this->_ctx.block_factory->get(bb));
   exec_engine.exec_leave(bb);
   return std::move(exec_engine.inv());
 }
@@ -237,41 +332,73 @@ void FunctionFixpoint::process_post(ar::BasicBlock* bb,
 }
 
 void FunctionFixpoint::run_checks() {
-  for (ar::BasicBlock* bb : *this->cfg()) {
-    NumericalExecutionEngineT
-        exec_engine(this->pre(bb),
-                    this->_ctx,
-                    this->_call_context,
-                    ExecutionEngine::UpdateAllocSizeVar,
-                    /* liveness = */ this->_ctx.liveness,
-                    /* pointer_info = */ this->_ctx.pointer == nullptr
-                        ? nullptr
-                        : &this->_ctx.pointer->results());
-    ConcurrentInlineCallExecutionEngineT call_exec_engine(this->_ctx,
-                                                          exec_engine,
-                                                          *this,
-                                                          this->_callees_cache);
+  if (this->_ctx.opts.display_checks != DisplayOption::None ||
+      this->_ctx.opts.display_invariants != DisplayOption::None) {
+    // Check sequentially to keep the output readable
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      this->run_checks(bb);
+    }
+    return;
+  }
 
-    // Check called functions during the transfer function
-    call_exec_engine.mark_check_callees();
+  // Once the fix-point is computed, basic blocks are independent
+  std::vector< ar::BasicBlock* > blocks(this->cfg()->begin(),
+                                        this->cfg()->end());
+  std::vector< ChecksTable::Buffer > buffers(blocks.size());
 
-    exec_engine.exec_enter(bb);
+  tbb::parallel_for(tbb::blocked_range< std::size_t >(0, blocks.size()),
+                    [&](const tbb::blocked_range< std::size_t >& r) {
+                      for (std::size_t i = r.begin(); i != r.end(); ++i) {
+                        ChecksTable::ScopeBuffer scope(buffers[i]);
+                        this->run_checks(blocks[i]);
+                      }
+                    });
 
-    for (ar::Statement* stmt : *bb) {
-      // Check the statement if it's related to an llvm instruction
-      if (stmt->has_frontend()) {
+  // Insert the results in order, for a deterministic output
+  for (ChecksTable::Buffer& buffer : buffers) {
+    this->_ctx.output_db->checks.insert(std::move(buffer));
+  }
+}
+
+void FunctionFixpoint::run_checks(ar::BasicBlock* bb) {
+  NumericalExecutionEngineT
+      exec_engine(this->pre(bb),
+                  this->_ctx,
+                  this->_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  ConcurrentInlineCallExecutionEngineT call_exec_engine(this->_ctx,
+                                                        exec_engine,
+                                                        *this,
+                                                        this->_callees_cache);
+
+  // Check called functions during the transfer function
+  call_exec_engine.mark_check_callees();
+
+  exec_engine.exec_enter(bb);
+
+  for (ar::Statement* stmt : *bb) {
+    // Check the statement if it's related to an llvm instruction
+    if (stmt->has_frontend()) {
+      {
+        Profiler::FunctionScope profile(this->_ctx.profiler,
+                                        this->_function,
+                                        FunctionOperation::Normalization);
         exec_engine.inv().normalize();
-        for (const auto& checker : this->_checkers) {
-          checker->check(stmt, exec_engine.inv(), this->_call_context);
-        }
       }
-
-      // Propagate
-      transfer_function(exec_engine, call_exec_engine, stmt);
+      for (const auto& checker : this->_checkers) {
+        checker->check(stmt, exec_engine.inv(), this->_call_context);
+      }
     }
 
-    exec_engine.exec_leave(bb);
+    // Propagate
+    transfer_function(exec_engine, call_exec_engine, stmt);
   }
+
+  exec_engine.exec_leave(bb);
 }
 
 } // end namespace concurrent
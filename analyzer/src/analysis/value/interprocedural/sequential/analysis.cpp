@@ -42,8 +42,11 @@
  ******************************************************************************/
 
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/global_variable.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/init_invariant.hpp>
@@ -79,6 +82,16 @@ void Analysis::run() {
     }
   }
 
+  // Setup a progress logger
+  //
+  // It is shared by all the function fixpoints, since the fixpoints of merged
+  // contexts outlive the analysis of an entry point.
+  std::unique_ptr< sequential::ProgressLogger > fixpoint_logger =
+      make_progress_logger(_ctx, _ctx.opts.progress, LogLevel::Info);
+
+  // Fixpoints of functions analyzed in merged contexts
+  FunctionFixpoint::MergedCalleesT merged_callees;
+
   // Initial invariant
   AbstractDomain init_inv = make_initial_abstract_value(_ctx);
 
@@ -88,6 +101,18 @@ void Analysis::run() {
 
     GlobalsInitPolicy policy = _ctx.opts.globals_init_policy;
 
+    // Global variables accessible from the analyzed code, or none to
+    // initialize all global variables
+    boost::optional< std::unordered_set< ar::GlobalVariable* > > accessible;
+    if (_ctx.opts.use_prune_globals_init) {
+      accessible = accessible_globals(bundle, _ctx.opts.entry_points);
+    }
+
+    auto needs_init = [&](ar::GlobalVariable* gv) {
+      return gv->is_definition() && is_initialized(gv, policy) &&
+             (!accessible || accessible->count(gv) > 0);
+    };
+
     // Setup a progress logger
     std::unique_ptr< analyzer::ProgressLogger > logger =
         make_progress_logger(_ctx.opts.progress,
@@ -95,16 +120,13 @@ void Analysis::run() {
                              /* num_tasks = */
                              std::count_if(bundle->global_begin(),
                                            bundle->global_end(),
-                                           [=](ar::GlobalVariable* gv) {
-                                             return gv->is_definition() &&
-                                                    is_initialized(gv, policy);
-                                           }));
+                                           needs_init));
     ScopeLogger scope(*logger);
 
     for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
          ++it) {
       ar::GlobalVariable* gv = *it;
-      if (gv->is_definition() && is_initialized(gv, policy)) {
+      if (needs_init(gv)) {
         logger->start_task("Initializing global variable '" +
                            demangle(gv->name()) + "'");
         GlobalVarInitializerFixpoint fixpoint(_ctx, gv);
@@ -137,13 +159,14 @@ void Analysis::run() {
         continue;
       }
 
-      // Setup a progress logger
-      std::unique_ptr< sequential::ProgressLogger > logger =
-          make_progress_logger(_ctx, _ctx.opts.progress, LogLevel::Info);
-      ScopeLogger scope(*logger);
+      ScopeLogger scope(*fixpoint_logger);
 
       // Create a function fixpoint
-      FunctionFixpoint fixpoint(_ctx, checkers, *logger, ctor);
+      FunctionFixpoint fixpoint(_ctx,
+                                checkers,
+                                *fixpoint_logger,
+                                merged_callees,
+                                ctor);
 
       {
         log::info("Analyzing global constructor '" + demangle(ctor->name()) +
@@ -197,13 +220,14 @@ void Analysis::run() {
       entry_inv = init_main_invariant(_ctx, entry_point, entry_inv);
     }
 
-    // Setup a progress logger
-    std::unique_ptr< sequential::ProgressLogger > logger =
-        make_progress_logger(_ctx, _ctx.opts.progress, LogLevel::Info);
-    ScopeLogger scope(*logger);
+    ScopeLogger scope(*fixpoint_logger);
 
     // Create a function fixpoint
-    FunctionFixpoint fixpoint(_ctx, checkers, *logger, entry_point);
+    FunctionFixpoint fixpoint(_ctx,
+                              checkers,
+                              *fixpoint_logger,
+                              merged_callees,
+                              entry_point);
 
     {
       log::info("Analyzing entry point '" + demangle(entry_point->name()) +
@@ -238,13 +262,14 @@ void Analysis::run() {
         continue;
       }
 
-      // Setup a progress logger
-      std::unique_ptr< sequential::ProgressLogger > logger =
-          make_progress_logger(_ctx, _ctx.opts.progress, LogLevel::Info);
-      ScopeLogger scope(*logger);
+      ScopeLogger scope(*fixpoint_logger);
 
       // Create a function fixpoint
-      FunctionFixpoint fixpoint(_ctx, checkers, *logger, dtor);
+      FunctionFixpoint fixpoint(_ctx,
+                                checkers,
+                                *fixpoint_logger,
+                                merged_callees,
+                                dtor);
 
       {
         log::info("Analyzing global destructor '" + demangle(dtor->name()) +
@@ -267,6 +292,27 @@ void Analysis::run() {
     }
   }
 
+  // Check the functions analyzed in merged contexts
+  //
+  // Their fixpoints are final only once all the entry points are analyzed.
+  if (!checkers.empty() && !merged_callees.functions().empty()) {
+    log::info("Checking properties for functions in merged contexts");
+
+    ScopeLogger scope(*fixpoint_logger);
+
+    // Checks can add entries, do not use iterators
+    for (std::size_t i = 0; i < merged_callees.functions().size(); i++) {
+      ar::Function* fun = merged_callees.functions()[i];
+      FunctionFixpoint::MergedCalleesT::Entry* entry =
+          merged_callees.find(fun);
+      ikos_assert(entry != nullptr && entry->fixpoint != nullptr);
+
+      ScopeTimerDatabase t(_ctx.output_db->times,
+                           "ikos-analyzer.check.merged." + fun->name());
+      entry->fixpoint->run_checks();
+    }
+  }
+
   // Insert all functions in the database
   for (auto it = bundle->function_begin(), et = bundle->function_end();
        it != et;
@@ -41,9 +41,13 @@
  *
  ******************************************************************************/
 
+#include <unordered_set>
+
+#include <ikos/analyzer/analysis/compiled_block.hpp>
 #include <ikos/analyzer/analysis/execution_engine/inliner.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/profiler.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/function_fixpoint.hpp>
 
 namespace ikos {
@@ -61,14 +65,23 @@ using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
 using InlineCallExecutionEngineT =
     InlineCallExecutionEngine< FunctionFixpoint, AbstractDomain >;
 
+/// \brief Operation on a function, for the profiler
+using FunctionOperation = Profiler::FunctionOperation;
+
+/// \brief Operation on a cycle head, for the profiler
+using CycleOperation = Profiler::CycleOperation;
+
 } // end anonymous namespace
 
 FunctionFixpoint::FunctionFixpoint(
     Context& ctx,
     const std::vector< std::unique_ptr< Checker > >& checkers,
     ProgressLogger& logger,
+    MergedCalleesT& merged_callees,
     ar::Function* entry_point)
-    : FwdFixpointIterator(entry_point->body(), make_bottom_abstract_value(ctx)),
+    : FwdFixpointIterator(entry_point->body(),
+                          make_bottom_abstract_value(ctx),
+                          ctx.opts.use_sparse_invariants),
       _ctx(ctx),
       _function(entry_point),
       _call_context(ctx.call_context_factory->get_empty()),
@@ -76,45 +89,89 @@ FunctionFixpoint::FunctionFixpoint(
       _checkers(checkers),
       _exit_invariant(make_bottom_abstract_value(ctx)),
       _return_stmt(nullptr),
-      _logger(logger) {}
+      _budget(ctx,
+              entry_point,
+              this->_call_context,
+              /* inlining = */ true,
+              /* restart = */ false),
+      _logger(logger),
+      _merged_callees(merged_callees) {}
 
 FunctionFixpoint::FunctionFixpoint(Context& ctx,
                                    const FunctionFixpoint& caller,
-                                   ar::CallBase* call,
+                                   CallContext* call_context,
                                    ar::Function* callee)
-    : FwdFixpointIterator(callee->body(), make_bottom_abstract_value(ctx)),
+    : FwdFixpointIterator(callee->body(),
+                          make_bottom_abstract_value(ctx),
+                          ctx.opts.use_sparse_invariants),
       _ctx(ctx),
       _function(callee),
-      _call_context(
-          ctx.call_context_factory->get_context(caller._call_context, call)),
+      _call_context(call_context),
       _fixpoint_parameters(ctx.fixpoint_parameters->get(callee)),
       _checkers(caller._checkers),
       _exit_invariant(make_bottom_abstract_value(ctx)),
       _return_stmt(nullptr),
-      _logger(caller._logger) {}
+      _budget(ctx,
+              callee,
+              this->_call_context,
+              /* inlining = */ true,
+              /* restart = */ false,
+              caller._budget.memory_degradation()),
+      _logger(caller._logger),
+      _merged_callees(caller._merged_callees) {}
 
 void FunctionFixpoint::run(AbstractDomain inv) {
+  Profiler::FunctionScope profile(this->_ctx.profiler,
+                                  this->_function,
+                                  FunctionOperation::Analysis);
+
   if (!this->_call_context->empty()) {
     this->_logger.start_callee(this->_call_context, this->_function);
   }
 
+  this->_merged_callees.enter(this->_function);
+  this->_budget.start();
+  this->check_budget();
+
   // Compute the fixpoint
   FwdFixpointIterator::run(std::move(inv));
 
   // Clear post invariants, save a lot of memory
   this->clear_post();
 
+  this->_merged_callees.leave(this->_function);
+
   if (!this->_call_context->empty()) {
     this->_logger.end_callee(this->_call_context, this->_function);
   }
 }
 
+void FunctionFixpoint::check_budget() {
+  this->_budget.update();
+
+  if (this->_budget.evict_fixpoint_cache()) {
+    this->_callees_cache.clear();
+  }
+}
+
 AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
                                              unsigned iteration,
                                              const AbstractDomain& before,
                                              const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler,
+                               head,
+                               this->_ctx.opts.machine_int_domain);
+  profile.count(CycleOperation::IncreasingIteration);
+
+  if (this->_budget.accelerate()) {
+    // Over budget, iterations using widening
+    profile.count(CycleOperation::Widening);
+    return before.widening(after);
+  }
+
   if (iteration <= this->_fixpoint_parameters.widening_delay) {
     // Fixed number of iterations using join
+    profile.count(CycleOperation::Join);
     return before.join_iter(after);
   }
 
@@ -123,6 +180,7 @@ AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
 
   if (iteration % this->_fixpoint_parameters.widening_period != 0) {
     // Not the period, iteration using join
+    profile.count(CycleOperation::Join);
     return before.join_iter(after);
   }
 
@@ -132,15 +190,18 @@ AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
         if (auto threshold =
                 this->_fixpoint_parameters.widening_hints.get(head)) {
           // One iteration using widening with threshold
+          profile.count(CycleOperation::Widening);
           return before.widening_threshold(after, *threshold);
         }
       }
 
       // Iterations using widening until convergence
+      profile.count(CycleOperation::Widening);
       return before.widening(after);
     }
     case WideningStrategy::Join: {
       // Iterations using join until convergence
+      profile.count(CycleOperation::Join);
       return before.join_iter(after);
     }
     default: {
@@ -153,21 +214,34 @@ AbstractDomain FunctionFixpoint::refine(ar::BasicBlock* head,
                                         unsigned iteration,
                                         const AbstractDomain& before,
                                         const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler,
+                               head,
+                               this->_ctx.opts.machine_int_domain);
+  profile.count(CycleOperation::DecreasingIteration);
+
+  if (this->_budget.accelerate()) {
+    // Over budget, skip the decreasing iterations
+    return before;
+  }
+
   switch (this->_fixpoint_parameters.narrowing_strategy) {
     case NarrowingStrategy::Narrow: {
       if (iteration == 1) {
         if (auto threshold =
                 this->_fixpoint_parameters.widening_hints.get(head)) {
           // First iteration using narrowing with threshold
+          profile.count(CycleOperation::Narrowing);
           return before.narrowing_threshold(after, *threshold);
         }
       }
 
       // Iterations using narrowing
+      profile.count(CycleOperation::Narrowing);
       return before.narrowing(after);
     }
     case NarrowingStrategy::Meet: {
       // Iterations using meet
+      profile.count(CycleOperation::Meet);
       return before.meet(after);
     }
     default: {
@@ -176,15 +250,40 @@ AbstractDomain FunctionFixpoint::refine(ar::BasicBlock* head,
   }
 }
 
+bool FunctionFixpoint::is_increasing_iterations_fixpoint(
+    ar::BasicBlock* head,
+    unsigned /*iteration*/,
+    const AbstractDomain& before,
+    const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler,
+                               head,
+                               this->_ctx.opts.machine_int_domain);
+  profile.count(CycleOperation::Leq);
+  return after.leq(before);
+}
+
 bool FunctionFixpoint::is_decreasing_iterations_fixpoint(
-    ar::BasicBlock* /*head*/,
+    ar::BasicBlock* head,
     unsigned iteration,
     const AbstractDomain& before,
     const AbstractDomain& after) {
-  // Check if we reached the number of requested iterations, or convergence
-  return (this->_fixpoint_parameters.narrowing_iterations &&
-          iteration >= *this->_fixpoint_parameters.narrowing_iterations) ||
-         before.leq(after);
+  if (this->_budget.accelerate()) {
+    // Over budget, skip the decreasing iterations
+    return true;
+  }
+
+  if (this->_fixpoint_parameters.narrowing_iterations &&
+      iteration >= *this->_fixpoint_parameters.narrowing_iterations) {
+    // Reached the number of requested iterations
+    return true;
+  }
+
+  // Check for convergence
+  Profiler::CycleScope profile(this->_ctx.profiler,
+                               head,
+                               this->_ctx.opts.machine_int_domain);
+  profile.count(CycleOperation::Leq);
+  return before.leq(after);
 }
 
 AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
@@ -203,9 +302,9 @@ AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
                                               *this,
                                               this->_callees_cache);
   exec_engine.exec_enter(bb);
-  for (ar::Statement* stmt : *bb) {
-    transfer_function(exec_engine, call_exec_engine, stmt);
-  }
+  transfer_function(exec_engine,
+                    call_exec_engine,
+                    this->_ctx.block_factory->get(bb));
   exec_engine.exec_leave(bb);
   return std::move(exec_engine.inv());
 }
@@ -235,6 +334,7 @@ void FunctionFixpoint::notify_cycle_iteration(
     unsigned iteration,
     core::FixpointIterationKind kind) {
   this->_logger.start_cycle_iter(head, iteration, kind);
+  this->check_budget();
 }
 
 void FunctionFixpoint::notify_leave_cycle(ar::BasicBlock* head) {
@@ -269,45 +369,76 @@ void FunctionFixpoint::run_checks() {
     this->_logger.start_callee(this->_call_context, this->_function);
   }
 
-  for (ar::BasicBlock* bb : *this->cfg()) {
-    NumericalExecutionEngineT
-        exec_engine(this->pre(bb),
-                    this->_ctx,
-                    this->_call_context,
-                    ExecutionEngine::UpdateAllocSizeVar,
-                    /* liveness = */ this->_ctx.liveness,
-                    /* pointer_info = */ this->_ctx.pointer == nullptr
-                        ? nullptr
-                        : &this->_ctx.pointer->results());
-    InlineCallExecutionEngineT call_exec_engine(this->_ctx,
-                                                exec_engine,
-                                                *this,
-                                                this->_callees_cache);
+  this->_merged_callees.enter(this->_function);
+
+  if (!this->sparse()) {
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      this->run_checks(bb, this->pre(bb));
+    }
+  } else {
+    // Recompute the pre invariants from the cycle heads
+    std::unordered_set< ar::BasicBlock* > visited;
+    this->for_each_pre([&](ar::BasicBlock* bb, AbstractDomain pre) {
+      visited.insert(bb);
+      return this->run_checks(bb, std::move(pre));
+    });
+
+    // Basic blocks unreachable from the entry
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      if (visited.find(bb) == visited.end()) {
+        this->run_checks(bb, this->bottom());
+      }
+    }
+  }
 
-    // Check called functions during the transfer function
-    call_exec_engine.mark_check_callees();
+  this->_merged_callees.leave(this->_function);
 
-    exec_engine.exec_enter(bb);
+  if (!this->_call_context->empty()) {
+    this->_logger.end_callee(this->_call_context, this->_function);
+  }
+}
 
-    for (ar::Statement* stmt : *bb) {
-      // Check the statement if it's related to an llvm instruction
-      if (stmt->has_frontend()) {
+AbstractDomain FunctionFixpoint::run_checks(ar::BasicBlock* bb,
+                                            AbstractDomain pre) {
+  NumericalExecutionEngineT
+      exec_engine(std::move(pre),
+                  this->_ctx,
+                  this->_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  InlineCallExecutionEngineT call_exec_engine(this->_ctx,
+                                              exec_engine,
+                                              *this,
+                                              this->_callees_cache);
+
+  // Check called functions during the transfer function
+  call_exec_engine.mark_check_callees();
+
+  exec_engine.exec_enter(bb);
+
+  for (ar::Statement* stmt : *bb) {
+    // Check the statement if it's related to an llvm instruction
+    if (stmt->has_frontend()) {
+      {
+        Profiler::FunctionScope profile(this->_ctx.profiler,
+                                        this->_function,
+                                        FunctionOperation::Normalization);
         exec_engine.inv().normalize();
-        for (const auto& checker : this->_checkers) {
-          checker->check(stmt, exec_engine.inv(), this->_call_context);
-        }
       }
-
-      // Propagate
-      transfer_function(exec_engine, call_exec_engine, stmt);
+      for (const auto& checker : this->_checkers) {
+        checker->check(stmt, exec_engine.inv(), this->_call_context);
+      }
     }
 
-    exec_engine.exec_leave(bb);
+    // Propagate
+    transfer_function(exec_engine, call_exec_engine, stmt);
   }
 
-  if (!this->_call_context->empty()) {
-    this->_logger.end_callee(this->_call_context, this->_function);
-  }
+  exec_engine.exec_leave(bb);
+  return std::move(exec_engine.inv());
 }
 
 } // end namespace sequential
@@ -249,6 +249,16 @@ static SourceLocation source_location(ar::BasicBlock* entry) {
 static std::string call_frame_string(CallContext* call_context,
                                      ar::Function* function,
                                      const boost::filesystem::path& wd) {
+  if (call_context->is_merged()) {
+    // No call statement, use the location of the callee
+    auto loc = source_location(function->body()->entry_block());
+    std::string r = source_location_string(loc, wd);
+    r += ": Analyzing called function '";
+    r += demangle(function->name());
+    r += "' in its merged context";
+    return r;
+  }
+
   auto loc = source_location(call_context->call());
   std::string r = source_location_string(loc, wd);
   r += ": Analyzing called function '";
@@ -43,11 +43,19 @@
  *
  ******************************************************************************/
 
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <ikos/analyzer/analysis/compiled_block.hpp>
 #include <ikos/analyzer/analysis/execution_engine/context_insensitive.hpp>
 #include <ikos/analyzer/analysis/execution_engine/engine.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/profiler.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/concurrent/function_fixpoint.hpp>
+#include <ikos/analyzer/database/output.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -64,15 +72,35 @@ using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
 using ContextInsensitiveCallExecutionEngineT =
     ContextInsensitiveCallExecutionEngine< AbstractDomain >;
 
+/// \brief Operation on a function, for the profiler
+using FunctionOperation = Profiler::FunctionOperation;
+
+/// \brief Operation on a cycle head, for the profiler
+using CycleOperation = Profiler::CycleOperation;
+
 } // end anonymous namespace
 
-FunctionFixpoint::FunctionFixpoint(Context& ctx, ar::Function* function)
-    : FwdFixpointIterator(function->body(), make_bottom_abstract_value(ctx)),
+FunctionFixpoint::FunctionFixpoint(Context& ctx,
+                                   ar::Function* function,
+                                   MachineIntDomainOption domain)
+    : FwdFixpointIterator(function->body(),
+                          make_bottom_abstract_value(ctx, domain)),
       _ctx(ctx),
       _empty_call_context(ctx.call_context_factory->get_empty()),
-      _fixpoint_parameters(ctx.fixpoint_parameters->get(function)) {}
+      _domain(domain),
+      _fixpoint_parameters(ctx.fixpoint_parameters->get(function)),
+      _budget(ctx,
+              function,
+              this->_empty_call_context,
+              /* inlining = */ false,
+              /* restart = */ domain != MachineIntDomainOption::Interval) {}
 
 void FunctionFixpoint::run(AbstractDomain inv) {
+  Profiler::FunctionScope profile(this->_ctx.profiler,
+                                  this->cfg()->function(),
+                                  FunctionOperation::Analysis);
+
+  this->_budget.start();
   FwdFixpointIterator::run(std::move(inv));
 }
 
@@ -80,8 +108,20 @@ AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
                                              unsigned iteration,
                                              const AbstractDomain& before,
                                              const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler, head, this->_domain);
+  profile.count(CycleOperation::IncreasingIteration);
+
+  this->_budget.update();
+
+  if (this->_budget.accelerate()) {
+    // Over budget, iterations using widening
+    profile.count(CycleOperation::Widening);
+    return before.widening(after);
+  }
+
   if (iteration <= this->_fixpoint_parameters.widening_delay) {
     // Fixed number of iterations using join
+    profile.count(CycleOperation::Join);
     return before.join_iter(after);
   }
 
@@ -90,6 +130,7 @@ AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
 
   if (iteration % this->_fixpoint_parameters.widening_period != 0) {
     // Not the period, iteration using join
+    profile.count(CycleOperation::Join);
     return before.join_iter(after);
   }
 
@@ -99,15 +140,18 @@ AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
         if (auto threshold =
                 this->_fixpoint_parameters.widening_hints.get(head)) {
           // One iteration using widening with threshold
+          profile.count(CycleOperation::Widening);
           return before.widening_threshold(after, *threshold);
         }
       }
 
       // Iterations using widening until convergence
+      profile.count(CycleOperation::Widening);
       return before.widening(after);
     }
     case WideningStrategy::Join: {
       // Iterations using join until convergence
+      profile.count(CycleOperation::Join);
       return before.join_iter(after);
     }
     default: {
@@ -120,21 +164,32 @@ AbstractDomain FunctionFixpoint::refine(ar::BasicBlock* head,
                                         unsigned iteration,
                                         const AbstractDomain& before,
                                         const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler, head, this->_domain);
+  profile.count(CycleOperation::DecreasingIteration);
+
+  if (this->_budget.accelerate()) {
+    // Over budget, skip the decreasing iterations
+    return before;
+  }
+
   switch (this->_fixpoint_parameters.narrowing_strategy) {
     case NarrowingStrategy::Narrow: {
       if (iteration == 1) {
         if (auto threshold =
                 this->_fixpoint_parameters.widening_hints.get(head)) {
           // First iteration using narrowing with threshold
+          profile.count(CycleOperation::Narrowing);
           return before.narrowing_threshold(after, *threshold);
         }
       }
 
       // Iterations using narrowing
+      profile.count(CycleOperation::Narrowing);
       return before.narrowing(after);
     }
     case NarrowingStrategy::Meet: {
       // Iterations using meet
+      profile.count(CycleOperation::Meet);
       return before.meet(after);
     }
     default: {
@@ -143,19 +198,46 @@ AbstractDomain FunctionFixpoint::refine(ar::BasicBlock* head,
   }
 }
 
+bool FunctionFixpoint::is_increasing_iterations_fixpoint(
+    ar::BasicBlock* head,
+    unsigned /*iteration*/,
+    const AbstractDomain& before,
+    const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler, head, this->_domain);
+  profile.count(CycleOperation::Leq);
+  return after.leq(before);
+}
+
 bool FunctionFixpoint::is_decreasing_iterations_fixpoint(
-    ar::BasicBlock* /*head*/,
+    ar::BasicBlock* head,
     unsigned iteration,
     const AbstractDomain& before,
     const AbstractDomain& after) {
-  // Check if we reached the number of requested iterations, or convergence
-  return (this->_fixpoint_parameters.narrowing_iterations &&
-          iteration >= *this->_fixpoint_parameters.narrowing_iterations) ||
-         before.leq(after);
+  if (this->_budget.accelerate()) {
+    // Over budget, skip the decreasing iterations
+    return true;
+  }
+
+  if (this->_fixpoint_parameters.narrowing_iterations &&
+      iteration >= *this->_fixpoint_parameters.narrowing_iterations) {
+    // Reached the number of requested iterations
+    return true;
+  }
+
+  // Check for convergence
+  Profiler::CycleScope profile(this->_ctx.profiler, head, this->_domain);
+  profile.count(CycleOperation::Leq);
+  return before.leq(after);
 }
 
 AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
                                               AbstractDomain pre) {
+  if (this->_budget.restart()) {
+    // Out of time budget, the fixpoint is discarded and the function is
+    // analyzed again with the interval domain
+    return this->bottom();
+  }
+
   NumericalExecutionEngineT
       exec_engine(std::move(pre),
                   this->_ctx,
@@ -167,9 +249,9 @@ AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
                       : &this->_ctx.pointer->results());
   ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
   exec_engine.exec_enter(bb);
-  for (ar::Statement* stmt : *bb) {
-    transfer_function(exec_engine, call_exec_engine, stmt);
-  }
+  transfer_function(exec_engine,
+                    call_exec_engine,
+                    this->_ctx.block_factory->get(bb));
   exec_engine.exec_leave(bb);
   return std::move(exec_engine.inv());
 }
@@ -177,6 +259,12 @@ AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
 AbstractDomain FunctionFixpoint::analyze_edge(ar::BasicBlock* src,
                                               ar::BasicBlock* dest,
                                               AbstractDomain pre) {
+  if (this->_budget.restart()) {
+    // Out of time budget, the fixpoint is discarded and the function is
+    // analyzed again with the interval domain
+    return this->bottom();
+  }
+
   NumericalExecutionEngineT
       exec_engine(std::move(pre),
                   this->_ctx,
@@ -198,35 +286,69 @@ void FunctionFixpoint::process_post(ar::BasicBlock* /*bb*/,
 
 void FunctionFixpoint::run_checks(
     const std::vector< std::unique_ptr< Checker > >& checkers) {
-  for (ar::BasicBlock* bb : *this->cfg()) {
-    NumericalExecutionEngineT
-        exec_engine(this->pre(bb),
-                    this->_ctx,
-                    this->_empty_call_context,
-                    ExecutionEngine::UpdateAllocSizeVar,
-                    /* liveness = */ this->_ctx.liveness,
-                    /* pointer_info = */ this->_ctx.pointer == nullptr
-                        ? nullptr
-                        : &this->_ctx.pointer->results());
-    ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
-
-    exec_engine.exec_enter(bb);
-
-    for (ar::Statement* stmt : *bb) {
-      // Check the statement if it's related to an llvm instruction
-      if (stmt->has_frontend()) {
+  if (this->_ctx.opts.display_checks != DisplayOption::None ||
+      this->_ctx.opts.display_invariants != DisplayOption::None) {
+    // Check sequentially to keep the output readable
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      this->run_checks(checkers, bb);
+    }
+    return;
+  }
+
+  // Once the fix-point is computed, basic blocks are independent
+  std::vector< ar::BasicBlock* > blocks(this->cfg()->begin(),
+                                        this->cfg()->end());
+  std::vector< ChecksTable::Buffer > buffers(blocks.size());
+
+  tbb::parallel_for(tbb::blocked_range< std::size_t >(0, blocks.size()),
+                    [&](const tbb::blocked_range< std::size_t >& r) {
+                      for (std::size_t i = r.begin(); i != r.end(); ++i) {
+                        ChecksTable::ScopeBuffer scope(buffers[i]);
+                        this->run_checks(checkers, blocks[i]);
+                      }
+                    });
+
+  // Insert the results in order, for a deterministic output
+  for (ChecksTable::Buffer& buffer : buffers) {
+    this->_ctx.output_db->checks.insert(std::move(buffer));
+  }
+}
+
+void FunctionFixpoint::run_checks(
+    const std::vector< std::unique_ptr< Checker > >& checkers,
+    ar::BasicBlock* bb) {
+  NumericalExecutionEngineT
+      exec_engine(this->pre(bb),
+                  this->_ctx,
+                  this->_empty_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
+
+  exec_engine.exec_enter(bb);
+
+  for (ar::Statement* stmt : *bb) {
+    // Check the statement if it's related to an llvm instruction
+    if (stmt->has_frontend()) {
+      {
+        Profiler::FunctionScope profile(this->_ctx.profiler,
+                                        this->cfg()->function(),
+                                        FunctionOperation::Normalization);
         exec_engine.inv().normalize();
-        for (const auto& checker : checkers) {
-          checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
-        }
       }
-
-      // Propagate
-      transfer_function(exec_engine, call_exec_engine, stmt);
+      for (const auto& checker : checkers) {
+        checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
+      }
     }
 
-    exec_engine.exec_leave(bb);
+    // Propagate
+    transfer_function(exec_engine, call_exec_engine, stmt);
   }
+
+  exec_engine.exec_leave(bb);
 }
 
 } // end namespace concurrent
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Cheap numerical pre-pass for the intraprocedural analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+#include <ikos/core/fixpoint/wto.hpp>
+
+#include <ikos/analyzer/analysis/value/intraprocedural/prepass.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+namespace intraprocedural {
+
+namespace {
+
+/// \brief Weak topological visitor to detect cycles
+class CycleDetector final : public core::WtoComponentVisitor< ar::Code* > {
+private:
+  using WtoVertexT = core::WtoVertex< ar::Code* >;
+  using WtoCycleT = core::WtoCycle< ar::Code* >;
+
+private:
+  bool _found = false;
+
+public:
+  /// \brief Constructor
+  CycleDetector() = default;
+
+  /// \brief No copy constructor
+  CycleDetector(const CycleDetector&) = delete;
+
+  /// \brief No move constructor
+  CycleDetector(CycleDetector&&) = delete;
+
+  /// \brief No copy assignment operator
+  CycleDetector& operator=(const CycleDetector&) = delete;
+
+  /// \brief No move assignment operator
+  CycleDetector& operator=(CycleDetector&&) = delete;
+
+  /// \brief Destructor
+  ~CycleDetector() override = default;
+
+  void visit(const WtoVertexT&) override {}
+
+  void visit(const WtoCycleT&) override { this->_found = true; }
+
+  /// \brief Return true if a cycle was visited
+  bool found() const { return this->_found; }
+
+}; // end class CycleDetector
+
+/// \brief Return true if the check is proven
+bool is_proven(const ChecksTable::PendingCheck& check) {
+  return check.status == Result::Ok || check.status == Result::Unreachable;
+}
+
+/// \brief Identify a check across the pre-pass and the precise analysis
+using CheckKey = std::tuple< ar::Statement*,
+                             CheckKind,
+                             CheckerName,
+                             const std::vector< ar::Value* >& >;
+
+/// \brief Return the key of the given check
+CheckKey check_key(const ChecksTable::PendingCheck& check) {
+  return CheckKey(check.stmt, check.kind, check.checker, check.operands);
+}
+
+} // end anonymous namespace
+
+bool use_prepass(const Context& ctx) {
+  return ctx.opts.use_domain_prepass &&
+         ctx.opts.machine_int_domain != PrepassMachineIntDomain &&
+         ctx.opts.display_checks == DisplayOption::None &&
+         ctx.opts.display_invariants == DisplayOption::None;
+}
+
+bool needs_precise_analysis(ar::Function* function,
+                            const ChecksTable::Buffer& prepass_checks) {
+  if (!std::all_of(prepass_checks.begin(), prepass_checks.end(), is_proven)) {
+    return true;
+  }
+
+  CycleDetector visitor;
+  core::Wto< ar::Code* > wto(function->body());
+  wto.accept(visitor);
+  return visitor.found();
+}
+
+void merge_proven_checks(const ChecksTable::Buffer& prepass_checks,
+                         ChecksTable::Buffer& checks) {
+  // Proven checks of the pre-pass, or null if the key is ambiguous
+  std::map< CheckKey, const ChecksTable::PendingCheck* > proven;
+  for (const ChecksTable::PendingCheck& check : prepass_checks) {
+    auto it = proven.find(check_key(check));
+    if (it != proven.end()) {
+      it->second = nullptr;
+    } else {
+      proven.emplace(check_key(check), is_proven(check) ? &check : nullptr);
+    }
+  }
+
+  for (ChecksTable::PendingCheck& check : checks) {
+    if (is_proven(check)) {
+      continue;
+    }
+
+    auto it = proven.find(check_key(check));
+    if (it != proven.end() && it->second != nullptr) {
+      check = *it->second;
+    }
+  }
+}
+
+} // end namespace intraprocedural
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
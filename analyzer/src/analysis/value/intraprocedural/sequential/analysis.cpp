@@ -42,12 +42,17 @@
  ******************************************************************************/
 
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/sequential/analysis.hpp>
+#include <ikos/analyzer/analysis/value/intraprocedural/prepass.hpp>
+#include <ikos/analyzer/analysis/value/intraprocedural/restart.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/sequential/function_fixpoint.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/database/output.hpp>
 #include <ikos/analyzer/util/demangle.hpp>
 #include <ikos/analyzer/util/log.hpp>
 #include <ikos/analyzer/util/progress.hpp>
@@ -75,51 +80,130 @@ void Analysis::run() {
     }
   }
 
+  // Analyze functions with a cheap numerical domain first, if requested
+  bool prepass = use_prepass(_ctx);
+  MachineIntDomainOption domain =
+      prepass ? PrepassMachineIntDomain : _ctx.opts.machine_int_domain;
+  std::string prefix = prepass ? "ikos-analyzer.prepass." : "ikos-analyzer.";
+
+  // Initial invariant
+  AbstractDomain init_inv = make_initial_abstract_value(_ctx, domain);
+
+  // Functions to analyze again with the numerical domain, with the checks of
+  // the pre-pass
+  std::vector< std::pair< ar::Function*, ChecksTable::Buffer > > pending;
+
+  {
+    // Setup a progress logger
+    std::unique_ptr< ProgressLogger > progress =
+        make_progress_logger(_ctx.opts.progress,
+                             LogLevel::Info,
+                             /* num_tasks = */
+                             2 * std::count_if(bundle->function_begin(),
+                                               bundle->function_end(),
+                                               [](ar::Function* fun) {
+                                                 return fun->is_definition();
+                                               }));
+    ScopeLogger scope(*progress);
+
+    // Analyze every function in the bundle
+    for (auto it = bundle->function_begin(), et = bundle->function_end();
+         it != et;
+         ++it) {
+      ar::Function* function = *it;
+
+      // Insert the function in the database
+      _ctx.output_db->functions.insert(function);
+
+      if (!function->is_definition()) {
+        continue;
+      }
+
+      std::unique_ptr< FunctionFixpoint > fixpoint;
+
+      {
+        progress->start_task("Analyzing function '" +
+                             demangle(function->name()) + "'");
+        ScopeTimerDatabase t(_ctx.output_db->times,
+                             prefix + "value." + function->name());
+        fixpoint = run_fixpoint< FunctionFixpoint >(_ctx,
+                                                    function,
+                                                    domain,
+                                                    init_inv);
+      }
+
+      ChecksTable::Buffer checks;
+
+      if (!checkers.empty()) {
+        progress->start_task("Checking properties for function '" +
+                             demangle(function->name()) + "'");
+        ScopeTimerDatabase t(_ctx.output_db->times,
+                             prefix + "check." + function->name());
+        if (prepass) {
+          ChecksTable::ScopeBuffer buffer(checks);
+          fixpoint->run_checks(checkers);
+        } else {
+          fixpoint->run_checks(checkers);
+        }
+      }
+
+      if (prepass) {
+        if (needs_precise_analysis(function, checks)) {
+          pending.emplace_back(function, std::move(checks));
+        } else {
+          _ctx.output_db->checks.insert(std::move(checks));
+        }
+      }
+    }
+  }
+
+  if (pending.empty()) {
+    return;
+  }
+
+  log::info("Analyzing " + std::to_string(pending.size()) +
+            " functions again with the " +
+            machine_int_domain_option_str(_ctx.opts.machine_int_domain) +
+            " domain");
+
   // Initial invariant
-  AbstractDomain init_inv = make_initial_abstract_value(_ctx);
+  init_inv = make_initial_abstract_value(_ctx);
 
   // Setup a progress logger
   std::unique_ptr< ProgressLogger > progress =
       make_progress_logger(_ctx.opts.progress,
                            LogLevel::Info,
-                           /* num_tasks = */
-                           2 * std::count_if(bundle->function_begin(),
-                                             bundle->function_end(),
-                                             [](ar::Function* fun) {
-                                               return fun->is_definition();
-                                             }));
+                           /* num_tasks = */ 2 * pending.size());
   ScopeLogger scope(*progress);
 
-  // Analyze every function in the bundle
-  for (auto it = bundle->function_begin(), et = bundle->function_end();
-       it != et;
-       ++it) {
-    ar::Function* function = *it;
-
-    // Insert the function in the database
-    _ctx.output_db->functions.insert(function);
-
-    if (!function->is_definition()) {
-      continue;
-    }
-
-    FunctionFixpoint fixpoint(_ctx, function);
+  for (auto& entry : pending) {
+    ar::Function* function = entry.first;
+    std::unique_ptr< FunctionFixpoint > fixpoint;
 
     {
       progress->start_task("Analyzing function '" + demangle(function->name()) +
                            "'");
       ScopeTimerDatabase t(_ctx.output_db->times,
                            "ikos-analyzer.value." + function->name());
-      fixpoint.run(init_inv);
+      fixpoint = run_fixpoint< FunctionFixpoint >(_ctx,
+                                                  function,
+                                                  _ctx.opts.machine_int_domain,
+                                                  init_inv);
     }
 
+    ChecksTable::Buffer checks;
+
     if (!checkers.empty()) {
       progress->start_task("Checking properties for function '" +
                            demangle(function->name()) + "'");
       ScopeTimerDatabase t(_ctx.output_db->times,
                            "ikos-analyzer.check." + function->name());
-      fixpoint.run_checks(checkers);
+      ChecksTable::ScopeBuffer buffer(checks);
+      fixpoint->run_checks(checkers);
     }
+
+    merge_proven_checks(entry.second, checks);
+    _ctx.output_db->checks.insert(std::move(checks));
   }
 }
 
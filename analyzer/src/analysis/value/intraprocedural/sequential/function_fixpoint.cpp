@@ -41,10 +41,14 @@
  *
  ******************************************************************************/
 
+#include <unordered_set>
+
+#include <ikos/analyzer/analysis/compiled_block.hpp>
 #include <ikos/analyzer/analysis/execution_engine/context_insensitive.hpp>
 #include <ikos/analyzer/analysis/execution_engine/engine.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/profiler.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/sequential/function_fixpoint.hpp>
 
 namespace ikos {
@@ -62,15 +66,36 @@ using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
 using ContextInsensitiveCallExecutionEngineT =
     ContextInsensitiveCallExecutionEngine< AbstractDomain >;
 
+/// \brief Operation on a function, for the profiler
+using FunctionOperation = Profiler::FunctionOperation;
+
+/// \brief Operation on a cycle head, for the profiler
+using CycleOperation = Profiler::CycleOperation;
+
 } // end anonymous namespace
 
-FunctionFixpoint::FunctionFixpoint(Context& ctx, ar::Function* function)
-    : FwdFixpointIterator(function->body(), make_bottom_abstract_value(ctx)),
+FunctionFixpoint::FunctionFixpoint(Context& ctx,
+                                   ar::Function* function,
+                                   MachineIntDomainOption domain)
+    : FwdFixpointIterator(function->body(),
+                          make_bottom_abstract_value(ctx, domain),
+                          ctx.opts.use_sparse_invariants),
       _ctx(ctx),
       _empty_call_context(ctx.call_context_factory->get_empty()),
-      _fixpoint_parameters(ctx.fixpoint_parameters->get(function)) {}
+      _domain(domain),
+      _fixpoint_parameters(ctx.fixpoint_parameters->get(function)),
+      _budget(ctx,
+              function,
+              this->_empty_call_context,
+              /* inlining = */ false,
+              /* restart = */ domain != MachineIntDomainOption::Interval) {}
 
 void FunctionFixpoint::run(AbstractDomain inv) {
+  Profiler::FunctionScope profile(this->_ctx.profiler,
+                                  this->cfg()->function(),
+                                  FunctionOperation::Analysis);
+
+  this->_budget.start();
   FwdFixpointIterator::run(std::move(inv));
 }
 
@@ -78,8 +103,18 @@ AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
                                              unsigned iteration,
                                              const AbstractDomain& before,
                                              const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler, head, this->_domain);
+  profile.count(CycleOperation::IncreasingIteration);
+
+  if (this->_budget.accelerate()) {
+    // Over budget, iterations using widening
+    profile.count(CycleOperation::Widening);
+    return before.widening(after);
+  }
+
   if (iteration <= this->_fixpoint_parameters.widening_delay) {
     // Fixed number of iterations using join
+    profile.count(CycleOperation::Join);
     return before.join_iter(after);
   }
 
@@ -88,6 +123,7 @@ AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
 
   if (iteration % this->_fixpoint_parameters.widening_period != 0) {
     // Not the period, iteration using join
+    profile.count(CycleOperation::Join);
     return before.join_iter(after);
   }
 
@@ -97,15 +133,18 @@ AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
         if (auto threshold =
                 this->_fixpoint_parameters.widening_hints.get(head)) {
           // One iteration using widening with threshold
+          profile.count(CycleOperation::Widening);
           return before.widening_threshold(after, *threshold);
         }
       }
 
       // Iterations using widening until convergence
+      profile.count(CycleOperation::Widening);
       return before.widening(after);
     }
     case WideningStrategy::Join: {
       // Iterations using join until convergence
+      profile.count(CycleOperation::Join);
       return before.join_iter(after);
     }
     default: {
@@ -118,21 +157,32 @@ AbstractDomain FunctionFixpoint::refine(ar::BasicBlock* head,
                                         unsigned iteration,
                                         const AbstractDomain& before,
                                         const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler, head, this->_domain);
+  profile.count(CycleOperation::DecreasingIteration);
+
+  if (this->_budget.accelerate()) {
+    // Over budget, skip the decreasing iterations
+    return before;
+  }
+
   switch (this->_fixpoint_parameters.narrowing_strategy) {
     case NarrowingStrategy::Narrow: {
       if (iteration == 1) {
         if (auto threshold =
                 this->_fixpoint_parameters.widening_hints.get(head)) {
           // First iteration using narrowing with threshold
+          profile.count(CycleOperation::Narrowing);
           return before.narrowing_threshold(after, *threshold);
         }
       }
 
       // Iterations using narrowing
+      profile.count(CycleOperation::Narrowing);
       return before.narrowing(after);
     }
     case NarrowingStrategy::Meet: {
       // Iterations using meet
+      profile.count(CycleOperation::Meet);
       return before.meet(after);
     }
     default: {
@@ -141,19 +191,46 @@ AbstractDomain FunctionFixpoint::refine(ar::BasicBlock* head,
   }
 }
 
+bool FunctionFixpoint::is_increasing_iterations_fixpoint(
+    ar::BasicBlock* head,
+    unsigned /*iteration*/,
+    const AbstractDomain& before,
+    const AbstractDomain& after) {
+  Profiler::CycleScope profile(this->_ctx.profiler, head, this->_domain);
+  profile.count(CycleOperation::Leq);
+  return after.leq(before);
+}
+
 bool FunctionFixpoint::is_decreasing_iterations_fixpoint(
-    ar::BasicBlock* /*head*/,
+    ar::BasicBlock* head,
     unsigned iteration,
     const AbstractDomain& before,
     const AbstractDomain& after) {
-  // Check if we reached the number of requested iterations, or convergence
-  return (this->_fixpoint_parameters.narrowing_iterations &&
-          iteration >= *this->_fixpoint_parameters.narrowing_iterations) ||
-         before.leq(after);
+  if (this->_budget.accelerate()) {
+    // Over budget, skip the decreasing iterations
+    return true;
+  }
+
+  if (this->_fixpoint_parameters.narrowing_iterations &&
+      iteration >= *this->_fixpoint_parameters.narrowing_iterations) {
+    // Reached the number of requested iterations
+    return true;
+  }
+
+  // Check for convergence
+  Profiler::CycleScope profile(this->_ctx.profiler, head, this->_domain);
+  profile.count(CycleOperation::Leq);
+  return before.leq(after);
 }
 
 AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
                                               AbstractDomain pre) {
+  if (this->_budget.restart()) {
+    // Out of time budget, the fixpoint is discarded and the function is
+    // analyzed again with the interval domain
+    return this->bottom();
+  }
+
   NumericalExecutionEngineT
       exec_engine(std::move(pre),
                   this->_ctx,
@@ -165,9 +242,9 @@ AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
                       : &this->_ctx.pointer->results());
   ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
   exec_engine.exec_enter(bb);
-  for (ar::Statement* stmt : *bb) {
-    transfer_function(exec_engine, call_exec_engine, stmt);
-  }
+  transfer_function(exec_engine,
+                    call_exec_engine,
+                    this->_ctx.block_factory->get(bb));
   exec_engine.exec_leave(bb);
   return std::move(exec_engine.inv());
 }
@@ -175,6 +252,12 @@ AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
 AbstractDomain FunctionFixpoint::analyze_edge(ar::BasicBlock* src,
                                               ar::BasicBlock* dest,
                                               AbstractDomain pre) {
+  if (this->_budget.restart()) {
+    // Out of time budget, the fixpoint is discarded and the function is
+    // analyzed again with the interval domain
+    return this->bottom();
+  }
+
   NumericalExecutionEngineT
       exec_engine(std::move(pre),
                   this->_ctx,
@@ -188,6 +271,13 @@ AbstractDomain FunctionFixpoint::analyze_edge(ar::BasicBlock* src,
   return std::move(exec_engine.inv());
 }
 
+void FunctionFixpoint::notify_cycle_iteration(
+    ar::BasicBlock* /*head*/,
+    unsigned /*iteration*/,
+    core::FixpointIterationKind /*kind*/) {
+  this->_budget.update();
+}
+
 void FunctionFixpoint::process_pre(ar::BasicBlock* /*bb*/,
                                    const AbstractDomain& /*pre*/) {}
 
@@ -196,35 +286,65 @@ void FunctionFixpoint::process_post(ar::BasicBlock* /*bb*/,
 
 void FunctionFixpoint::run_checks(
     const std::vector< std::unique_ptr< Checker > >& checkers) {
+  if (!this->sparse()) {
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      this->run_checks(checkers, bb, this->pre(bb));
+    }
+    return;
+  }
+
+  // Recompute the pre invariants from the cycle heads
+  std::unordered_set< ar::BasicBlock* > visited;
+  this->for_each_pre([&](ar::BasicBlock* bb, AbstractDomain pre) {
+    visited.insert(bb);
+    return this->run_checks(checkers, bb, std::move(pre));
+  });
+
+  // Basic blocks unreachable from the entry
   for (ar::BasicBlock* bb : *this->cfg()) {
-    NumericalExecutionEngineT
-        exec_engine(this->pre(bb),
-                    this->_ctx,
-                    this->_empty_call_context,
-                    ExecutionEngine::UpdateAllocSizeVar,
-                    /* liveness = */ this->_ctx.liveness,
-                    /* pointer_info = */ this->_ctx.pointer == nullptr
-                        ? nullptr
-                        : &this->_ctx.pointer->results());
-    ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
-
-    exec_engine.exec_enter(bb);
-
-    for (ar::Statement* stmt : *bb) {
-      // Check the statement if it's related to an llvm instruction
-      if (stmt->has_frontend()) {
+    if (visited.find(bb) == visited.end()) {
+      this->run_checks(checkers, bb, this->bottom());
+    }
+  }
+}
+
+AbstractDomain FunctionFixpoint::run_checks(
+    const std::vector< std::unique_ptr< Checker > >& checkers,
+    ar::BasicBlock* bb,
+    AbstractDomain pre) {
+  NumericalExecutionEngineT
+      exec_engine(std::move(pre),
+                  this->_ctx,
+                  this->_empty_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
+
+  exec_engine.exec_enter(bb);
+
+  for (ar::Statement* stmt : *bb) {
+    // Check the statement if it's related to an llvm instruction
+    if (stmt->has_frontend()) {
+      {
+        Profiler::FunctionScope profile(this->_ctx.profiler,
+                                        this->cfg()->function(),
+                                        FunctionOperation::Normalization);
         exec_engine.inv().normalize();
-        for (const auto& checker : checkers) {
-          checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
-        }
       }
-
-      // Propagate
-      transfer_function(exec_engine, call_exec_engine, stmt);
+      for (const auto& checker : checkers) {
+        checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
+      }
     }
 
-    exec_engine.exec_leave(bb);
+    // Propagate
+    transfer_function(exec_engine, call_exec_engine, stmt);
   }
+
+  exec_engine.exec_leave(bb);
+  return std::move(exec_engine.inv());
 }
 
 } // end namespace sequential
@@ -52,6 +52,8 @@ MachineIntAbstractDomain make_top_machine_int_abstract_value(
   switch (domain) {
     case MachineIntDomainOption::Interval:
       return make_top_machine_int_interval();
+    case MachineIntDomainOption::CompactInterval:
+      return make_top_machine_int_compact_interval();
     case MachineIntDomainOption::Congruence:
       return make_top_machine_int_congruence();
     case MachineIntDomainOption::IntervalCongruence:
@@ -103,6 +105,8 @@ MachineIntAbstractDomain make_bottom_machine_int_abstract_value(
   switch (domain) {
     case MachineIntDomainOption::Interval:
       return make_bottom_machine_int_interval();
+    case MachineIntDomainOption::CompactInterval:
+      return make_bottom_machine_int_compact_interval();
     case MachineIntDomainOption::Congruence:
       return make_bottom_machine_int_congruence();
     case MachineIntDomainOption::IntervalCongruence:
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief MemoryBudget implementation
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <ikos/core/support/memory_usage.hpp>
+
+#include <ikos/analyzer/analysis/value/memory_budget.hpp>
+#include <ikos/analyzer/database/output.hpp>
+#include <ikos/analyzer/util/demangle.hpp>
+#include <ikos/analyzer/util/log.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+
+MemoryBudget::MemoryBudget(Context& ctx,
+                           ar::Function* function,
+                           CallContext* call_context,
+                           bool inlining,
+                           MemoryDegradation degradation)
+    : _ctx(ctx),
+      _function(function),
+      _call_context(call_context),
+      _inlining(inlining),
+      _degradation(degradation) {}
+
+bool MemoryBudget::update() {
+  if (!this->_ctx.opts.mem_budget || this->accelerate()) {
+    return false;
+  }
+
+  std::size_t budget =
+      static_cast< std::size_t >(*this->_ctx.opts.mem_budget) * 1024 * 1024;
+  std::size_t usage = core::MemoryUsage::total();
+
+  MemoryDegradation degradation = MemoryDegradation::None;
+  if (usage >= budget) {
+    degradation = MemoryDegradation::Accelerate;
+  } else if (this->_inlining && usage >= budget / 10 * 9) {
+    degradation = MemoryDegradation::NoInlining;
+  } else if (this->_inlining && usage >= budget / 4 * 3) {
+    degradation = MemoryDegradation::EvictFixpointCache;
+  }
+
+  MemoryDegradation current = this->degradation();
+  do {
+    if (degradation <= current) {
+      return false;
+    }
+  } while (!this->_degradation.compare_exchange_weak(current, degradation));
+
+  auto usage_mb = static_cast< double >(usage) / (1024 * 1024);
+  log::debug("Memory budget exceeded on function '" +
+             demangle(this->_function->name()) + "', degradation: " +
+             memory_degradation_str(degradation));
+  this->_ctx.output_db->degradations.insert(this->_function,
+                                            this->_call_context,
+                                            "memory",
+                                            memory_degradation_str(degradation),
+                                            usage_mb);
+  return true;
+}
+
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
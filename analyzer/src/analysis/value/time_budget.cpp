@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief TimeBudget implementation
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <ikos/analyzer/analysis/value/time_budget.hpp>
+#include <ikos/analyzer/database/output.hpp>
+#include <ikos/analyzer/util/demangle.hpp>
+#include <ikos/analyzer/util/log.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+
+TimeBudget::TimeBudget(Context& ctx,
+                       ar::Function* function,
+                       CallContext* call_context,
+                       bool inlining,
+                       bool restart)
+    : _ctx(ctx),
+      _function(function),
+      _call_context(call_context),
+      _inlining(inlining),
+      _restart(restart),
+      _start(Clock::now()),
+      _degradation(TimeDegradation::None) {}
+
+bool TimeBudget::update() {
+  if (!this->_ctx.opts.function_time_budget) {
+    return false;
+  }
+
+  auto budget = static_cast< double >(*this->_ctx.opts.function_time_budget);
+  double elapsed =
+      std::chrono::duration< double >(Clock::now() - this->_start).count();
+
+  TimeDegradation degradation = TimeDegradation::None;
+  if (this->_restart && elapsed >= 2 * budget) {
+    degradation = TimeDegradation::Restart;
+  } else if (this->_inlining && elapsed >= 2 * budget) {
+    degradation = TimeDegradation::NoInlining;
+  } else if (elapsed >= budget) {
+    degradation = TimeDegradation::Accelerate;
+  }
+
+  TimeDegradation current = this->degradation();
+  do {
+    if (degradation <= current) {
+      return false;
+    }
+  } while (!this->_degradation.compare_exchange_weak(current, degradation));
+
+  log::debug("Time budget exceeded on function '" +
+             demangle(this->_function->name()) +
+             "', degradation: " + time_degradation_str(degradation));
+  this->_ctx.output_db->degradations.insert(this->_function,
+                                            this->_call_context,
+                                            "time",
+                                            time_degradation_str(degradation),
+                                            elapsed);
+  return true;
+}
+
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
@@ -44,6 +44,7 @@
 #include <llvm/IR/Instructions.h>
 
 #include <ikos/analyzer/checker/dead_code.hpp>
+#include <ikos/analyzer/support/assert.hpp>
 #include <ikos/analyzer/support/cast.hpp>
 
 namespace ikos {
@@ -66,8 +67,7 @@ void DeadCodeChecker::check(ar::Statement* stmt,
     return;
   }
 
-  ar::Statement* prev_stmt = this->previous_statement(stmt);
-  this->save_current_statement(stmt);
+  ar::Statement* prev_stmt = previous_statement(stmt);
 
   // Check if the current statement needs a check
   if (!needs_check(prev_stmt, stmt->parent())) {
@@ -85,25 +85,29 @@ void DeadCodeChecker::check(ar::Statement* stmt,
                        call_context);
 }
 
-ar::Statement* DeadCodeChecker::previous_statement(ar::Statement* stmt) const {
-  auto it = this->_prev_stmts.find(stmt->parent());
-  if (it != this->_prev_stmts.end()) {
-    return it->second;
-  } else {
-    return nullptr; // First statement in the basic block
-  }
-}
-
-void DeadCodeChecker::save_current_statement(ar::Statement* stmt) {
+ar::Statement* DeadCodeChecker::previous_statement(ar::Statement* stmt) {
   ar::BasicBlock* bb = stmt->parent();
-
-  if (bb->back() == stmt) {
-    // Last statement in the basic block, no need to keep it in the map
-    this->_prev_stmts.erase(bb);
-    return;
+  std::lock_guard< std::mutex > lock(this->_mutex);
+
+  auto it = this->_previous.find(bb);
+  if (it == this->_previous.end()) {
+    // There is no O(1) access to the previous statement, walk the basic block
+    PreviousMap previous;
+    previous.reserve(bb->num_statements());
+    ar::Statement* prev_stmt = nullptr;
+    for (ar::Statement* bb_stmt : *bb) {
+      previous.emplace(bb_stmt, prev_stmt);
+      if (!skip_check(bb_stmt)) {
+        prev_stmt = bb_stmt;
+      }
+    }
+    it = this->_previous.emplace(bb, std::move(previous)).first;
   }
 
-  this->_prev_stmts[bb] = stmt;
+  auto prev = it->second.find(stmt);
+  ikos_assert_msg(prev != it->second.end(),
+                  "statement not found in its parent basic block");
+  return prev->second;
 }
 
 bool DeadCodeChecker::skip_check(ar::Statement* stmt) {
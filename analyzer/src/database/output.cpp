@@ -56,7 +56,11 @@ OutputDatabase::OutputDatabase(sqlite::DbConnection& db_)
       operands(db_),
       call_contexts(db_, functions, statements),
       memory_locations(db_, functions, statements, call_contexts),
-      checks(db_, statements, operands, call_contexts) {
+      checks(db_, statements, operands, call_contexts),
+      degradations(db_, functions, call_contexts),
+      profile_functions(db_, functions),
+      profile_cycles(db_, functions, statements),
+      profile_operations(db_) {
   this->db.set_commit_policy(sqlite::CommitPolicy::Auto);
 }
 
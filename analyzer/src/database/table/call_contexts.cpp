@@ -63,6 +63,8 @@ CallContextsTable::CallContextsTable(sqlite::DbConnection& db,
 sqlite::DbInt64 CallContextsTable::insert(CallContext* call_context) {
   ikos_assert(call_context != nullptr);
 
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
+
   auto it = this->_map.find(call_context);
   if (it != this->_map.end()) {
     return it->second;
@@ -82,6 +84,11 @@ sqlite::DbInt64 CallContextsTable::insert(CallContext* call_context) {
     this->_row << sqlite::null;
     this->_row << sqlite::null;
     this->_row << sqlite::null;
+  } else if (call_context->is_merged()) {
+    // Merged context: no call_id and no parent_id, function_id is the callee
+    this->_row << sqlite::null;
+    this->_row << this->_functions.insert(call_context->merged_function());
+    this->_row << sqlite::null;
   } else {
     // call_id
     ar::CallBase* call = call_context->call();
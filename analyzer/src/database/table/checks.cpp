@@ -41,6 +41,8 @@
  *
  ******************************************************************************/
 
+#include <iterator>
+
 #include <ikos/analyzer/database/table/checks.hpp>
 
 namespace ikos {
@@ -66,6 +68,17 @@ ChecksTable::ChecksTable(sqlite::DbConnection& db,
       _call_contexts(call_contexts),
       _row(db, "checks", 8) {}
 
+thread_local ChecksTable::Buffer* ChecksTable::CurrentBuffer = nullptr;
+
+ChecksTable::ScopeBuffer::ScopeBuffer(Buffer& buffer)
+    : _prev(ChecksTable::CurrentBuffer) {
+  ChecksTable::CurrentBuffer = &buffer;
+}
+
+ChecksTable::ScopeBuffer::~ScopeBuffer() {
+  ChecksTable::CurrentBuffer = this->_prev;
+}
+
 void ChecksTable::insert(CheckKind kind,
                          CheckerName checker,
                          Result status,
@@ -73,6 +86,46 @@ void ChecksTable::insert(CheckKind kind,
                          CallContext* call_context,
                          llvm::ArrayRef< ar::Value* > operands,
                          const JsonDict& info) {
+  if (CurrentBuffer != nullptr) {
+    CurrentBuffer->push_back(PendingCheck{kind,
+                                          checker,
+                                          status,
+                                          stmt,
+                                          call_context,
+                                          operands.vec(),
+                                          info});
+  } else {
+    this->insert_row(kind, checker, status, stmt, call_context, operands, info);
+  }
+}
+
+void ChecksTable::insert(Buffer&& buffer) {
+  if (CurrentBuffer != nullptr) {
+    CurrentBuffer->insert(CurrentBuffer->end(),
+                          std::make_move_iterator(buffer.begin()),
+                          std::make_move_iterator(buffer.end()));
+  } else {
+    for (const PendingCheck& check : buffer) {
+      this->insert_row(check.kind,
+                       check.checker,
+                       check.status,
+                       check.stmt,
+                       check.call_context,
+                       check.operands,
+                       check.info);
+    }
+  }
+  buffer.clear();
+}
+
+void ChecksTable::insert_row(CheckKind kind,
+                             CheckerName checker,
+                             Result status,
+                             ar::Statement* stmt,
+                             CallContext* call_context,
+                             llvm::ArrayRef< ar::Value* > operands,
+                             const JsonDict& info) {
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
   sqlite::DbInt64 id = this->_last_insert_id++;
 
   this->_row << id;
@@ -76,6 +76,19 @@ OperandsTable::OperandsTable(sqlite::DbConnection& db)
 sqlite::DbInt64 OperandsTable::insert(ar::Value* value) {
   ikos_assert(value != nullptr);
 
+  {
+    boost::shared_lock< boost::shared_mutex > lock(this->_map_mutex);
+    auto it = this->_map.find(value);
+    if (it != this->_map.end()) {
+      return it->second;
+    }
+  }
+
+  std::string str = repr(value);
+
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
+
+  // Another thread might have inserted the operand in the meantime
   auto it = this->_map.find(value);
   if (it != this->_map.end()) {
     return it->second;
@@ -84,10 +97,13 @@ sqlite::DbInt64 OperandsTable::insert(ar::Value* value) {
   sqlite::DbInt64 id = this->_last_insert_id++;
   this->_row << id;
   this->_row << static_cast< sqlite::DbInt64 >(value->kind());
-  this->_row << repr(value);
+  this->_row << str;
   this->_row << sqlite::end_row;
 
-  this->_map.try_emplace(value, id);
+  {
+    boost::unique_lock< boost::shared_mutex > map_lock(this->_map_mutex);
+    this->_map.try_emplace(value, id);
+  }
   return id;
 }
 
@@ -321,8 +337,36 @@ using TypeSet = boost::container::flat_set< llvm::Type* >;
 /// \brief Set of values
 using ValueSet = boost::container::flat_set< llvm::Value* >;
 
+/// \brief Remove an element from a set when leaving the scope
+///
+/// The sets of types and values being processed are shared by the recursive
+/// calls rather than copied at each step.
+template < typename Set >
+class ScopedInsert {
+private:
+  Set& _set;
+  typename Set::value_type _elem;
+  bool _inserted;
+
+public:
+  /// \brief Insert the given element in the set
+  ScopedInsert(Set& set, typename Set::value_type elem)
+      : _set(set), _elem(elem), _inserted(set.insert(elem).second) {}
+
+  /// \brief Return true if the element was not already in the set
+  bool inserted() const { return this->_inserted; }
+
+  /// \brief Destructor
+  ~ScopedInsert() {
+    if (this->_inserted) {
+      this->_set.erase(this->_elem);
+    }
+  }
+
+}; // end class ScopedInsert
+
 /// \brief Return the textual representation of a llvm::Type*
-std::string repr(llvm::Type* type, TypeSet seen) {
+std::string repr(llvm::Type* type, TypeSet& seen) {
   ikos_assert(type != nullptr);
 
   if (type->isVoidTy()) {
@@ -367,8 +411,8 @@ std::string repr(llvm::Type* type, TypeSet seen) {
     }
 
     // Avoid infinite recursion
-    auto p = seen.insert(type);
-    if (!p.second) {
+    ScopedInsert< TypeSet > p(seen, type);
+    if (!p.inserted()) {
       return "{...}"; // already processing
     }
 
@@ -456,11 +500,11 @@ public:
 }; // end struct ReprResult
 
 // Forward declaration
-ReprResult repr(llvm::Constant*, ValueSet seen);
-ReprResult repr(llvm::Value*, ValueSet seen);
+ReprResult repr(llvm::Constant*, ValueSet& seen);
+ReprResult repr(llvm::Value*, ValueSet& seen);
 
 /// \brief Return the textual representation of a llvm::Constant*
-ReprResult repr(llvm::Constant* cst, ValueSet seen) {
+ReprResult repr(llvm::Constant* cst, ValueSet& seen) {
   if (auto gv_alias = llvm::dyn_cast< llvm::GlobalAlias >(cst)) {
     return repr(gv_alias->getAliasee(), seen);
   } else if (auto gv = llvm::dyn_cast< llvm::GlobalVariable >(cst)) {
@@ -681,7 +725,7 @@ ReprResult add_array_access(const ReprResult& addr, const ReprResult& index) {
 }
 
 /// \brief Return the textual representation of a llvm::Value*
-ReprResult repr(llvm::Value* value, ValueSet seen) {
+ReprResult repr(llvm::Value* value, ValueSet& seen) {
   ikos_assert(value != nullptr);
 
   // Check for llvm.dbg.value
@@ -860,8 +904,8 @@ ReprResult repr(llvm::Value* value, ValueSet seen) {
       return ReprResult{r};
     } else if (auto phi = llvm::dyn_cast< llvm::PHINode >(inst)) {
       // Avoid infinite recursion
-      auto p = seen.insert(phi);
-      if (!p.second) {
+      ScopedInsert< ValueSet > p(seen, phi);
+      if (!p.inserted()) {
         return ReprResult{"..."}; // already processing
       }
 
@@ -1002,6 +1046,19 @@ struct OperandReprVisitor {
     return r;
   }
 
+  std::string operator()(ar::DataArrayConstant* c) const {
+    std::string r = "[";
+    for (std::size_t i = 0, n = c->num_elements(); i < n;) {
+      r += c->element(i).str();
+      ++i;
+      if (i != n) {
+        r += ", ";
+      }
+    }
+    r += "]";
+    return r;
+  }
+
   std::string operator()(ar::AggregateZeroConstant*) const { return "{0}"; }
 
   std::string operator()(ar::FunctionPointerConstant* c) const {
@@ -1107,15 +1164,18 @@ struct OperandReprVisitor {
 } // end namespace detail
 
 std::string OperandsTable::repr(llvm::Type* type) {
-  return detail::repr(type, detail::TypeSet{});
+  detail::TypeSet seen;
+  return detail::repr(type, seen);
 }
 
 std::string OperandsTable::repr(llvm::Constant* cst) {
-  return detail::repr(cst, detail::ValueSet{}).str;
+  detail::ValueSet seen;
+  return detail::repr(cst, seen).str;
 }
 
 std::string OperandsTable::repr(llvm::Value* value) {
-  return detail::repr(value, detail::ValueSet{}).str;
+  detail::ValueSet seen;
+  return detail::repr(value, seen).str;
 }
 
 std::string OperandsTable::repr(ar::Value* value) {
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief ProfileCyclesTable implementation
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+
+#include <ikos/analyzer/database/table/profile_cycles.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+ProfileCyclesTable::ProfileCyclesTable(sqlite::DbConnection& db,
+                                       FunctionsTable& functions,
+                                       StatementsTable& statements)
+    : DatabaseTable(db,
+                    "profile_cycles",
+                    {{"function_id", sqlite::DbColumnType::Integer},
+                     {"statement_id", sqlite::DbColumnType::Integer},
+                     {"head", sqlite::DbColumnType::Text},
+                     {"increasing_iterations", sqlite::DbColumnType::Integer},
+                     {"decreasing_iterations", sqlite::DbColumnType::Integer},
+                     {"joins", sqlite::DbColumnType::Integer},
+                     {"widenings", sqlite::DbColumnType::Integer},
+                     {"narrowings", sqlite::DbColumnType::Integer},
+                     {"meets", sqlite::DbColumnType::Integer},
+                     {"leqs", sqlite::DbColumnType::Integer},
+                     {"time", sqlite::DbColumnType::Real}},
+                    {"function_id"}),
+      _functions(functions),
+      _statements(statements),
+      _row(db, "profile_cycles", 11) {}
+
+void ProfileCyclesTable::insert(ar::BasicBlock* head,
+                                const Profiler::CycleCounters& counters) {
+  ikos_assert(head != nullptr);
+
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
+
+  ar::Code* code = head->code();
+  ikos_assert(code->is_function_body());
+  this->_row << this->_functions.insert(code->function());
+
+  // Locate the cycle with its first statement related to an llvm instruction
+  auto it = std::find_if(head->begin(), head->end(), [](ar::Statement* stmt) {
+    return stmt->has_frontend();
+  });
+  if (it != head->end()) {
+    this->_row << this->_statements.insert(*it);
+  } else {
+    this->_row << sqlite::null;
+  }
+
+  if (head->has_name()) {
+    this->_row << head->name();
+  } else {
+    this->_row << sqlite::null;
+  }
+
+  this->_row << static_cast< sqlite::DbInt64 >(counters.increasing_iterations);
+  this->_row << static_cast< sqlite::DbInt64 >(counters.decreasing_iterations);
+  this->_row << static_cast< sqlite::DbInt64 >(counters.joins);
+  this->_row << static_cast< sqlite::DbInt64 >(counters.widenings);
+  this->_row << static_cast< sqlite::DbInt64 >(counters.narrowings);
+  this->_row << static_cast< sqlite::DbInt64 >(counters.meets);
+  this->_row << static_cast< sqlite::DbInt64 >(counters.leqs);
+  this->_row << static_cast< sqlite::DbDouble >(counters.time.count());
+  this->_row << sqlite::end_row;
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -66,6 +66,22 @@ StatementsTable::StatementsTable(sqlite::DbConnection& db,
 sqlite::DbInt64 StatementsTable::insert(ar::Statement* stmt) {
   ikos_assert(stmt != nullptr);
 
+  {
+    boost::shared_lock< boost::shared_mutex > lock(this->_map_mutex);
+    auto it = this->_map.find(stmt);
+    if (it != this->_map.end()) {
+      return it->second;
+    }
+  }
+
+  ar::Code* code = stmt->parent()->code();
+  ikos_assert(code->is_function_body());
+  ikos_assert(stmt->has_frontend());
+  SourceLocation loc = source_location(stmt);
+
+  std::lock_guard< std::recursive_mutex > lock(this->_db.mutex());
+
+  // Another thread might have inserted the statement in the meantime
   auto it = this->_map.find(stmt);
   if (it != this->_map.end()) {
     return it->second;
@@ -75,13 +91,8 @@ sqlite::DbInt64 StatementsTable::insert(ar::Statement* stmt) {
 
   this->_row << id;
   this->_row << static_cast< sqlite::DbInt64 >(stmt->kind());
-
-  ar::Code* code = stmt->parent()->code();
-  ikos_assert(code->is_function_body());
   this->_row << this->_functions.insert(code->function());
 
-  ikos_assert(stmt->has_frontend());
-  SourceLocation loc = source_location(stmt);
   if (loc) {
     this->_row << this->_files.insert(loc.file());
     this->_row << static_cast< sqlite::DbInt64 >(loc.line());
@@ -94,7 +105,10 @@ sqlite::DbInt64 StatementsTable::insert(ar::Statement* stmt) {
 
   this->_row << sqlite::end_row;
 
-  this->_map.try_emplace(stmt, id);
+  {
+    boost::unique_lock< boost::shared_mutex > map_lock(this->_map_mutex);
+    this->_map.try_emplace(stmt, id);
+  }
   return id;
 }
 
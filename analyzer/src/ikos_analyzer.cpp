@@ -48,6 +48,9 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 
+#include <tbb/parallel_for.h>
+#include <tbb/task_scheduler_init.h>
+
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Support/CommandLine.h>
@@ -69,9 +72,12 @@
 #include <ikos/ar/verify/frontend.hpp>
 #include <ikos/ar/verify/type.hpp>
 
+#include <ikos/core/support/memory_usage.hpp>
+
 #include <ikos/frontend/llvm/import.hpp>
 
 #include <ikos/analyzer/analysis/call_context.hpp>
+#include <ikos/analyzer/analysis/compiled_block.hpp>
 #include <ikos/analyzer/analysis/context.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/hardware_addresses.hpp>
@@ -81,7 +87,9 @@
 #include <ikos/analyzer/analysis/option.hpp>
 #include <ikos/analyzer/analysis/pointer/function.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/profiler.hpp>
 #include <ikos/analyzer/analysis/result.hpp>
+#include <ikos/analyzer/analysis/summary_store.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/concurrent/analysis.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/analysis.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/concurrent/analysis.hpp>
@@ -103,17 +111,17 @@ namespace analyzer = ikos::analyzer;
 
 static llvm::cl::OptionCategory MainCategory("Main Options");
 
-static llvm::cl::opt< std::string > InputFilename(
+static llvm::cl::list< std::string > InputFilenames(
     llvm::cl::Positional,
-    llvm::cl::desc("<input bitcode file>"),
-    llvm::cl::Required,
+    llvm::cl::desc("<input bitcode files>"),
+    llvm::cl::OneOrMore,
     llvm::cl::value_desc("file"));
 
-static llvm::cl::opt< std::string > OutputFilename(
+static llvm::cl::list< std::string > OutputFilenames(
     "o",
-    llvm::cl::desc("Output database filename (default: output.db)"),
+    llvm::cl::desc("Output database filename, once per input file "
+                   "(default: output.db)"),
     llvm::cl::value_desc("file"),
-    llvm::cl::init("output.db"),
     llvm::cl::cat(MainCategory));
 
 static llvm::cl::opt< analyzer::LogLevel > LogLevel(
@@ -225,6 +233,10 @@ static llvm::cl::opt< analyzer::MachineIntDomainOption > Domain(
                    machine_int_domain_option_str(
                        analyzer::MachineIntDomainOption::Interval),
                    "Interval domain"),
+        clEnumValN(analyzer::MachineIntDomainOption::CompactInterval,
+                   machine_int_domain_option_str(
+                       analyzer::MachineIntDomainOption::CompactInterval),
+                   "Interval domain with a compact storage"),
         clEnumValN(analyzer::MachineIntDomainOption::Congruence,
                    machine_int_domain_option_str(
                        analyzer::MachineIntDomainOption::Congruence),
@@ -414,6 +426,12 @@ static llvm::cl::opt< bool > NoLiveness(
     llvm::cl::desc("Disable the liveness analysis"),
     llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< bool > NoCompiledBlocks(
+    "no-compiled-blocks",
+    llvm::cl::desc("Execute basic blocks statement by statement, without "
+                   "runs of integer instructions"),
+    llvm::cl::cat(AnalysisCategory));
+
 static llvm::cl::opt< bool > NoPointer(
     "no-pointer",
     llvm::cl::desc("Disable the pointer analysis"),
@@ -429,15 +447,86 @@ static llvm::cl::opt< bool > EnablePartitioningDomain(
     llvm::cl::desc("Enable the partitioning abstract domain"),
     llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< bool > EnableFusedScalarDomain(
+    "enable-fused-scalar-domain",
+    llvm::cl::desc("Use a single map of per-variable records for the "
+                   "uninitialized, nullity and points-to information"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< int > MaxCellsPerLocation(
+    "max-cells-per-location",
+    llvm::cl::desc("Maximum number of memory cells per memory location, past "
+                   "which the cells are summarized"),
+    llvm::cl::init(-1),
+    llvm::cl::value_desc("int"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< bool > EnableDomainPrepass(
+    "enable-domain-prepass",
+    llvm::cl::desc("Analyze functions with intervals first, and only use the "
+                   "numerical domain on functions with cycles or unproven "
+                   "checks (intraprocedural only)"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< bool > EnableSparseInvariants(
+    "enable-sparse-invariants",
+    llvm::cl::desc("Only keep invariants at cycle heads, and recompute the "
+                   "others when checking (sequential analysis only)"),
+    llvm::cl::cat(AnalysisCategory));
+
 static llvm::cl::opt< bool > NoFixpointCache(
     "no-fixpoint-cache",
     llvm::cl::desc("Disable the cache of fixpoints"),
     llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< std::string > SummaryStorePath(
+    "summary-store",
+    llvm::cl::desc("Load and save function summaries in the given file, to "
+                   "reuse them across runs (interprocedural only)"),
+    llvm::cl::value_desc("file"),
+    llvm::cl::cat(AnalysisCategory));
+
 static llvm::cl::opt< bool > NoChecks("no-checks",
                                       llvm::cl::desc("Disable all the checks"),
                                       llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< int > MemBudget(
+    "mem-budget",
+    llvm::cl::desc("Memory budget of the value analysis, in megabytes"),
+    llvm::cl::init(-1),
+    llvm::cl::value_desc("int"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< int > FunctionTimeBudget(
+    "function-time-budget",
+    llvm::cl::desc("Time budget of the analysis of a function, in seconds"),
+    llvm::cl::init(-1),
+    llvm::cl::value_desc("int"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< int > ContextDepth(
+    "context-depth",
+    llvm::cl::desc("Maximum depth of fully inlined call contexts, deeper "
+                   "calls are analyzed in a merged context per callee"),
+    llvm::cl::init(-1),
+    llvm::cl::value_desc("int"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::list< std::string > ContextDepthFunctions(
+    "context-depth-functions",
+    llvm::cl::desc("Maximum depth of fully inlined call contexts for specific "
+                   "callees"),
+    llvm::cl::CommaSeparated,
+    llvm::cl::value_desc("function:int"),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< int > CalleeContextsLimit(
+    "callee-contexts-limit",
+    llvm::cl::desc("Maximum number of fully inlined call contexts per callee"),
+    llvm::cl::init(-1),
+    llvm::cl::value_desc("int"),
+    llvm::cl::cat(AnalysisCategory));
+
 static llvm::cl::opt< analyzer::GlobalsInitPolicy > GlobalsInitPolicy(
     "globals-init",
     llvm::cl::desc("Policy of initialization for global variables"),
@@ -458,6 +547,12 @@ static llvm::cl::opt< analyzer::GlobalsInitPolicy > GlobalsInitPolicy(
     llvm::cl::init(analyzer::GlobalsInitPolicy::SkipBigArrays),
     llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< bool > PruneGlobalsInit(
+    "prune-globals-init",
+    llvm::cl::desc("Only initialize the global variables accessible from the "
+                   "analyzed code"),
+    llvm::cl::cat(AnalysisCategory));
+
 static llvm::cl::list< std::string > HardwareAddresses(
     "hardware-addresses",
     llvm::cl::desc(
@@ -508,6 +603,12 @@ static llvm::cl::opt< bool > AllowDebugInfoMismatch(
     llvm::cl::desc("Allow incorrect debug information in the module"),
     llvm::cl::cat(ImportCategory));
 
+static llvm::cl::opt< bool > NoPruneUnreachable(
+    "no-prune-unreachable",
+    llvm::cl::desc(
+        "Do not skip the functions unreachable from the entry points"),
+    llvm::cl::cat(ImportCategory));
+
 /// @}
 /// \name Passes options
 /// @{
@@ -561,6 +662,12 @@ static llvm::cl::opt< bool > DisplayLiveness(
     llvm::cl::desc("Display liveness analysis results"),
     llvm::cl::cat(DebugCategory));
 
+static llvm::cl::opt< bool > CheckLiveness(
+    "check-liveness",
+    llvm::cl::desc("Check liveness analysis results against a slow reference "
+                   "solver"),
+    llvm::cl::cat(DebugCategory));
+
 static llvm::cl::opt< bool > DisplayFunctionPointer(
     "display-function-pointer",
     llvm::cl::desc("Display function pointer analysis results"),
@@ -576,6 +683,11 @@ static llvm::cl::opt< bool > DisplayFixpointParameters(
     llvm::cl::desc("Display fixpoint parameters"),
     llvm::cl::cat(DebugCategory));
 
+static llvm::cl::opt< bool > Profile(
+    "profile",
+    llvm::cl::desc("Profile the hot paths of the value analysis"),
+    llvm::cl::cat(DebugCategory));
+
 static llvm::cl::opt< bool > DisplayAR(
     "display-ar",
     llvm::cl::desc("Display the Abstract Representation as text"),
@@ -720,6 +832,30 @@ static std::vector< ar::Function* > parse_function_names(
   return functions;
 }
 
+/// \brief Find the LLVM functions of the entry points
+///
+/// Returns false if the entry points cannot be resolved, either because of
+/// the wildcard or because a function is missing. Errors are reported later,
+/// when the entry points are resolved in AR.
+static bool find_entry_points(llvm::Module& module,
+                              std::vector< llvm::Function* >& functions) {
+  for (std::string name : EntryPoints) {
+    boost::trim(name);
+    if (name == "*") {
+      return false;
+    }
+
+    llvm::Function* fun = module.getFunction(name);
+    if (fun == nullptr || fun->isDeclaration()) {
+      return false;
+    }
+
+    functions.push_back(fun);
+  }
+
+  return true;
+}
+
 /// \brief Interpret an unsigned integer value in the string `str`
 static unsigned stou(const std::string& str,
                      size_t* pos = nullptr,
@@ -805,10 +941,36 @@ static analyzer::AnalysisOptions make_analysis_options(ar::Bundle* bundle) {
       .use_pointer = !NoPointer,
       .use_widening_hints = !NoWideningHints,
       .use_partitioning_domain = EnablePartitioningDomain,
+      .use_fused_scalar_domain = EnableFusedScalarDomain,
+      .max_cells_per_location =
+          ((MaxCellsPerLocation > 0)
+               ? boost::optional< unsigned >(MaxCellsPerLocation)
+               : boost::none),
+      .use_domain_prepass = EnableDomainPrepass,
+      .use_sparse_invariants = EnableSparseInvariants,
       .use_fixpoint_cache = !NoFixpointCache,
       .use_checks = !NoChecks,
+      .mem_budget = ((MemBudget >= 0)
+                         ? boost::optional< unsigned >(MemBudget)
+                         : boost::none),
+      .function_time_budget =
+          ((FunctionTimeBudget >= 0)
+               ? boost::optional< unsigned >(FunctionTimeBudget)
+               : boost::none),
+      .context_depth = ((ContextDepth >= 0)
+                            ? boost::optional< unsigned >(ContextDepth)
+                            : boost::none),
+      .context_depth_functions =
+          parse_function_names_to_unsigned(ContextDepthFunctions, bundle),
+      .callee_contexts_limit =
+          ((CalleeContextsLimit >= 0)
+               ? boost::optional< unsigned >(CalleeContextsLimit)
+               : boost::none),
       .globals_init_policy = GlobalsInitPolicy,
-      .progress = Progress,
+      .use_prune_globals_init = PruneGlobalsInit,
+      // Progress loggers of concurrent bundles would overwrite each other
+      .progress = ((InputFilenames.size() > 1) ? analyzer::ProgressOption::None
+                                               : Progress.getValue()),
       .display_invariants = DisplayInvariants,
       .display_checks = DisplayChecks,
       .hardware_addresses = {bundle, HardwareAddresses, HardwareAddressesFile},
@@ -857,6 +1019,497 @@ static void generate_dot(ar::Bundle* bundle,
   }
 }
 
+/// \brief Return the number of threads for the AR passes and verifiers
+///
+/// 0 means one thread per hardware thread.
+static std::size_t num_pass_threads() {
+  return Jobs > 0 ? static_cast< std::size_t >(Jobs) : 0;
+}
+
+/// \brief Load an input bitcode file and translate it into AR
+///
+/// This also runs the verifiers and the AR passes. It is not thread-safe, since
+/// it creates types and constants in the AR context.
+///
+/// The AR keeps pointers on the LLVM module, used to write the source locations
+/// in the output database. The caller must keep the module alive until the
+/// analysis and the database output are done.
+///
+/// \returns 0 on success, otherwise the exit code of the error
+static int load_bundle(const std::string& progname,
+                       const std::string& input_filename,
+                       llvm::LLVMContext& llvm_context,
+                       ar::Context& ar_context,
+                       analyzer::OutputDatabase& output_db,
+                       std::unique_ptr< llvm::Module >& module,
+                       ar::Bundle*& bundle) {
+  // Load the input module
+  {
+    analyzer::log::debug("Loading LLVM bitcode");
+    analyzer::ScopeTimerDatabase t(output_db.times, "ikos-analyzer.load-bc");
+    llvm::SMDiagnostic err; // Error diagnostic
+    module = llvm::parseIRFile(input_filename, err, llvm_context);
+    if (!module) {
+      err.print(progname.c_str(), llvm::errs());
+      return 2;
+    }
+  }
+
+  // Immediately run the verifier to catch any problems
+  if (!NoVerify) {
+    analyzer::log::debug("Verifying integrity of LLVM bitcode");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.verify-bc");
+    if (verifyModule(*module, &llvm::errs())) {
+      llvm::errs() << progname << ": " << input_filename
+                   << ": error: input module is broken!\n";
+      return 3;
+    }
+  }
+
+  // Check for debug information in LLVM
+  {
+    analyzer::log::debug("Checking for debug information");
+    if (!llvm_to_ar::has_debug_info(*module)) {
+      llvm::errs() << progname << ": " << input_filename
+                   << ": error: llvm bitcode has no debug information\n";
+      return 4;
+    }
+  }
+
+  // Remove the functions unreachable from the entry points
+  //
+  // The interprocedural analysis never analyzes them, so skip them before the
+  // translation, the AR passes and the pre-analyses.
+  std::vector< llvm::Function* > entry_points;
+  if (Procedural == analyzer::Procedural::Interprocedural &&
+      !NoPruneUnreachable && find_entry_points(*module, entry_points)) {
+    analyzer::log::debug("Removing functions unreachable from entry points");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.prune-unreachable");
+    std::size_t num_removed =
+        llvm_to_ar::remove_unreachable_functions(*module, entry_points);
+    analyzer::log::info("Skipping " + std::to_string(num_removed) +
+                        " functions unreachable from the entry points");
+    output_db.settings.insert("unreachable-functions",
+                              std::to_string(num_removed));
+  }
+
+  // Translate LLVM bitcode into AR
+  // This might throw ImportError
+  {
+    analyzer::log::info("Translating LLVM bitcode to AR");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.llvm-to-ar");
+    llvm_to_ar::Importer importer(ar_context);
+    bundle = importer.import(*module, make_import_options());
+  }
+
+  // Run type checker
+  if (!NoTypeCheck) {
+    analyzer::log::debug("Running type verifier on AR");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.type-checker");
+    if (!ar::TypeVerifier(/*all = */ true, num_pass_threads())
+             .verify(bundle, std::cerr)) {
+      llvm::errs() << progname << ": " << input_filename
+                   << ": error: type checker\n";
+      return 7;
+    }
+  }
+
+  // Check for debug information in AR
+  if (!ar::FrontendVerifier(/*all = */ true).verify(bundle, std::cerr)) {
+    return 8;
+  }
+
+  // Simplify the control flow graph
+  if (!NoSimplifyCFG) {
+    analyzer::log::debug("Running simplify-cfg pass on AR");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.simplify-cfg");
+    ar::SimplifyCFGPass pass;
+    pass.set_num_threads(num_pass_threads());
+    pass.run(bundle);
+  }
+
+  // Add a loop counter in each cycle, for the Gauge domain
+  if (AddLoopCounters) {
+    analyzer::log::debug("Running add-loop-counters pass on AR");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.add-loop-counters");
+    ar::AddLoopCountersPass pass;
+    pass.set_num_threads(num_pass_threads());
+    pass.run(bundle);
+  }
+
+  // Add partitioning variable annotations, for the Partitioning domain
+  if (AddPartitioningVariables) {
+    analyzer::log::debug("Running add-partitioning-variables pass on AR");
+    analyzer::ScopeTimerDatabase
+        t(output_db.times, "ikos-analyzer.add-partitioning-variables");
+    ar::AddPartitioningVariablesPass().run(bundle);
+  }
+
+  // Simplify upcast comparison loop
+  if (!NoSimplifyUpcastComparison) {
+    analyzer::log::debug("Running simplify-upcast-comparison pass on AR");
+    analyzer::ScopeTimerDatabase
+        t(output_db.times, "ikos-analyzer.simplify-upcast-comparison");
+    ar::SimplifyUpcastComparisonPass pass;
+    pass.set_num_threads(num_pass_threads());
+    pass.run(bundle);
+  }
+
+  // Name variables and basic block, for debugging purpose only
+  if (NameValues) {
+    analyzer::log::debug("Running name-values pass on AR");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.name-values");
+    ar::NameValuesPass pass(!NoNamePrefix);
+    pass.set_num_threads(num_pass_threads());
+    pass.run(bundle);
+  }
+
+  // Display the abstract representation
+  if (DisplayAR) {
+    analyzer::log::info("Printing Abstract Representation");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.display-ar");
+    ar::TextFormatter formatter(make_format_options());
+    formatter.format(analyzer::log::msg().stream(), bundle);
+  }
+
+  // Generate .dot files
+  if (GenerateDot) {
+    analyzer::log::info("Generating .dot files");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.generate-dot");
+    generate_dot(bundle, GenerateDotDirectory.getValue());
+  }
+
+  return 0;
+}
+
+/// \brief Run the analyses on a bundle and save the results in the database
+///
+/// \param bundle The bundle
+/// \param output_db The output database
+/// \param concurrent True to use the concurrent value analysis
+/// \param summary_store The persistent store of function summaries, or null
+static void analyze_bundle(ar::Bundle* bundle,
+                           analyzer::OutputDatabase& output_db,
+                           bool concurrent,
+                           analyzer::SummaryStore* summary_store) {
+  // Save analysis options in the database
+  analyzer::AnalysisOptions opts = make_analysis_options(bundle);
+  opts.save(output_db.settings);
+
+  // Initialize factories
+  analyzer::MemoryFactory mem_factory;
+  analyzer::VariableFactory var_factory(bundle);
+  analyzer::LiteralFactory lit_factory(var_factory, bundle->data_layout());
+  analyzer::CompiledBlockFactory
+      block_factory(lit_factory, /* int_runs = */ !NoCompiledBlocks);
+  analyzer::CallContextFactory call_context_factory(opts);
+
+  // Fixpoint parameters
+  analyzer::FixpointParameters fixpoint_parameters(opts);
+
+  // Analysis context
+  analyzer::Context ctx(bundle,
+                        opts,
+                        boost::filesystem::current_path(),
+                        output_db,
+                        mem_factory,
+                        var_factory,
+                        lit_factory,
+                        block_factory,
+                        call_context_factory,
+                        fixpoint_parameters);
+
+  // Run a liveness analysis
+  //
+  // The goal is to detect unused variables to speed up the following
+  // analyses
+  analyzer::LivenessAnalysis liveness(ctx);
+  if (!NoLiveness) {
+    analyzer::log::info("Running liveness analysis");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.liveness-analysis");
+    liveness.run();
+    ctx.liveness = &liveness;
+  }
+  if (DisplayLiveness) {
+    liveness.dump(analyzer::log::msg().stream());
+  }
+  if (CheckLiveness && !NoLiveness) {
+    analyzer::log::info("Checking liveness analysis results");
+    output_db.settings.insert("liveness-mismatches",
+                              std::to_string(liveness.check()));
+  }
+
+  // Run a widening hint analysis
+  //
+  // This is used to detect widening hints, useful for other analyses
+  if (!NoWideningHints) {
+    analyzer::WideningHintAnalysis widening_hint(ctx);
+    analyzer::log::info("Running widening hint analysis");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.widening-hint-analysis");
+    widening_hint.run();
+  }
+  if (DisplayFixpointParameters) {
+    fixpoint_parameters.dump(analyzer::log::msg().stream());
+  }
+
+  // Run a fast intraprocedural function pointer analysis
+  //
+  // The goal here is to get all function pointers so that we can analyse
+  // precisely indirect calls in the following analyses
+  analyzer::FunctionPointerAnalysis function_pointer(ctx);
+  if (Procedural == analyzer::Procedural::Intraprocedural && !NoPointer) {
+    analyzer::log::info("Running function pointer analysis");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.function-pointer-analysis");
+    function_pointer.run();
+    ctx.function_pointer = &function_pointer;
+  }
+  if (DisplayFunctionPointer) {
+    function_pointer.dump(analyzer::log::msg().stream());
+  }
+
+  // Run a deep (still intraprocedural) pointer analysis
+  //
+  // That step uses the result of the previous function pointer analysis.
+  analyzer::PointerAnalysis pointer(ctx, function_pointer);
+  if (Procedural == analyzer::Procedural::Intraprocedural && !NoPointer) {
+    analyzer::log::info("Running pointer analysis");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.pointer-analysis");
+    pointer.run();
+    ctx.pointer = &pointer;
+  }
+  if (DisplayPointer) {
+    pointer.dump(analyzer::log::msg().stream());
+  }
+
+  // Profile the value analysis, if requested
+  analyzer::Profiler profiler;
+  if (Profile) {
+    ctx.profiler = &profiler;
+  }
+
+  // Bound the number of cells per memory location, if requested
+  ikos::core::memory::CellSummarization cell_summarization(
+      opts.max_cells_per_location ? *opts.max_cells_per_location : 0);
+  if (opts.max_cells_per_location) {
+    ctx.cell_summarization = &cell_summarization;
+  }
+
+  // Apply and export function summaries, if requested
+  ctx.summary_store = summary_store;
+
+  // Final step, run a value analysis, and check properties on the results
+  if (Procedural == analyzer::Procedural::Interprocedural) {
+    analyzer::log::info("Running interprocedural value analysis");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.value-analysis");
+    if (!concurrent) {
+      analyzer::value::interprocedural::sequential::Analysis(ctx).run();
+    } else {
+      analyzer::value::interprocedural::concurrent::Analysis(ctx).run();
+    }
+  } else if (Procedural == analyzer::Procedural::Intraprocedural) {
+    analyzer::log::info("Running intraprocedural value analysis");
+    analyzer::ScopeTimerDatabase t(output_db.times,
+                                   "ikos-analyzer.value-analysis");
+    if (!concurrent) {
+      analyzer::value::intraprocedural::sequential::Analysis(ctx).run();
+    } else {
+      analyzer::value::intraprocedural::concurrent::Analysis(ctx).run();
+    }
+  } else {
+    ikos_unreachable("unreachable");
+  }
+
+  if (Profile) {
+    analyzer::log::info("Saving profile");
+    profiler.save(output_db);
+  }
+
+  if (opts.max_cells_per_location) {
+    analyzer::log::info(
+        "Summarized memory locations with too many cells " +
+        std::to_string(cell_summarization.num_summarizations()) + " times");
+    output_db.settings.insert("summarized-locations",
+                              std::to_string(
+                                  cell_summarization.num_summarizations()));
+  }
+
+  if (summary_store != nullptr) {
+    output_db.settings.insert("summary-hits",
+                              std::to_string(summary_store->num_hits()));
+  }
+}
+
+/// \brief Create the persistent store of function summaries, if requested
+static std::unique_ptr< analyzer::SummaryStore > make_summary_store() {
+  if (SummaryStorePath.empty()) {
+    return nullptr;
+  }
+
+  analyzer::log::info("Loading function summaries");
+  auto store = std::make_unique< analyzer::SummaryStore >(
+      boost::filesystem::path(SummaryStorePath.getValue()));
+  store->load();
+  return store;
+}
+
+/// \brief Save the persistent store of function summaries
+static void save_summary_store(analyzer::SummaryStore& store) {
+  analyzer::log::info("Saving function summaries");
+  store.save();
+  analyzer::log::info("Applied " + std::to_string(store.num_hits()) +
+                      " function summaries, exported " +
+                      std::to_string(store.num_insertions()) +
+                      " new function summaries");
+}
+
+/// \brief Print the exception being handled and return the exit code
+static int handle_exception(const std::string& progname,
+                            const std::string& input_filename,
+                            const std::string& output_filename) {
+  try {
+    throw;
+  } catch (analyzer::sqlite::DbError& err) {
+    llvm::errs() << progname << ": " << output_filename
+                 << ": error: " << err.what() << "\n";
+    return 1;
+  } catch (llvm_to_ar::ImportError& err) {
+    llvm::errs() << progname << ": " << input_filename
+                 << ": error: " << err.what() << "\n";
+    return 5;
+  } catch (std::exception& err) {
+    // catch any std::exception, core::Exception or analyzer::Exception
+    llvm::errs() << progname << ": " << input_filename
+                 << ": error: " << err.what() << "\n";
+    return 9;
+  }
+}
+
+/// \brief Create an output database
+static std::unique_ptr< analyzer::sqlite::DbConnection > make_database(
+    const std::string& output_filename) {
+  analyzer::log::debug("Creating output database '" + output_filename + "'");
+  auto db = std::make_unique< analyzer::sqlite::DbConnection >(output_filename);
+  db->set_journal_mode(analyzer::sqlite::JournalMode::Off);
+  db->set_synchronous_flag(analyzer::sqlite::SynchronousFlag::Off);
+  return db;
+}
+
+/// \brief Analysis of one input file, when analyzing several input files
+struct BundleJob {
+  /// \brief Input bitcode filename
+  std::string input_filename;
+
+  /// \brief Output database filename
+  std::string output_filename;
+
+  /// \brief Output database connection
+  std::unique_ptr< analyzer::sqlite::DbConnection > db;
+
+  /// \brief Output database
+  std::unique_ptr< analyzer::OutputDatabase > output_db;
+
+  /// \brief LLVM module, referenced by the bundle
+  std::unique_ptr< llvm::Module > module;
+
+  /// \brief Translated bundle, or null
+  ar::Bundle* bundle = nullptr;
+
+  /// \brief Exit code
+  int status = 0;
+};
+
+/// \brief Analyze several input files in one process
+///
+/// All the input files are translated into the same AR context, sharing types
+/// and constants. The translation is sequential, then the bundles are analyzed
+/// in parallel, each one with the sequential value analysis and its own output
+/// database.
+///
+/// \returns the exit code of the first input file that failed, or 0
+static int analyze_bundles(const std::string& progname,
+                           const std::vector< std::string >& output_filenames,
+                           llvm::LLVMContext& llvm_context) {
+  // AR context, shared by all the bundles
+  ar::Context ar_context;
+
+  std::vector< BundleJob > jobs(InputFilenames.size());
+
+  // Translate each input file into AR
+  for (std::size_t i = 0; i < jobs.size(); i++) {
+    BundleJob& job = jobs[i];
+    job.input_filename = InputFilenames[i];
+    job.output_filename = output_filenames[i];
+
+    try {
+      // This might throw DbError or ImportError
+      job.db = make_database(job.output_filename);
+      job.output_db = std::make_unique< analyzer::OutputDatabase >(*job.db);
+      job.status = load_bundle(progname,
+                               job.input_filename,
+                               llvm_context,
+                               ar_context,
+                               *job.output_db,
+                               job.module,
+                               job.bundle);
+    } catch (...) {
+      job.status =
+          handle_exception(progname, job.input_filename, job.output_filename);
+    }
+  }
+
+  // Function summaries, shared by all the bundles
+  std::unique_ptr< analyzer::SummaryStore > summary_store =
+      make_summary_store();
+
+  // Analyze the bundles in parallel
+  tbb::parallel_for(std::size_t(0), jobs.size(), [&](std::size_t i) {
+    BundleJob& job = jobs[i];
+    if (job.status != 0) {
+      return;
+    }
+
+    // Bundles are analyzed concurrently, each one logs with its own logger
+    analyzer::TerminalLogger logger(std::cout);
+    analyzer::ThreadScopeLogger scope(logger);
+
+    try {
+      analyzer::log::info("Analyzing '" + job.input_filename + "'");
+      analyze_bundle(job.bundle,
+                     *job.output_db,
+                     /* concurrent = */ false,
+                     summary_store.get());
+    } catch (...) {
+      job.status =
+          handle_exception(progname, job.input_filename, job.output_filename);
+    }
+  });
+
+  if (summary_store != nullptr) {
+    save_summary_store(*summary_store);
+  }
+
+  for (const BundleJob& job : jobs) {
+    if (job.status != 0) {
+      return job.status;
+    }
+  }
+  return 0;
+}
+
 /// \brief Main for ikos-analyzer
 int main(int argc, char** argv) {
   llvm::InitLLVM x(argc, argv);
@@ -884,258 +1537,70 @@ int main(int argc, char** argv) {
   // Enable colors, if asked
   analyzer::color::Enable = colors_enabled();
 
+  // Account for the memory of abstract values, for the memory budget
+  if (MemBudget >= 0) {
+    ikos::core::MemoryUsage::enable();
+  }
+
+  // Initialize the task scheduler, shared by all the parallel analyses
+  tbb::task_scheduler_init init(Jobs > 0 ? Jobs
+                                         : tbb::task_scheduler_init::automatic);
+
+  // Output database filenames
+  std::vector< std::string > output_filenames(OutputFilenames.begin(),
+                                              OutputFilenames.end());
+  if (output_filenames.empty() && InputFilenames.size() == 1) {
+    output_filenames.emplace_back("output.db");
+  }
+  if (output_filenames.size() != InputFilenames.size()) {
+    llvm::errs() << progname
+                 << ": error: expected one output database per input file\n";
+    return 1;
+  }
+
+  if (InputFilenames.size() > 1) {
+    return analyze_bundles(progname, output_filenames, llvm_context);
+  }
+
+  const std::string& input_filename = InputFilenames.front();
+  const std::string& output_filename = output_filenames.front();
+
   try {
     // Initialize output database
     // This might throw DbError, see catch()
-    analyzer::log::debug("Creating output database '" + OutputFilename + "'");
-    analyzer::sqlite::DbConnection db(OutputFilename);
-    db.set_journal_mode(analyzer::sqlite::JournalMode::Off);
-    db.set_synchronous_flag(analyzer::sqlite::SynchronousFlag::Off);
-    analyzer::OutputDatabase output_db(db);
-
-    // Load the input module
-    std::unique_ptr< llvm::Module > module = nullptr;
-    {
-      analyzer::log::debug("Loading LLVM bitcode");
-      analyzer::ScopeTimerDatabase t(output_db.times, "ikos-analyzer.load-bc");
-      llvm::SMDiagnostic err; // Error diagnostic
-      module = llvm::parseIRFile(InputFilename, err, llvm_context);
-      if (!module) {
-        err.print(progname.c_str(), llvm::errs());
-        return 2;
-      }
-    }
-
-    // Immediately run the verifier to catch any problems
-    if (!NoVerify) {
-      analyzer::log::debug("Verifying integrity of LLVM bitcode");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.verify-bc");
-      if (verifyModule(*module, &llvm::errs())) {
-        llvm::errs() << progname << ": " << InputFilename
-                     << ": error: input module is broken!\n";
-        return 3;
-      }
-    }
-
-    // Check for debug information in LLVM
-    {
-      analyzer::log::debug("Checking for debug information");
-      if (!llvm_to_ar::has_debug_info(*module)) {
-        llvm::errs() << progname << ": " << InputFilename
-                     << ": error: llvm bitcode has no debug information\n";
-        return 4;
-      }
-    }
+    std::unique_ptr< analyzer::sqlite::DbConnection > db =
+        make_database(output_filename);
+    analyzer::OutputDatabase output_db(*db);
 
     // AR context
     ar::Context ar_context;
 
     // Translate LLVM bitcode into AR
     // This might throw ImportError, see catch()
+    std::unique_ptr< llvm::Module > module;
     ar::Bundle* bundle = nullptr;
-    {
-      analyzer::log::info("Translating LLVM bitcode to AR");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.llvm-to-ar");
-      llvm_to_ar::Importer importer(ar_context);
-      bundle = importer.import(*module, make_import_options());
-    }
-
-    // Run type checker
-    if (!NoTypeCheck) {
-      analyzer::log::debug("Running type verifier on AR");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.type-checker");
-      if (!ar::TypeVerifier(/*all = */ true).verify(bundle, std::cerr)) {
-        llvm::errs() << progname << ": " << InputFilename
-                     << ": error: type checker\n";
-        return 7;
-      }
-    }
-
-    // Check for debug information in AR
-    if (!ar::FrontendVerifier(/*all = */ true).verify(bundle, std::cerr)) {
-      return 8;
-    }
-
-    // Simplify the control flow graph
-    if (!NoSimplifyCFG) {
-      analyzer::log::debug("Running simplify-cfg pass on AR");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.simplify-cfg");
-      ar::SimplifyCFGPass().run(bundle);
-    }
-
-    // Add a loop counter in each cycle, for the Gauge domain
-    if (AddLoopCounters) {
-      analyzer::log::debug("Running add-loop-counters pass on AR");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.add-loop-counters");
-      ar::AddLoopCountersPass().run(bundle);
-    }
-
-    // Add partitioning variable annotations, for the Partitioning domain
-    if (AddPartitioningVariables) {
-      analyzer::log::debug("Running add-partitioning-variables pass on AR");
-      analyzer::ScopeTimerDatabase
-          t(output_db.times, "ikos-analyzer.add-partitioning-variables");
-      ar::AddPartitioningVariablesPass().run(bundle);
-    }
-
-    // Simplify upcast comparison loop
-    if (!NoSimplifyUpcastComparison) {
-      analyzer::log::debug("Running simplify-upcast-comparison pass on AR");
-      analyzer::ScopeTimerDatabase
-          t(output_db.times, "ikos-analyzer.simplify-upcast-comparison");
-      ar::SimplifyUpcastComparisonPass().run(bundle);
+    int status = load_bundle(progname,
+                             input_filename,
+                             llvm_context,
+                             ar_context,
+                             output_db,
+                             module,
+                             bundle);
+    if (status != 0) {
+      return status;
     }
 
-    // Name variables and basic block, for debugging purpose only
-    if (NameValues) {
-      analyzer::log::debug("Running name-values pass on AR");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.name-values");
-      ar::NameValuesPass(!NoNamePrefix).run(bundle);
-    }
-
-    // Display the abstract representation
-    if (DisplayAR) {
-      analyzer::log::info("Printing Abstract Representation");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.display-ar");
-      ar::TextFormatter formatter(make_format_options());
-      formatter.format(analyzer::log::msg().stream(), bundle);
-    }
-
-    // Generate .dot files
-    if (GenerateDot) {
-      analyzer::log::info("Generating .dot files");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.generate-dot");
-      generate_dot(bundle, GenerateDotDirectory.getValue());
-    }
-
-    // Save analysis options in the database
-    analyzer::AnalysisOptions opts = make_analysis_options(bundle);
-    opts.save(output_db.settings);
-
-    // Initialize factories
-    analyzer::MemoryFactory mem_factory;
-    analyzer::VariableFactory var_factory(bundle);
-    analyzer::LiteralFactory lit_factory(var_factory, bundle->data_layout());
-    analyzer::CallContextFactory call_context_factory;
-
-    // Fixpoint parameters
-    analyzer::FixpointParameters fixpoint_parameters(opts);
-
-    // Analysis context
-    analyzer::Context ctx(bundle,
-                          opts,
-                          boost::filesystem::current_path(),
-                          output_db,
-                          mem_factory,
-                          var_factory,
-                          lit_factory,
-                          call_context_factory,
-                          fixpoint_parameters);
-
-    // Run a liveness analysis
-    //
-    // The goal is to detect unused variables to speed up the following
-    // analyses
-    analyzer::LivenessAnalysis liveness(ctx);
-    if (!NoLiveness) {
-      analyzer::log::info("Running liveness analysis");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.liveness-analysis");
-      liveness.run();
-      ctx.liveness = &liveness;
-    }
-    if (DisplayLiveness) {
-      liveness.dump(analyzer::log::msg().stream());
-    }
-
-    // Run a widening hint analysis
-    //
-    // This is used to detect widening hints, useful for other analyses
-    if (!NoWideningHints) {
-      analyzer::WideningHintAnalysis widening_hint(ctx);
-      analyzer::log::info("Running widening hint analysis");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.widening-hint-analysis");
-      widening_hint.run();
-    }
-    if (DisplayFixpointParameters) {
-      fixpoint_parameters.dump(analyzer::log::msg().stream());
-    }
-
-    // Run a fast intraprocedural function pointer analysis
-    //
-    // The goal here is to get all function pointers so that we can analyse
-    // precisely indirect calls in the following analyses
-    analyzer::FunctionPointerAnalysis function_pointer(ctx);
-    if (Procedural == analyzer::Procedural::Intraprocedural && !NoPointer) {
-      analyzer::log::info("Running function pointer analysis");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.function-pointer-analysis");
-      function_pointer.run();
-      ctx.function_pointer = &function_pointer;
-    }
-    if (DisplayFunctionPointer) {
-      function_pointer.dump(analyzer::log::msg().stream());
-    }
-
-    // Run a deep (still intraprocedural) pointer analysis
-    //
-    // That step uses the result of the previous function pointer analysis.
-    analyzer::PointerAnalysis pointer(ctx, function_pointer);
-    if (Procedural == analyzer::Procedural::Intraprocedural && !NoPointer) {
-      analyzer::log::info("Running pointer analysis");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.pointer-analysis");
-      pointer.run();
-      ctx.pointer = &pointer;
-    }
-    if (DisplayPointer) {
-      pointer.dump(analyzer::log::msg().stream());
-    }
-
-    // Final step, run a value analysis, and check properties on the results
-    if (Procedural == analyzer::Procedural::Interprocedural) {
-      analyzer::log::info("Running interprocedural value analysis");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.value-analysis");
-      if (Jobs == 1) {
-        analyzer::value::interprocedural::sequential::Analysis(ctx).run();
-      } else {
-        analyzer::value::interprocedural::concurrent::Analysis(ctx).run();
-      }
-    } else if (Procedural == analyzer::Procedural::Intraprocedural) {
-      analyzer::log::info("Running intraprocedural value analysis");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.value-analysis");
-      if (Jobs == 1) {
-        analyzer::value::intraprocedural::sequential::Analysis(ctx).run();
-      } else {
-        analyzer::value::intraprocedural::concurrent::Analysis(ctx).run();
-      }
-    } else {
-      ikos_unreachable("unreachable");
+    std::unique_ptr< analyzer::SummaryStore > summary_store =
+        make_summary_store();
+    analyze_bundle(bundle,
+                   output_db,
+                   /* concurrent = */ Jobs != 1,
+                   summary_store.get());
+    if (summary_store != nullptr) {
+      save_summary_store(*summary_store);
     }
     return 0;
-  } catch (analyzer::sqlite::DbError& err) {
-    llvm::errs() << progname << ": " << OutputFilename
-                 << ": error: " << err.what() << "\n";
-    return 1;
-  } catch (llvm_to_ar::ImportError& err) {
-    llvm::errs() << progname << ": " << InputFilename
-                 << ": error: " << err.what() << "\n";
-    return 5;
-  } catch (std::exception& err) {
-    // catch any std::exception, core::Exception or analyzer::Exception
-    llvm::errs() << progname << ": " << InputFilename
-                 << ": error: " << err.what() << "\n";
-    return 9;
+  } catch (...) {
+    return handle_exception(progname, input_filename, output_filename);
   }
 }
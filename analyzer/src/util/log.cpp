@@ -42,20 +42,39 @@
  ******************************************************************************/
 
 #include <iostream>
+#include <mutex>
 
 #include <ikos/analyzer/util/log.hpp>
 
 namespace ikos {
 namespace analyzer {
 
+namespace log {
+
+/// \brief Mutex serializing the log messages of all threads
+///
+/// The mutex is held from the creation of a message to its end. It is
+/// recursive since a message can be logged while writing another one.
+static std::recursive_mutex& message_mutex() {
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+/// \brief Logger of the current thread, or null to use the global logger
+static thread_local Logger* ThreadLog = nullptr;
+
+} // end namespace log
+
 // LoggerOutputStream
 
 void LogMessage::start() {
+  log::message_mutex().lock();
   this->_logger->start_message();
 }
 
 void LogMessage::end() {
   this->_logger->end_message();
+  log::message_mutex().unlock();
 }
 
 // TerminalLogger
@@ -86,6 +105,19 @@ ScopeLogger::~ScopeLogger() {
   log::set_logger(this->_previous_logger);
 }
 
+// ThreadScopeLogger
+
+ThreadScopeLogger::ThreadScopeLogger(Logger& logger)
+    : _previous_logger(log::ThreadLog) {
+  log::ThreadLog = &logger;
+  logger.start_logger();
+}
+
+ThreadScopeLogger::~ThreadScopeLogger() {
+  log::ThreadLog->end_logger();
+  log::ThreadLog = this->_previous_logger;
+}
+
 namespace log {
 
 // Default global logging level
@@ -98,13 +130,14 @@ static TerminalLogger DefaultLogger(std::cout);
 static Logger* Log = &DefaultLogger;
 
 void set_logger(Logger& logger) {
-  Log->end_logger();
-  Log = &logger;
-  Log->start_logger();
+  Logger*& current = (ThreadLog != nullptr) ? ThreadLog : Log;
+  current->end_logger();
+  current = &logger;
+  current->start_logger();
 }
 
 Logger& get_logger() {
-  return *Log;
+  return (ThreadLog != nullptr) ? *ThreadLog : *Log;
 }
 
 } // end namespace log
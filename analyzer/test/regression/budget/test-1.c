@@ -0,0 +1,15 @@
+int sum(int* a, int n) {
+  int s = 0;
+  for (int i = 0; i < n; i++) {
+    s += a[i];
+  }
+  return s;
+}
+
+int main() {
+  int a[10];
+  for (int i = 0; i < 10; i++) {
+    a[i] = i;
+  }
+  return sum(a, 10);
+}
@@ -0,0 +1,13 @@
+int g[8];
+
+int main() {
+  g[0] = 0;
+  g[1] = 1;
+  g[2] = 2;
+  g[3] = 3;
+  g[4] = 4;
+  g[5] = 5;
+  g[6] = 6;
+  g[7] = 7;
+  return g[3];
+}
@@ -231,6 +231,19 @@ class Database:
         self.cursor.execute('SELECT checks.status FROM checks INNER JOIN statements ON checks.statement_id = statements.id WHERE statements.line=%d' % line)
         return [row[0] for row in self.cursor.fetchall()]
 
+    def get_degradations(self, resource):
+        self.cursor.execute("SELECT action FROM degradations WHERE resource='%s'" % resource)
+        return [row[0] for row in self.cursor.fetchall()]
+
+    def get_checks(self):
+        self.cursor.execute('SELECT checks.kind, checks.checker, checks.status, statements.line, statements.column FROM checks INNER JOIN statements ON checks.statement_id = statements.id')
+        return sorted(self.cursor.fetchall())
+
+    def get_setting(self, name):
+        self.cursor.execute("SELECT value FROM settings WHERE name='%s'" % name)
+        row = self.cursor.fetchone()
+        return row[0] if row else None
+
 
 class TestResult:
     def __init__(self, code, comments=None):
@@ -254,7 +267,11 @@ class Test:
                  entry_points=None,
                  procedural=None,
                  options=None,
-                 line_checks=None):
+                 line_checks=None,
+                 degradations=None,
+                 settings=None,
+                 reference_options=None,
+                 setup_options=None):
         if not isinstance(analyses, list):
             analyses = [analyses]
 
@@ -273,6 +290,26 @@ class Test:
         self.procedural = procedural or 'inter'
         self.options = options or []
         self.line_checks = line_checks or []
+        self.degradations = degradations or []
+        self.settings = settings or []
+        self.reference_options = reference_options
+        self.setup_options = setup_options
+
+    def ikos_analyzer_cmd(self, pp_path, options, output_db):
+        # '{wd}' in an option is replaced by the working directory
+        wd = os.path.dirname(pp_path)
+        cmd = [find_ikos_analyzer(),
+               '-a=%s' % ','.join(self.analyses),
+               '-d=%s' % self.domain,
+               '-entry-points=%s' % ','.join(self.entry_points),
+               '-proc=%s' % self.procedural]
+        cmd.extend(option.format(wd=wd) for option in options)
+        if self.opt_level == 'aggressive':
+            cmd.append('-allow-dbg-mismatch')
+        if 'gauge' in self.domain:
+            cmd.append('-add-loop-counters')
+        cmd += [pp_path, '-o', output_db]
+        return cmd
 
     def run(self, root, output_db):
         fullpath = os.path.join(root, self.filename)
@@ -305,22 +342,30 @@ class Test:
                               stdout=subprocess.PIPE,
                               stderr=subprocess.PIPE)
 
+        # run ikos analyzer with the setup options first, if requested
+        if self.setup_options is not None:
+            setup_db = os.path.join(wd, 'setup.db')
+            subprocess.check_call(self.ikos_analyzer_cmd(pp_path,
+                                                         self.setup_options,
+                                                         setup_db),
+                                  stdout=subprocess.PIPE,
+                                  stderr=subprocess.PIPE)
+
         # run ikos analyzer
-        cmd = [find_ikos_analyzer(),
-               '-a=%s' % ','.join(self.analyses),
-               '-d=%s' % self.domain,
-               '-entry-points=%s' % ','.join(self.entry_points),
-               '-proc=%s' % self.procedural]
-        cmd.extend(self.options)
-        if self.opt_level == 'aggressive':
-            cmd.append('-allow-dbg-mismatch')
-        if 'gauge' in self.domain:
-            cmd.append('-add-loop-counters')
-        cmd += [pp_path, '-o', output_db]
+        cmd = self.ikos_analyzer_cmd(pp_path, self.options, output_db)
         subprocess.check_call(cmd,
                               stdout=subprocess.PIPE,
                               stderr=subprocess.PIPE)
 
+        # run ikos analyzer with the reference options, if requested
+        reference_db = os.path.join(wd, 'reference.db')
+        if self.reference_options is not None:
+            subprocess.check_call(self.ikos_analyzer_cmd(pp_path,
+                                                         self.reference_options,
+                                                         reference_db),
+                                  stdout=subprocess.PIPE,
+                                  stderr=subprocess.PIPE)
+
         with Database(output_db) as db:
             # Get the global result
             errors = db.get_num_checks(Result.ERROR)
@@ -383,6 +428,42 @@ class Test:
                                     '(%s) for line %d and not the expected one (%s).'
                                     % (line_result, line_num, line_expected))
 
+            # Degradations check
+            for resource, action in self.degradations:
+                actions = db.get_degradations(resource)
+
+                if action not in actions:
+                    ret.code = 'FAIL'
+                    ret.add_comment('Got degradations %r for resource "%s", was expecting "%s".'
+                                    % (actions, resource, action))
+
+            # Settings check
+            # The expected value is either a string or a predicate
+            for name, value in self.settings:
+                setting = db.get_setting(name)
+
+                if callable(value):
+                    ok = setting is not None and value(setting)
+                else:
+                    ok = setting == value
+
+                if not ok:
+                    ret.code = 'FAIL'
+                    if callable(value):
+                        ret.add_comment('Got unexpected setting %r for "%s".'
+                                        % (setting, name))
+                    else:
+                        ret.add_comment('Got setting %r for "%s", was expecting %r.'
+                                        % (setting, name, value))
+
+            # Same checks as the reference run
+            if self.reference_options is not None:
+                with Database(reference_db) as reference:
+                    if db.get_checks() != reference.get_checks():
+                        ret.code = 'FAIL'
+                        ret.add_comment('Got different checks with options %r.'
+                                        % self.reference_options)
+
             if ret.code == 'FAIL':
                 ret.comments.insert(0, 'Running %r' % cmd)
 
@@ -0,0 +1,28 @@
+extern void __ikos_assert(int);
+extern int __ikos_nondet_int(void);
+
+// Nested loops, with break and continue
+int main() {
+  int a[10][10];
+  int s = 0;
+
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 10; j++) {
+      if (__ikos_nondet_int()) {
+        continue;
+      }
+      a[i][j] = i + j;
+      s += a[i][j];
+      if (s > 1000) {
+        break;
+      }
+    }
+  }
+
+  int k = 0;
+  while (k < 100) {
+    k++;
+  }
+  __ikos_assert(k == 100);
+  return s;
+}
@@ -0,0 +1,41 @@
+#include <stdlib.h>
+
+extern void __ikos_assert(int);
+extern int __ikos_nondet_int(void);
+
+// Basic blocks that cannot reach the exit block
+static void spin(void) {
+  int x = 0;
+  for (;;) {
+    x++;
+  }
+}
+
+static int checked_sum(int* a, int n) {
+  int s = 0;
+  for (int i = 0; i < n; i++) {
+    if (a[i] < 0) {
+      abort();
+    }
+    if (a[i] > 100) {
+      exit(1);
+    }
+    s += a[i];
+  }
+  return s;
+}
+
+int main() {
+  int a[4] = {1, 2, 3, 4};
+
+  if (__ikos_nondet_int()) {
+    spin();
+  }
+
+  int s = checked_sum(a, 4);
+  if (s < 0) {
+    __builtin_unreachable();
+  }
+  __ikos_assert(s >= 0);
+  return s;
+}
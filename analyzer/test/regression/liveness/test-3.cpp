@@ -0,0 +1,32 @@
+#include <stdexcept>
+
+extern "C" int __ikos_nondet_int(void);
+
+// Calls that may throw are translated into invokes
+static int may_throw(int x) {
+  if (x > 5) {
+    throw std::runtime_error("too big");
+  }
+  return x;
+}
+
+int main() {
+  int s = 0;
+  for (int i = 0; i < 10; i++) {
+    try {
+      s += may_throw(i);
+    } catch (const std::runtime_error&) {
+      s += 1;
+    }
+  }
+
+  try {
+    if (__ikos_nondet_int()) {
+      may_throw(s);
+    }
+  } catch (...) {
+    return 1;
+  }
+
+  return 0;
+}
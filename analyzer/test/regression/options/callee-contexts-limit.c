@@ -0,0 +1,14 @@
+static int get(int* a, int i) {
+  return a[i];
+}
+
+int main() {
+  int a[10];
+  for (int i = 0; i < 10; i++) {
+    a[i] = i;
+  }
+  int x = get(a, 3);
+  int y = get(a, 12);
+  int z = get(a, 5);
+  return x + y + z;
+}
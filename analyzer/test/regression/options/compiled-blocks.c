@@ -0,0 +1,43 @@
+extern void __ikos_assert(int);
+extern int __ikos_nondet_int(void);
+
+// Long runs of integer assignments and binary operations
+static int mix(int x, int y) {
+  int a = x + y;
+  int b = a * 3;
+  int c = b - x;
+  int d = c / 2;
+  int e = d % 7;
+  int f = (e << 2) | 1;
+  int g = f ^ 5;
+  int h = g & 0xff;
+  return h + (a >> 1);
+}
+
+int main() {
+  int a[16];
+  int s = 0;
+  int t = 0;
+
+  for (int i = 0; i < 16; i++) {
+    int j = i * 2;
+    int k = j + 1;
+    int l = k - i;
+    a[i] = l;
+    s = s + l;
+    t = t + 1;
+  }
+  __ikos_assert(t == 16);
+  __ikos_assert(s >= 0);
+
+  int x = __ikos_nondet_int();
+  if (x < 0 || x > 100) {
+    return 0;
+  }
+  int y = x + 10;
+  int z = y - x;
+  __ikos_assert(z == 10);
+
+  int m = mix(x, y);
+  return a[m & 15] + 100 / (z - 9);
+}
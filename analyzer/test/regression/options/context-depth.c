@@ -0,0 +1,21 @@
+static int get(int* a, int i) {
+  return a[i];
+}
+
+static int level2(int* a, int i) {
+  return get(a, i);
+}
+
+static int level1(int* a, int i) {
+  return level2(a, i);
+}
+
+int main() {
+  int a[10];
+  for (int i = 0; i < 10; i++) {
+    a[i] = i;
+  }
+  int x = level1(a, 3);
+  int y = level1(a, 12);
+  return x + y;
+}
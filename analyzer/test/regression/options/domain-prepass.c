@@ -0,0 +1,37 @@
+extern int __ikos_nondet_int(void);
+
+int a[10];
+
+// Proven by the pre-pass
+int straight(void) {
+  a[3] = 1;
+  return 100 / a[3];
+}
+
+// Needs a relation between i and j
+int relational(int i) {
+  int j = i + 1;
+  if (i >= 0 && j < 10) {
+    return a[i];
+  }
+  return 0;
+}
+
+// Has a cycle
+int loop(void) {
+  int s = 0;
+  for (int i = 0; i < 10; i++) {
+    s += a[i];
+  }
+  return s;
+}
+
+// Not proven by any domain
+int unknown(int i) {
+  return a[i];
+}
+
+int main() {
+  int i = __ikos_nondet_int();
+  return straight() + relational(i) + loop() + unknown(i);
+}
@@ -0,0 +1,42 @@
+extern int __ikos_nondet_int(void);
+
+int shared[10];
+int last = 0;
+
+static void fill(int* a, int n, int v) {
+  for (int i = 0; i < n; i++) {
+    a[i] = v;
+  }
+}
+
+static int get(int* a, int i) {
+  return a[i];
+}
+
+void entry_a(void) {
+  fill(shared, 10, 1);
+  last = get(shared, 9);
+}
+
+void entry_b(void) {
+  int x = __ikos_nondet_int();
+  last = get(shared, x);
+}
+
+void entry_c(void) {
+  fill(shared, 5, 2);
+  shared[10] = 2;
+}
+
+int entry_d(int x) {
+  int d = 0;
+  if (x > 0) {
+    return 100 / x;
+  }
+  return 100 / d;
+}
+
+__attribute__((destructor)) static void fini(void) {
+  int y = 10;
+  last = shared[y];
+}
@@ -0,0 +1,48 @@
+extern void __ikos_assert(int);
+
+// 200 integers and 200 arrays with independent initializers
+#define G(n)   \
+  int g##n = n; \
+  int a##n[3] = {n, n + 1, n + 2};
+#define G10(p) \
+  G(p##0)      \
+  G(p##1)      \
+  G(p##2)      \
+  G(p##3)      \
+  G(p##4)      \
+  G(p##5)      \
+  G(p##6)      \
+  G(p##7)      \
+  G(p##8)      \
+  G(p##9)
+#define G100(p) \
+  G10(p##0)     \
+  G10(p##1)     \
+  G10(p##2)     \
+  G10(p##3)     \
+  G10(p##4)     \
+  G10(p##5)     \
+  G10(p##6)     \
+  G10(p##7)     \
+  G10(p##8)     \
+  G10(p##9)
+
+G100(1)
+G100(2)
+
+// Initializers referencing other global variables
+int* p = &a150[2];
+int* q = &g299;
+int** r = &p;
+
+int main() {
+  __ikos_assert(g100 == 100);
+  __ikos_assert(g299 == 299);
+  __ikos_assert(a150[1] == 151);
+  __ikos_assert(*p == 152);
+  __ikos_assert(*q == 299);
+  __ikos_assert(**r == 152);
+  __ikos_assert(a175[g100 - 98] == 177);
+  __ikos_assert(a250[a200[0] - 198] == 252);
+  return 0;
+}
@@ -0,0 +1,41 @@
+extern void __ikos_assert(int);
+
+// Only referenced by the initializer of `table_ptr`
+int table[4] = {1, 2, 3, 4};
+int* table_ptr = table;
+
+// Only referenced by the constructor
+int seed = 7;
+int counter = 0;
+
+// Only referenced by the destructor
+int expected_done = 1;
+int done = 0;
+
+// Only referenced by a function stored in a global function pointer
+int divisor = 5;
+
+static int divide(int x) {
+  return x / divisor;
+}
+
+int (*operation)(int) = divide;
+
+// Not accessible from the analyzed code
+int unused[256] = {1};
+
+__attribute__((constructor)) static void init(void) {
+  counter = seed;
+}
+
+__attribute__((destructor)) static void fini(void) {
+  __ikos_assert(done == expected_done);
+}
+
+int main() {
+  __ikos_assert(counter == 7);
+  __ikos_assert(table_ptr[3] == 4);
+  __ikos_assert(operation(100) == 20);
+  done = 1;
+  return 0;
+}
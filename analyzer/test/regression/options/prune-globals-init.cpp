@@ -0,0 +1,59 @@
+extern "C" void __ikos_assert(int);
+
+namespace {
+
+// Only referenced by the constructor and destructor of `registry`
+int capacity = 8;
+
+class Registry {
+private:
+  int _entries[8];
+  int _size;
+
+public:
+  Registry() : _size(0) {
+    for (int i = 0; i < capacity; i++) {
+      _entries[i] = 0;
+    }
+  }
+
+  void add(int x) {
+    __ikos_assert(_size < capacity);
+    _entries[_size++] = x;
+  }
+
+  int size() const { return _size; }
+
+  ~Registry() { __ikos_assert(_size <= capacity); }
+};
+
+Registry registry;
+
+} // end anonymous namespace
+
+// Only referenced by the virtual table of `Square`
+int scale = 2;
+
+struct Shape {
+  virtual ~Shape() = default;
+  virtual int area() const = 0;
+};
+
+struct Square : Shape {
+  int side;
+
+  explicit Square(int s) : side(s) {}
+
+  int area() const override { return scale * side * side; }
+};
+
+int main() {
+  registry.add(1);
+  registry.add(2);
+  __ikos_assert(registry.size() == 2);
+
+  Square square(3);
+  const Shape& shape = square;
+  __ikos_assert(shape.area() == 18);
+  return 0;
+}
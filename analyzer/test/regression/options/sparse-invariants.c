@@ -0,0 +1,35 @@
+extern int __ikos_nondet_int(void);
+
+static int sum(int* a, int n) {
+  int s = 0;
+  for (int i = 0; i < n; i++) {
+    s += a[i];
+  }
+  return s;
+}
+
+int main() {
+  int a[10];
+  int m[4][5];
+
+  for (int i = 0; i < 10; i++) {
+    a[i] = i;
+  }
+
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 5; j++) {
+      if (__ikos_nondet_int()) {
+        m[i][j] = a[i + j];
+      } else {
+        m[i][j] = 100 / (j + 1);
+      }
+    }
+  }
+
+  int s = sum(a, 10) + sum(m[3], 5);
+  int k = __ikos_nondet_int();
+  if (k >= 0 && k <= 10) {
+    s += a[k];
+  }
+  return s;
+}
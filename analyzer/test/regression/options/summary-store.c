@@ -0,0 +1,30 @@
+extern int __ikos_nondet_int(void);
+
+static int clamp(int x, int lo, int hi) {
+  if (x < lo) {
+    return lo;
+  }
+  if (x > hi) {
+    return hi;
+  }
+  return x;
+}
+
+static int twice(int x) {
+  return 2 * x;
+}
+
+int main() {
+  int a[10];
+  for (int i = 0; i < 10; i++) {
+    a[i] = 0;
+  }
+  int n = twice(5);
+  int k = clamp(__ikos_nondet_int(), 0, 9);
+  a[k] = 1;
+  int t = twice(k);
+  if (t < 10) {
+    a[t] = 2;
+  }
+  return a[n];
+}
@@ -0,0 +1,23 @@
+extern void __ikos_assert(int);
+extern int __ikos_nondet_int(void);
+
+#define R4(x) (x), (x) + 1, (x) + 2, (x) + 3
+#define R16(x) R4(x), R4((x) + 4), R4((x) + 8), R4((x) + 12)
+#define R64(x) R16(x), R16((x) + 16), R16((x) + 32), R16((x) + 48)
+#define R256(x) R64(x), R64((x) + 64), R64((x) + 128), R64((x) + 192)
+#define R1024(x) R256(x), R256((x) + 256), R256((x) + 512), R256((x) + 768)
+
+// More than 1024 elements: the initializer is summarized
+int table[2048] = {R1024(1), R1024(1025)};
+
+int main() {
+  int i = __ikos_nondet_int();
+  if (i >= 0 && i < 2048) {
+    int x = table[i];
+    __ikos_assert(x >= 1 && x <= 2048);
+  }
+
+  int y = table[1500];
+  __ikos_assert(y >= 1);
+  return 0;
+}
@@ -0,0 +1,36 @@
+extern void __ikos_assert(int);
+
+// Only reachable through the initializer of `global_fun`
+int helper(int x) {
+  return x + 1;
+}
+
+int from_global(int x) {
+  return helper(x);
+}
+
+int (*global_fun)(int) = from_global;
+
+// Only reachable through a function pointer constant in `main`
+int from_pointer(int x) {
+  return x + 2;
+}
+
+int apply(int (*f)(int), int x) {
+  return f(x);
+}
+
+// Unreachable from `main`
+int unreachable_1(int x) {
+  return x + 3;
+}
+
+int unreachable_2(int x) {
+  return unreachable_1(x) + global_fun(x);
+}
+
+int main() {
+  __ikos_assert(global_fun(1) == 2);
+  __ikos_assert(apply(from_pointer, 1) == 3);
+  return 0;
+}
@@ -0,0 +1,50 @@
+#include <stdlib.h>
+
+extern int __ikos_nondet_int(void);
+
+struct handler {
+  int id;
+  int (*run)(int*, int);
+};
+
+static int sum(int* a, int n) {
+  int s = 0;
+  for (int i = 0; i < n; i++) {
+    s += a[i];
+  }
+  return s;
+}
+
+static int last(int* a, int n) {
+  return a[n - 1];
+}
+
+struct handler handlers[] = {{0, sum}, {1, last}};
+
+int unused_overflow(int* a) {
+  return a[100];
+}
+
+int unused_division(int x) {
+  return 100 / x;
+}
+
+int main() {
+  int a[10];
+  for (int i = 0; i < 10; i++) {
+    a[i] = i;
+  }
+
+  int k = __ikos_nondet_int();
+  if (k < 0 || k > 1) {
+    return 1;
+  }
+
+  int* p = malloc(sizeof(int) * 4);
+  if (p == NULL) {
+    return 2;
+  }
+  p[0] = handlers[k].run(a, 10);
+  free(p);
+  return 0;
+}
@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <ikos/ar/semantic/bundle.hpp>
 #include <ikos/ar/semantic/code.hpp>
 
@@ -84,11 +86,30 @@ public:
 }; // end class Pass
 
 /// \brief Helper class for passes that work on Codes
+///
+/// Codes can be processed on several threads, see set_num_threads(). In that
+/// case, run_on_code() should only modify the given code, and create types
+/// and constants through the (thread-safe) Context factories.
 class CodePass : public Pass {
+private:
+  /// \brief Number of threads (0 means one per hardware thread)
+  std::size_t _num_threads = 1;
+
 public:
   /// \brief Default constructor
   CodePass() = default;
 
+  /// \brief Set the number of threads used to process the codes
+  ///
+  /// 0 means one thread per hardware thread. The result does not depend on
+  /// the number of threads.
+  void set_num_threads(std::size_t num_threads) {
+    this->_num_threads = num_threads;
+  }
+
+  /// \brief Get the number of threads used to process the codes
+  std::size_t num_threads() const { return this->_num_threads; }
+
   /// \brief Run the pass on the given Bundle
   ///
   /// Returns true if the bundle has been updated
@@ -56,6 +56,7 @@
 #include <ikos/ar/semantic/context.hpp>
 #include <ikos/ar/semantic/function.hpp>
 #include <ikos/ar/semantic/value.hpp>
+#include <ikos/ar/support/arena.hpp>
 #include <ikos/ar/support/assert.hpp>
 #include <ikos/ar/support/iterator.hpp>
 #include <ikos/ar/support/traceable.hpp>
@@ -70,7 +71,7 @@ class Statement;
 /// \brief Basic block
 ///
 /// A basic block is a container of statements that execute sequentially.
-class BasicBlock : public Traceable {
+class BasicBlock : public Traceable, public ArenaAllocated {
 private:
   // List of statements
   std::vector< std::unique_ptr< Statement > > _statements;
@@ -300,8 +301,14 @@ public:
 ///
 /// A code represents the control flow graph of a function or global variable
 /// initializer
+///
+/// Its basic blocks, statements and internal variables are allocated in an
+/// arena owned by the code, see arena().
 class Code : public Traceable {
 private:
+  // Arena of the basic blocks, statements and internal variables
+  Arena* _arena;
+
   // List of basic blocks
   std::vector< std::unique_ptr< BasicBlock > > _blocks;
 
@@ -383,6 +390,14 @@ public:
                                               InternalVariable >());
   }
 
+  /// \brief Return the arena of the basic blocks, statements and internal
+  /// variables
+  ///
+  /// Basic blocks and internal variables are always allocated in it.
+  /// Statements are allocated in it within an Arena::Scope, e.g, during the
+  /// translation of the code or in a pass.
+  Arena& arena() const { return *this->_arena; }
+
   /// \brief Does it have an entry block?
   ///
   /// This should always return true, except if we just created this code and
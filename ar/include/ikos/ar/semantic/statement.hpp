@@ -57,6 +57,7 @@
 #include <ikos/ar/semantic/intrinsic.hpp>
 #include <ikos/ar/semantic/type.hpp>
 #include <ikos/ar/semantic/value.hpp>
+#include <ikos/ar/support/arena.hpp>
 #include <ikos/ar/support/assert.hpp>
 #include <ikos/ar/support/number.hpp>
 #include <ikos/ar/support/traceable.hpp>
@@ -65,7 +66,10 @@ namespace ikos {
 namespace ar {
 
 /// \brief Base class for statements
-class Statement : public Traceable {
+///
+/// Statements created within an Arena::Scope are allocated in the arena of
+/// their code, so that the statements of a basic block are close in memory.
+class Statement : public Traceable, public ArenaAllocated {
 public:
   enum StatementKind {
     AssignmentKind,
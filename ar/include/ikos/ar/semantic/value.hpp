@@ -51,6 +51,7 @@
 #include <ikos/ar/semantic/bundle.hpp>
 #include <ikos/ar/semantic/context.hpp>
 #include <ikos/ar/semantic/type.hpp>
+#include <ikos/ar/support/arena.hpp>
 #include <ikos/ar/support/assert.hpp>
 #include <ikos/ar/support/cast.hpp>
 #include <ikos/ar/support/number.hpp>
@@ -82,6 +83,7 @@ public:
     ArrayConstantKind,
     VectorConstantKind,
     _EndSequentialConstantKind,
+    DataArrayConstantKind,
     AggregateZeroConstantKind,
     FunctionPointerConstantKind,
     InlineAssemblyConstantKind,
@@ -166,6 +168,11 @@ public:
   /// \brief Is it a constant vector?
   bool is_vector_constant() const { return this->_kind == VectorConstantKind; }
 
+  /// \brief Is it a constant data array?
+  bool is_data_array_constant() const {
+    return this->_kind == DataArrayConstantKind;
+  }
+
   /// \brief Is it a constant aggregate zero?
   bool is_aggregate_zero_constant() const {
     return this->_kind == AggregateZeroConstantKind;
@@ -519,6 +526,69 @@ public:
 
 }; // end class VectorConstant
 
+/// \brief Constant array of integers, stored as raw bytes
+///
+/// This is a compact representation of integer arrays, similar to
+/// llvm::ConstantDataArray. Elements are not uniqued as IntegerConstant, they
+/// are stored in little-endian byte order, each one using the store size of
+/// the element type.
+class DataArrayConstant final : public Constant {
+private:
+  // Raw element bytes
+  std::string _data;
+
+private:
+  /// \brief Private constructor
+  DataArrayConstant(ArrayType* type, std::string data);
+
+public:
+  /// \brief Static constructor
+  ///
+  /// \param ctx The context
+  /// \param type The array type, with an integer element type of 8, 16, 32 or
+  ///   64 bits
+  /// \param data The little-endian bytes of the elements
+  static DataArrayConstant* get(Context& ctx,
+                                ArrayType* type,
+                                const std::string& data);
+
+  /// \brief Get the type
+  ArrayType* type() const { return cast< ArrayType >(this->_type); }
+
+  /// \brief Get the element type
+  IntegerType* element_type() const {
+    return cast< IntegerType >(this->type()->element_type());
+  }
+
+  /// \brief Get the raw element bytes
+  const std::string& data() const { return this->_data; }
+
+  /// \brief Get the size of an element, in bytes
+  std::size_t element_byte_size() const {
+    return this->element_type()->bit_width() / 8;
+  }
+
+  /// \brief Get the number of elements
+  std::size_t num_elements() const {
+    return this->_data.size() / this->element_byte_size();
+  }
+
+  /// \brief Get the value of the element at the given index
+  MachineInt element(std::size_t i) const;
+
+  /// \brief Dump the value for debugging purpose
+  void dump(std::ostream&) const override;
+
+  /// \brief Method for type support (isa, cast, dyn_cast)
+  static bool classof(const Value* v) {
+    return v->kind() == DataArrayConstantKind;
+  }
+
+  // friends
+  friend class ContextImpl;
+
+}; // end class DataArrayConstant
+
 /// \brief Constant aggregate full of zeros
 class AggregateZeroConstant final : public Constant {
 private:
@@ -778,7 +848,7 @@ public:
 
 }; // end class LocalVariable
 
-class InternalVariable final : public Variable {
+class InternalVariable final : public Variable, public ArenaAllocated {
 private:
   // Parent code
   Code* _parent;
@@ -65,6 +65,7 @@ namespace ar {
 ///   int operator()(StructConstant* c) { ... }
 ///   int operator()(ArrayConstant* c) { ... }
 ///   int operator()(VectorConstant* c) { ... }
+///   int operator()(DataArrayConstant* c) { ... }
 ///   int operator()(AggregateZeroConstant* c) { ... }
 ///   int operator()(FunctionPointerConstant* c) { ... }
 ///   int operator()(InlineAssemblyConstant* c) { ... }
@@ -90,6 +91,8 @@ typename Visitor::ResultType apply_visitor(Visitor& visitor, Value* v) {
       return visitor(cast< ArrayConstant >(v));
     case Value::VectorConstantKind:
       return visitor(cast< VectorConstant >(v));
+    case Value::DataArrayConstantKind:
+      return visitor(cast< DataArrayConstant >(v));
     case Value::AggregateZeroConstantKind:
       return visitor(cast< AggregateZeroConstant >(v));
     case Value::FunctionPointerConstantKind:
@@ -122,6 +125,7 @@ typename Visitor::ResultType apply_visitor(Visitor& visitor, Value* v) {
 ///   int operator()(StructConstant* c) const { ... }
 ///   int operator()(ArrayConstant* c) const { ... }
 ///   int operator()(VectorConstant* c) const { ... }
+///   int operator()(DataArrayConstant* c) const { ... }
 ///   int operator()(AggregateZeroConstant* c) const { ... }
 ///   int operator()(FunctionPointerConstant* c) const { ... }
 ///   int operator()(InlineAssemblyConstant* c) const { ... }
@@ -147,6 +151,8 @@ typename Visitor::ResultType apply_visitor(const Visitor& visitor, Value* v) {
       return visitor(cast< ArrayConstant >(v));
     case Value::VectorConstantKind:
       return visitor(cast< VectorConstant >(v));
+    case Value::DataArrayConstantKind:
+      return visitor(cast< DataArrayConstant >(v));
     case Value::AggregateZeroConstantKind:
       return visitor(cast< AggregateZeroConstant >(v));
     case Value::FunctionPointerConstantKind:
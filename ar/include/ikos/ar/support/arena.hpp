@@ -0,0 +1,299 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Arena allocation of small objects of the abstract representation
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace ikos {
+namespace ar {
+
+/// \brief Arena of small objects
+///
+/// Each ar::Code owns an arena for its basic blocks, statements and internal
+/// variables. Objects are carved out of large slabs, so that objects allocated
+/// one after the other (e.g, the statements of a function during the
+/// translation) are contiguous in memory. A deallocated object is recycled for
+/// the next object of the same size class.
+///
+/// The arena is reference counted: the owner holds one reference, and each
+/// live object holds one. Objects can therefore outlive the owner of the arena
+/// (e.g, a statement removed from a basic block), and the slabs are released
+/// with the last object.
+///
+/// This class is thread-safe. An arena is only used by the thread working on
+/// its code, so the mutex is not contended.
+class Arena {
+public:
+  /// \brief Alignment and granularity of the size classes
+  static constexpr std::size_t Alignment = alignof(std::max_align_t);
+
+  /// \brief Maximum size of an object allocated in a slab
+  static constexpr std::size_t MaxObjectSize = 256;
+
+  /// \brief Size of a slab
+  static constexpr std::size_t SlabSize = 64 * 1024;
+
+  /// \brief Use an arena for the objects allocated by the current thread, for
+  /// a given scope
+  ///
+  /// See ArenaAllocated.
+  class Scope {
+  private:
+    /// \brief Previous arena of the current thread, or null
+    Arena* _previous;
+
+  public:
+    /// \brief Constructor
+    explicit Scope(Arena& arena) : _previous(current_ref()) {
+      current_ref() = &arena;
+    }
+
+    /// \brief No copy constructor
+    Scope(const Scope&) = delete;
+
+    /// \brief No move constructor
+    Scope(Scope&&) = delete;
+
+    /// \brief No copy assignment operator
+    Scope& operator=(const Scope&) = delete;
+
+    /// \brief No move assignment operator
+    Scope& operator=(Scope&&) = delete;
+
+    /// \brief Destructor
+    ~Scope() { current_ref() = this->_previous; }
+
+  }; // end class Scope
+
+private:
+  /// \brief Node of a free list
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  /// \brief Number of size classes
+  static constexpr std::size_t NumSizeClasses = MaxObjectSize / Alignment;
+
+private:
+  // Number of references: the owner and the live objects
+  std::atomic< std::size_t > _refs{1};
+
+  std::mutex _mutex;
+
+  // Allocated slabs
+  std::vector< void* > _slabs;
+
+  // Free space in the current slab
+  char* _begin = nullptr;
+  char* _end = nullptr;
+
+  // Free list for each size class
+  std::array< FreeNode*, NumSizeClasses > _free_lists{};
+
+private:
+  /// \brief Destructor, see release()
+  ~Arena() {
+    for (void* slab : this->_slabs) {
+      ::operator delete(slab);
+    }
+  }
+
+public:
+  /// \brief Create an empty arena, with one reference for the owner
+  Arena() = default;
+
+  /// \brief No copy constructor
+  Arena(const Arena&) = delete;
+
+  /// \brief No move constructor
+  Arena(Arena&&) = delete;
+
+  /// \brief No copy assignment operator
+  Arena& operator=(const Arena&) = delete;
+
+  /// \brief No move assignment operator
+  Arena& operator=(Arena&&) = delete;
+
+  /// \brief Drop a reference, and destroy the arena if it was the last one
+  void release() {
+    if (this->_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  /// \brief Allocate memory for an object of the given size
+  ///
+  /// The object holds a reference on the arena until deallocate() is called.
+  /// Returns null if the object is bigger than MaxObjectSize.
+  void* allocate(std::size_t size) {
+    if (size > MaxObjectSize) {
+      return nullptr;
+    }
+
+    std::size_t size_class = this->size_class(size);
+    this->_refs.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard< std::mutex > lock(this->_mutex);
+
+    FreeNode*& free_list = this->_free_lists[size_class];
+    if (free_list != nullptr) {
+      FreeNode* node = free_list;
+      free_list = node->next;
+      return node;
+    }
+
+    std::size_t rounded_size = (size_class + 1) * Alignment;
+    if (static_cast< std::size_t >(this->_end - this->_begin) <
+        rounded_size) {
+      this->_begin = static_cast< char* >(::operator new(SlabSize));
+      this->_end = this->_begin + SlabSize;
+      this->_slabs.push_back(this->_begin);
+    }
+    void* ptr = this->_begin;
+    this->_begin += rounded_size;
+    return ptr;
+  }
+
+  /// \brief Deallocate the memory of an object of the given size, allocated
+  /// with allocate()
+  void deallocate(void* ptr, std::size_t size) {
+    {
+      std::lock_guard< std::mutex > lock(this->_mutex);
+      auto node = static_cast< FreeNode* >(ptr);
+      FreeNode*& free_list = this->_free_lists[this->size_class(size)];
+      node->next = free_list;
+      free_list = node;
+    }
+    this->release();
+  }
+
+  /// \brief Return the arena of the current thread, or null
+  static Arena* current() { return current_ref(); }
+
+private:
+  /// \brief Return the size class of an object of the given size
+  static std::size_t size_class(std::size_t size) {
+    return size == 0 ? 0 : (size - 1) / Alignment;
+  }
+
+  /// \brief Return a reference on the arena of the current thread
+  static Arena*& current_ref() {
+    thread_local Arena* arena = nullptr;
+    return arena;
+  }
+
+}; // end class Arena
+
+/// \brief Allocate derived classes in an arena
+///
+/// Objects are allocated in the given arena, or in the arena of the current
+/// thread (see Arena::Scope), or with ::operator new if there is none. Each
+/// object is preceded by a header recording where it was allocated, so it can
+/// be deleted from any thread, after its arena owner is gone.
+///
+/// A class deriving from ArenaAllocated and deleted through a pointer on a base
+/// class must have a virtual destructor.
+class ArenaAllocated {
+private:
+  /// \brief Header of an object
+  struct alignas(Arena::Alignment) Header {
+    /// \brief Arena of the object, or null if allocated with ::operator new
+    Arena* arena;
+
+    /// \brief Size of the allocation, including the header
+    std::size_t size;
+  };
+
+public:
+  /// \brief Allocate an object in the arena of the current thread, if any
+  static void* operator new(std::size_t size) {
+    return allocate(size, Arena::current());
+  }
+
+  /// \brief Allocate an object in the given arena
+  static void* operator new(std::size_t size, Arena* arena) {
+    return allocate(size, arena);
+  }
+
+  /// \brief Deallocate an object
+  static void operator delete(void* ptr) {
+    if (ptr == nullptr) {
+      return;
+    }
+    Header* header = static_cast< Header* >(ptr) - 1;
+    if (header->arena != nullptr) {
+      header->arena->deallocate(header, header->size);
+    } else {
+      ::operator delete(header);
+    }
+  }
+
+  /// \brief Deallocate an object if its constructor throws
+  static void operator delete(void* ptr, Arena* /*arena*/) {
+    operator delete(ptr);
+  }
+
+private:
+  /// \brief Allocate an object with its header
+  static void* allocate(std::size_t size, Arena* arena) {
+    std::size_t full_size = sizeof(Header) + size;
+    void* ptr = (arena != nullptr) ? arena->allocate(full_size) : nullptr;
+    if (ptr == nullptr) {
+      arena = nullptr;
+      ptr = ::operator new(full_size);
+    }
+    Header* header = static_cast< Header* >(ptr);
+    header->arena = arena;
+    header->size = full_size;
+    return header + 1;
+  }
+
+}; // end class ArenaAllocated
+
+} // end namespace ar
+} // end namespace ikos
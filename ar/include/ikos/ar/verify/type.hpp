@@ -43,6 +43,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iosfwd>
 
 #include <ikos/ar/semantic/bundle.hpp>
@@ -60,11 +61,18 @@ private:
   // Find all errors, do not stop at the first one
   bool _all;
 
+  // Number of threads to check a bundle (0 means one per hardware thread)
+  std::size_t _num_threads;
+
 public:
   /// \brief Public constructor
   ///
   /// \param all Find all errors, do not stop at the first one
-  explicit TypeVerifier(bool all = true) : _all(all) {}
+  /// \param num_threads Number of threads to check the global variables and
+  /// functions of a bundle (0 means one per hardware thread). Errors are
+  /// reported in the same order as with a single thread.
+  explicit TypeVerifier(bool all = true, std::size_t num_threads = 1)
+      : _all(all), _num_threads(num_threads) {}
 
   /// \brief Copy constructor
   TypeVerifier(const TypeVerifier&) noexcept = default;
@@ -110,6 +118,10 @@ public:
               std::ostream& err,
               Type* return_type = nullptr) const;
 
+private:
+  /// \brief Type check the given bundle, on several threads
+  bool verify_parallel(Bundle* bundle, std::ostream& err) const;
+
 public:
   // Check if there is an implicit bitcast between two types.
   //
@@ -672,6 +672,18 @@ public:
     o << ">";
   }
 
+  void operator()(DataArrayConstant* c) {
+    o << "[";
+    for (std::size_t i = 0, n = c->num_elements(); i < n;) {
+      o << c->element(i);
+      ++i;
+      if (i != n) {
+        o << ", ";
+      }
+    }
+    o << "]";
+  }
+
   void operator()(AggregateZeroConstant* /*c*/) { o << "aggregate_zero"; }
 
   void operator()(FunctionPointerConstant* c) {
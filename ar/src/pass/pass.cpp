@@ -41,7 +41,11 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
+#include <vector>
+
 #include <ikos/ar/pass/pass.hpp>
+#include <ikos/ar/support/parallel.hpp>
 
 namespace ikos {
 namespace ar {
@@ -49,13 +53,14 @@ namespace ar {
 // CodePass
 
 bool CodePass::run(Bundle* bundle) {
-  bool change = false;
+  // Collect the codes first, in a deterministic order
+  std::vector< Code* > codes;
 
   for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
        ++it) {
     GlobalVariable* gv = *it;
     if (gv->is_definition()) {
-      change = this->run_on_code(gv->initializer()) || change;
+      codes.push_back(gv->initializer());
     }
   }
 
@@ -64,11 +69,21 @@ bool CodePass::run(Bundle* bundle) {
        ++it) {
     Function* fun = *it;
     if (fun->is_definition()) {
-      change = this->run_on_code(fun->body()) || change;
+      codes.push_back(fun->body());
     }
   }
 
-  return change;
+  // Codes are independent, each thread only writes its own flag
+  std::vector< char > changes(codes.size(), 0);
+
+  parallel_for(codes.size(), this->_num_threads, [&](std::size_t i) {
+    Arena::Scope scope(codes[i]->arena());
+    changes[i] = this->run_on_code(codes[i]);
+  });
+
+  return std::any_of(changes.begin(), changes.end(), [](char change) {
+    return change != 0;
+  });
 }
 
 } // end namespace ar
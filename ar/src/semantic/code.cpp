@@ -59,7 +59,8 @@ BasicBlock::BasicBlock(Code* code) : _parent(code) {
 BasicBlock::~BasicBlock() = default;
 
 BasicBlock* BasicBlock::create(Code* code) {
-  auto bb = std::unique_ptr< BasicBlock >(new BasicBlock(code));
+  auto bb = std::unique_ptr< BasicBlock >(new (&code->arena())
+                                              BasicBlock(code));
   return code->add_basic_block(std::move(bb));
 }
 
@@ -266,7 +267,8 @@ void BasicBlock::full_dump(std::ostream& o) const {
 // Code
 
 Code::Code(Function* function)
-    : _entry_block(nullptr),
+    : _arena(new Arena()),
+      _entry_block(nullptr),
       _exit_block(nullptr),
       _function(function),
       _global_var(nullptr),
@@ -275,7 +277,8 @@ Code::Code(Function* function)
 }
 
 Code::Code(GlobalVariable* gv)
-    : _entry_block(nullptr),
+    : _arena(new Arena()),
+      _entry_block(nullptr),
       _exit_block(nullptr),
       _function(nullptr),
       _global_var(gv),
@@ -283,7 +286,11 @@ Code::Code(GlobalVariable* gv)
   ikos_assert_msg(gv, "gv is null");
 }
 
-Code::~Code() = default;
+Code::~Code() {
+  // The basic blocks and internal variables, destroyed after this, and the
+  // statements removed from the code keep the arena alive
+  this->_arena->release();
+}
 
 void Code::set_entry_block(BasicBlock* bb) {
   this->_entry_block = bb;
@@ -76,6 +76,7 @@ void ContextImpl::add_bundle(std::unique_ptr< Bundle > bundle) {
 }
 
 IntegerType* ContextImpl::integer_type(unsigned bit_width, Signedness sign) {
+  std::lock_guard< std::mutex > lock(this->_scalar_types_mutex);
   auto it = this->_integer_types.find(std::make_tuple(bit_width, sign));
   if (it == this->_integer_types.end()) {
     auto type =
@@ -90,6 +91,7 @@ IntegerType* ContextImpl::integer_type(unsigned bit_width, Signedness sign) {
 }
 
 PointerType* ContextImpl::pointer_type(Type* pointee) {
+  std::lock_guard< std::mutex > lock(this->_scalar_types_mutex);
   auto it = this->_pointer_types.find(pointee);
   if (it == this->_pointer_types.end()) {
     auto type = std::unique_ptr< PointerType >(new PointerType(pointee));
@@ -103,6 +105,7 @@ PointerType* ContextImpl::pointer_type(Type* pointee) {
 
 ArrayType* ContextImpl::array_type(Type* element_type,
                                    const ZNumber& num_element) {
+  std::lock_guard< std::mutex > lock(this->_aggregate_types_mutex);
   auto it = this->_array_types.find(std::make_tuple(element_type, num_element));
   if (it == this->_array_types.end()) {
     auto type =
@@ -119,6 +122,7 @@ ArrayType* ContextImpl::array_type(Type* element_type,
 
 VectorType* ContextImpl::vector_type(ScalarType* element_type,
                                      const ZNumber& num_element) {
+  std::lock_guard< std::mutex > lock(this->_aggregate_types_mutex);
   auto it =
       this->_vector_types.find(std::make_tuple(element_type, num_element));
   if (it == this->_vector_types.end()) {
@@ -138,6 +142,7 @@ FunctionType* ContextImpl::function_type(
     Type* return_type,
     const FunctionType::ParamTypes& param_types,
     bool is_var_arg) {
+  std::lock_guard< std::mutex > lock(this->_aggregate_types_mutex);
   auto it = this->_function_types.find(
       std::make_tuple(return_type, param_types, is_var_arg));
   if (it == this->_function_types.end()) {
@@ -155,11 +160,13 @@ FunctionType* ContextImpl::function_type(
 }
 
 Type* ContextImpl::add_type(std::unique_ptr< Type > type) {
+  std::lock_guard< std::mutex > lock(this->_aggregate_types_mutex);
   this->_types.emplace_back(std::move(type));
   return this->_types.back().get();
 }
 
 UndefinedConstant* ContextImpl::undefined_cst(Type* type) {
+  std::lock_guard< std::mutex > lock(this->_constants_mutex);
   auto it = this->_undefined_constants.find(type);
   if (it == this->_undefined_constants.end()) {
     auto cst =
@@ -174,6 +181,7 @@ UndefinedConstant* ContextImpl::undefined_cst(Type* type) {
 
 IntegerConstant* ContextImpl::integer_cst(IntegerType* type,
                                           const MachineInt& value) {
+  std::lock_guard< std::mutex > lock(this->_integer_constants_mutex);
   auto it = this->_integer_constants.find(std::make_tuple(type, value));
   if (it == this->_integer_constants.end()) {
     auto cst =
@@ -189,6 +197,7 @@ IntegerConstant* ContextImpl::integer_cst(IntegerType* type,
 
 FloatConstant* ContextImpl::float_cst(FloatType* type,
                                       const std::string& value) {
+  std::lock_guard< std::mutex > lock(this->_constants_mutex);
   auto it = this->_float_constants.find(std::make_tuple(type, value));
   if (it == this->_float_constants.end()) {
     auto cst = std::unique_ptr< FloatConstant >(new FloatConstant(type, value));
@@ -202,6 +211,7 @@ FloatConstant* ContextImpl::float_cst(FloatType* type,
 }
 
 NullConstant* ContextImpl::null_cst(PointerType* type) {
+  std::lock_guard< std::mutex > lock(this->_constants_mutex);
   auto it = this->_null_constants.find(type);
   if (it == this->_null_constants.end()) {
     auto cst = std::unique_ptr< NullConstant >(new NullConstant(type));
@@ -215,6 +225,7 @@ NullConstant* ContextImpl::null_cst(PointerType* type) {
 
 StructConstant* ContextImpl::struct_cst(StructType* type,
                                         const StructConstant::Values& values) {
+  std::lock_guard< std::mutex > lock(this->_constants_mutex);
   auto it = this->_struct_constants.find(std::make_tuple(type, values));
   if (it == this->_struct_constants.end()) {
     auto cst =
@@ -230,6 +241,7 @@ StructConstant* ContextImpl::struct_cst(StructType* type,
 
 ArrayConstant* ContextImpl::array_cst(ArrayType* type,
                                       const ArrayConstant::Values& values) {
+  std::lock_guard< std::mutex > lock(this->_constants_mutex);
   auto it = this->_array_constants.find(std::make_tuple(type, values));
   if (it == this->_array_constants.end()) {
     auto cst =
@@ -245,6 +257,7 @@ ArrayConstant* ContextImpl::array_cst(ArrayType* type,
 
 VectorConstant* ContextImpl::vector_cst(VectorType* type,
                                         const VectorConstant::Values& values) {
+  std::lock_guard< std::mutex > lock(this->_constants_mutex);
   auto it = this->_vector_constants.find(std::make_tuple(type, values));
   if (it == this->_vector_constants.end()) {
     auto cst =
@@ -258,7 +271,22 @@ VectorConstant* ContextImpl::vector_cst(VectorType* type,
   }
 }
 
+DataArrayConstant* ContextImpl::data_array_cst(ArrayType* type,
+                                               const std::string& data) {
+  std::lock_guard< std::mutex > lock(this->_constants_mutex);
+  auto& csts = this->_data_array_constants[std::make_tuple(
+      type, std::hash< std::string >()(data))];
+  for (const auto& cst : csts) {
+    if (cst->data() == data) {
+      return cst.get();
+    }
+  }
+  csts.emplace_back(new DataArrayConstant(type, data));
+  return csts.back().get();
+}
+
 AggregateZeroConstant* ContextImpl::aggregate_zero_cst(AggregateType* type) {
+  std::lock_guard< std::mutex > lock(this->_constants_mutex);
   auto it = this->_aggregate_zero_constants.find(type);
   if (it == this->_aggregate_zero_constants.end()) {
     auto cst = std::unique_ptr< AggregateZeroConstant >(
@@ -272,6 +300,7 @@ AggregateZeroConstant* ContextImpl::aggregate_zero_cst(AggregateType* type) {
 }
 
 FunctionPointerConstant* ContextImpl::function_pointer_cst(Function* function) {
+  std::lock_guard< std::mutex > lock(this->_constants_mutex);
   auto it = this->_function_pointer_constants.find(function);
   if (it == this->_function_pointer_constants.end()) {
     ikos_assert_msg(function, "function is null");
@@ -289,6 +318,7 @@ FunctionPointerConstant* ContextImpl::function_pointer_cst(Function* function) {
 
 InlineAssemblyConstant* ContextImpl::inline_assembly_cst(
     PointerType* type, const std::string& code) {
+  std::lock_guard< std::mutex > lock(this->_constants_mutex);
   auto it = this->_inline_assembly_constants.find(std::make_tuple(type, code));
   if (it == this->_inline_assembly_constants.end()) {
     auto cst = std::unique_ptr< InlineAssemblyConstant >(
@@ -43,7 +43,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -104,6 +108,12 @@ private:
   boost::container::flat_map< Type*, std::unique_ptr< PointerType > >
       _pointer_types;
 
+  // Mutex for _integer_types and _pointer_types
+  //
+  // Integer and pointer types can be created by the analyzer while analyzing
+  // several bundles in parallel.
+  std::mutex _scalar_types_mutex;
+
   // Array types
   boost::container::flat_map< std::tuple< Type*, ZNumber >,
                               std::unique_ptr< ArrayType > >
@@ -123,6 +133,12 @@ private:
   // Other types (struct and opaque)
   std::vector< std::unique_ptr< Type > > _types;
 
+  // Mutex for _array_types, _vector_types, _function_types and _types
+  //
+  // Types can be created by AR passes running on several codes in parallel,
+  // or by the analyzer while analyzing several bundles in parallel.
+  std::mutex _aggregate_types_mutex;
+
   // Undefined constants
   boost::container::flat_map< Type*, std::unique_ptr< UndefinedConstant > >
       _undefined_constants;
@@ -132,6 +148,12 @@ private:
                               std::unique_ptr< IntegerConstant > >
       _integer_constants;
 
+  // Mutex for _integer_constants
+  //
+  // Integer constants can be created by the analyzer while checking basic
+  // blocks in parallel.
+  std::mutex _integer_constants_mutex;
+
   // Float constants
   boost::container::flat_map< std::tuple< FloatType*, std::string >,
                               std::unique_ptr< FloatConstant > >
@@ -156,6 +178,15 @@ private:
                               std::unique_ptr< VectorConstant > >
       _vector_constants;
 
+  // Data array constants, keyed by the hash of their bytes
+  //
+  // The bytes are only stored in the constants, and only compared on a hash
+  // collision.
+  boost::container::flat_map<
+      std::tuple< ArrayType*, std::size_t >,
+      std::vector< std::unique_ptr< DataArrayConstant > > >
+      _data_array_constants;
+
   // Aggregate zero constants
   boost::container::flat_map< AggregateType*,
                               std::unique_ptr< AggregateZeroConstant > >
@@ -171,6 +202,12 @@ private:
                               std::unique_ptr< InlineAssemblyConstant > >
       _inline_assembly_constants;
 
+  // Mutex for all the constant maps, except _integer_constants
+  //
+  // Constants can be created by AR passes running on several codes in
+  // parallel, or by the analyzer while analyzing several bundles in parallel.
+  std::mutex _constants_mutex;
+
 public:
   /// \brief Default constructor
   ContextImpl();
@@ -194,6 +231,9 @@ public:
   void add_bundle(std::unique_ptr< Bundle >);
 
   // type management
+  //
+  // The void type and the predefined integer and float types below are
+  // members, they do not need a lock.
 
   VoidType* void_type() { return &_void_ty; }
 
@@ -267,6 +307,9 @@ public:
   VectorConstant* vector_cst(VectorType* type,
                              const VectorConstant::Values& values);
 
+  /// \brief Get or create a data array constant
+  DataArrayConstant* data_array_cst(ArrayType* type, const std::string& data);
+
   /// \brief Get or create an aggregate zero constant
   AggregateZeroConstant* aggregate_zero_cst(AggregateType* type);
 
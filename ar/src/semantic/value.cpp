@@ -235,6 +235,53 @@ void VectorConstant::dump(std::ostream& o) const {
   o << ">";
 }
 
+// DataArrayConstant
+
+DataArrayConstant::DataArrayConstant(ArrayType* type, std::string data)
+    : Constant(DataArrayConstantKind, type), _data(std::move(data)) {
+  ikos_assert_msg(type->element_type()->is_integer(),
+                  "element type is not an integer");
+  ikos_assert_msg(this->element_type()->bit_width() % 8 == 0 &&
+                      this->element_type()->bit_width() <= 64,
+                  "unexpected element bit-width");
+  ikos_assert_msg(type->num_elements() ==
+                      this->_data.size() / this->element_byte_size(),
+                  "incompatible size");
+}
+
+DataArrayConstant* DataArrayConstant::get(Context& ctx,
+                                          ArrayType* type,
+                                          const std::string& data) {
+  return ctx_impl(ctx).data_array_cst(type, data);
+}
+
+MachineInt DataArrayConstant::element(std::size_t i) const {
+  ikos_assert(i < this->num_elements());
+  std::size_t size = this->element_byte_size();
+  const char* p = this->_data.data() + i * size;
+
+  uint64_t n = 0;
+  for (std::size_t j = size; j > 0; j--) {
+    n = (n << 8) | static_cast< uint8_t >(p[j - 1]);
+  }
+
+  return MachineInt(n,
+                    this->element_type()->bit_width(),
+                    this->element_type()->sign());
+}
+
+void DataArrayConstant::dump(std::ostream& o) const {
+  o << "[";
+  for (std::size_t i = 0, n = this->num_elements(); i < n;) {
+    o << this->element(i);
+    ++i;
+    if (i != n) {
+      o << ", ";
+    }
+  }
+  o << "]";
+}
+
 // AggregateZeroConstant
 
 AggregateZeroConstant::AggregateZeroConstant(AggregateType* type)
@@ -393,8 +440,9 @@ InternalVariable::InternalVariable(Code* code, Type* type)
 }
 
 InternalVariable* InternalVariable::create(Code* code, Type* type) {
-  auto iv =
-      std::unique_ptr< InternalVariable >(new InternalVariable(code, type));
+  auto iv = std::unique_ptr< InternalVariable >(new (&code->arena())
+                                                     InternalVariable(code,
+                                                                      type));
   return code->add_internal_variable(std::move(iv));
 }
 
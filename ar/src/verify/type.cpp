@@ -41,10 +41,14 @@
  *
  ******************************************************************************/
 
+#include <sstream>
+#include <vector>
+
 #include <ikos/ar/format/namer.hpp>
 #include <ikos/ar/format/text.hpp>
 #include <ikos/ar/semantic/statement_visitor.hpp>
 #include <ikos/ar/support/assert.hpp>
+#include <ikos/ar/support/parallel.hpp>
 #include <ikos/ar/verify/type.hpp>
 
 namespace ikos {
@@ -60,6 +64,10 @@ namespace ar {
 // valid is false because of short-circuiting.
 
 bool TypeVerifier::verify(Bundle* bundle, std::ostream& err) const {
+  if (effective_num_threads(this->_num_threads) > 1) {
+    return this->verify_parallel(bundle, err);
+  }
+
   bool valid = true;
   for (auto it = bundle->global_begin(), et = bundle->global_end();
        it != et && (this->_all || valid);
@@ -74,6 +82,34 @@ bool TypeVerifier::verify(Bundle* bundle, std::ostream& err) const {
   return valid;
 }
 
+bool TypeVerifier::verify_parallel(Bundle* bundle, std::ostream& err) const {
+  std::vector< GlobalVariable* > gvs(bundle->global_begin(),
+                                     bundle->global_end());
+  std::vector< Function* > funs(bundle->function_begin(),
+                                bundle->function_end());
+
+  // Each job writes its errors in its own buffer
+  std::size_t n = gvs.size() + funs.size();
+  std::vector< std::ostringstream > errs(n);
+  std::vector< char > valids(n, 1);
+
+  parallel_for(n, this->_num_threads, [&](std::size_t i) {
+    if (i < gvs.size()) {
+      valids[i] = this->verify(gvs[i], errs[i]);
+    } else {
+      valids[i] = this->verify(funs[i - gvs.size()], errs[i]);
+    }
+  });
+
+  // Report the errors in the sequential order
+  bool valid = true;
+  for (std::size_t i = 0; i < n && (this->_all || valid); i++) {
+    err << errs[i].str();
+    valid = valids[i] != 0 && valid;
+  }
+  return valid;
+}
+
 bool TypeVerifier::verify(GlobalVariable* gv, std::ostream& err) const {
   return gv->is_declaration() || this->verify(gv->initializer(), err, nullptr);
 }
@@ -60,6 +60,7 @@
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/indexable.hpp>
 #include <ikos/core/support/assert.hpp>
+#include <ikos/core/support/memory_usage.hpp>
 
 namespace ikos {
 namespace core {
@@ -455,7 +456,15 @@ public:
         _prefix(prefix),
         _branching_bit(branching_bit),
         _left_tree(std::move(left_tree)),
-        _right_tree(std::move(right_tree)) {}
+        _right_tree(std::move(right_tree)) {
+    MemoryUsage::allocate(MemoryCategory::PatriciaTree,
+                          sizeof(PatriciaTreeNode));
+  }
+
+  ~PatriciaTreeNode() override {
+    MemoryUsage::deallocate(MemoryCategory::PatriciaTree,
+                            sizeof(PatriciaTreeNode));
+  }
 
   Index prefix() const { return this->_prefix; }
 
@@ -479,7 +488,15 @@ private:
 
 public:
   PatriciaTreeLeaf(const Key& key, const Value& value)
-      : PatriciaTree< Key, Value >(1), _pair(key, value) {}
+      : PatriciaTree< Key, Value >(1), _pair(key, value) {
+    MemoryUsage::allocate(MemoryCategory::PatriciaTree,
+                          sizeof(PatriciaTreeLeaf));
+  }
+
+  ~PatriciaTreeLeaf() override {
+    MemoryUsage::deallocate(MemoryCategory::PatriciaTree,
+                            sizeof(PatriciaTreeLeaf));
+  }
 
   const Key& key() const { return this->_pair.first; }
 
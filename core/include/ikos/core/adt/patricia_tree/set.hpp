@@ -58,6 +58,7 @@
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/indexable.hpp>
 #include <ikos/core/support/assert.hpp>
+#include <ikos/core/support/memory_usage.hpp>
 
 namespace ikos {
 namespace core {
@@ -336,7 +337,15 @@ public:
         _prefix(prefix),
         _branching_bit(branching_bit),
         _left_tree(std::move(left_tree)),
-        _right_tree(std::move(right_tree)) {}
+        _right_tree(std::move(right_tree)) {
+    MemoryUsage::allocate(MemoryCategory::PatriciaTree,
+                          sizeof(PatriciaTreeNode));
+  }
+
+  ~PatriciaTreeNode() override {
+    MemoryUsage::deallocate(MemoryCategory::PatriciaTree,
+                            sizeof(PatriciaTreeNode));
+  }
 
   Index prefix() const { return this->_prefix; }
 
@@ -359,7 +368,15 @@ private:
 
 public:
   explicit PatriciaTreeLeaf(Key key)
-      : PatriciaTree< Key >(1), _key(std::move(key)) {}
+      : PatriciaTree< Key >(1), _key(std::move(key)) {
+    MemoryUsage::allocate(MemoryCategory::PatriciaTree,
+                          sizeof(PatriciaTreeLeaf));
+  }
+
+  ~PatriciaTreeLeaf() override {
+    MemoryUsage::deallocate(MemoryCategory::PatriciaTree,
+                            sizeof(PatriciaTreeLeaf));
+  }
 
   const Key& key() const { return this->_key; }
 
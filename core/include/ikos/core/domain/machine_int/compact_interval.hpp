@@ -0,0 +1,1129 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Machine integer interval domain with a compact storage
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <ikos/core/domain/abstract_domain.hpp>
+#include <ikos/core/domain/machine_int/interval.hpp>
+#include <ikos/core/domain/machine_int/operator.hpp>
+#include <ikos/core/domain/machine_int/separate_domain.hpp>
+#include <ikos/core/linear_expression.hpp>
+#include <ikos/core/number/machine_int.hpp>
+#include <ikos/core/semantic/dumpable.hpp>
+#include <ikos/core/semantic/indexable.hpp>
+#include <ikos/core/semantic/machine_int/variable.hpp>
+#include <ikos/core/semantic/variable.hpp>
+#include <ikos/core/value/machine_int/interval.hpp>
+
+namespace ikos {
+namespace core {
+namespace machine_int {
+
+namespace compact_interval_impl {
+
+/// \brief Maximum number of intervals in a chunk
+constexpr std::size_t ChunkCapacity = 32;
+
+/// \brief Sorted block of machine integer intervals
+///
+/// Entries are sorted by variable index and stored in a structure-of-arrays
+/// layout. Bounds are encoded as unsigned 64-bit integers: a machine integer
+/// of bit-width n is mapped to [0, 2**n-1] preserving the order, thus the
+/// encoded minimum is always 0 and the encoded maximum is stored in `max`.
+template < typename VariableRef >
+struct Chunk {
+  /// \brief Number of entries
+  std::size_t size = 0;
+
+  /// \brief Variable indexes, in increasing order
+  std::array< Index, ChunkCapacity > keys;
+
+  /// \brief Variables
+  std::array< VariableRef, ChunkCapacity > vars;
+
+  /// \brief Encoded lower bounds
+  std::array< uint64_t, ChunkCapacity > lb;
+
+  /// \brief Encoded upper bounds
+  std::array< uint64_t, ChunkCapacity > ub;
+
+  /// \brief Encoded maximum integers
+  std::array< uint64_t, ChunkCapacity > max;
+
+  /// \brief Copy the entry `j` of `other` at position `i`
+  void copy_entry(std::size_t i, const Chunk& other, std::size_t j) {
+    this->keys[i] = other.keys[j];
+    this->vars[i] = other.vars[j];
+    this->lb[i] = other.lb[j];
+    this->ub[i] = other.ub[j];
+    this->max[i] = other.max[j];
+  }
+};
+
+} // end namespace compact_interval_impl
+
+/// \brief Compact map from machine integer variables to intervals
+///
+/// Intervals of variables with a bit-width of at most 64 are stored as raw
+/// 64-bit bounds in sorted chunks of fixed size (see compact_interval_impl).
+/// Copies share the chunks, which are copied on write.
+///
+/// Binary operations on abstract values with the same layout (i.e, the same
+/// variables in the same chunks, which is the common case for abstract values
+/// computed from a common ancestor) process chunks pairwise with tight loops on
+/// the bound arrays, without decoding the machine integers. Other abstract
+/// values fall back to a sorted merge.
+///
+/// Intervals of variables with a bit-width larger than 64 are stored in a
+/// separate domain.
+///
+/// It provides the same interface as SeparateDomain< VariableRef, Interval >,
+/// so that it can be used as the storage of IntervalDomain.
+template < typename VariableRef >
+class CompactIntervalMap final
+    : public core::AbstractDomain< CompactIntervalMap< VariableRef > > {
+public:
+  static_assert(
+      core::IsVariable< VariableRef >::value,
+      "VariableRef does not meet the requirements for variable types");
+  static_assert(machine_int::IsVariable< VariableRef >::value,
+                "VariableRef must implement machine_int::VariableTraits");
+  static_assert(std::is_nothrow_default_constructible< VariableRef >::value,
+                "VariableRef must be default constructible");
+
+private:
+  using VariableTrait = machine_int::VariableTraits< VariableRef >;
+  using ChunkT = compact_interval_impl::Chunk< VariableRef >;
+  using ChunkRef = std::shared_ptr< ChunkT >;
+  using ChunkVector = std::vector< ChunkRef >;
+  using WideDomainT = SeparateDomain< VariableRef, Interval >;
+
+  static constexpr std::size_t ChunkCapacity =
+      compact_interval_impl::ChunkCapacity;
+
+public:
+  using LinearExpressionT = LinearExpression< MachineInt, VariableRef >;
+
+  class Iterator;
+
+private:
+  /// \brief Sorted chunks of intervals, or null if there are none
+  ///
+  /// Chunks are never empty. Intervals are never top.
+  std::shared_ptr< ChunkVector > _chunks;
+
+  /// \brief Intervals of variables with a bit-width larger than 64
+  ///
+  /// This is never bottom.
+  WideDomainT _wide;
+
+  bool _is_bottom;
+
+private:
+  struct TopTag {};
+  struct BottomTag {};
+
+  /// \brief Create the top abstract value
+  explicit CompactIntervalMap(TopTag)
+      : _wide(WideDomainT::top()), _is_bottom(false) {}
+
+  /// \brief Create the bottom abstract value
+  explicit CompactIntervalMap(BottomTag)
+      : _wide(WideDomainT::top()), _is_bottom(true) {}
+
+public:
+  /// \brief Create the top abstract value
+  static CompactIntervalMap top() { return CompactIntervalMap(TopTag{}); }
+
+  /// \brief Create the bottom abstract value
+  static CompactIntervalMap bottom() {
+    return CompactIntervalMap(BottomTag{});
+  }
+
+  /// \brief Copy constructor
+  CompactIntervalMap(const CompactIntervalMap&) noexcept = default;
+
+  /// \brief Move constructor
+  CompactIntervalMap(CompactIntervalMap&&) noexcept = default;
+
+  /// \brief Copy assignment operator
+  CompactIntervalMap& operator=(const CompactIntervalMap&) noexcept = default;
+
+  /// \brief Move assignment operator
+  CompactIntervalMap& operator=(CompactIntervalMap&&) noexcept = default;
+
+  /// \brief Destructor
+  ~CompactIntervalMap() override = default;
+
+  /// \brief Begin iterator over the pairs (variable, interval)
+  Iterator begin() const {
+    ikos_assert(!this->is_bottom());
+    return Iterator(this, /*end = */ false);
+  }
+
+  /// \brief End iterator over the pairs (variable, interval)
+  Iterator end() const {
+    ikos_assert(!this->is_bottom());
+    return Iterator(this, /*end = */ true);
+  }
+
+  void normalize() override {}
+
+  bool is_bottom() const override { return this->_is_bottom; }
+
+  bool is_top() const override {
+    return !this->is_bottom() && this->_chunks == nullptr &&
+           this->_wide.is_top();
+  }
+
+  void set_to_bottom() override {
+    this->_is_bottom = true;
+    this->_chunks = nullptr;
+    this->_wide.set_to_top();
+  }
+
+  void set_to_top() override {
+    this->_is_bottom = false;
+    this->_chunks = nullptr;
+    this->_wide.set_to_top();
+  }
+
+  bool leq(const CompactIntervalMap& other) const override {
+    if (this->is_bottom()) {
+      return true;
+    } else if (other.is_bottom()) {
+      return false;
+    } else if (!this->_wide.leq(other._wide)) {
+      return false;
+    } else if (this->_chunks == other._chunks) {
+      return true;
+    } else if (this->same_layout(other)) {
+      const ChunkVector& a = this->chunks();
+      const ChunkVector& b = other.chunks();
+      for (std::size_t c = 0; c < a.size(); c++) {
+        if (a[c] == b[c]) {
+          continue;
+        }
+        const ChunkT& x = *a[c];
+        const ChunkT& y = *b[c];
+        bool included = true;
+        for (std::size_t i = 0; i < x.size; i++) {
+          included &= (y.lb[i] <= x.lb[i]) & (x.ub[i] <= y.ub[i]);
+        }
+        if (!included) {
+          return false;
+        }
+      }
+      return true;
+    } else {
+      // Every interval of `other` must be refined by `this`
+      Cursor i(this->chunks());
+      Cursor j(other.chunks());
+      for (; !j.at_end(); j.next()) {
+        while (!i.at_end() && i.key() < j.key()) {
+          i.next();
+        }
+        if (i.at_end() || i.key() != j.key()) {
+          return false;
+        }
+        if (j.lb() > i.lb() || i.ub() > j.ub()) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+
+  bool equals(const CompactIntervalMap& other) const override {
+    if (this->is_bottom()) {
+      return other.is_bottom();
+    } else if (other.is_bottom()) {
+      return false;
+    } else if (!this->_wide.equals(other._wide)) {
+      return false;
+    } else if (this->_chunks == other._chunks) {
+      return true;
+    } else {
+      Cursor i(this->chunks());
+      Cursor j(other.chunks());
+      for (; !i.at_end() && !j.at_end(); i.next(), j.next()) {
+        if (i.key() != j.key() || i.lb() != j.lb() || i.ub() != j.ub()) {
+          return false;
+        }
+      }
+      return i.at_end() && j.at_end();
+    }
+  }
+
+  void join_with(const CompactIntervalMap& other) override {
+    if (other.is_bottom()) {
+      return;
+    } else if (this->is_bottom()) {
+      this->operator=(other);
+    } else {
+      this->_wide.join_with(other._wide);
+      this->intersect_with(other,
+                           [](uint64_t& lb,
+                              uint64_t& ub,
+                              uint64_t other_lb,
+                              uint64_t other_ub,
+                              uint64_t /*max*/,
+                              VariableRef /*x*/) {
+                             lb = std::min(lb, other_lb);
+                             ub = std::max(ub, other_ub);
+                           });
+    }
+  }
+
+  void widen_with(const CompactIntervalMap& other) override {
+    if (other.is_bottom()) {
+      return;
+    } else if (this->is_bottom()) {
+      this->operator=(other);
+    } else {
+      this->_wide.widen_with(other._wide);
+      this->intersect_with(other,
+                           [](uint64_t& lb,
+                              uint64_t& ub,
+                              uint64_t other_lb,
+                              uint64_t other_ub,
+                              uint64_t max,
+                              VariableRef /*x*/) {
+                             lb = (other_lb < lb) ? 0 : lb;
+                             ub = (ub < other_ub) ? max : ub;
+                           });
+    }
+  }
+
+  void widen_threshold_with(const CompactIntervalMap& other,
+                            const MachineInt& threshold) {
+    if (other.is_bottom()) {
+      return;
+    } else if (this->is_bottom()) {
+      this->operator=(other);
+    } else {
+      this->_wide.widen_threshold_with(other._wide, threshold);
+      this->intersect_with(other,
+                           [&threshold](uint64_t& lb,
+                                        uint64_t& ub,
+                                        uint64_t other_lb,
+                                        uint64_t other_ub,
+                                        uint64_t /*max*/,
+                                        VariableRef x) {
+                             Interval i = decode(x, lb, ub).widening_threshold(
+                                 decode(x, other_lb, other_ub), threshold);
+                             encode(i, lb, ub);
+                           });
+    }
+  }
+
+  void meet_with(const CompactIntervalMap& other) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (other.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      this->_wide.meet_with(other._wide);
+      this->union_with(other,
+                       [](uint64_t& lb,
+                          uint64_t& ub,
+                          uint64_t other_lb,
+                          uint64_t other_ub,
+                          uint64_t /*max*/,
+                          VariableRef /*x*/) {
+                         lb = std::max(lb, other_lb);
+                         ub = std::min(ub, other_ub);
+                       });
+    }
+  }
+
+  void narrow_with(const CompactIntervalMap& other) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (other.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      this->_wide.narrow_with(other._wide);
+      this->union_with(other,
+                       [](uint64_t& lb,
+                          uint64_t& ub,
+                          uint64_t other_lb,
+                          uint64_t other_ub,
+                          uint64_t max,
+                          VariableRef /*x*/) {
+                         lb = (lb == 0) ? other_lb : lb;
+                         ub = (ub == max) ? other_ub : ub;
+                       });
+    }
+  }
+
+  void narrow_threshold_with(const CompactIntervalMap& other,
+                             const MachineInt& threshold) {
+    if (this->is_bottom()) {
+      return;
+    } else if (other.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      this->_wide.narrow_threshold_with(other._wide, threshold);
+      this->union_with(other,
+                       [&threshold](uint64_t& lb,
+                                    uint64_t& ub,
+                                    uint64_t other_lb,
+                                    uint64_t other_ub,
+                                    uint64_t /*max*/,
+                                    VariableRef x) {
+                         Interval i = decode(x, lb, ub).narrowing_threshold(
+                             decode(x, other_lb, other_ub), threshold);
+                         encode(i, lb, ub);
+                       });
+    }
+  }
+
+  /// \brief Get the interval for the given variable
+  Interval get(VariableRef x) const {
+    if (this->is_bottom()) {
+      return Interval::bottom(VariableTrait::bit_width(x),
+                              VariableTrait::sign(x));
+    } else if (!is_compact(x)) {
+      return this->_wide.get(x);
+    } else {
+      Position pos = this->locate(IndexableTraits< VariableRef >::index(x));
+      if (pos.found) {
+        const ChunkT& chunk = *this->chunks()[pos.chunk];
+        return decode(x, chunk.lb[pos.index], chunk.ub[pos.index]);
+      } else {
+        return Interval::top(VariableTrait::bit_width(x),
+                             VariableTrait::sign(x));
+      }
+    }
+  }
+
+  /// \brief Set the interval of the given variable
+  void set(VariableRef x, const Interval& value) {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else if (!is_compact(x)) {
+      this->_wide.set(x, value);
+    } else if (value.is_top()) {
+      this->erase(x);
+    } else {
+      uint64_t lb;
+      uint64_t ub;
+      encode(value, lb, ub);
+      this->insert_or_assign(x, lb, ub);
+    }
+  }
+
+  /// \brief Refine the interval of the given variable
+  void refine(VariableRef x, const Interval& value) {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else if (value.is_top()) {
+      return;
+    } else {
+      this->set(x, this->get(x).meet(value));
+    }
+  }
+
+  /// \brief Projection
+  ///
+  /// Return an overapproximation of the linear expression e as an interval
+  ///
+  /// Note that it wraps on integer overflow.
+  /// Note that it will automatically cast variables to the type of
+  /// `e.constant()`.
+  Interval project(const LinearExpressionT& e) const {
+    // Result type
+    unsigned bit_width = e.constant().bit_width();
+    Signedness sign = e.constant().sign();
+
+    if (this->is_bottom()) {
+      return Interval::bottom(bit_width, sign);
+    }
+
+    Interval r(e.constant());
+    for (const auto& term : e) {
+      r = add(r,
+              mul(Interval(term.second),
+                  this->get(term.first).cast(bit_width, sign)));
+    }
+    return r;
+  }
+
+  /// \brief Forget the interval of the given variable
+  void forget(VariableRef x) {
+    if (this->is_bottom()) {
+      return;
+    } else if (!is_compact(x)) {
+      this->_wide.forget(x);
+    } else {
+      this->erase(x);
+    }
+  }
+
+  /// \brief Assign `x = n`
+  void assign(VariableRef x, const MachineInt& n) {
+    this->set(x, Interval(n));
+  }
+
+  /// \brief Assign `x = n`
+  void assign(VariableRef x, VariableRef y) { this->set(x, this->get(y)); }
+
+  /// \brief Assign `x = e`
+  ///
+  /// Note that it wraps on integer overflow.
+  /// Note that it will automatically cast variables to the type of `x`.
+  void assign(VariableRef x, const LinearExpressionT& e) {
+    this->set(x, this->project(e));
+  }
+
+  /// \brief Apply `x = op y`
+  void apply(UnaryOperator op, VariableRef x, VariableRef y) {
+    this->set(x,
+              apply_unary_operator(op,
+                                   this->get(y),
+                                   VariableTrait::bit_width(x),
+                                   VariableTrait::sign(x)));
+  }
+
+  /// \brief Apply `x = y op z`
+  void apply(BinaryOperator op, VariableRef x, VariableRef y, VariableRef z) {
+    this->set(x, apply_bin_operator(op, this->get(y), this->get(z)));
+  }
+
+  /// \brief Apply `x = y op z`
+  void apply(BinaryOperator op,
+             VariableRef x,
+             VariableRef y,
+             const MachineInt& z) {
+    this->set(x, apply_bin_operator(op, this->get(y), Interval(z)));
+  }
+
+  /// \brief Apply `x = y op z`
+  void apply(BinaryOperator op,
+             VariableRef x,
+             const MachineInt& y,
+             VariableRef z) {
+    this->set(x, apply_bin_operator(op, Interval(y), this->get(z)));
+  }
+
+  void dump(std::ostream& o) const override {
+    if (this->is_bottom()) {
+      o << "⊥";
+    } else {
+      o << "{";
+      for (auto it = this->begin(), et = this->end(); it != et;) {
+        DumpableTraits< VariableRef >::dump(o, it->first);
+        o << " -> ";
+        it->second.dump(o);
+        ++it;
+        if (it != et) {
+          o << "; ";
+        }
+      }
+      o << "}";
+    }
+  }
+
+  static std::string name() { return "compact map of intervals"; }
+
+private:
+  /// \name Encoding of bounds
+  /// @{
+
+  /// \brief Return true if the variable is stored in the chunks
+  static bool is_compact(VariableRef x) {
+    return VariableTrait::bit_width(x) <= 64;
+  }
+
+  /// \brief Return the encoded maximum integer for the given bit-width
+  static uint64_t encoded_max(unsigned bit_width) {
+    return ~uint64_t(0) >> (64 - bit_width);
+  }
+
+  /// \brief Return the bias of encoded integers for the given type
+  ///
+  /// Signed integers are shifted by 2**(n-1) so that the encoded minimum is 0.
+  static uint64_t bias(unsigned bit_width, Signedness sign) {
+    return (sign == Signed) ? (uint64_t(1) << (bit_width - 1)) : 0;
+  }
+
+  /// \brief Encode a machine integer of at most 64 bits
+  static uint64_t encode(const MachineInt& n) {
+    ikos_assert(n.bit_width() <= 64);
+    if (n.is_signed()) {
+      auto raw = static_cast< uint64_t >(n.to< int64_t >());
+      return (raw & encoded_max(n.bit_width())) ^
+             bias(n.bit_width(), n.sign());
+    } else {
+      return n.to< uint64_t >();
+    }
+  }
+
+  /// \brief Encode a non-bottom interval, or `lb > ub` for bottom
+  static void encode(const Interval& i, uint64_t& lb, uint64_t& ub) {
+    if (i.is_bottom()) {
+      lb = 1;
+      ub = 0;
+    } else {
+      lb = encode(i.lb());
+      ub = encode(i.ub());
+    }
+  }
+
+  /// \brief Decode a machine integer for the given variable
+  static MachineInt decode(VariableRef x, uint64_t n) {
+    unsigned bit_width = VariableTrait::bit_width(x);
+    Signedness sign = VariableTrait::sign(x);
+    return MachineInt(n ^ bias(bit_width, sign), bit_width, sign);
+  }
+
+  /// \brief Decode an interval for the given variable
+  static Interval decode(VariableRef x, uint64_t lb, uint64_t ub) {
+    return Interval(decode(x, lb), decode(x, ub));
+  }
+
+  /// @}
+  /// \name Access to chunks
+  /// @{
+
+  /// \brief Return the chunks
+  const ChunkVector& chunks() const {
+    static const ChunkVector Empty;
+    return (this->_chunks != nullptr) ? *this->_chunks : Empty;
+  }
+
+  /// \brief Return the chunks, copied if shared
+  ChunkVector& mutable_chunks() {
+    if (this->_chunks == nullptr) {
+      this->_chunks = std::make_shared< ChunkVector >();
+    } else if (this->_chunks.use_count() > 1) {
+      this->_chunks = std::make_shared< ChunkVector >(*this->_chunks);
+    }
+    return *this->_chunks;
+  }
+
+  /// \brief Return the chunk at the given position, copied if shared
+  ChunkT& mutable_chunk(std::size_t c) {
+    ChunkVector& chunks = this->mutable_chunks();
+    if (chunks[c].use_count() > 1) {
+      chunks[c] = std::make_shared< ChunkT >(*chunks[c]);
+    }
+    return *chunks[c];
+  }
+
+  /// \brief Set the chunks
+  void set_chunks(ChunkVector chunks) {
+    if (chunks.empty()) {
+      this->_chunks = nullptr;
+    } else {
+      this->_chunks = std::make_shared< ChunkVector >(std::move(chunks));
+    }
+  }
+
+  /// \brief Position of an entry
+  struct Position {
+    /// \brief Index of the chunk, or number of chunks if past the last entry
+    std::size_t chunk;
+
+    /// \brief Index of the entry in the chunk
+    std::size_t index;
+
+    /// \brief True if the entry holds the key
+    bool found;
+  };
+
+  /// \brief Return the position of the given key, or where to insert it
+  Position locate(Index key) const {
+    const ChunkVector& chunks = this->chunks();
+    auto it = std::lower_bound(chunks.begin(),
+                               chunks.end(),
+                               key,
+                               [](const ChunkRef& chunk, Index k) {
+                                 return chunk->keys[chunk->size - 1] < k;
+                               });
+    if (it == chunks.end()) {
+      return Position{chunks.size(), 0, false};
+    }
+    const ChunkT& chunk = **it;
+    auto kt = std::lower_bound(chunk.keys.begin(),
+                               chunk.keys.begin() + chunk.size,
+                               key);
+    auto index = static_cast< std::size_t >(kt - chunk.keys.begin());
+    return Position{static_cast< std::size_t >(it - chunks.begin()),
+                    index,
+                    chunk.keys[index] == key};
+  }
+
+  /// \brief Insert or update the interval of the given variable
+  void insert_or_assign(VariableRef x, uint64_t lb, uint64_t ub) {
+    Position pos = this->locate(IndexableTraits< VariableRef >::index(x));
+
+    if (pos.found) {
+      ChunkT& chunk = this->mutable_chunk(pos.chunk);
+      chunk.lb[pos.index] = lb;
+      chunk.ub[pos.index] = ub;
+      return;
+    }
+
+    ChunkVector& chunks = this->mutable_chunks();
+    if (chunks.empty()) {
+      chunks.push_back(std::make_shared< ChunkT >());
+    } else if (pos.chunk == chunks.size()) {
+      // Append to the last chunk
+      pos.chunk = chunks.size() - 1;
+      pos.index = chunks.back()->size;
+    }
+
+    if (chunks[pos.chunk]->size == ChunkCapacity) {
+      this->split(pos.chunk);
+      if (pos.index > ChunkCapacity / 2) {
+        pos.chunk++;
+        pos.index -= ChunkCapacity / 2;
+      }
+    }
+
+    ChunkT& chunk = this->mutable_chunk(pos.chunk);
+    for (std::size_t i = chunk.size; i > pos.index; i--) {
+      chunk.copy_entry(i, chunk, i - 1);
+    }
+    chunk.keys[pos.index] = IndexableTraits< VariableRef >::index(x);
+    chunk.vars[pos.index] = x;
+    chunk.lb[pos.index] = lb;
+    chunk.ub[pos.index] = ub;
+    chunk.max[pos.index] = encoded_max(VariableTrait::bit_width(x));
+    chunk.size++;
+  }
+
+  /// \brief Split a full chunk in two halves
+  void split(std::size_t c) {
+    auto upper = std::make_shared< ChunkT >();
+    ChunkT& lower = this->mutable_chunk(c);
+    ikos_assert(lower.size == ChunkCapacity);
+    for (std::size_t i = ChunkCapacity / 2; i < ChunkCapacity; i++) {
+      upper->copy_entry(upper->size++, lower, i);
+    }
+    lower.size = ChunkCapacity / 2;
+    ChunkVector& chunks = this->mutable_chunks();
+    chunks.insert(chunks.begin() + static_cast< std::ptrdiff_t >(c + 1),
+                  std::move(upper));
+  }
+
+  /// \brief Remove the interval of the given variable
+  void erase(VariableRef x) {
+    Position pos = this->locate(IndexableTraits< VariableRef >::index(x));
+    if (!pos.found) {
+      return;
+    }
+
+    ChunkT& chunk = this->mutable_chunk(pos.chunk);
+    for (std::size_t i = pos.index + 1; i < chunk.size; i++) {
+      chunk.copy_entry(i - 1, chunk, i);
+    }
+    chunk.size--;
+
+    if (chunk.size == 0) {
+      ChunkVector& chunks = this->mutable_chunks();
+      chunks.erase(chunks.begin() + static_cast< std::ptrdiff_t >(pos.chunk));
+      if (chunks.empty()) {
+        this->_chunks = nullptr;
+      }
+    }
+  }
+
+  /// @}
+  /// \name Binary operations
+  /// @{
+
+  /// \brief Return true if both abstract values have chunks with the same keys
+  bool same_layout(const CompactIntervalMap& other) const {
+    const ChunkVector& a = this->chunks();
+    const ChunkVector& b = other.chunks();
+    if (a.size() != b.size()) {
+      return false;
+    }
+    for (std::size_t c = 0; c < a.size(); c++) {
+      if (a[c] != b[c] &&
+          (a[c]->size != b[c]->size ||
+           !std::equal(a[c]->keys.begin(),
+                       a[c]->keys.begin() + a[c]->size,
+                       b[c]->keys.begin()))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Cursor over the entries of chunks, in increasing order
+  class Cursor {
+  private:
+    const ChunkVector& _chunks;
+    std::size_t _chunk = 0;
+    std::size_t _index = 0;
+
+  public:
+    explicit Cursor(const ChunkVector& chunks) : _chunks(chunks) {}
+
+    bool at_end() const { return this->_chunk == this->_chunks.size(); }
+
+    void next() {
+      if (++this->_index == this->_chunks[this->_chunk]->size) {
+        this->_chunk++;
+        this->_index = 0;
+      }
+    }
+
+    const ChunkT& chunk() const { return *this->_chunks[this->_chunk]; }
+
+    std::size_t index() const { return this->_index; }
+
+    Index key() const { return this->chunk().keys[this->_index]; }
+
+    uint64_t lb() const { return this->chunk().lb[this->_index]; }
+
+    uint64_t ub() const { return this->chunk().ub[this->_index]; }
+  };
+
+  /// \brief Builder of sorted chunks
+  class Builder {
+  private:
+    ChunkVector _chunks;
+
+  public:
+    /// \brief Append the entry `i` of `chunk` with the given bounds
+    void push_back(const ChunkT& chunk,
+                   std::size_t i,
+                   uint64_t lb,
+                   uint64_t ub) {
+      if (this->_chunks.empty() ||
+          this->_chunks.back()->size == ChunkCapacity) {
+        this->_chunks.push_back(std::make_shared< ChunkT >());
+      }
+      ChunkT& last = *this->_chunks.back();
+      last.copy_entry(last.size, chunk, i);
+      last.lb[last.size] = lb;
+      last.ub[last.size] = ub;
+      last.size++;
+    }
+
+    /// \brief Return the chunks
+    ChunkVector finish() { return std::move(this->_chunks); }
+  };
+
+  /// \brief Combine two chunks with the same keys
+  ///
+  /// Returns `a` if the result is unchanged, otherwise a new chunk without the
+  /// top intervals, or null if all intervals are top. Sets `is_bottom` if an
+  /// interval is bottom.
+  template < typename BoundOp >
+  static ChunkRef combine(const ChunkRef& a,
+                          const ChunkT& b,
+                          BoundOp op,
+                          bool& is_bottom) {
+    const ChunkT& x = *a;
+    std::array< uint64_t, ChunkCapacity > lb;
+    std::array< uint64_t, ChunkCapacity > ub;
+    for (std::size_t i = 0; i < x.size; i++) {
+      uint64_t l = x.lb[i];
+      uint64_t u = x.ub[i];
+      op(l, u, b.lb[i], b.ub[i], x.max[i], x.vars[i]);
+      lb[i] = l;
+      ub[i] = u;
+    }
+
+    if (std::equal(lb.begin(), lb.begin() + x.size, x.lb.begin()) &&
+        std::equal(ub.begin(), ub.begin() + x.size, x.ub.begin())) {
+      return a;
+    }
+
+    auto r = std::make_shared< ChunkT >();
+    for (std::size_t i = 0; i < x.size; i++) {
+      if (lb[i] > ub[i]) {
+        is_bottom = true;
+        return nullptr;
+      } else if (lb[i] != 0 || ub[i] != x.max[i]) {
+        r->copy_entry(r->size, x, i);
+        r->lb[r->size] = lb[i];
+        r->ub[r->size] = ub[i];
+        r->size++;
+      }
+    }
+    return (r->size == 0) ? nullptr : r;
+  }
+
+  /// \brief Apply a binary operation on the common variables
+  ///
+  /// Variables missing on one side are top in the result. This is used for
+  /// the join and the widening.
+  template < typename BoundOp >
+  void intersect_with(const CompactIntervalMap& other, BoundOp op) {
+    if (this->_chunks == other._chunks) {
+      return;
+    }
+
+    const ChunkVector& a = this->chunks();
+    const ChunkVector& b = other.chunks();
+    ChunkVector result;
+
+    if (this->same_layout(other)) {
+      result.reserve(a.size());
+      bool is_bottom = false;
+      for (std::size_t c = 0; c < a.size(); c++) {
+        ChunkRef r =
+            (a[c] == b[c]) ? a[c] : combine(a[c], *b[c], op, is_bottom);
+        if (r != nullptr) {
+          result.push_back(std::move(r));
+        }
+      }
+      ikos_assert(!is_bottom);
+    } else {
+      Builder builder;
+      Cursor i(a);
+      Cursor j(b);
+      while (!i.at_end() && !j.at_end()) {
+        if (i.key() < j.key()) {
+          i.next();
+        } else if (j.key() < i.key()) {
+          j.next();
+        } else {
+          const ChunkT& chunk = i.chunk();
+          std::size_t k = i.index();
+          uint64_t lb = i.lb();
+          uint64_t ub = i.ub();
+          op(lb, ub, j.lb(), j.ub(), chunk.max[k], chunk.vars[k]);
+          if (lb != 0 || ub != chunk.max[k]) {
+            builder.push_back(chunk, k, lb, ub);
+          }
+          i.next();
+          j.next();
+        }
+      }
+      result = builder.finish();
+    }
+
+    this->set_chunks(std::move(result));
+  }
+
+  /// \brief Apply a binary operation on all variables
+  ///
+  /// Variables missing on one side take the interval of the other side. This
+  /// is used for the meet and the narrowing.
+  template < typename BoundOp >
+  void union_with(const CompactIntervalMap& other, BoundOp op) {
+    if (this->_wide.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    } else if (this->_chunks == other._chunks) {
+      return;
+    }
+
+    const ChunkVector& a = this->chunks();
+    const ChunkVector& b = other.chunks();
+    ChunkVector result;
+    bool is_bottom = false;
+
+    if (this->same_layout(other)) {
+      result.reserve(a.size());
+      for (std::size_t c = 0; c < a.size() && !is_bottom; c++) {
+        ChunkRef r =
+            (a[c] == b[c]) ? a[c] : combine(a[c], *b[c], op, is_bottom);
+        if (r != nullptr) {
+          result.push_back(std::move(r));
+        }
+      }
+    } else {
+      Builder builder;
+      Cursor i(a);
+      Cursor j(b);
+      while ((!i.at_end() || !j.at_end()) && !is_bottom) {
+        if (j.at_end() || (!i.at_end() && i.key() < j.key())) {
+          builder.push_back(i.chunk(), i.index(), i.lb(), i.ub());
+          i.next();
+        } else if (i.at_end() || j.key() < i.key()) {
+          builder.push_back(j.chunk(), j.index(), j.lb(), j.ub());
+          j.next();
+        } else {
+          const ChunkT& chunk = i.chunk();
+          std::size_t k = i.index();
+          uint64_t lb = i.lb();
+          uint64_t ub = i.ub();
+          op(lb, ub, j.lb(), j.ub(), chunk.max[k], chunk.vars[k]);
+          if (lb > ub) {
+            is_bottom = true;
+          } else if (lb != 0 || ub != chunk.max[k]) {
+            builder.push_back(chunk, k, lb, ub);
+          }
+          i.next();
+          j.next();
+        }
+      }
+      result = builder.finish();
+    }
+
+    if (is_bottom) {
+      this->set_to_bottom();
+    } else {
+      this->set_chunks(std::move(result));
+    }
+  }
+
+  /// @}
+
+public:
+  /// \brief Forward iterator over the pairs (variable, interval)
+  ///
+  /// Intervals of variables with a bit-width of at most 64 come first, in
+  /// increasing order of index, then the others.
+  class Iterator final {
+  public:
+    // Required types for iterators
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = const std::pair< VariableRef, Interval >;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::pair< VariableRef, Interval >*;
+    using reference = const std::pair< VariableRef, Interval >&;
+
+  private:
+    using WideIterator = typename WideDomainT::Iterator;
+
+    const CompactIntervalMap* _map;
+    std::size_t _chunk;
+    std::size_t _index;
+    WideIterator _wide_it;
+    boost::optional< std::pair< VariableRef, Interval > > _current;
+
+  public:
+    /// \brief Create an iterator on the given map
+    Iterator(const CompactIntervalMap* map, bool end)
+        : _map(map),
+          _chunk(end ? map->chunks().size() : 0),
+          _index(0),
+          _wide_it(end ? map->_wide.end() : map->_wide.begin()) {
+      this->load();
+    }
+
+    /// \brief Pre-increment the iterator
+    Iterator& operator++() {
+      const ChunkVector& chunks = this->_map->chunks();
+      if (this->_chunk < chunks.size()) {
+        if (++this->_index == chunks[this->_chunk]->size) {
+          this->_chunk++;
+          this->_index = 0;
+        }
+      } else {
+        ++this->_wide_it;
+      }
+      this->load();
+      return *this;
+    }
+
+    /// \brief Post-increment the iterator
+    const Iterator operator++(int) {
+      Iterator r = *this;
+      ++(*this);
+      return r;
+    }
+
+    /// \brief Compare two iterators
+    bool operator==(const Iterator& other) const {
+      return this->_chunk == other._chunk && this->_index == other._index &&
+             this->_wide_it == other._wide_it;
+    }
+
+    /// \brief Compare two iterators
+    bool operator!=(const Iterator& other) const {
+      return !this->operator==(other);
+    }
+
+    /// \brief Dereference the iterator
+    reference operator*() const { return *this->_current; }
+
+    /// \brief Dereference the iterator
+    pointer operator->() const { return &*this->_current; }
+
+  private:
+    /// \brief Load the current pair
+    void load() {
+      const ChunkVector& chunks = this->_map->chunks();
+      if (this->_chunk < chunks.size()) {
+        const ChunkT& chunk = *chunks[this->_chunk];
+        VariableRef x = chunk.vars[this->_index];
+        this->_current.emplace(x,
+                               decode(x,
+                                      chunk.lb[this->_index],
+                                      chunk.ub[this->_index]));
+      } else if (this->_wide_it != this->_map->_wide.end()) {
+        this->_current.emplace(*this->_wide_it);
+      } else {
+        this->_current = boost::none;
+      }
+    }
+
+  }; // end class Iterator
+
+}; // end class CompactIntervalMap
+
+/// \brief Machine integer interval abstract domain with a compact storage
+///
+/// This is a drop-in replacement for IntervalDomain, faster on abstract
+/// values with many variables of at most 64 bits.
+template < typename VariableRef >
+using CompactIntervalDomain =
+    IntervalDomain< VariableRef, CompactIntervalMap< VariableRef > >;
+
+} // end namespace machine_int
+} // end namespace core
+} // end namespace ikos
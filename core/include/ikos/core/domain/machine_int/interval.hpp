@@ -71,35 +71,39 @@ inline Interval trim_bound(const Interval& i, const MachineInt& b) {
 }
 
 /// \brief Machine integer interval abstract domain
-template < typename VariableRef >
+///
+/// The map from variables to intervals is a SeparateDomain by default. See
+/// CompactIntervalDomain for a compact storage.
+template <
+    typename VariableRef,
+    typename Storage = machine_int::SeparateDomain< VariableRef, Interval > >
 class IntervalDomain final
     : public machine_int::AbstractDomain< VariableRef,
-                                          IntervalDomain< VariableRef > > {
+                                          IntervalDomain< VariableRef,
+                                                          Storage > > {
 private:
   using Parent =
-      machine_int::AbstractDomain< VariableRef, IntervalDomain< VariableRef > >;
-  using SeparateDomainT = machine_int::SeparateDomain< VariableRef, Interval >;
+      machine_int::AbstractDomain< VariableRef,
+                                   IntervalDomain< VariableRef, Storage > >;
   using VariableTrait = machine_int::VariableTraits< VariableRef >;
 
 public:
   using LinearExpressionT = LinearExpression< MachineInt, VariableRef >;
-  using Iterator = typename SeparateDomainT::Iterator;
+  using Iterator = typename Storage::Iterator;
 
 private:
-  SeparateDomainT _inv;
+  Storage _inv;
 
 private:
   /// \brief Private constructor
-  explicit IntervalDomain(SeparateDomainT inv) : _inv(std::move(inv)) {}
+  explicit IntervalDomain(Storage inv) : _inv(std::move(inv)) {}
 
 public:
   /// \brief Create the top abstract value
-  static IntervalDomain top() { return IntervalDomain(SeparateDomainT::top()); }
+  static IntervalDomain top() { return IntervalDomain(Storage::top()); }
 
   /// \brief Create the bottom abstract value
-  static IntervalDomain bottom() {
-    return IntervalDomain(SeparateDomainT::bottom());
-  }
+  static IntervalDomain bottom() { return IntervalDomain(Storage::bottom()); }
 
   /// \brief Copy constructor
   IntervalDomain(const IntervalDomain&) noexcept = default;
@@ -76,6 +76,18 @@ public:
                          const LiteralT& v,
                          const MachineInt& size) = 0;
 
+  /// \brief Perform the memory write `p[i] = v` for all the elements of an
+  /// array
+  ///
+  /// \param p The pointer variable, on the first element
+  /// \param v The value stored in every element
+  /// \param element_size The size of an element, in bytes
+  /// \param size The size of the array, in bytes
+  virtual void mem_write_array(VariableRef p,
+                               const LiteralT& v,
+                               const MachineInt& element_size,
+                               const MachineInt& size) = 0;
+
   /// \brief Perform the memory read `x = *p`
   ///
   /// \param x The result variable
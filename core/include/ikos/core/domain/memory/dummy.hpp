@@ -637,6 +637,13 @@ public:
     }
   }
 
+  void mem_write_array(VariableRef p,
+                       const LiteralT& v,
+                       const MachineInt& element_size,
+                       const MachineInt& /*size*/) override {
+    this->mem_write(p, v, element_size);
+  }
+
   void mem_read(const LiteralT& x,
                 VariableRef p,
                 const MachineInt& /*size*/) override {
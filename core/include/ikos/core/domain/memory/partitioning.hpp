@@ -1453,6 +1453,15 @@ public:
     }
   }
 
+  void mem_write_array(VariableRef p,
+                       const LiteralT& v,
+                       const MachineInt& element_size,
+                       const MachineInt& size) override {
+    for (Partition& partition : this->_partitions) {
+      partition.memory.mem_write_array(p, v, element_size, size);
+    }
+  }
+
   void mem_read(const LiteralT& x,
                 VariableRef p,
                 const MachineInt& size) override {
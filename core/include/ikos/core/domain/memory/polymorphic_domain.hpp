@@ -588,6 +588,18 @@ private:
                            const LiteralT& v,
                            const MachineInt& size) = 0;
 
+    /// \brief Perform the memory write `p[i] = v` for all the elements of an
+    /// array
+    ///
+    /// \param p The pointer variable, on the first element
+    /// \param v The value stored in every element
+    /// \param element_size The size of an element, in bytes
+    /// \param size The size of the array, in bytes
+    virtual void mem_write_array(VariableRef p,
+                                 const LiteralT& v,
+                                 const MachineInt& element_size,
+                                 const MachineInt& size) = 0;
+
     /// \brief Perform the memory read `x = *p`
     ///
     /// \param x The result variable
@@ -1345,6 +1357,13 @@ private:
       this->_inv.mem_write(p, v, size);
     }
 
+    void mem_write_array(VariableRef p,
+                         const LiteralT& v,
+                         const MachineInt& element_size,
+                         const MachineInt& size) override {
+      this->_inv.mem_write_array(p, v, element_size, size);
+    }
+
     void mem_read(const LiteralT& x,
                   VariableRef p,
                   const MachineInt& size) override {
@@ -2001,6 +2020,13 @@ public:
     this->_ptr->mem_write(p, v, size);
   }
 
+  void mem_write_array(VariableRef p,
+                       const LiteralT& v,
+                       const MachineInt& element_size,
+                       const MachineInt& size) override {
+    this->_ptr->mem_write_array(p, v, element_size, size);
+  }
+
   void mem_read(const LiteralT& x,
                 VariableRef p,
                 const MachineInt& size) override {
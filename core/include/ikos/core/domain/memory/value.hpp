@@ -51,11 +51,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <type_traits>
+#include <vector>
 
+#include <boost/optional.hpp>
+
+#include <ikos/core/adt/patricia_tree/map.hpp>
 #include <ikos/core/domain/lifetime/abstract_domain.hpp>
 #include <ikos/core/domain/memory/abstract_domain.hpp>
 #include <ikos/core/domain/memory/value/cell_set.hpp>
+#include <ikos/core/domain/memory/value/cell_summarization.hpp>
 #include <ikos/core/domain/memory/value/mem_loc_to_cell_set.hpp>
 #include <ikos/core/domain/memory/value/mem_loc_to_pointer_set.hpp>
 #include <ikos/core/semantic/machine_int/variable.hpp>
@@ -155,18 +161,53 @@ private:
   /// \brief Underlying lifetime abstract domain
   LifetimeDomain _lifetime;
 
+  /// \brief Cell summarization parameters, or null
+  CellSummarization* _summarization;
+
+  /// \brief Smash cell of a summarized memory location
+  ///
+  /// The aligned slots of the cell size within `[begin, end]` all hold a value
+  /// described by `cell`. Writes on these slots are weak updates of `cell`.
+  struct SmashCell {
+    /// \brief Cell at offset zero, with the size of the slots
+    VariableRef cell;
+
+    /// \brief First byte covered
+    MachineInt begin;
+
+    /// \brief Last byte covered
+    MachineInt end;
+
+    bool operator==(const SmashCell& other) const {
+      return this->cell == other.cell && this->begin == other.begin &&
+             this->end == other.end;
+    }
+  };
+
+  /// \brief Map from summarized memory location to smash cell, if any
+  using SummaryMapT =
+      PatriciaTreeMap< MemoryLocationRef, boost::optional< SmashCell > >;
+
+  /// \brief Memory locations with summarized cells
+  ///
+  /// These memory locations have no cells. Their contents are described by
+  /// their smash cell, or unknown if they have none.
+  SummaryMapT _summarized;
+
 private:
   /// \brief Constructor
   ValueDomain(CellFactoryRef cell_factory,
               ScalarDomain scalar,
               MemLocToCellSetT cells,
               MemLocToPointerSetT pointer_sets,
-              LifetimeDomain lifetime)
+              LifetimeDomain lifetime,
+              CellSummarization* summarization)
       : _cell_factory(std::move(cell_factory)),
         _scalar(std::move(scalar)),
         _cells(std::move(cells)),
         _pointer_sets(std::move(pointer_sets)),
-        _lifetime(std::move(lifetime)) {
+        _lifetime(std::move(lifetime)),
+        _summarization(summarization) {
     this->normalize();
   }
 
@@ -176,14 +217,18 @@ public:
   /// \param cell_factory The cell factory
   /// \param scalar The scalar abstract value
   /// \param lifetime The lifetime abstract value
+  /// \param summarization The cell summarization parameters, or null to keep
+  /// all the cells
   ValueDomain(CellFactoryRef cell_factory,
               ScalarDomain scalar,
-              LifetimeDomain lifetime)
+              LifetimeDomain lifetime,
+              CellSummarization* summarization = nullptr)
       : _cell_factory(std::move(cell_factory)),
         _scalar(std::move(scalar)),
         _cells(MemLocToCellSetT::top()),
         _pointer_sets(MemLocToPointerSetT::top()),
-        _lifetime(std::move(lifetime)) {
+        _lifetime(std::move(lifetime)),
+        _summarization(summarization) {
     this->normalize();
   }
 
@@ -261,6 +306,7 @@ public:
     this->_cells.set_to_bottom();
     this->_pointer_sets.set_to_bottom();
     this->_lifetime.set_to_bottom();
+    this->_summarized.clear();
   }
 
   void set_to_top() override {
@@ -268,6 +314,7 @@ public:
     this->_cells.set_to_top();
     this->_pointer_sets.set_to_top();
     this->_lifetime.set_to_top();
+    this->_summarized.clear();
   }
 
   bool leq(const ValueDomain& other) const override {
@@ -275,11 +322,16 @@ public:
       return true;
     } else if (other.is_bottom()) {
       return false;
+    } else if (!this->summarizes_as(other)) {
+      ValueDomain tmp(*this);
+      tmp.summarize_as(other);
+      return tmp.leq(other);
     } else {
       return this->_scalar.leq(other._scalar) &&
              this->_cells.leq(other._cells) &&
              this->_pointer_sets.leq(other._pointer_sets) &&
-             this->_lifetime.leq(other._lifetime);
+             this->_lifetime.leq(other._lifetime) &&
+             this->summaries_leq(other);
     }
   }
 
@@ -292,7 +344,8 @@ public:
       return this->_scalar.equals(other._scalar) &&
              this->_cells.equals(other._cells) &&
              this->_pointer_sets.equals(other._pointer_sets) &&
-             this->_lifetime.equals(other._lifetime);
+             this->_lifetime.equals(other._lifetime) &&
+             this->summaries_equals(other);
     }
   }
 
@@ -304,10 +357,13 @@ public:
     } else if (other.is_bottom()) {
       return;
     } else {
+      this->summarize_as(other);
+      other.summarize_as(*this);
       this->_scalar.join_with(std::move(other._scalar));
       this->_cells.join_with(std::move(other._cells));
       this->_pointer_sets.join_with(std::move(other._pointer_sets));
       this->_lifetime.join_with(std::move(other._lifetime));
+      this->join_summaries(other, /* widening = */ false);
     }
   }
 
@@ -317,11 +373,17 @@ public:
       this->operator=(other);
     } else if (other.is_bottom()) {
       return;
+    } else if (!other.summarizes_as(*this)) {
+      ValueDomain tmp(other);
+      tmp.summarize_as(*this);
+      this->join_with(tmp);
     } else {
+      this->summarize_as(other);
       this->_scalar.join_with(other._scalar);
       this->_cells.join_with(other._cells);
       this->_pointer_sets.join_with(other._pointer_sets);
       this->_lifetime.join_with(other._lifetime);
+      this->join_summaries(other, /* widening = */ false);
     }
   }
 
@@ -333,10 +395,13 @@ public:
     } else if (other.is_bottom()) {
       return;
     } else {
+      this->summarize_as(other);
+      other.summarize_as(*this);
       this->_scalar.join_loop_with(std::move(other._scalar));
       this->_cells.join_loop_with(std::move(other._cells));
       this->_pointer_sets.join_loop_with(std::move(other._pointer_sets));
       this->_lifetime.join_loop_with(std::move(other._lifetime));
+      this->join_summaries(other, /* widening = */ false);
     }
   }
 
@@ -346,11 +411,17 @@ public:
       this->operator=(other);
     } else if (other.is_bottom()) {
       return;
+    } else if (!other.summarizes_as(*this)) {
+      ValueDomain tmp(other);
+      tmp.summarize_as(*this);
+      this->join_loop_with(tmp);
     } else {
+      this->summarize_as(other);
       this->_scalar.join_loop_with(other._scalar);
       this->_cells.join_loop_with(other._cells);
       this->_pointer_sets.join_loop_with(other._pointer_sets);
       this->_lifetime.join_loop_with(other._lifetime);
+      this->join_summaries(other, /* widening = */ false);
     }
   }
 
@@ -362,10 +433,13 @@ public:
     } else if (other.is_bottom()) {
       return;
     } else {
+      this->summarize_as(other);
+      other.summarize_as(*this);
       this->_scalar.join_iter_with(std::move(other._scalar));
       this->_cells.join_iter_with(std::move(other._cells));
       this->_pointer_sets.join_iter_with(std::move(other._pointer_sets));
       this->_lifetime.join_iter_with(std::move(other._lifetime));
+      this->join_summaries(other, /* widening = */ false);
     }
   }
 
@@ -375,11 +449,17 @@ public:
       this->operator=(other);
     } else if (other.is_bottom()) {
       return;
+    } else if (!other.summarizes_as(*this)) {
+      ValueDomain tmp(other);
+      tmp.summarize_as(*this);
+      this->join_iter_with(tmp);
     } else {
+      this->summarize_as(other);
       this->_scalar.join_iter_with(other._scalar);
       this->_cells.join_iter_with(other._cells);
       this->_pointer_sets.join_iter_with(other._pointer_sets);
       this->_lifetime.join_iter_with(other._lifetime);
+      this->join_summaries(other, /* widening = */ false);
     }
   }
 
@@ -389,11 +469,17 @@ public:
       this->operator=(other);
     } else if (other.is_bottom()) {
       return;
+    } else if (!other.summarizes_as(*this)) {
+      ValueDomain tmp(other);
+      tmp.summarize_as(*this);
+      this->widen_with(tmp);
     } else {
+      this->summarize_as(other);
       this->_scalar.widen_with(other._scalar);
       this->_cells.widen_with(other._cells);
       this->_pointer_sets.widen_with(other._pointer_sets);
       this->_lifetime.widen_with(other._lifetime);
+      this->join_summaries(other, /* widening = */ true);
     }
   }
 
@@ -404,11 +490,17 @@ public:
       this->operator=(other);
     } else if (other.is_bottom()) {
       return;
+    } else if (!other.summarizes_as(*this)) {
+      ValueDomain tmp(other);
+      tmp.summarize_as(*this);
+      this->widen_threshold_with(tmp, threshold);
     } else {
+      this->summarize_as(other);
       this->_scalar.widen_threshold_with(other._scalar, threshold);
       this->_cells.widen_with(other._cells);
       this->_pointer_sets.join_with(other._pointer_sets);
       this->_lifetime.widen_with(other._lifetime);
+      this->join_summaries(other, /* widening = */ true);
     }
   }
 
@@ -418,6 +510,10 @@ public:
       return;
     } else if (other.is_bottom()) {
       this->set_to_bottom();
+    } else if (!this->summaries_equals(other)) {
+      ValueDomain tmp(other);
+      this->meet_summaries(tmp);
+      this->meet_with(tmp);
     } else {
       this->_scalar.meet_with(other._scalar);
       this->_cells.meet_with(other._cells);
@@ -432,6 +528,10 @@ public:
       return;
     } else if (other.is_bottom()) {
       this->set_to_bottom();
+    } else if (!this->summaries_equals(other)) {
+      ValueDomain tmp(other);
+      this->meet_summaries(tmp);
+      this->narrow_with(tmp);
     } else {
       this->_scalar.narrow_with(other._scalar);
       this->_cells.narrow_with(other._cells);
@@ -447,6 +547,10 @@ public:
       return;
     } else if (other.is_bottom()) {
       this->set_to_bottom();
+    } else if (!this->summaries_equals(other)) {
+      ValueDomain tmp(other);
+      this->meet_summaries(tmp);
+      this->narrow_threshold_with(tmp, threshold);
     } else {
       this->_scalar.narrow_threshold_with(other._scalar, threshold);
       this->_cells.narrow_with(other._cells);
@@ -460,12 +564,17 @@ public:
       return other;
     } else if (other.is_bottom()) {
       return *this;
+    } else if (!this->_summarized.empty() || !other._summarized.empty()) {
+      ValueDomain tmp(*this);
+      tmp.join_with(other);
+      return tmp;
     } else {
       return ValueDomain(this->_cell_factory,
                          this->_scalar.join(other._scalar),
                          this->_cells.join(other._cells),
                          this->_pointer_sets.join(other._pointer_sets),
-                         this->_lifetime.join(other._lifetime));
+                         this->_lifetime.join(other._lifetime),
+                         this->_summarization);
     }
   }
 
@@ -474,12 +583,17 @@ public:
       return other;
     } else if (other.is_bottom()) {
       return *this;
+    } else if (!this->_summarized.empty() || !other._summarized.empty()) {
+      ValueDomain tmp(*this);
+      tmp.join_loop_with(other);
+      return tmp;
     } else {
       return ValueDomain(this->_cell_factory,
                          this->_scalar.join_loop(other._scalar),
                          this->_cells.join_loop(other._cells),
                          this->_pointer_sets.join_loop(other._pointer_sets),
-                         this->_lifetime.join_loop(other._lifetime));
+                         this->_lifetime.join_loop(other._lifetime),
+                         this->_summarization);
     }
   }
 
@@ -488,12 +602,17 @@ public:
       return other;
     } else if (other.is_bottom()) {
       return *this;
+    } else if (!this->_summarized.empty() || !other._summarized.empty()) {
+      ValueDomain tmp(*this);
+      tmp.join_iter_with(other);
+      return tmp;
     } else {
       return ValueDomain(this->_cell_factory,
                          this->_scalar.join_iter(other._scalar),
                          this->_cells.join_iter(other._cells),
                          this->_pointer_sets.join_iter(other._pointer_sets),
-                         this->_lifetime.join_iter(other._lifetime));
+                         this->_lifetime.join_iter(other._lifetime),
+                         this->_summarization);
     }
   }
 
@@ -502,12 +621,17 @@ public:
       return other;
     } else if (other.is_bottom()) {
       return *this;
+    } else if (!this->_summarized.empty() || !other._summarized.empty()) {
+      ValueDomain tmp(*this);
+      tmp.widen_with(other);
+      return tmp;
     } else {
       return ValueDomain(this->_cell_factory,
                          this->_scalar.widening(other._scalar),
                          this->_cells.widening(other._cells),
                          this->_pointer_sets.widening(other._pointer_sets),
-                         this->_lifetime.widening(other._lifetime));
+                         this->_lifetime.widening(other._lifetime),
+                         this->_summarization);
     }
   }
 
@@ -517,13 +641,18 @@ public:
       return other;
     } else if (other.is_bottom()) {
       return *this;
+    } else if (!this->_summarized.empty() || !other._summarized.empty()) {
+      ValueDomain tmp(*this);
+      tmp.widen_threshold_with(other, threshold);
+      return tmp;
     } else {
       return ValueDomain(this->_cell_factory,
                          this->_scalar.widening_threshold(other._scalar,
                                                           threshold),
                          this->_cells.widening(other._cells),
                          this->_pointer_sets.join(other._pointer_sets),
-                         this->_lifetime.widening(other._lifetime));
+                         this->_lifetime.widening(other._lifetime),
+                         this->_summarization);
     }
   }
 
@@ -532,12 +661,17 @@ public:
       return *this;
     } else if (other.is_bottom()) {
       return other;
+    } else if (!this->_summarized.empty() || !other._summarized.empty()) {
+      ValueDomain tmp(*this);
+      tmp.meet_with(other);
+      return tmp;
     } else {
       return ValueDomain(this->_cell_factory,
                          this->_scalar.meet(other._scalar),
                          this->_cells.meet(other._cells),
                          this->_pointer_sets.meet(other._pointer_sets),
-                         this->_lifetime.meet(other._lifetime));
+                         this->_lifetime.meet(other._lifetime),
+                         this->_summarization);
     }
   }
 
@@ -546,12 +680,17 @@ public:
       return *this;
     } else if (other.is_bottom()) {
       return other;
+    } else if (!this->_summarized.empty() || !other._summarized.empty()) {
+      ValueDomain tmp(*this);
+      tmp.narrow_with(other);
+      return tmp;
     } else {
       return ValueDomain(this->_cell_factory,
                          this->_scalar.narrowing(other._scalar),
                          this->_cells.narrowing(other._cells),
                          this->_pointer_sets.narrowing(other._pointer_sets),
-                         this->_lifetime.narrowing(other._lifetime));
+                         this->_lifetime.narrowing(other._lifetime),
+                         this->_summarization);
     }
   }
 
@@ -561,13 +700,18 @@ public:
       return *this;
     } else if (other.is_bottom()) {
       return other;
+    } else if (!this->_summarized.empty() || !other._summarized.empty()) {
+      ValueDomain tmp(*this);
+      tmp.narrow_threshold_with(other, threshold);
+      return tmp;
     } else {
       return ValueDomain(this->_cell_factory,
                          this->_scalar.narrowing_threshold(other._scalar,
                                                            threshold),
                          this->_cells.narrowing(other._cells),
                          this->_pointer_sets.narrowing(other._pointer_sets),
-                         this->_lifetime.narrowing(other._lifetime));
+                         this->_lifetime.narrowing(other._lifetime),
+                         this->_summarization);
     }
   }
 
@@ -1089,6 +1233,358 @@ private:
     return offset == IntIntervalCongruence(cell_offset);
   }
 
+  /// \brief Return true if the cells of the given memory location are
+  /// summarized
+  bool is_summarized(MemoryLocationRef base) const {
+    return static_cast< bool >(this->_summarized.at(base));
+  }
+
+  /// \brief Return true if every memory location summarized in `other` is
+  /// summarized in `this`
+  bool summarizes_as(const ValueDomain& other) const {
+    for (const auto& entry : other._summarized) {
+      if (!this->is_summarized(entry.first)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Summarize the memory locations summarized in `other`
+  void summarize_as(const ValueDomain& other) {
+    for (const auto& entry : other._summarized) {
+      if (!this->is_summarized(entry.first)) {
+        this->summarize(entry.first);
+      }
+    }
+  }
+
+  /// \brief Return true if the accesses of `size` bytes at `offset` are
+  /// aligned on the slots of the given smash cell
+  static bool smash_aligned(const SmashCell& smash,
+                            const IntIntervalCongruence& offset,
+                            const MachineInt& size) {
+    if (CellVariableTrait::size(smash.cell) != size) {
+      return false;
+    }
+    ZNumber n = size.to_z_number();
+    return mod(offset.modulus(), n) == 0 &&
+           mod(offset.residue() - smash.begin.to_z_number(), n) == 0;
+  }
+
+  /// \brief Return the byte range of the accesses of `size` bytes at `offset`
+  static IntInterval access_range(const IntInterval& offset,
+                                  const MachineInt& size) {
+    auto zero = MachineInt::zero(size.bit_width(), Unsigned);
+    auto one = MachineInt(1, size.bit_width(), Unsigned);
+    return add(offset, IntInterval(zero, size - one));
+  }
+
+  /// \brief Return the byte range covered by the given smash cell
+  static IntInterval smash_range(const SmashCell& smash) {
+    return IntInterval(smash.begin, smash.end);
+  }
+
+  /// \brief Build the smash cell of a memory location from its cells
+  ///
+  /// This requires cells of the same size, covering a contiguous range of
+  /// bytes. The smash cell then holds the join of the values of the cells.
+  /// Returns boost::none otherwise.
+  boost::optional< SmashCell > make_smash_cell(MemoryLocationRef base,
+                                               const CellSetT& cells) {
+    if (cells.is_empty()) {
+      return boost::none;
+    }
+
+    VariableRef first = *cells.begin();
+    const MachineInt& size = CellVariableTrait::size(first);
+    std::vector< ZNumber > offsets;
+    offsets.reserve(cells.size());
+    for (VariableRef cell : cells) {
+      if (CellVariableTrait::size(cell) != size) {
+        return boost::none;
+      }
+      offsets.push_back(CellVariableTrait::offset(cell).to_z_number());
+    }
+    std::sort(offsets.begin(), offsets.end());
+    for (std::size_t i = 1; i < offsets.size(); i++) {
+      if (offsets[i] != offsets[i - 1] + size.to_z_number()) {
+        return boost::none;
+      }
+    }
+
+    const MachineInt& first_offset = CellVariableTrait::offset(first);
+    VariableRef smash =
+        this->make_cell(base,
+                        MachineInt::zero(first_offset.bit_width(), Unsigned),
+                        size,
+                        MachIntVariableTrait::sign(first));
+
+    // smash = join of the cells
+    boost::optional< ScalarDomain > scalar;
+    for (VariableRef cell : cells) {
+      ScalarDomain value = this->_scalar;
+      if (cell != smash) {
+        value.dynamic_assign(smash, cell);
+      }
+      if (!scalar) {
+        scalar = std::move(value);
+      } else {
+        scalar->join_with(std::move(value));
+      }
+    }
+    this->_scalar = std::move(*scalar);
+
+    auto one = MachineInt(1, first_offset.bit_width(), Unsigned);
+    return SmashCell{smash,
+                     MachineInt(offsets.front(),
+                                first_offset.bit_width(),
+                                Unsigned),
+                     MachineInt(offsets.back(),
+                                first_offset.bit_width(),
+                                Unsigned) +
+                         (size - one)};
+  }
+
+  /// \brief Summarize the given memory location
+  ///
+  /// Its cells are smashed into one cell, if possible, and then removed.
+  void summarize(MemoryLocationRef base) {
+    CellSetT cells = this->_cells.get(base);
+    boost::optional< SmashCell > smash = this->make_smash_cell(base, cells);
+
+    for (VariableRef cell : cells) {
+      if (!smash || cell != smash->cell) {
+        this->_scalar.dynamic_forget(cell);
+      }
+    }
+    this->_cells.forget(base);
+    this->_summarized.insert_or_assign(base, smash);
+  }
+
+  /// \brief Summarize the given memory location if it has too many cells
+  ///
+  /// \returns true if the memory location is summarized
+  bool summarize_if_needed(MemoryLocationRef base) {
+    if (this->_summarization == nullptr ||
+        this->_cells.get(base).size() <= this->_summarization->max_cells()) {
+      return false;
+    }
+
+    this->summarize(base);
+    this->_summarization->record();
+    return true;
+  }
+
+  /// \brief Drop the smash cell of the given summarized memory location
+  ///
+  /// Its contents become unknown.
+  void forget_smash_cell(MemoryLocationRef base) {
+    boost::optional< const boost::optional< SmashCell >& > smash =
+        this->_summarized.at(base);
+    if (smash && *smash) {
+      this->_scalar.dynamic_forget((*smash)->cell);
+      this->_summarized.insert_or_assign(base, boost::none);
+    }
+  }
+
+  /// \brief Forget that the given memory location is summarized
+  void forget_summary(MemoryLocationRef base) {
+    boost::optional< const boost::optional< SmashCell >& > smash =
+        this->_summarized.at(base);
+    if (smash) {
+      if (*smash) {
+        this->_scalar.dynamic_forget((*smash)->cell);
+      }
+      this->_summarized.erase(base);
+    }
+  }
+
+  /// \brief Forget all the summarized memory locations
+  void forget_summaries() {
+    for (const auto& entry : this->_summarized) {
+      if (entry.second) {
+        this->_scalar.dynamic_forget(entry.second->cell);
+      }
+    }
+    this->_summarized.clear();
+  }
+
+  /// \brief Join the smash cells of `this` and `other`, after the join of the
+  /// scalar abstract values
+  ///
+  /// Both must summarize the same memory locations. A smash cell is kept if
+  /// both have it, on the bytes covered by both. When widening, a smash cell
+  /// covering different bytes is dropped, to ensure termination.
+  void join_summaries(const ValueDomain& other, bool widening) {
+    SummaryMapT summarized = this->_summarized;
+    for (const auto& entry : summarized) {
+      const boost::optional< SmashCell >& smash = entry.second;
+      const boost::optional< SmashCell >& other_smash =
+          *other._summarized.at(entry.first);
+
+      if (smash && other_smash && smash->cell == other_smash->cell &&
+          smash_aligned(*smash,
+                        IntIntervalCongruence(other_smash->begin),
+                        CellVariableTrait::size(smash->cell)) &&
+          !(widening && !(*smash == *other_smash))) {
+        IntInterval range =
+            smash_range(*smash).meet(smash_range(*other_smash));
+        if (!range.is_bottom()) {
+          this->_summarized.insert_or_assign(entry.first,
+                                             SmashCell{smash->cell,
+                                                       range.lb(),
+                                                       range.ub()});
+          continue;
+        }
+      }
+
+      if (smash) {
+        this->_scalar.dynamic_forget(smash->cell);
+      }
+      if (other_smash) {
+        this->_scalar.dynamic_forget(other_smash->cell);
+      }
+      this->_summarized.insert_or_assign(entry.first, boost::none);
+    }
+  }
+
+  /// \brief Make the summaries of `this` and `other` equal before a meet
+  ///
+  /// A memory location summarized differently in `this` and `other` is
+  /// forgotten in the summarized operand, which gives a sound approximation.
+  void meet_summaries(ValueDomain& other) {
+    SummaryMapT summarized = this->_summarized;
+    for (const auto& entry : summarized) {
+      boost::optional< const boost::optional< SmashCell >& > other_smash =
+          other._summarized.at(entry.first);
+      if (!other_smash || !(*other_smash == entry.second)) {
+        this->forget_summary(entry.first);
+        other.forget_summary(entry.first);
+      }
+    }
+    summarized = other._summarized;
+    for (const auto& entry : summarized) {
+      if (!this->is_summarized(entry.first)) {
+        other.forget_summary(entry.first);
+      }
+    }
+  }
+
+  /// \brief Return true if the summaries of `this` hold less information than
+  /// the summaries of `other`
+  bool summaries_leq(const ValueDomain& other) const {
+    for (const auto& entry : this->_summarized) {
+      if (!other.is_summarized(entry.first)) {
+        return false;
+      }
+    }
+    for (const auto& entry : other._summarized) {
+      boost::optional< const boost::optional< SmashCell >& > smash =
+          this->_summarized.at(entry.first);
+      if (!smash) {
+        return false;
+      }
+      const boost::optional< SmashCell >& other_smash = entry.second;
+      if (other_smash &&
+          (!*smash || (*smash)->cell != other_smash->cell ||
+           !smash_aligned(**smash,
+                          IntIntervalCongruence(other_smash->begin),
+                          CellVariableTrait::size(other_smash->cell)) ||
+           !smash_range(*other_smash).leq(smash_range(**smash)))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Return true if the summaries of `this` and `other` are equal
+  bool summaries_equals(const ValueDomain& other) const {
+    if (this->_summarized.size() != other._summarized.size()) {
+      return false;
+    }
+    for (const auto& entry : this->_summarized) {
+      boost::optional< const boost::optional< SmashCell >& > other_smash =
+          other._summarized.at(entry.first);
+      if (!other_smash || !(*other_smash == entry.second)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Write on a summarized memory location
+  ///
+  /// \param base The summarized memory location
+  /// \param offset The offset of the write
+  /// \param size The size of the write
+  /// \param rhs The written value
+  /// \param strong True if the write certainly happens on this memory location
+  void summarized_write(MemoryLocationRef base,
+                        const IntIntervalCongruence& offset,
+                        const MachineInt& size,
+                        const LiteralT& rhs,
+                        bool strong) {
+    boost::optional< SmashCell > smash = *this->_summarized.at(base);
+
+    if (!smash) {
+      if (strong && offset.singleton()) {
+        // Start a new smash cell on the written slot
+        auto zero = MachineInt::zero(offset.bit_width(), Unsigned);
+        auto one = MachineInt(1, offset.bit_width(), Unsigned);
+        VariableRef cell =
+            this->make_cell(base, zero, size, this->preferred_cell_sign(rhs));
+        this->strong_update(cell, rhs);
+        this->_summarized.insert_or_assign(base,
+                                           SmashCell{cell,
+                                                     *offset.singleton(),
+                                                     *offset.singleton() +
+                                                         (size - one)});
+      }
+      return;
+    }
+
+    if (!smash_aligned(*smash, offset, size)) {
+      if (!access_range(offset.interval(), size)
+               .meet(smash_range(*smash))
+               .is_bottom()) {
+        // The write breaks the slots of the smash cell
+        this->forget_smash_cell(base);
+      }
+      return;
+    }
+
+    this->weak_update(smash->cell, rhs);
+
+    if (strong && offset.singleton()) {
+      // Extend the covered bytes with the written slot, if contiguous
+      ZNumber o = offset.singleton()->to_z_number();
+      ZNumber n = size.to_z_number();
+      auto one = MachineInt(1, offset.bit_width(), Unsigned);
+      if (o + n == smash->begin.to_z_number()) {
+        smash->begin = *offset.singleton();
+      } else if (o == smash->end.to_z_number() + 1) {
+        smash->end = *offset.singleton() + (size - one);
+      }
+      this->_summarized.insert_or_assign(base, smash);
+    }
+  }
+
+  /// \brief Read from a summarized memory location
+  ///
+  /// Returns the smash cell if it describes the read bytes, or boost::none.
+  boost::optional< VariableRef > summarized_read(
+      MemoryLocationRef base,
+      const IntIntervalCongruence& offset,
+      const MachineInt& size) const {
+    const boost::optional< SmashCell >& smash = *this->_summarized.at(base);
+    if (smash && smash_aligned(*smash, offset, size) &&
+        access_range(offset.interval(), size).leq(smash_range(*smash))) {
+      return smash->cell;
+    }
+    return boost::none;
+  }
+
   /// \brief Create a new cell for a write, performing reduction if possible
   VariableRef write_realize_single_cell(MemoryLocationRef base,
                                         const MachineInt& offset,
@@ -1131,9 +1627,7 @@ private:
       const IntIntervalCongruence& offset,
       const MachineInt& size) {
     // Write byte range
-    auto zero = MachineInt::zero(size.bit_width(), Unsigned);
-    auto one = MachineInt(1, size.bit_width(), Unsigned);
-    IntInterval range = add(offset.interval(), IntInterval(zero, size - one));
+    IntInterval range = access_range(offset.interval(), size);
 
     // Current list of cells
     const CellSetT& cells = this->_cells.get(base);
@@ -1163,12 +1657,26 @@ private:
   }
 
   /// \brief Create a new cell for a read
-  VariableRef read_realize_single_cell(MemoryLocationRef base,
-                                       const MachineInt& offset,
-                                       const MachineInt& size,
-                                       Signedness sign) {
+  ///
+  /// If the new cell would exceed the maximum number of cells, the memory
+  /// location is summarized instead. Returns boost::none if the smash cell
+  /// does not describe the read bytes.
+  boost::optional< VariableRef > read_realize_single_cell(
+      MemoryLocationRef base,
+      const MachineInt& offset,
+      const MachineInt& size,
+      Signedness sign) {
     VariableRef new_cell = this->make_cell(base, offset, size, sign);
     CellSetT cells = this->_cells.get(base);
+
+    if (this->_summarization != nullptr && !cells.contains(new_cell) &&
+        cells.size() >= this->_summarization->max_cells()) {
+      // Do not smash the unknown value of the new cell
+      this->summarize(base);
+      this->_summarization->record();
+      return this->summarized_read(base, IntIntervalCongruence(offset), size);
+    }
+
     cells.add(new_cell);
     this->_cells.set(base, cells);
 
@@ -1380,6 +1888,11 @@ public:
       Signedness sign = this->preferred_cell_sign(rhs);
 
       for (MemoryLocationRef addr : addrs) {
+        if (this->is_summarized(addr)) {
+          this->summarized_write(addr, offset_ic, size, rhs, addrs.size() == 1);
+          continue;
+        }
+
         VariableRef cell =
             this->write_realize_single_cell(addr, offset, size, sign);
 
@@ -1388,6 +1901,8 @@ public:
         } else {
           this->weak_update(cell, rhs);
         }
+
+        this->summarize_if_needed(addr);
       }
     } else {
       // The offset is a range.
@@ -1408,6 +1923,11 @@ public:
       // update.
 
       for (MemoryLocationRef addr : addrs) {
+        if (this->is_summarized(addr)) {
+          this->summarized_write(addr, offset_ic, size, rhs, false);
+          continue;
+        }
+
         std::vector< VariableRef > cells =
             this->write_realize_range_cells(addr, offset_ic, size);
         for (VariableRef cell : cells) {
@@ -1443,6 +1963,119 @@ public:
     }
   }
 
+  void mem_write_array(VariableRef ptr,
+                       const LiteralT& rhs,
+                       const MachineInt& element_size,
+                       const MachineInt& size) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(ptr));
+    ikos_assert(element_size.is_strictly_positive());
+
+    if (size == element_size) {
+      this->mem_write(ptr, rhs, size);
+      return;
+    }
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    // Null/undefined pointer dereference
+    this->_scalar.nullity_assert_non_null(ptr);
+
+    // Writing an uninitialized variable is an error
+    if (rhs.is_var()) {
+      this->_scalar.uninit_assert_initialized(rhs.var());
+    }
+
+    this->_scalar.normalize();
+
+    if (this->_scalar.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    // Memory locations pointed by the pointer
+    PointsToSetT addrs = this->_scalar.pointer_to_points_to(ptr);
+
+    if (addrs.is_empty()) {
+      // Invalid dereference
+      this->set_to_bottom();
+      return;
+    }
+
+    if (size.is_zero()) {
+      // Does nothing
+      return;
+    }
+
+    if (addrs.is_top()) {
+      this->mem_forget_all(); // Very conservative, but sound
+      return;
+    }
+
+    //
+    // Update memory cells
+    //
+
+    IntInterval offset = this->_scalar.pointer_offset_to_interval(ptr);
+
+    if (addrs.singleton() && offset.singleton()) {
+      // Every element is written.
+      //
+      // The memory location is summarized, with a smash cell holding the
+      // written value on the bytes of the array.
+      MemoryLocationRef addr = *addrs.singleton();
+      auto zero = MachineInt::zero(offset.bit_width(), Unsigned);
+      auto one = MachineInt(1, offset.bit_width(), Unsigned);
+      MachineInt begin = *offset.singleton();
+      MachineInt end = begin + (size - one);
+
+      this->mem_forget_cells(addr, IntInterval(begin, end));
+      if (!this->is_summarized(addr)) {
+        this->summarize(addr);
+      }
+      this->forget_smash_cell(addr);
+
+      VariableRef cell = this->make_cell(addr,
+                                         zero,
+                                         element_size,
+                                         this->preferred_cell_sign(rhs));
+      this->strong_update(cell, rhs);
+      this->_summarized.insert_or_assign(addr, SmashCell{cell, begin, end});
+    } else {
+      // The written bytes are not known precisely, forget them
+      for (MemoryLocationRef addr : addrs) {
+        this->mem_forget_cells(addr, offset, size);
+      }
+    }
+
+    //
+    // Update pointer sets
+    //
+
+    auto rhs_ptr = PointerAbsValueT::bottom(1, Unsigned);
+    if (rhs.is_memory_location()) {
+      rhs_ptr =
+          PointerAbsValueT(Uninitialized::initialized(),
+                           Nullity::non_null(),
+                           PointsToSetT{rhs.memory_location()},
+                           IntInterval(MachineInt::zero(offset.bit_width(),
+                                                        Unsigned)));
+    } else if (rhs.is_pointer_var()) {
+      rhs_ptr = this->_scalar.pointer_to_pointer(rhs.var());
+    } else {
+      // Right hand side is not a pointer, nothing else to do
+      return;
+    }
+
+    for (MemoryLocationRef addr : addrs) {
+      PointerSetT pointer_set =
+          this->_pointer_sets.get(addr, offset.bit_width(), Unsigned);
+      pointer_set.add(rhs_ptr);
+      this->_pointer_sets.set(addr, pointer_set);
+    }
+  }
+
   void mem_read(const LiteralT& lhs,
                 VariableRef ptr,
                 const MachineInt& size) override {
@@ -1482,47 +2115,46 @@ public:
     // Handle memory cells
     //
 
-    // Offset interval
-    IntInterval offset_intv = this->_scalar.pointer_offset_to_interval(ptr);
+    // Offset interval-congruence
+    IntIntervalCongruence offset_ic =
+        this->_scalar.pointer_offset_to_interval_congruence(ptr);
+    const IntInterval& offset_intv = offset_ic.interval();
     ikos_assert(offset_intv.sign() == Unsigned);
 
-    if (offset_intv.singleton()) {
-      // The offset has one possible value.
-      //
-      // We can perform the usual reduction and update.
-      MachineInt offset = *offset_intv.singleton();
-      Signedness sign = this->preferred_cell_sign(lhs);
-      bool first = true;
+    // If the offset has one possible value, we can perform the usual
+    // reduction and update. Otherwise, we can only read from the smash cells
+    // of summarized memory locations, and the result is top.
+    //
+    // TODO(jnavas): note that we could have a bounded array for which we
+    // have the complete set of cells and thus we could be more
+    // precise in that case.
+    Signedness sign = this->preferred_cell_sign(lhs);
+    bool first = true;
 
-      for (MemoryLocationRef addr : addrs) {
-        VariableRef cell =
-            this->read_realize_single_cell(addr, offset, size, sign);
+    for (MemoryLocationRef addr : addrs) {
+      boost::optional< VariableRef > cell;
+
+      if (this->is_summarized(addr)) {
+        cell = this->summarized_read(addr, offset_ic, size);
+      } else if (offset_intv.singleton()) {
+        cell = this->read_realize_single_cell(addr,
+                                              *offset_intv.singleton(),
+                                              size,
+                                              sign);
+      }
 
-        if (first) {
-          this->strong_update(lhs, cell);
-          first = false;
-        } else {
-          this->weak_update(lhs, cell);
-        }
+      if (!cell) {
+        // The content is unknown
+        this->_scalar.scalar_assign_nondet(lhs.var());
+        break;
+      }
+
+      if (first) {
+        this->strong_update(lhs, *cell);
+        first = false;
+      } else {
+        this->weak_update(lhs, *cell);
       }
-    } else {
-      // The offset is a range.
-      //
-      // If we try to read a summarized region of the heap we just
-      // return top. Note that we do not keep track of writes into
-      // summarized cells that's why if we read a summarized cell
-      // the only sound result we can return is top.
-      //
-      // TODO(jnavas): note that we could have a bounded array for which we
-      // have the complete set of cells and thus we could be more
-      // precise in that case.
-      //
-      // To deal with this situation in a more systematic way
-      // we should combine anyway the value domain with some
-      // summarization array-based domain (e.g.,some array domain
-      // such as a trivial array smashing or something more
-      // expressive like Cousot&Logozzo's POPL'11).
-      this->_scalar.scalar_assign_nondet(lhs.var());
     }
 
     //
@@ -1616,8 +2248,9 @@ public:
       this->mem_forget_cells(addr, dest_intv, size_intv.ub());
     }
 
-    if (dest_addrs.singleton() && dest_intv.singleton() &&
-        !src_addrs.is_top() && src_intv.singleton() &&
+    if (dest_addrs.singleton() &&
+        !this->is_summarized(*dest_addrs.singleton()) &&
+        dest_intv.singleton() && !src_addrs.is_top() && src_intv.singleton() &&
         !size_intv.lb().is_zero()) {
       // In this case, we can be more precise
       MemoryLocationRef dest_addr = *dest_addrs.singleton();
@@ -1658,6 +2291,7 @@ public:
       ikos_assert(new_scalar);
       this->_scalar = std::move(*new_scalar);
       this->_cells.set(dest_addr, dest_cells);
+      this->summarize_if_needed(dest_addr);
     }
 
     //
@@ -1779,6 +2413,11 @@ public:
           add(dest_intv, IntInterval(zero, size_intv.ub() - one));
 
       for (MemoryLocationRef addr : addrs) {
+        if (this->is_summarized(addr)) {
+          this->mem_forget_cells(addr, unsafe_range);
+          continue;
+        }
+
         const CellSetT& cells = this->_cells.get(addr);
 
         if (!cells.is_empty()) {
@@ -1822,6 +2461,8 @@ private:
       return;
     }
 
+    this->forget_summaries();
+
     for (auto it = this->_cells.begin(), et = this->_cells.end(); it != et;
          ++it) {
       const CellSetT& cells = it->second;
@@ -1840,6 +2481,8 @@ private:
 
   /// \brief Forget the memory cells for the given memory location
   void mem_forget_cells(MemoryLocationRef addr) {
+    this->forget_summary(addr);
+
     const CellSetT& cells = this->_cells.get(addr);
 
     if (cells.is_bottom()) {
@@ -1870,6 +2513,15 @@ private:
   /// \brief Forget the memory cells in
   /// `[addr + range.lb(), addr + range.ub()]`
   void mem_forget_cells(MemoryLocationRef addr, const IntInterval& range) {
+    boost::optional< const boost::optional< SmashCell >& > smash =
+        this->_summarized.at(addr);
+    if (smash) {
+      if (*smash && !smash_range(**smash).meet(range).is_bottom()) {
+        this->forget_smash_cell(addr);
+      }
+      return;
+    }
+
     const CellSetT& cells = this->_cells.get(addr);
 
     if (cells.is_bottom() || cells.is_empty()) {
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Parameters and statistics of the cell summarization
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace ikos {
+namespace core {
+namespace memory {
+
+/// \brief Parameters and statistics of the cell summarization
+///
+/// When the number of cells of a memory location exceeds the given limit, the
+/// value domain summarizes the memory location: its cells, if they all have
+/// the same size and are contiguous, are smashed into one cell covering all of
+/// them, and no new cells are created for it. Aligned writes in the covered
+/// bytes are weak updates on the smash cell, other writes drop it.
+///
+/// This class is shared by all the abstract values of an analysis, and can be
+/// used concurrently.
+class CellSummarization {
+private:
+  /// \brief Maximum number of cells per memory location
+  std::size_t _max_cells;
+
+  /// \brief Number of summarizations
+  std::atomic< std::size_t > _num_summarizations{0};
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param max_cells Maximum number of cells per memory location
+  explicit CellSummarization(std::size_t max_cells) : _max_cells(max_cells) {}
+
+  /// \brief No copy constructor
+  CellSummarization(const CellSummarization&) = delete;
+
+  /// \brief No move constructor
+  CellSummarization(CellSummarization&&) = delete;
+
+  /// \brief No copy assignment operator
+  CellSummarization& operator=(const CellSummarization&) = delete;
+
+  /// \brief No move assignment operator
+  CellSummarization& operator=(CellSummarization&&) = delete;
+
+  /// \brief Destructor
+  ~CellSummarization() = default;
+
+  /// \brief Return the maximum number of cells per memory location
+  std::size_t max_cells() const { return this->_max_cells; }
+
+  /// \brief Record a summarization
+  void record() { this->_num_summarizations++; }
+
+  /// \brief Return the number of summarizations
+  std::size_t num_summarizations() const {
+    return this->_num_summarizations.load();
+  }
+
+}; // end class CellSummarization
+
+} // end namespace memory
+} // end namespace core
+} // end namespace ikos
@@ -62,6 +62,7 @@
 #include <ikos/core/linear_expression.hpp>
 #include <ikos/core/number.hpp>
 #include <ikos/core/support/assert.hpp>
+#include <ikos/core/support/memory_usage.hpp>
 #include <ikos/core/value/numeric/congruence.hpp>
 #include <ikos/core/value/numeric/interval.hpp>
 
@@ -254,13 +255,59 @@ private:
   using VariableMap = PatriciaTreeMap< VariableRef, ap_dim_t >;
   using Parent = numeric::AbstractDomain< Number, VariableRef, ApronDomain >;
 
-  /// \brief Deleter for ap_abstract0_t*
-  struct InvDeleter {
-    void operator()(ap_abstract0_t* inv) { ap_abstract0_free(manager(), inv); }
-  };
-
   /// \brief Wrapper for ap_abstract0_t
-  using InvPtr = std::unique_ptr< ap_abstract0_t, InvDeleter >;
+  ///
+  /// Owns the ap_abstract0_t and accounts its approximate size in MemoryUsage.
+  class InvPtr {
+  private:
+    ap_abstract0_t* _inv = nullptr;
+    MemoryAccount _account{MemoryCategory::Apron};
+
+  public:
+    /// \brief Create a null pointer
+    InvPtr() = default;
+
+    /// \brief Take ownership of the given ap_abstract0_t
+    explicit InvPtr(ap_abstract0_t* inv) : _inv(inv) { this->update(); }
+
+    /// \brief Move constructor
+    InvPtr(InvPtr&& other) noexcept
+        : _inv(other._inv), _account(std::move(other._account)) {
+      other._inv = nullptr;
+    }
+
+    /// \brief Move assignment operator
+    InvPtr& operator=(InvPtr&& other) noexcept {
+      if (this != &other) {
+        if (this->_inv != nullptr) {
+          ap_abstract0_free(manager(), this->_inv);
+        }
+        this->_inv = other._inv;
+        this->_account = std::move(other._account);
+        other._inv = nullptr;
+      }
+      return *this;
+    }
+
+    /// \brief Destructor
+    ~InvPtr() {
+      if (this->_inv != nullptr) {
+        ap_abstract0_free(manager(), this->_inv);
+      }
+    }
+
+    /// \brief Return the underlying ap_abstract0_t
+    ap_abstract0_t* get() const { return this->_inv; }
+
+    /// \brief Update the accounted size, after an in-place operation
+    void update() {
+      this->_account.update(
+          this->_inv != nullptr
+              ? ap_abstract0_size(manager(), this->_inv) * sizeof(ap_coeff_t)
+              : 0);
+    }
+
+  }; // end class InvPtr
 
 private:
   mutable std::mutex _mutex;
@@ -341,6 +388,7 @@ private:
                                 dimchange,
                                 false);
     ap_dimchange_free(dimchange);
+    this->_inv.update();
     return new_dim;
   }
 
@@ -664,12 +712,14 @@ public:
       return;
     } else if (this->same_var_map(other)) {
       ap_abstract0_join(manager(), true, this->_inv.get(), other._inv.get());
+      this->_inv.update();
     } else {
       this->_var_map = merge_var_maps(this->_var_map,
                                       this->_inv.get(),
                                       other._var_map,
                                       other._inv.get());
       ap_abstract0_join(manager(), true, this->_inv.get(), other._inv.get());
+      this->_inv.update();
     }
   }
 
@@ -689,6 +739,7 @@ public:
       return;
     } else if (this->same_var_map(other)) {
       ap_abstract0_join(manager(), true, this->_inv.get(), other._inv.get());
+      this->_inv.update();
     } else {
       InvPtr rhs = InvPtr(ap_abstract0_copy(manager(), other._inv.get()));
       this->_var_map = merge_var_maps(this->_var_map,
@@ -696,6 +747,7 @@ public:
                                       other._var_map,
                                       rhs.get());
       ap_abstract0_join(manager(), true, this->_inv.get(), rhs.get());
+      this->_inv.update();
     }
   }
 
@@ -875,6 +927,7 @@ public:
                               v_dim,
                               t,
                               nullptr);
+    this->_inv.update();
     ap_texpr0_free(t);
   }
 
@@ -929,6 +982,7 @@ private:
                               x_dim,
                               t,
                               nullptr);
+    this->_inv.update();
     ap_texpr0_free(t);
   }
 
@@ -1023,6 +1077,7 @@ public:
     }
 
     ap_abstract0_meet_tcons_array(manager(), true, this->_inv.get(), &ap_csts);
+    this->_inv.update();
 
     // Improve the precision
     for (i = 0; i < csts.size() &&
@@ -1111,6 +1166,7 @@ public:
                          this->to_ap_expr(VariableExprT(x) - value.residue()),
                          apron::to_ap_scalar(value.modulus()));
       ap_abstract0_meet_tcons_array(manager(), true, this->_inv.get(), &csts);
+      this->_inv.update();
       ap_tcons0_array_clear(&csts);
     }
   }
@@ -1149,6 +1205,7 @@ public:
                                    this->_inv.get(),
                                    dimchange);
     ap_dimchange_free(dimchange);
+    this->_inv.update();
     this->_var_map.transform([dim](VariableRef, ap_dim_t d) {
       if (d < dim) {
         return boost::optional< ap_dim_t >(d);
@@ -52,6 +52,7 @@
 #include <ikos/core/domain/numeric/linear_interval_solver.hpp>
 #include <ikos/core/number/bound.hpp>
 #include <ikos/core/support/assert.hpp>
+#include <ikos/core/support/memory_usage.hpp>
 #include <ikos/core/value/numeric/congruence.hpp>
 #include <ikos/core/value/numeric/interval.hpp>
 #include <ikos/core/value/numeric/interval_congruence.hpp>
@@ -96,6 +97,13 @@ private:
   private:
     std::vector< BoundT > _matrix;
     MatrixIndex _num_vars = 0; // size of the matrix
+    MemoryAccount _account{MemoryCategory::DBM};
+
+  private:
+    /// \brief Update the memory accounted for the matrix
+    void update_account() {
+      this->_account.update(this->_matrix.size() * sizeof(BoundT));
+    }
 
   public:
     /// \brief Create an empty matrix
@@ -137,6 +145,7 @@ private:
     void clear() {
       this->_num_vars = 0;
       this->_matrix.clear();
+      this->update_account();
     }
 
     /// \brief Clear and resize the matrix
@@ -144,6 +153,10 @@ private:
       this->_num_vars = num_vars;
       this->_matrix.clear();
       this->_matrix.resize(num_vars * num_vars, BoundT::plus_infinity());
+      for (MatrixIndex i = 0; i < num_vars; i++) {
+        this->_matrix[num_vars * i + i] = BoundT(0);
+      }
+      this->update_account();
     }
 
     /// \brief Resize the matrix to handle a new variable
@@ -154,6 +167,7 @@ private:
         this->_num_vars = 2;
         this->_matrix.resize(this->_num_vars * this->_num_vars,
                              BoundT::plus_infinity());
+        this->_matrix[0] = BoundT(0);
       } else {
         std::vector< BoundT > new_matrix((this->_num_vars + 1) *
                                              (this->_num_vars + 1),
@@ -170,10 +184,17 @@ private:
         this->_num_vars++;
       }
 
+      // The diagonal is always zero, so that a closed matrix stays closed
+      MatrixIndex i = this->_num_vars - 1;
+      this->_matrix[this->_num_vars * i + i] = BoundT(0);
+
+      this->update_account();
       return this->_num_vars - 1;
     }
 
     /// \brief Apply Floyd-Warshall algorithm to normalize the matrix
+    ///
+    /// Entries equal to +oo are skipped, since they cannot improve any bound.
     void normalize() {
       const MatrixIndex n = this->_num_vars;
 
@@ -181,17 +202,67 @@ private:
         this->_matrix[n * i + i] = BoundT(0);
       }
 
+      std::vector< MatrixIndex > succs;
+      succs.reserve(n);
+
       for (MatrixIndex k = 0; k < n; k++) {
+        // Finite entries of the row k
+        succs.clear();
+        for (MatrixIndex j = 0; j < n; j++) {
+          if (!this->_matrix[n * k + j].is_plus_infinity()) {
+            succs.push_back(j);
+          }
+        }
+
         for (MatrixIndex i = 0; i < n; i++) {
-          for (MatrixIndex j = 0; j < n; j++) {
+          if (this->_matrix[n * i + k].is_plus_infinity()) {
+            continue;
+          }
+
+          const BoundT w_i_k = this->_matrix[n * i + k];
+          for (MatrixIndex j : succs) {
             this->_matrix[n * i + j] =
-                min(this->_matrix[n * i + j],
-                    this->_matrix[n * i + k] + this->_matrix[n * k + j]);
+                min(this->_matrix[n * i + j], w_i_k + this->_matrix[n * k + j]);
           }
         }
       }
     }
 
+    /// \brief Normalize the matrix after the element (i, j) decreased
+    ///
+    /// This is the incremental closure, in O(n^2) in the worst case. Only the
+    /// rows with a finite M[k, i] and the columns with a finite M[j, k] are
+    /// visited.
+    ///
+    /// Precondition: the matrix was normalized before the update, and the new
+    /// element does not create a negative cycle, i.e M[j, i] + M[i, j] >= 0
+    void normalize_edge(MatrixIndex i, MatrixIndex j) {
+      const MatrixIndex n = this->_num_vars;
+
+      std::vector< MatrixIndex > preds;
+      std::vector< MatrixIndex > succs;
+
+      for (MatrixIndex k = 0; k < n; k++) {
+        if (!this->_matrix[n * k + i].is_plus_infinity()) {
+          preds.push_back(k);
+        }
+        if (!this->_matrix[n * j + k].is_plus_infinity()) {
+          succs.push_back(k);
+        }
+      }
+
+      // M[k, i] and M[j, l] are left unchanged by the loop, because the new
+      // element does not create a negative cycle.
+      const BoundT w_i_j = this->_matrix[n * i + j];
+      for (MatrixIndex k : preds) {
+        const BoundT w_k_j = this->_matrix[n * k + i] + w_i_j;
+        for (MatrixIndex l : succs) {
+          this->_matrix[n * k + l] =
+              min(this->_matrix[n * k + l], w_k_j + this->_matrix[n * j + l]);
+        }
+      }
+    }
+
     /// \brief Return true if the matrix has a negative cycle
     ///
     /// Precondition: matrix is normalized
@@ -825,12 +896,33 @@ private:
   }
 
   /// \brief Add constraint v_i - v_j <= c
+  ///
+  /// If the matrix is normalized, it is kept normalized using the incremental
+  /// closure.
   void add_constraint(MatrixIndex i, MatrixIndex j, const BoundT& c) {
+    if (this->_is_bottom) {
+      return;
+    }
+
     const BoundT& w = this->_matrix(j, i);
-    if (c < w) {
+    if (!(c < w)) {
+      return;
+    }
+
+    if (!this->_is_normalized) {
       this->_matrix(j, i) = c;
+      return;
+    }
+
+    if (c + this->_matrix(i, j) < BoundT(0)) {
+      // Negative cycle
+      this->_is_bottom = true;
       this->_is_normalized = false;
+      return;
     }
+
+    this->_matrix(j, i) = c;
+    this->_matrix.normalize_edge(j, i);
   }
 
   /// \brief Add constraint v_i - v_j <= c
@@ -844,6 +936,8 @@ private:
   }
 
   /// \brief Apply v_i = v_i + c
+  ///
+  /// This preserves the normalization.
   void increment(MatrixIndex i, const BoundT& c) {
     if (c == BoundT(0)) {
       return;
@@ -855,8 +949,6 @@ private:
         this->_matrix(j, i) += c;
       }
     }
-
-    this->_is_normalized = false;
   }
 
   /// \brief Apply v_i = v_i + c
@@ -1369,6 +1461,8 @@ public:
 
 private:
   /// \brief Forget all informations about variable k
+  ///
+  /// This preserves the normalization.
   void forget(MatrixIndex k) {
     // Use informations about k to improve all constraints
     // Not necessary if already normalized
@@ -1395,8 +1489,6 @@ private:
       this->_matrix(k, i) = BoundT::plus_infinity();
     }
     this->_matrix(k, k) = BoundT(0);
-
-    this->_is_normalized = false;
   }
 
 public:
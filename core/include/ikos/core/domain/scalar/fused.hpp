@@ -0,0 +1,1988 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Scalar abstract domain with a fused per-variable record
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/core/domain/machine_int/abstract_domain.hpp>
+#include <ikos/core/domain/scalar/abstract_domain.hpp>
+#include <ikos/core/domain/separate_domain.hpp>
+#include <ikos/core/value/nullity.hpp>
+#include <ikos/core/value/pointer/points_to_set.hpp>
+#include <ikos/core/value/uninitialized.hpp>
+
+namespace ikos {
+namespace core {
+namespace scalar {
+
+namespace fused_domain_impl {
+
+/// \brief Non-relational abstract value of a scalar variable
+///
+/// The record holds:
+///   * An uninitialized abstract value
+///   * A nullity abstract value
+///   * A points-to set of memory locations
+///
+/// The record is reduced: if any field is bottom, all fields are bottom.
+template < typename MemoryLocationRef >
+class Record final
+    : public core::AbstractDomain< Record< MemoryLocationRef > > {
+public:
+  using PointsToSetT = PointsToSet< MemoryLocationRef >;
+
+private:
+  /// \brief Uninitialized
+  Uninitialized _uninitialized;
+
+  /// \brief Nullity
+  Nullity _nullity;
+
+  /// \brief Set of memory locations (i.e, addresses) pointed by the variable
+  PointsToSetT _points_to;
+
+private:
+  /// \brief Reduce the record
+  void reduce() {
+    if (this->_uninitialized.is_bottom() || this->_nullity.is_bottom() ||
+        this->_points_to.is_bottom()) {
+      this->set_to_bottom();
+    }
+  }
+
+public:
+  /// \brief Create the top abstract value
+  static Record top() {
+    return Record(Uninitialized::top(), Nullity::top(), PointsToSetT::top());
+  }
+
+  /// \brief Create the bottom abstract value
+  static Record bottom() {
+    return Record(Uninitialized::bottom(),
+                  Nullity::bottom(),
+                  PointsToSetT::bottom());
+  }
+
+  /// \brief Create the record of a variable with the given initialization,
+  /// with no information on its nullity and points-to set
+  explicit Record(Uninitialized uninitialized)
+      : _uninitialized(std::move(uninitialized)),
+        _nullity(Nullity::top()),
+        _points_to(PointsToSetT::top()) {
+    this->reduce();
+  }
+
+  /// \brief Create the record with the given uninitialized, nullity and
+  /// points-to set
+  Record(Uninitialized uninitialized, Nullity nullity, PointsToSetT points_to)
+      : _uninitialized(std::move(uninitialized)),
+        _nullity(std::move(nullity)),
+        _points_to(std::move(points_to)) {
+    this->reduce();
+  }
+
+  /// \brief Copy constructor
+  Record(const Record&) = default;
+
+  /// \brief Move constructor
+  Record(Record&&) noexcept = default;
+
+  /// \brief Copy assignment operator
+  Record& operator=(const Record&) = default;
+
+  /// \brief Move assignment operator
+  Record& operator=(Record&&) noexcept = default;
+
+  /// \brief Destructor
+  ~Record() override = default;
+
+  /// \brief Return the uninitialized
+  const Uninitialized& uninitialized() const { return this->_uninitialized; }
+
+  /// \brief Return the nullity
+  const Nullity& nullity() const { return this->_nullity; }
+
+  /// \brief Return the points-to set
+  const PointsToSetT& points_to() const { return this->_points_to; }
+
+  /// \brief Set the uninitialized
+  void set_uninitialized(Uninitialized value) {
+    this->_uninitialized = std::move(value);
+    this->reduce();
+  }
+
+  /// \brief Set the nullity
+  void set_nullity(Nullity value) {
+    this->_nullity = std::move(value);
+    this->reduce();
+  }
+
+  /// \brief Set the points-to set
+  void set_points_to(PointsToSetT value) {
+    this->_points_to = std::move(value);
+    this->reduce();
+  }
+
+  /// \brief Refine the uninitialized
+  void refine_uninitialized(const Uninitialized& value) {
+    this->_uninitialized.meet_with(value);
+    this->reduce();
+  }
+
+  /// \brief Refine the nullity
+  void refine_nullity(const Nullity& value) {
+    this->_nullity.meet_with(value);
+    this->reduce();
+  }
+
+  /// \brief Refine the points-to set
+  void refine_points_to(const PointsToSetT& value) {
+    this->_points_to.meet_with(value);
+    this->reduce();
+  }
+
+  void normalize() override {
+    // Already performed by the reduction
+  }
+
+  bool is_bottom() const override {
+    return this->_uninitialized.is_bottom(); // Correct because of reduction
+  }
+
+  bool is_top() const override {
+    return this->_uninitialized.is_top() && this->_nullity.is_top() &&
+           this->_points_to.is_top();
+  }
+
+  void set_to_bottom() override {
+    this->_uninitialized.set_to_bottom();
+    this->_nullity.set_to_bottom();
+    this->_points_to.set_to_bottom();
+  }
+
+  void set_to_top() override {
+    this->_uninitialized.set_to_top();
+    this->_nullity.set_to_top();
+    this->_points_to.set_to_top();
+  }
+
+  bool leq(const Record& other) const override {
+    return this->_uninitialized.leq(other._uninitialized) &&
+           this->_nullity.leq(other._nullity) &&
+           this->_points_to.leq(other._points_to);
+  }
+
+  bool equals(const Record& other) const override {
+    return this->_uninitialized.equals(other._uninitialized) &&
+           this->_nullity.equals(other._nullity) &&
+           this->_points_to.equals(other._points_to);
+  }
+
+  void join_with(const Record& other) override {
+    this->_uninitialized.join_with(other._uninitialized);
+    this->_nullity.join_with(other._nullity);
+    this->_points_to.join_with(other._points_to);
+  }
+
+  void join_loop_with(const Record& other) override {
+    this->_uninitialized.join_loop_with(other._uninitialized);
+    this->_nullity.join_loop_with(other._nullity);
+    this->_points_to.join_loop_with(other._points_to);
+  }
+
+  void join_iter_with(const Record& other) override {
+    this->_uninitialized.join_iter_with(other._uninitialized);
+    this->_nullity.join_iter_with(other._nullity);
+    this->_points_to.join_iter_with(other._points_to);
+  }
+
+  void widen_with(const Record& other) override {
+    this->_uninitialized.widen_with(other._uninitialized);
+    this->_nullity.widen_with(other._nullity);
+    this->_points_to.widen_with(other._points_to);
+  }
+
+  void meet_with(const Record& other) override {
+    this->_uninitialized.meet_with(other._uninitialized);
+    this->_nullity.meet_with(other._nullity);
+    this->_points_to.meet_with(other._points_to);
+    this->reduce();
+  }
+
+  void narrow_with(const Record& other) override {
+    this->_uninitialized.narrow_with(other._uninitialized);
+    this->_nullity.narrow_with(other._nullity);
+    this->_points_to.narrow_with(other._points_to);
+    this->reduce();
+  }
+
+  void dump(std::ostream& o) const override {
+    if (this->is_bottom()) {
+      o << "⊥";
+    } else {
+      o << "(";
+      this->_uninitialized.dump(o);
+      o << ", ";
+      this->_nullity.dump(o);
+      o << ", ";
+      this->_points_to.dump(o);
+      o << ")";
+    }
+  }
+
+  static std::string name() { return "scalar record"; }
+
+}; // end class Record
+
+} // end namespace fused_domain_impl
+
+/// \brief Scalar abstract domain with a fused per-variable record
+///
+/// The fused domain is a scalar domain with the same semantics as the
+/// composite domain (see scalar::CompositeDomain) built on a separate
+/// uninitialized domain and a separate nullity domain.
+///
+/// Instead of keeping one separate map for the initialization, one for the
+/// nullity and one for the points-to sets, the fused domain keeps a single
+/// persistent map from variables to records holding all the non-relational
+/// information on a variable. A pointer assignment, load or store therefore
+/// only requires one lookup and one update, and the lattice operations only
+/// traverse one tree.
+///
+/// The offset of a pointer `p` is still modelled by the underlying machine
+/// integer abstract domain `MachineIntDomain` with the special variable
+/// `offset_var(p)`, so that it can be related to other integer variables.
+template < typename VariableRef,
+           typename MemoryLocationRef,
+           typename MachineIntDomain >
+class FusedDomain final
+    : public scalar::AbstractDomain<
+          VariableRef,
+          MemoryLocationRef,
+          FusedDomain< VariableRef, MemoryLocationRef, MachineIntDomain > > {
+public:
+  static_assert(
+      machine_int::IsAbstractDomain< MachineIntDomain, VariableRef >::value,
+      "MachineIntDomain must implement machine_int::AbstractDomain");
+
+public:
+  using IntUnaryOperator = machine_int::UnaryOperator;
+  using IntBinaryOperator = machine_int::BinaryOperator;
+  using IntPredicate = machine_int::Predicate;
+  using IntLinearExpression = LinearExpression< MachineInt, VariableRef >;
+  using IntInterval = machine_int::Interval;
+  using IntCongruence = machine_int::Congruence;
+  using IntIntervalCongruence = machine_int::IntervalCongruence;
+  using PointerPredicate = pointer::Predicate;
+  using PointsToSetT = PointsToSet< MemoryLocationRef >;
+  using PointerAbsValueT = PointerAbsValue< MemoryLocationRef >;
+  using PointerSetT = PointerSet< MemoryLocationRef >;
+
+private:
+  using Record = fused_domain_impl::Record< MemoryLocationRef >;
+  using RecordMap = SeparateDomain< VariableRef, Record >;
+  using IntVariableTrait = machine_int::VariableTraits< VariableRef >;
+  using ScalarVariableTrait = scalar::VariableTraits< VariableRef >;
+
+private:
+  /// \brief Map variables to their non-relational record
+  RecordMap _records;
+
+  /// \brief Underlying machine integer abstract domains
+  MachineIntDomain _integer;
+
+private:
+  /// \brief Constructor
+  FusedDomain(RecordMap records, MachineIntDomain integer)
+      : _records(std::move(records)), _integer(std::move(integer)) {
+    this->normalize();
+  }
+
+public:
+  /// \brief Create an abstract value with the given machine integer abstract
+  /// value, and no information on the initialization, nullity and points-to
+  /// sets of variables
+  ///
+  /// \param integer The machine integer abstract value
+  explicit FusedDomain(MachineIntDomain integer)
+      : _records(RecordMap::top()), _integer(std::move(integer)) {
+    this->normalize();
+  }
+
+  /// \brief Copy constructor
+  FusedDomain(const FusedDomain&) noexcept(
+      std::is_nothrow_copy_constructible< MachineIntDomain >::value) = default;
+
+  /// \brief Move constructor
+  FusedDomain(FusedDomain&&) noexcept(
+      std::is_nothrow_move_constructible< MachineIntDomain >::value) = default;
+
+  /// \brief Copy assignment operator
+  FusedDomain& operator=(const FusedDomain&) noexcept(
+      std::is_nothrow_copy_assignable< MachineIntDomain >::value) = default;
+
+  /// \brief Move assignment operator
+  FusedDomain& operator=(FusedDomain&&) noexcept(
+      std::is_nothrow_move_assignable< MachineIntDomain >::value) = default;
+
+  /// \brief Destructor
+  ~FusedDomain() override = default;
+
+  /// \name Implement core abstract domain methods
+  /// @{
+
+  void normalize() override {
+    if (this->_records.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    this->_integer.normalize();
+    if (this->_integer.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+  }
+
+private:
+  /// \brief Return true if the abstract value is bottom
+  ///
+  /// This is not always correct since it doesn't check this->_integer
+  bool is_bottom_fast() const { return this->_records.is_bottom(); }
+
+  /// \brief Return the record of the given variable
+  Record record(VariableRef x) const { return this->_records.get(x); }
+
+  /// \brief Set the record of the given variable
+  void set_record(VariableRef x, const Record& value) {
+    this->_records.set(x, value);
+  }
+
+  /// \brief Assign `x = initialized`, forgetting its nullity and points-to set
+  void assign_initialized(VariableRef x) {
+    this->_records.set(x, Record(Uninitialized::initialized()));
+  }
+
+  /// \brief Assign `x = uninitialized`, forgetting its nullity and points-to
+  /// set
+  void assign_uninitialized(VariableRef x) {
+    this->_records.set(x, Record(Uninitialized::uninitialized()));
+  }
+
+  /// \brief Assert that `x` is initialized
+  ///
+  /// This only requires one traversal of the map.
+  void assert_initialized(VariableRef x) {
+    this->_records.refine(x, Record(Uninitialized::initialized()));
+  }
+
+  /// \brief Assign the machine integer offset of `p` to zero
+  void assign_offset_zero(VariableRef p) {
+    VariableRef offset = ScalarVariableTrait::offset_var(p);
+    this->_integer.assign(offset,
+                          MachineInt::zero(IntVariableTrait::bit_width(offset),
+                                           IntVariableTrait::sign(offset)));
+  }
+
+public:
+  bool is_bottom() const override {
+    return this->_records.is_bottom() || this->_integer.is_bottom();
+  }
+
+  bool is_top() const override {
+    return this->_records.is_top() && this->_integer.is_top();
+  }
+
+  void set_to_bottom() override {
+    this->_records.set_to_bottom();
+    this->_integer.set_to_bottom();
+  }
+
+  void set_to_top() override {
+    this->_records.set_to_top();
+    this->_integer.set_to_top();
+  }
+
+  bool leq(const FusedDomain& other) const override {
+    if (this->is_bottom()) {
+      return true;
+    } else if (other.is_bottom()) {
+      return false;
+    } else {
+      return this->_records.leq(other._records) &&
+             this->_integer.leq(other._integer);
+    }
+  }
+
+  bool equals(const FusedDomain& other) const override {
+    if (this->is_bottom()) {
+      return other.is_bottom();
+    } else if (other.is_bottom()) {
+      return false;
+    } else {
+      return this->_records.equals(other._records) &&
+             this->_integer.equals(other._integer);
+    }
+  }
+
+  void join_with(FusedDomain&& other) override {
+    this->normalize();
+    other.normalize();
+    if (this->is_bottom()) {
+      this->operator=(std::move(other));
+    } else if (other.is_bottom()) {
+      return;
+    } else {
+      this->_records.join_with(std::move(other._records));
+      this->_integer.join_with(std::move(other._integer));
+    }
+  }
+
+  void join_with(const FusedDomain& other) override {
+    this->normalize();
+    if (this->is_bottom()) {
+      this->operator=(other);
+    } else if (other.is_bottom()) {
+      return;
+    } else {
+      this->_records.join_with(other._records);
+      this->_integer.join_with(other._integer);
+    }
+  }
+
+  void join_loop_with(FusedDomain&& other) override {
+    this->normalize();
+    other.normalize();
+    if (this->is_bottom()) {
+      this->operator=(std::move(other));
+    } else if (other.is_bottom()) {
+      return;
+    } else {
+      this->_records.join_loop_with(std::move(other._records));
+      this->_integer.join_loop_with(std::move(other._integer));
+    }
+  }
+
+  void join_loop_with(const FusedDomain& other) override {
+    this->normalize();
+    if (this->is_bottom()) {
+      this->operator=(other);
+    } else if (other.is_bottom()) {
+      return;
+    } else {
+      this->_records.join_loop_with(other._records);
+      this->_integer.join_loop_with(other._integer);
+    }
+  }
+
+  void join_iter_with(FusedDomain&& other) override {
+    this->normalize();
+    other.normalize();
+    if (this->is_bottom()) {
+      this->operator=(std::move(other));
+    } else if (other.is_bottom()) {
+      return;
+    } else {
+      this->_records.join_iter_with(std::move(other._records));
+      this->_integer.join_iter_with(std::move(other._integer));
+    }
+  }
+
+  void join_iter_with(const FusedDomain& other) override {
+    this->normalize();
+    if (this->is_bottom()) {
+      this->operator=(other);
+    } else if (other.is_bottom()) {
+      return;
+    } else {
+      this->_records.join_iter_with(other._records);
+      this->_integer.join_iter_with(other._integer);
+    }
+  }
+
+  void widen_with(const FusedDomain& other) override {
+    this->normalize();
+    if (this->is_bottom()) {
+      this->operator=(other);
+    } else if (other.is_bottom()) {
+      return;
+    } else {
+      this->_records.widen_with(other._records);
+      this->_integer.widen_with(other._integer);
+    }
+  }
+
+  void widen_threshold_with(const FusedDomain& other,
+                            const MachineInt& threshold) override {
+    this->normalize();
+    if (this->is_bottom()) {
+      this->operator=(other);
+    } else if (other.is_bottom()) {
+      return;
+    } else {
+      this->_records.widen_with(other._records);
+      this->_integer.widen_threshold_with(other._integer, threshold);
+    }
+  }
+
+  void meet_with(const FusedDomain& other) override {
+    this->normalize();
+    if (this->is_bottom()) {
+      return;
+    } else if (other.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      this->_records.meet_with(other._records);
+      this->_integer.meet_with(other._integer);
+    }
+  }
+
+  void narrow_with(const FusedDomain& other) override {
+    this->normalize();
+    if (this->is_bottom()) {
+      return;
+    } else if (other.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      this->_records.narrow_with(other._records);
+      this->_integer.narrow_with(other._integer);
+    }
+  }
+
+  void narrow_threshold_with(const FusedDomain& other,
+                             const MachineInt& threshold) override {
+    this->normalize();
+    if (this->is_bottom()) {
+      return;
+    } else if (other.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      this->_records.narrow_with(other._records);
+      this->_integer.narrow_threshold_with(other._integer, threshold);
+    }
+  }
+
+  FusedDomain join(const FusedDomain& other) const override {
+    if (this->is_bottom()) {
+      return other;
+    } else if (other.is_bottom()) {
+      return *this;
+    } else {
+      return FusedDomain(this->_records.join(other._records),
+                         this->_integer.join(other._integer));
+    }
+  }
+
+  FusedDomain join_loop(const FusedDomain& other) const override {
+    if (this->is_bottom()) {
+      return other;
+    } else if (other.is_bottom()) {
+      return *this;
+    } else {
+      return FusedDomain(this->_records.join_loop(other._records),
+                         this->_integer.join_loop(other._integer));
+    }
+  }
+
+  FusedDomain join_iter(const FusedDomain& other) const override {
+    if (this->is_bottom()) {
+      return other;
+    } else if (other.is_bottom()) {
+      return *this;
+    } else {
+      return FusedDomain(this->_records.join_iter(other._records),
+                         this->_integer.join_iter(other._integer));
+    }
+  }
+
+  FusedDomain widening(const FusedDomain& other) const override {
+    if (this->is_bottom()) {
+      return other;
+    } else if (other.is_bottom()) {
+      return *this;
+    } else {
+      return FusedDomain(this->_records.widening(other._records),
+                         this->_integer.widening(other._integer));
+    }
+  }
+
+  FusedDomain widening_threshold(const FusedDomain& other,
+                                 const MachineInt& threshold) const override {
+    if (this->is_bottom()) {
+      return other;
+    } else if (other.is_bottom()) {
+      return *this;
+    } else {
+      return FusedDomain(this->_records.widening(other._records),
+                         this->_integer.widening_threshold(other._integer,
+                                                           threshold));
+    }
+  }
+
+  FusedDomain meet(const FusedDomain& other) const override {
+    if (this->is_bottom()) {
+      return *this;
+    } else if (other.is_bottom()) {
+      return other;
+    } else {
+      return FusedDomain(this->_records.meet(other._records),
+                         this->_integer.meet(other._integer));
+    }
+  }
+
+  FusedDomain narrowing(const FusedDomain& other) const override {
+    if (this->is_bottom()) {
+      return *this;
+    } else if (other.is_bottom()) {
+      return other;
+    } else {
+      return FusedDomain(this->_records.narrowing(other._records),
+                         this->_integer.narrowing(other._integer));
+    }
+  }
+
+  FusedDomain narrowing_threshold(const FusedDomain& other,
+                                  const MachineInt& threshold) const override {
+    if (this->is_bottom()) {
+      return *this;
+    } else if (other.is_bottom()) {
+      return other;
+    } else {
+      return FusedDomain(this->_records.narrowing(other._records),
+                         this->_integer.narrowing_threshold(other._integer,
+                                                            threshold));
+    }
+  }
+
+  /// @}
+  /// \name Implement uninitialized abstract domain methods
+  /// @{
+
+  void uninit_assert_initialized(VariableRef x) override {
+    this->assert_initialized(x);
+  }
+
+  bool uninit_is_initialized(VariableRef x) const override {
+    Uninitialized value = this->record(x).uninitialized();
+    return value.is_bottom() || value.is_initialized();
+  }
+
+  bool uninit_is_uninitialized(VariableRef x) const override {
+    Uninitialized value = this->record(x).uninitialized();
+    return value.is_bottom() || value.is_uninitialized();
+  }
+
+  void uninit_refine(VariableRef x, Uninitialized value) override {
+    this->_records.refine(x, Record(std::move(value)));
+  }
+
+  Uninitialized uninit_to_uninitialized(VariableRef x) const override {
+    return this->record(x).uninitialized();
+  }
+
+  /// @}
+  /// \name Implement machine integer abstract domain methods
+  /// @{
+
+  void int_assign(VariableRef x, const MachineInt& n) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.assign(x, n);
+  }
+
+  void int_assign_undef(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_uninitialized(x);
+    this->_integer.forget(x);
+  }
+
+  void int_assign_nondet(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.forget(x);
+  }
+
+  void int_assign(VariableRef x, VariableRef y) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+    ikos_assert(ScalarVariableTrait::is_int(y));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(x, this->record(y));
+    this->_integer.assign(x, y);
+  }
+
+  void int_assign(VariableRef x, const IntLinearExpression& e) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    for (const auto& term : e) {
+      ikos_assert(ScalarVariableTrait::is_int(term.first));
+      this->assert_initialized(term.first);
+    }
+
+    if (this->_records.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.assign(x, e);
+  }
+
+  void int_apply(IntUnaryOperator op, VariableRef x, VariableRef y) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+    ikos_assert(ScalarVariableTrait::is_int(y));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assert_initialized(y);
+
+    if (this->_records.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.apply(op, x, y);
+  }
+
+  void int_apply(IntBinaryOperator op,
+                 VariableRef x,
+                 VariableRef y,
+                 VariableRef z) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+    ikos_assert(ScalarVariableTrait::is_int(y));
+    ikos_assert(ScalarVariableTrait::is_int(z));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assert_initialized(y);
+    this->assert_initialized(z);
+
+    if (this->_records.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.apply(op, x, y, z);
+  }
+
+  void int_apply(IntBinaryOperator op,
+                 VariableRef x,
+                 VariableRef y,
+                 const MachineInt& z) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+    ikos_assert(ScalarVariableTrait::is_int(y));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assert_initialized(y);
+
+    if (this->_records.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.apply(op, x, y, z);
+  }
+
+  void int_apply(IntBinaryOperator op,
+                 VariableRef x,
+                 const MachineInt& y,
+                 VariableRef z) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+    ikos_assert(ScalarVariableTrait::is_int(z));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assert_initialized(z);
+
+    if (this->_records.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.apply(op, x, y, z);
+  }
+
+  void int_add(IntPredicate pred, VariableRef x, VariableRef y) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+    ikos_assert(ScalarVariableTrait::is_int(y));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assert_initialized(x);
+    this->assert_initialized(y);
+
+    if (this->_records.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    this->_integer.add(pred, x, y);
+  }
+
+  void int_add(IntPredicate pred, VariableRef x, const MachineInt& y) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assert_initialized(x);
+
+    if (this->_records.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    this->_integer.add(pred, x, y);
+  }
+
+  void int_add(IntPredicate pred, const MachineInt& x, VariableRef y) override {
+    ikos_assert(ScalarVariableTrait::is_int(y));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assert_initialized(y);
+
+    if (this->_records.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    this->_integer.add(pred, x, y);
+  }
+
+  void int_set(VariableRef x, const IntInterval& value) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.set(x, value);
+  }
+
+  void int_set(VariableRef x, const IntCongruence& value) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.set(x, value);
+  }
+
+  void int_set(VariableRef x, const IntIntervalCongruence& value) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.set(x, value);
+  }
+
+  void int_refine(VariableRef x, const IntInterval& value) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    this->_integer.refine(x, value);
+  }
+
+  void int_refine(VariableRef x, const IntCongruence& value) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    this->_integer.refine(x, value);
+  }
+
+  void int_refine(VariableRef x, const IntIntervalCongruence& value) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    this->_integer.refine(x, value);
+  }
+
+  void int_forget(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->_records.forget(x);
+    this->_integer.forget(x);
+  }
+
+  IntInterval int_to_interval(VariableRef x) const override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    return this->_integer.to_interval(x);
+  }
+
+  IntInterval int_to_interval(const IntLinearExpression& e) const override {
+    return this->_integer.to_interval(e);
+  }
+
+  IntCongruence int_to_congruence(VariableRef x) const override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    return this->_integer.to_congruence(x);
+  }
+
+  IntCongruence int_to_congruence(const IntLinearExpression& e) const override {
+    return this->_integer.to_congruence(e);
+  }
+
+  IntIntervalCongruence int_to_interval_congruence(
+      VariableRef x) const override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    return this->_integer.to_interval_congruence(x);
+  }
+
+  IntIntervalCongruence int_to_interval_congruence(
+      const IntLinearExpression& e) const override {
+    return this->_integer.to_interval_congruence(e);
+  }
+
+  /// @}
+  /// \name Implement non-negative loop counter abstract domain methods
+  /// @{
+
+  void counter_mark(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    this->_integer.counter_mark(x);
+  }
+
+  void counter_unmark(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    this->_integer.counter_unmark(x);
+  }
+
+  void counter_init(VariableRef x, const MachineInt& c) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    this->_integer.counter_init(x, c);
+  }
+
+  void counter_incr(VariableRef x, const MachineInt& k) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    this->_integer.counter_incr(x, k);
+  }
+
+  void counter_forget(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+
+    this->_integer.counter_forget(x);
+  }
+
+  /// @}
+  /// \name Implement floating point abstract domain methods
+  /// @{
+
+  void float_assign_undef(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_float(x));
+
+    this->assign_uninitialized(x);
+  }
+
+  void float_assign_nondet(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_float(x));
+
+    this->assign_initialized(x);
+  }
+
+  void float_assign(VariableRef x, VariableRef y) override {
+    ikos_assert(ScalarVariableTrait::is_float(x));
+    ikos_assert(ScalarVariableTrait::is_float(y));
+
+    this->set_record(x, this->record(y));
+  }
+
+  void float_forget(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_float(x));
+
+    this->_records.forget(x);
+  }
+
+  /// @}
+  /// \name Implement nullity abstract domain methods
+  /// @{
+
+  void nullity_assert_null(VariableRef p) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->_records.refine(p,
+                          Record(Uninitialized::initialized(),
+                                 Nullity::null(),
+                                 PointsToSetT::empty()));
+  }
+
+  void nullity_assert_non_null(VariableRef p) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    Record value = this->record(p);
+
+    if (value.points_to().is_empty()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    value.refine_uninitialized(Uninitialized::initialized());
+    value.refine_nullity(Nullity::non_null());
+    this->set_record(p, value);
+  }
+
+  bool nullity_is_null(VariableRef p) const override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    Nullity value = this->record(p).nullity();
+    return value.is_bottom() || value.is_null();
+  }
+
+  bool nullity_is_non_null(VariableRef p) const override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    Nullity value = this->record(p).nullity();
+    return value.is_bottom() || value.is_non_null();
+  }
+
+  void nullity_set(VariableRef p, Nullity value) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    Record record_p = this->record(p);
+    record_p.set_nullity(std::move(value));
+    this->set_record(p, record_p);
+  }
+
+  void nullity_refine(VariableRef p, Nullity value) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    this->_records.refine(p,
+                          Record(Uninitialized::top(),
+                                 std::move(value),
+                                 PointsToSetT::top()));
+  }
+
+  Nullity nullity_to_nullity(VariableRef p) const override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    return this->record(p).nullity();
+  }
+
+  /// @}
+  /// \name Implement pointer abstract domain methods
+  /// @{
+
+  void pointer_assign(VariableRef p,
+                      MemoryLocationRef addr,
+                      Nullity nullity) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(p,
+                     Record(Uninitialized::initialized(),
+                            std::move(nullity),
+                            PointsToSetT{addr}));
+    this->assign_offset_zero(p);
+  }
+
+  void pointer_assign_null(VariableRef p) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(p,
+                     Record(Uninitialized::initialized(),
+                            Nullity::null(),
+                            PointsToSetT::empty()));
+    this->assign_offset_zero(p);
+  }
+
+  void pointer_assign_undef(VariableRef p) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(p,
+                     Record(Uninitialized::uninitialized(),
+                            Nullity::top(),
+                            PointsToSetT::empty()));
+    this->_integer.forget(ScalarVariableTrait::offset_var(p));
+  }
+
+  void pointer_assign_nondet(VariableRef p) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_initialized(p);
+    this->_integer.forget(ScalarVariableTrait::offset_var(p));
+  }
+
+  void pointer_assign(VariableRef p, VariableRef q) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+    ikos_assert(ScalarVariableTrait::is_pointer(q));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(p, this->record(q));
+    this->_integer.assign(ScalarVariableTrait::offset_var(p),
+                          ScalarVariableTrait::offset_var(q));
+  }
+
+  void pointer_assign(VariableRef p, VariableRef q, VariableRef o) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+    ikos_assert(ScalarVariableTrait::is_pointer(q));
+    ikos_assert(ScalarVariableTrait::is_int(o));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assert_initialized(o);
+
+    Record value = this->record(q);
+    value.refine_uninitialized(Uninitialized::initialized());
+
+    if (this->_records.is_bottom() || value.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    if (p != q) {
+      this->set_record(q, value);
+    }
+    this->set_record(p, value);
+    this->_integer.apply(IntBinaryOperator::Add,
+                         ScalarVariableTrait::offset_var(p),
+                         ScalarVariableTrait::offset_var(q),
+                         o);
+  }
+
+  void pointer_assign(VariableRef p,
+                      VariableRef q,
+                      const MachineInt& o) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+    ikos_assert(ScalarVariableTrait::is_pointer(q));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    Record value = this->record(q);
+    value.refine_uninitialized(Uninitialized::initialized());
+
+    if (value.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    if (p != q) {
+      this->set_record(q, value);
+    }
+    this->set_record(p, value);
+    this->_integer.apply(IntBinaryOperator::Add,
+                         ScalarVariableTrait::offset_var(p),
+                         ScalarVariableTrait::offset_var(q),
+                         o);
+  }
+
+  void pointer_assign(VariableRef p,
+                      VariableRef q,
+                      const IntLinearExpression& o) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+    ikos_assert(ScalarVariableTrait::is_pointer(q));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    for (const auto& term : o) {
+      ikos_assert(ScalarVariableTrait::is_int(term.first));
+      this->assert_initialized(term.first);
+    }
+
+    Record value = this->record(q);
+    value.refine_uninitialized(Uninitialized::initialized());
+
+    if (this->_records.is_bottom() || value.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    if (p != q) {
+      this->set_record(q, value);
+    }
+    this->set_record(p, value);
+    VariableRef offset_p = ScalarVariableTrait::offset_var(p);
+    VariableRef offset_q = ScalarVariableTrait::offset_var(q);
+    auto one = MachineInt(1,
+                          IntVariableTrait::bit_width(offset_p),
+                          IntVariableTrait::sign(offset_p));
+    IntLinearExpression offset(o);
+    offset.add(one, offset_q);
+    this->_integer.assign(offset_p, offset);
+  }
+
+  void pointer_add(PointerPredicate pred,
+                   VariableRef p,
+                   VariableRef q) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+    ikos_assert(ScalarVariableTrait::is_pointer(q));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    Record record_p = this->record(p);
+    record_p.refine_uninitialized(Uninitialized::initialized());
+    Record record_q = this->record(q);
+    record_q.refine_uninitialized(Uninitialized::initialized());
+
+    if (record_p.is_bottom() || record_q.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    // Nullity reduction, see nullity::SeparateDomain::add
+    Nullity nullity_p = record_p.nullity();
+    Nullity nullity_q = record_q.nullity();
+
+    switch (pred) {
+      case PointerPredicate::EQ: {
+        Nullity nullity_pq = nullity_p.meet(nullity_q);
+        record_p.set_nullity(nullity_pq);
+        record_q.set_nullity(nullity_pq);
+      } break;
+      case PointerPredicate::NE:
+      case PointerPredicate::GT:
+      case PointerPredicate::LT: {
+        if (nullity_p.is_null() && nullity_q.is_null()) {
+          this->set_to_bottom();
+          return;
+        } else if (nullity_p.is_top() && nullity_q.is_null()) {
+          record_p.set_nullity(Nullity::non_null());
+        } else if (nullity_p.is_null() && nullity_q.is_top()) {
+          record_q.set_nullity(Nullity::non_null());
+        }
+      } break;
+      case PointerPredicate::GE:
+      case PointerPredicate::LE: {
+        // No reduction
+      } break;
+    }
+
+    if (record_p.is_bottom() || record_q.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    const PointsToSetT& addrs_p = record_p.points_to();
+    const PointsToSetT& addrs_q = record_q.points_to();
+
+    switch (pred) {
+      case PointerPredicate::EQ: {
+        // p == q
+        PointsToSetT addrs_pq = addrs_p.meet(addrs_q);
+
+        if (addrs_pq.is_bottom() ||
+            (addrs_pq.is_empty() && record_p.nullity().is_non_null())) {
+          this->set_to_bottom();
+          return;
+        }
+
+        // p and q's points-to sets
+        record_p.set_points_to(addrs_pq);
+        record_q.set_points_to(addrs_pq);
+
+        // p and q's offsets
+        this->_integer.add(IntPredicate::EQ,
+                           ScalarVariableTrait::offset_var(p),
+                           ScalarVariableTrait::offset_var(q));
+      } break;
+      case PointerPredicate::NE: {
+        // p != q
+        if (record_p.nullity().is_non_null() &&
+            record_q.nullity().is_non_null() && addrs_p.singleton() &&
+            addrs_p == addrs_q) {
+          // p and q's offsets
+          this->_integer.add(IntPredicate::NE,
+                             ScalarVariableTrait::offset_var(p),
+                             ScalarVariableTrait::offset_var(q));
+        }
+      } break;
+      case PointerPredicate::GT: {
+        // p > q
+        if (record_p.nullity().is_non_null() &&
+            record_q.nullity().is_non_null() && addrs_p.singleton() &&
+            addrs_p == addrs_q) {
+          // p and q's offsets
+          this->_integer.add(IntPredicate::GT,
+                             ScalarVariableTrait::offset_var(p),
+                             ScalarVariableTrait::offset_var(q));
+        }
+      } break;
+      case PointerPredicate::GE: {
+        // p >= q
+        if (record_p.nullity().is_non_null() &&
+            record_q.nullity().is_non_null() && addrs_p.singleton() &&
+            addrs_p == addrs_q) {
+          // p and q's offsets
+          this->_integer.add(IntPredicate::GE,
+                             ScalarVariableTrait::offset_var(p),
+                             ScalarVariableTrait::offset_var(q));
+        }
+      } break;
+      case PointerPredicate::LT: {
+        // p < q
+        if (record_p.nullity().is_non_null() &&
+            record_q.nullity().is_non_null() && addrs_p.singleton() &&
+            addrs_p == addrs_q) {
+          // p and q's offsets
+          this->_integer.add(IntPredicate::LT,
+                             ScalarVariableTrait::offset_var(p),
+                             ScalarVariableTrait::offset_var(q));
+        }
+      } break;
+      case PointerPredicate::LE: {
+        // p <= q
+        if (record_p.nullity().is_non_null() &&
+            record_q.nullity().is_non_null() && addrs_p.singleton() &&
+            addrs_p == addrs_q) {
+          // p and q's offsets
+          this->_integer.add(IntPredicate::LE,
+                             ScalarVariableTrait::offset_var(p),
+                             ScalarVariableTrait::offset_var(q));
+        }
+      } break;
+    }
+
+    this->set_record(p, record_p);
+    this->set_record(q, record_q);
+  }
+
+  void pointer_refine(VariableRef p, const PointsToSetT& addrs) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    this->_records.refine(p,
+                          Record(Uninitialized::top(), Nullity::top(), addrs));
+  }
+
+  void pointer_refine(VariableRef p,
+                      const PointsToSetT& addrs,
+                      const IntInterval& offset) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->_records.refine(p,
+                          Record(Uninitialized::top(), Nullity::top(), addrs));
+    this->_integer.refine(ScalarVariableTrait::offset_var(p), offset);
+  }
+
+  void pointer_refine(VariableRef p, const PointerAbsValueT& value) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    if (this->is_bottom_fast()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else if (value.is_uninitialized()) {
+      this->_records.refine(p,
+                            Record(Uninitialized::uninitialized(),
+                                   Nullity::top(),
+                                   PointsToSetT::empty()));
+    } else if (value.is_null()) {
+      this->_records.refine(p,
+                            Record(Uninitialized::initialized(),
+                                   Nullity::null(),
+                                   PointsToSetT::empty()));
+    } else {
+      this->_records.refine(p,
+                            Record(value.uninitialized(),
+                                   value.nullity(),
+                                   value.points_to()));
+      this->_integer.refine(ScalarVariableTrait::offset_var(p), value.offset());
+    }
+  }
+
+  void pointer_refine(VariableRef p, const PointerSetT& set) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    if (this->is_bottom_fast()) {
+      return;
+    } else if (set.is_bottom()) {
+      this->set_to_bottom();
+    } else if (set.points_to().is_empty()) {
+      // The pointer set only contains null and uninitialized pointers
+      this->pointer_refine(p, PointsToSetT::empty());
+    } else {
+      this->pointer_refine(p, set.points_to());
+      this->_integer.refine(ScalarVariableTrait::offset_var(p), set.offsets());
+    }
+  }
+
+  void pointer_offset_to_int(VariableRef x, VariableRef p) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+    ikos_assert(
+        IntVariableTrait::bit_width(x) ==
+        IntVariableTrait::bit_width(ScalarVariableTrait::offset_var(p)));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assert_initialized(p);
+
+    if (this->_records.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+
+    VariableRef offset = ScalarVariableTrait::offset_var(p);
+
+    this->assign_initialized(x);
+    if (x == offset) {
+      return; // No-op
+    } else if (IntVariableTrait::sign(x) == IntVariableTrait::sign(offset)) {
+      this->_integer.assign(x, offset);
+    } else {
+      this->_integer.apply(IntUnaryOperator::SignCast, x, offset);
+    }
+  }
+
+  IntInterval pointer_offset_to_interval(VariableRef p) const override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    return this->_integer.to_interval(ScalarVariableTrait::offset_var(p));
+  }
+
+  IntCongruence pointer_offset_to_congruence(VariableRef p) const override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    return this->_integer.to_congruence(ScalarVariableTrait::offset_var(p));
+  }
+
+  IntIntervalCongruence pointer_offset_to_interval_congruence(
+      VariableRef p) const override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    return this->_integer.to_interval_congruence(
+        ScalarVariableTrait::offset_var(p));
+  }
+
+  PointsToSetT pointer_to_points_to(VariableRef p) const override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    return this->record(p).points_to();
+  }
+
+  PointerAbsValueT pointer_to_pointer(VariableRef p) const override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    Record value = this->record(p);
+    return PointerAbsValueT(value.uninitialized(),
+                            value.nullity(),
+                            value.points_to(),
+                            this->_integer.to_interval(
+                                ScalarVariableTrait::offset_var(p)));
+  }
+
+  void pointer_forget_offset(VariableRef p) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    this->_integer.forget(ScalarVariableTrait::offset_var(p));
+  }
+
+  void pointer_forget(VariableRef p) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->_records.forget(p);
+    this->_integer.forget(ScalarVariableTrait::offset_var(p));
+  }
+
+  /// @}
+  /// \name Implement dynamically typed variables abstract domain methods
+  /// @{
+
+  void dynamic_assign(VariableRef x, VariableRef y) override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+    ikos_assert(ScalarVariableTrait::is_dynamic(y));
+    ikos_assert(IntVariableTrait::bit_width(x) ==
+                IntVariableTrait::bit_width(y));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(x, this->record(y));
+    if (IntVariableTrait::sign(x) == IntVariableTrait::sign(y)) {
+      this->_integer.assign(x, y);
+    } else {
+      this->_integer.apply(IntUnaryOperator::SignCast, x, y);
+    }
+    this->_integer.assign(ScalarVariableTrait::offset_var(x),
+                          ScalarVariableTrait::offset_var(y));
+  }
+
+  void dynamic_write_undef(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_uninitialized(x);
+    this->_integer.forget(x);
+    this->_integer.forget(ScalarVariableTrait::offset_var(x));
+  }
+
+  void dynamic_write_nondet(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.forget(x);
+    this->_integer.forget(ScalarVariableTrait::offset_var(x));
+  }
+
+  void dynamic_write_int(VariableRef x, const MachineInt& n) override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+    ikos_assert(IntVariableTrait::bit_width(x) == n.bit_width());
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_initialized(x);
+    if (IntVariableTrait::sign(x) == n.sign()) {
+      this->_integer.assign(x, n);
+    } else {
+      this->_integer.assign(x, n.sign_cast(IntVariableTrait::sign(x)));
+    }
+    this->_integer.forget(ScalarVariableTrait::offset_var(x));
+  }
+
+  void dynamic_write_nondet_int(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.forget(x);
+    this->_integer.forget(ScalarVariableTrait::offset_var(x));
+  }
+
+  void dynamic_write_int(VariableRef x, VariableRef y) override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+    ikos_assert(ScalarVariableTrait::is_int(y));
+    ikos_assert(IntVariableTrait::bit_width(x) ==
+                IntVariableTrait::bit_width(y));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(x, Record(this->record(y).uninitialized()));
+    if (IntVariableTrait::sign(x) == IntVariableTrait::sign(y)) {
+      this->_integer.assign(x, y);
+    } else {
+      this->_integer.apply(IntUnaryOperator::SignCast, x, y);
+    }
+    this->_integer.forget(ScalarVariableTrait::offset_var(x));
+  }
+
+  void dynamic_write_nondet_float(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assign_initialized(x);
+    this->_integer.forget(x);
+    this->_integer.forget(ScalarVariableTrait::offset_var(x));
+  }
+
+  void dynamic_write_null(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(x,
+                     Record(Uninitialized::initialized(),
+                            Nullity::null(),
+                            PointsToSetT::empty()));
+    this->_integer.forget(x);
+    this->assign_offset_zero(x);
+  }
+
+  void dynamic_write_pointer(VariableRef x,
+                             MemoryLocationRef addr,
+                             Nullity nullity) override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(x,
+                     Record(Uninitialized::initialized(),
+                            std::move(nullity),
+                            PointsToSetT{addr}));
+    this->_integer.forget(x);
+    this->assign_offset_zero(x);
+  }
+
+  void dynamic_write_pointer(VariableRef x, VariableRef y) override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+    ikos_assert(ScalarVariableTrait::is_pointer(y));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(x, this->record(y));
+    this->_integer.forget(x);
+    this->_integer.assign(ScalarVariableTrait::offset_var(x),
+                          ScalarVariableTrait::offset_var(y));
+  }
+
+  void dynamic_read_int(VariableRef x, VariableRef y) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+    ikos_assert(ScalarVariableTrait::is_dynamic(y));
+    ikos_assert(IntVariableTrait::bit_width(x) ==
+                IntVariableTrait::bit_width(y));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(x, Record(this->record(y).uninitialized()));
+    if (IntVariableTrait::sign(x) == IntVariableTrait::sign(y)) {
+      this->_integer.assign(x, y);
+    } else {
+      this->_integer.apply(IntUnaryOperator::SignCast, x, y);
+    }
+  }
+
+  void dynamic_read_pointer(VariableRef x, VariableRef y) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(x));
+    ikos_assert(ScalarVariableTrait::is_dynamic(y));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->set_record(x, this->record(y));
+    this->_integer.assign(ScalarVariableTrait::offset_var(x),
+                          ScalarVariableTrait::offset_var(y));
+  }
+
+  bool dynamic_is_zero(VariableRef x) const override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+
+    IntInterval value = this->_integer.to_interval(x);
+    return value.is_bottom() || value.is_zero();
+  }
+
+  bool dynamic_is_null(VariableRef x) const override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+
+    Nullity value = this->record(x).nullity();
+    return value.is_bottom() || value.is_null();
+  }
+
+  void dynamic_forget(VariableRef x) override {
+    ikos_assert(ScalarVariableTrait::is_dynamic(x));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->_records.forget(x);
+    this->_integer.forget(x);
+    this->_integer.forget(ScalarVariableTrait::offset_var(x));
+  }
+
+  /// @}
+  /// \name Implement scalar abstract domain methods
+  /// @{
+
+  void scalar_assign_undef(VariableRef x) override {
+    if (this->is_bottom_fast()) {
+      return;
+    } else if (ScalarVariableTrait::is_int(x)) {
+      this->int_assign_undef(x);
+    } else if (ScalarVariableTrait::is_float(x)) {
+      this->float_assign_undef(x);
+    } else if (ScalarVariableTrait::is_pointer(x)) {
+      this->pointer_assign_undef(x);
+    } else if (ScalarVariableTrait::is_dynamic(x)) {
+      this->dynamic_write_undef(x);
+    } else {
+      ikos_unreachable("unexpected type");
+    }
+  }
+
+  void scalar_assign_nondet(VariableRef x) override {
+    if (this->is_bottom_fast()) {
+      return;
+    } else if (ScalarVariableTrait::is_int(x)) {
+      this->int_assign_nondet(x);
+    } else if (ScalarVariableTrait::is_float(x)) {
+      this->float_assign_nondet(x);
+    } else if (ScalarVariableTrait::is_pointer(x)) {
+      this->pointer_assign_nondet(x);
+    } else if (ScalarVariableTrait::is_dynamic(x)) {
+      this->dynamic_write_nondet(x);
+    } else {
+      ikos_unreachable("unexpected type");
+    }
+  }
+
+  void scalar_pointer_to_int(VariableRef x,
+                             VariableRef p,
+                             MemoryLocationRef absolute_zero) override {
+    ikos_assert(ScalarVariableTrait::is_int(x));
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+    ikos_assert(
+        IntVariableTrait::bit_width(x) ==
+        IntVariableTrait::bit_width(ScalarVariableTrait::offset_var(p)));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assert_initialized(p);
+
+    this->normalize();
+
+    if (this->is_bottom()) {
+      return;
+    }
+
+    Record value = this->record(p);
+
+    this->assign_initialized(x);
+    if (value.nullity().is_null()) {
+      auto zero = MachineInt::zero(IntVariableTrait::bit_width(x),
+                                   IntVariableTrait::sign(x));
+      this->_integer.assign(x, zero);
+    } else if (value.points_to() == PointsToSetT{absolute_zero}) {
+      VariableRef offset = ScalarVariableTrait::offset_var(p);
+      if (IntVariableTrait::sign(x) == IntVariableTrait::sign(offset)) {
+        this->_integer.assign(x, offset);
+      } else {
+        this->_integer.apply(IntUnaryOperator::SignCast, x, offset);
+      }
+    } else {
+      this->_integer.forget(x);
+    }
+  }
+
+  void scalar_int_to_pointer(VariableRef p,
+                             VariableRef x,
+                             MemoryLocationRef absolute_zero) override {
+    ikos_assert(ScalarVariableTrait::is_pointer(p));
+    ikos_assert(ScalarVariableTrait::is_int(x));
+    ikos_assert(
+        IntVariableTrait::bit_width(x) ==
+        IntVariableTrait::bit_width(ScalarVariableTrait::offset_var(p)));
+
+    if (this->is_bottom_fast()) {
+      return;
+    }
+
+    this->assert_initialized(x);
+
+    this->normalize();
+
+    if (this->is_bottom()) {
+      return;
+    }
+
+    IntIntervalCongruence value = this->_integer.to_interval_congruence(x);
+    auto zero = MachineInt::zero(IntVariableTrait::bit_width(x),
+                                 IntVariableTrait::sign(x));
+    auto nullity = Nullity::top();
+    if (value.contains(zero)) {
+      if (value.singleton()) {
+        nullity = Nullity::null();
+      } else {
+        nullity = Nullity::top();
+      }
+    } else {
+      nullity = Nullity::non_null();
+    }
+
+    this->set_record(p,
+                     Record(Uninitialized::initialized(),
+                            nullity,
+                            PointsToSetT{absolute_zero}));
+    VariableRef offset = ScalarVariableTrait::offset_var(p);
+    if (IntVariableTrait::sign(offset) == IntVariableTrait::sign(x)) {
+      this->_integer.assign(offset, x);
+    } else {
+      this->_integer.apply(IntUnaryOperator::SignCast, offset, x);
+    }
+  }
+
+  void scalar_forget(VariableRef x) override {
+    if (this->is_bottom_fast()) {
+      return;
+    } else if (ScalarVariableTrait::is_int(x)) {
+      this->int_forget(x);
+    } else if (ScalarVariableTrait::is_float(x)) {
+      this->float_forget(x);
+    } else if (ScalarVariableTrait::is_pointer(x)) {
+      this->pointer_forget(x);
+    } else if (ScalarVariableTrait::is_dynamic(x)) {
+      this->dynamic_forget(x);
+    } else {
+      ikos_unreachable("unexpected type");
+    }
+  }
+
+  /// @}
+
+  void dump(std::ostream& o) const override {
+    if (this->is_bottom()) {
+      o << "⊥";
+    } else {
+      o << "(";
+      this->_records.dump(o);
+      o << ", ";
+      this->_integer.dump(o);
+      o << ")";
+    }
+  }
+
+  static std::string name() {
+    return "fused domain using " + MachineIntDomain::name();
+  }
+
+}; // end class FusedDomain
+
+} // end namespace scalar
+} // end namespace core
+} // end namespace ikos
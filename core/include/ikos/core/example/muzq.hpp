@@ -749,9 +749,12 @@ private:
 
 public:
   /// \brief Create a fixpoint iterator on the given ControlFlowGraph
-  explicit FixpointIterator(ControlFlowGraphT& cfg)
+  ///
+  /// \param sparse Only keep the pre invariants of the entry and cycle heads
+  explicit FixpointIterator(ControlFlowGraphT& cfg, bool sparse = false)
       : Parent(&cfg,
-               AbstractDomain(ZNumDomain::bottom(), QNumDomain::bottom())) {}
+               AbstractDomain(ZNumDomain::bottom(), QNumDomain::bottom()),
+               sparse) {}
 
   /// \brief Return the invariant at the given checkpoint
   const AbstractDomain& checkpoint(const std::string& name) {
@@ -43,12 +43,17 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
+#include <ikos/core/example/memory_factory.hpp>
+#include <ikos/core/number/machine_int.hpp>
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/indexable.hpp>
 #include <ikos/core/semantic/machine_int/variable.hpp>
+#include <ikos/core/semantic/memory/value/cell_factory.hpp>
+#include <ikos/core/semantic/memory/value/cell_variable.hpp>
 #include <ikos/core/semantic/scalar/variable.hpp>
 #include <ikos/core/semantic/variable.hpp>
 #include <ikos/core/support/assert.hpp>
@@ -75,6 +80,18 @@ public:
     DynamicVariableKind,
   };
 
+  /// \brief Memory cell, see memory::CellVariableTraits
+  struct Cell {
+    /// \brief Base memory location
+    MemoryFactory::MemoryLocationRef base;
+
+    /// \brief Offset, in bytes
+    MachineInt offset;
+
+    /// \brief Size, in bytes
+    MachineInt size;
+  };
+
   class Variable {
   private:
     /// \brief Variable name
@@ -95,6 +112,9 @@ public:
     /// \brief Offset variable (if any)
     Variable* _offset_var;
 
+    /// \brief Memory cell (if any)
+    std::unique_ptr< Cell > _cell;
+
   private:
     /// \brief Private constructor
     Variable(std::string name,
@@ -102,13 +122,15 @@ public:
              VariableKind kind,
              unsigned bit_width,
              Signedness sign,
-             Variable* offset_var)
+             Variable* offset_var,
+             std::unique_ptr< Cell > cell = nullptr)
         : _name(std::move(name)),
           _id(id),
           _kind(kind),
           _bit_width(bit_width),
           _sign(sign),
-          _offset_var(offset_var) {}
+          _offset_var(offset_var),
+          _cell(std::move(cell)) {}
 
   public:
     static Variable make_int(std::string name,
@@ -141,6 +163,21 @@ public:
               offset_var};
     }
 
+    static Variable make_cell(std::string name,
+                              Index id,
+                              unsigned bit_width,
+                              Signedness sign,
+                              Variable* offset_var,
+                              Cell cell) {
+      return {std::move(name),
+              id,
+              DynamicVariableKind,
+              bit_width,
+              sign,
+              offset_var,
+              std::make_unique< Cell >(std::move(cell))};
+    }
+
     /// \brief No default constructor
     Variable() = delete;
 
@@ -189,6 +226,15 @@ public:
       return this->_offset_var;
     }
 
+    /// \brief Return true if the variable is a memory cell
+    bool is_cell() const { return this->_cell != nullptr; }
+
+    /// \brief Return the memory cell of the variable
+    const Cell& cell() const {
+      ikos_assert(this->_cell != nullptr);
+      return *this->_cell;
+    }
+
   }; // end class Variable
 
 public:
@@ -320,6 +366,44 @@ public:
     return &(res.first->second);
   }
 
+  /// \brief Get or create a memory cell variable
+  ///
+  /// The cell holds `size` bytes at `base + offset`. Its offset variable has
+  /// the bit-width of `offset`.
+  VariableRef get_cell(MemoryFactory::MemoryLocationRef base,
+                       const MachineInt& offset,
+                       const MachineInt& size,
+                       Signedness sign) {
+    // This is sound because references are kept valid when using
+    // std::unordered_map::emplace()
+
+    std::string name =
+        "C{" + base->name() + "," + offset.str() + "," + size.str() + "}";
+
+    auto it = this->_map.find(name);
+    if (it != this->_map.end()) {
+      return &(it->second);
+    }
+
+    auto res = this->_map.emplace(name + ".offset",
+                                  Variable::make_int(name + ".offset",
+                                                     this->_next_id++,
+                                                     offset.bit_width(),
+                                                     Unsigned));
+    ikos_assert(res.second);
+    Variable* offset_var = &(res.first->second);
+
+    res = this->_map.emplace(name,
+                             Variable::make_cell(name,
+                                                 this->_next_id++,
+                                                 size.to< unsigned >() * 8,
+                                                 sign,
+                                                 offset_var,
+                                                 Cell{base, offset, size}));
+    ikos_assert(res.second);
+    return &(res.first->second);
+  }
+
 }; // end class VariableFactory
 
 /// \brief Write a variable on a stream
@@ -403,5 +487,50 @@ struct VariableTraits< example::scalar::VariableFactory::VariableRef > {
 
 } // end namespace scalar
 
+namespace memory {
+
+/// \brief Implement memory::CellVariableTraits for
+/// example::scalar::VariableFactory::VariableRef
+template <>
+struct CellVariableTraits< example::scalar::VariableFactory::VariableRef,
+                           example::MemoryFactory::MemoryLocationRef > {
+  static bool is_cell(example::scalar::VariableFactory::VariableRef var) {
+    return var->is_cell();
+  }
+
+  static example::MemoryFactory::MemoryLocationRef base(
+      example::scalar::VariableFactory::VariableRef var) {
+    return var->cell().base;
+  }
+
+  static const MachineInt& offset(
+      example::scalar::VariableFactory::VariableRef var) {
+    return var->cell().offset;
+  }
+
+  static const MachineInt& size(
+      example::scalar::VariableFactory::VariableRef var) {
+    return var->cell().size;
+  }
+};
+
+/// \brief Implement memory::CellFactoryTraits for
+/// example::scalar::VariableFactory
+template <>
+struct CellFactoryTraits< example::scalar::VariableFactory::VariableRef,
+                          example::MemoryFactory::MemoryLocationRef,
+                          example::scalar::VariableFactory* > {
+  static example::scalar::VariableFactory::VariableRef cell(
+      example::scalar::VariableFactory* vfac,
+      example::MemoryFactory::MemoryLocationRef base,
+      const MachineInt& offset,
+      const MachineInt& size,
+      Signedness sign) {
+    return vfac->get_cell(base, offset, size, sign);
+  }
+};
+
+} // end namespace memory
+
 } // end namespace core
 } // end namespace ikos
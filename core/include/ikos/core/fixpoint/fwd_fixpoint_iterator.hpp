@@ -47,9 +47,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <ikos/core/fixpoint/fixpoint_iterator.hpp>
 #include <ikos/core/fixpoint/wto.hpp>
@@ -65,11 +67,22 @@ class WtoIterator;
 template < typename GraphRef, typename AbstractValue, typename GraphTrait >
 class WtoProcessor;
 
+template < typename GraphRef,
+           typename AbstractValue,
+           typename GraphTrait,
+           typename Function >
+class WtoReplayer;
+
 } // end namespace interleaved_fwd_fixpoint_iterator_impl
 
 /// \brief Interleaved forward fixpoint iterator
 ///
 /// This class computes a fixpoint on a control flow graph.
+///
+/// In sparse mode, the pre invariants are only kept for the entry node and the
+/// cycle heads of the weak topological order. Other pre invariants are
+/// recomputed on demand from the post invariants of their predecessors, see
+/// `for_each_pre()`.
 template < typename GraphRef,
            typename AbstractValue,
            typename GraphTrait = GraphTraits< GraphRef > >
@@ -77,6 +90,10 @@ class InterleavedFwdFixpointIterator
     : public ForwardFixpointIterator< GraphRef, AbstractValue, GraphTrait > {
   friend class interleaved_fwd_fixpoint_iterator_impl::
       WtoIterator< GraphRef, AbstractValue, GraphTrait >;
+  friend class interleaved_fwd_fixpoint_iterator_impl::
+      WtoProcessor< GraphRef, AbstractValue, GraphTrait >;
+  template < typename, typename, typename, typename >
+  friend class interleaved_fwd_fixpoint_iterator_impl::WtoReplayer;
 
 private:
   using NodeRef = typename GraphTrait::NodeRef;
@@ -94,14 +111,22 @@ private:
   InvariantTable _pre;
   InvariantTable _post;
   bool _converged;
+  bool _sparse;
 
 public:
   /// \brief Create an interleaved forward fixpoint iterator
   ///
   /// \param cfg The control flow graph
   /// \param bottom The bottom abstract value
-  InterleavedFwdFixpointIterator(GraphRef cfg, AbstractValue bottom)
-      : _cfg(cfg), _wto(cfg), _bottom(std::move(bottom)), _converged(false) {}
+  /// \param sparse Only keep the pre invariants of the entry and cycle heads
+  InterleavedFwdFixpointIterator(GraphRef cfg,
+                                 AbstractValue bottom,
+                                 bool sparse = false)
+      : _cfg(cfg),
+        _wto(cfg),
+        _bottom(std::move(bottom)),
+        _converged(false),
+        _sparse(sparse) {}
 
   /// \brief No copy constructor
   InterleavedFwdFixpointIterator(const InterleavedFwdFixpointIterator&) =
@@ -130,6 +155,10 @@ public:
   /// \brief Return true if the fixpoint is reached
   bool converged() const override { return this->_converged; }
 
+  /// \brief Return true if only the pre invariants of the entry and cycle
+  /// heads are kept
+  bool sparse() const { return this->_sparse; }
+
 private:
   /// \brief Set the invariant for the given node
   void set(InvariantTable& table, NodeRef node, AbstractValue inv) const {
@@ -163,8 +192,31 @@ private:
     }
   }
 
+  /// \brief Return true if the pre invariant of the given node is kept
+  bool has_pre(NodeRef node) const {
+    return this->_pre.find(node) != this->_pre.end();
+  }
+
+  /// \brief Compute the pre invariant of the given node from the post
+  /// invariants of its predecessors
+  AbstractValue join_pre(NodeRef node) {
+    AbstractValue pre = this->_bottom;
+    for (auto it = GraphTrait::predecessor_begin(node),
+              et = GraphTrait::predecessor_end(node);
+         it != et;
+         ++it) {
+      NodeRef pred = *it;
+      pre.join_with(this->analyze_edge(pred, node, this->post(pred)));
+    }
+    pre.normalize();
+    return pre;
+  }
+
 public:
   /// \brief Return the pre invariant for the given node
+  ///
+  /// In sparse mode, this returns bottom for nodes that are neither the entry
+  /// nor a cycle head. Use `for_each_pre()` instead.
   const AbstractValue& pre(NodeRef node) const override {
     return this->get(this->_pre, node);
   }
@@ -292,6 +344,23 @@ public:
     this->_wto.accept(processor);
   }
 
+  /// \brief Call `f(node, pre)` on each node, in the weak topological order
+  ///
+  /// `f` must return the post invariant of the node. In sparse mode, pre
+  /// invariants that are not kept are recomputed from the post invariants
+  /// returned by `f` for the predecessors, hence this does not require the
+  /// post invariants of the fixpoint. A post invariant is released as soon as
+  /// all the successors needing it are visited.
+  ///
+  /// Nodes unreachable from the entry are not visited.
+  template < typename Function >
+  void for_each_pre(Function f) {
+    interleaved_fwd_fixpoint_iterator_impl::
+        WtoReplayer< GraphRef, AbstractValue, GraphTrait, Function >
+            replayer(*this, std::move(f));
+    this->_wto.accept(replayer);
+  }
+
   /// \brief Clear the pre invariants
   void clear_pre() { this->_pre.clear(); }
 
@@ -354,8 +423,11 @@ public:
     }
 
     pre.normalize();
-    this->_iterator.set_pre(node, pre);
-    this->_iterator.set_post(node, this->_iterator.analyze_node(node, pre));
+    if (!this->_iterator.sparse() || node == this->_entry) {
+      this->_iterator.set_pre(node, pre);
+    }
+    this->_iterator.set_post(node,
+                             this->_iterator.analyze_node(node, std::move(pre)));
   }
 
   void visit(const WtoCycleT& cycle) override {
@@ -474,7 +546,11 @@ public:
 
   void visit(const WtoVertexT& vertex) override {
     NodeRef node = vertex.node();
-    this->_iterator.process_pre(node, this->_iterator.pre(node));
+    if (this->_iterator.has_pre(node)) {
+      this->_iterator.process_pre(node, this->_iterator.pre(node));
+    } else {
+      this->_iterator.process_pre(node, this->_iterator.join_pre(node));
+    }
     this->_iterator.process_post(node, this->_iterator.post(node));
   }
 
@@ -490,6 +566,108 @@ public:
 
 }; // end class WtoProcessor
 
+template < typename GraphRef,
+           typename AbstractValue,
+           typename GraphTrait,
+           typename Function >
+class WtoReplayer final : public WtoComponentVisitor< GraphRef, GraphTrait > {
+public:
+  using InterleavedIterator =
+      InterleavedFwdFixpointIterator< GraphRef, AbstractValue, GraphTrait >;
+  using NodeRef = typename GraphTrait::NodeRef;
+  using WtoVertexT = WtoVertex< GraphRef, GraphTrait >;
+  using WtoCycleT = WtoCycle< GraphRef, GraphTrait >;
+
+private:
+  /// \brief Post invariant and number of successors still needing it
+  using PostTable =
+      std::unordered_map< NodeRef, std::pair< AbstractValue, std::size_t > >;
+
+private:
+  /// \brief Fixpoint engine
+  InterleavedIterator& _iterator;
+
+  /// \brief User function
+  Function _f;
+
+  /// \brief Post invariants still needed
+  PostTable _post;
+
+public:
+  WtoReplayer(InterleavedIterator& iterator, Function f)
+      : _iterator(iterator), _f(std::move(f)) {}
+
+  void visit(const WtoVertexT& vertex) override { this->replay(vertex.node()); }
+
+  void visit(const WtoCycleT& cycle) override {
+    this->replay(cycle.head());
+
+    for (auto it = cycle.begin(), et = cycle.end(); it != et; ++it) {
+      it->accept(*this);
+    }
+  }
+
+private:
+  /// \brief Return the distinct nodes in [begin, end)
+  template < typename Iterator >
+  static std::vector< NodeRef > distinct(Iterator begin, Iterator end) {
+    std::vector< NodeRef > nodes;
+    for (; begin != end; ++begin) {
+      if (std::find(nodes.begin(), nodes.end(), *begin) == nodes.end()) {
+        nodes.push_back(*begin);
+      }
+    }
+    return nodes;
+  }
+
+  /// \brief Compute the pre invariant of the given node, call the user
+  /// function and keep the post invariant if needed
+  void replay(NodeRef node) {
+    if (this->_iterator.has_pre(node)) {
+      this->keep_post(node, this->_f(node, this->_iterator.pre(node)));
+      return;
+    }
+
+    // In a weak topological order, the predecessors of a node that is not a
+    // cycle head are visited before it
+    AbstractValue pre = this->_iterator.bottom();
+    for (NodeRef pred : distinct(GraphTrait::predecessor_begin(node),
+                                 GraphTrait::predecessor_end(node))) {
+      auto it = this->_post.find(pred);
+      if (it == this->_post.end()) {
+        // Unreachable predecessor
+        continue;
+      }
+
+      pre.join_with(
+          this->_iterator.analyze_edge(pred, node, it->second.first));
+
+      if (--it->second.second == 0) {
+        this->_post.erase(it);
+      }
+    }
+    pre.normalize();
+
+    this->keep_post(node, this->_f(node, std::move(pre)));
+  }
+
+  /// \brief Keep the post invariant of the given node if a successor needs it
+  void keep_post(NodeRef node, AbstractValue post) {
+    std::size_t uses = 0;
+    for (NodeRef succ : distinct(GraphTrait::successor_begin(node),
+                                 GraphTrait::successor_end(node))) {
+      if (!this->_iterator.has_pre(succ)) {
+        uses++;
+      }
+    }
+
+    if (uses > 0) {
+      this->_post.emplace(node, std::make_pair(std::move(post), uses));
+    }
+  }
+
+}; // end class WtoReplayer
+
 } // end namespace interleaved_fwd_fixpoint_iterator_impl
 
 } // end namespace core
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Serialization of numbers
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/core/number/exception.hpp>
+#include <ikos/core/number/machine_int.hpp>
+#include <ikos/core/number/signedness.hpp>
+#include <ikos/core/number/z_number.hpp>
+#include <ikos/core/support/serialization.hpp>
+
+namespace ikos {
+namespace core {
+
+/// \brief Implement SerializableTraits for Signedness
+template <>
+struct SerializableTraits< Signedness > {
+  static void save(OutputArchive& ar, Signedness sign) {
+    ar.write_bool(sign == Signed);
+  }
+
+  static Signedness load(InputArchive& ar) {
+    return ar.read_bool() ? Signed : Unsigned;
+  }
+};
+
+/// \brief Implement SerializableTraits for ZNumber
+///
+/// Numbers are stored in base 16, to avoid depending on the limb size of GMP.
+template <>
+struct SerializableTraits< ZNumber > {
+  static void save(OutputArchive& ar, const ZNumber& n) {
+    ar.write_string(n.str(16));
+  }
+
+  static ZNumber load(InputArchive& ar) {
+    try {
+      return ZNumber::from_string(ar.read_string(), 16);
+    } catch (const NumberError&) {
+      throw SerializationError("invalid archive: bad integer");
+    }
+  }
+};
+
+/// \brief Implement SerializableTraits for MachineInt
+template <>
+struct SerializableTraits< MachineInt > {
+  static void save(OutputArchive& ar, const MachineInt& n) {
+    ar.write_uint(n.bit_width());
+    core::save(ar, n.sign());
+    core::save(ar, n.to_z_number());
+  }
+
+  static MachineInt load(InputArchive& ar) {
+    auto bit_width = core::load< unsigned >(ar);
+    auto sign = core::load< Signedness >(ar);
+    auto z = core::load< ZNumber >(ar);
+    if (bit_width == 0 || z < MachineInt::min(bit_width, sign).to_z_number() ||
+        z > MachineInt::max(bit_width, sign).to_z_number()) {
+      throw SerializationError("invalid archive: bad machine integer");
+    }
+    return MachineInt(z, bit_width, sign);
+  }
+};
+
+} // end namespace core
+} // end namespace ikos
@@ -0,0 +1,256 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Approximate accounting of the memory held by abstract values
+ *
+ * Abstract domains report the memory they allocate and release for their
+ * internal data structures (patricia tree nodes, difference-bound matrices,
+ * apron objects, etc.). This allows an analysis to react to its memory
+ * consumption before hitting the system memory limit.
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ikos/core/support/assert.hpp>
+
+namespace ikos {
+namespace core {
+
+/// \brief Category of memory tracked by MemoryUsage
+enum class MemoryCategory {
+  PatriciaTree = 0,
+  DBM = 1,
+  Apron = 2,
+};
+
+/// \brief Approximate accounting of the memory held by abstract values
+///
+/// Each thread updates its own counters, so that allocations do not contend.
+/// The counters of all threads are summed up on demand. An allocation and its
+/// deallocation can happen on different threads, hence a single counter can be
+/// negative, but the total is always accurate.
+///
+/// The accounting is disabled by default, so that abstract values only pay for
+/// a relaxed load of a flag. It must be enabled before creating the abstract
+/// values to account for.
+class MemoryUsage {
+private:
+  static constexpr std::size_t NumCategories = 3;
+
+  /// \brief Counters of a thread, in bytes
+  struct Counters {
+    std::array< std::atomic< std::int64_t >, NumCategories > bytes;
+
+    Counters() {
+      for (auto& counter : this->bytes) {
+        counter.store(0, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  /// \brief Counters of all threads
+  struct Registry {
+    std::mutex mutex;
+    std::vector< std::unique_ptr< Counters > > counters;
+  };
+
+private:
+  /// \brief Return the global registry
+  ///
+  /// The registry is never destroyed: abstract values held by static
+  /// variables are released after it would be, at exit.
+  static Registry& registry() {
+    static auto* Instance = new Registry();
+    return *Instance;
+  }
+
+  /// \brief Return the counters of the current thread
+  static Counters& local() {
+    static thread_local Counters* Local = nullptr;
+    if (ikos_unlikely(Local == nullptr)) {
+      Registry& r = registry();
+      std::lock_guard< std::mutex > lock(r.mutex);
+      r.counters.emplace_back(new Counters());
+      Local = r.counters.back().get();
+    }
+    return *Local;
+  }
+
+  /// \brief Return the flag enabling the accounting
+  static std::atomic< bool >& enabled_flag() {
+    static std::atomic< bool > Enabled{false};
+    return Enabled;
+  }
+
+  /// \brief Add `delta` bytes to the given category
+  static void add(MemoryCategory category, std::int64_t delta) {
+    if (!enabled()) {
+      return;
+    }
+
+    // Only the current thread writes this counter
+    std::atomic< std::int64_t >& counter =
+        local().bytes[static_cast< std::size_t >(category)];
+    counter.store(counter.load(std::memory_order_relaxed) + delta,
+                  std::memory_order_relaxed);
+  }
+
+public:
+  /// \brief Enable the accounting
+  ///
+  /// Abstract values created before are not accounted for, and their
+  /// deallocation makes the total inaccurate.
+  static void enable() {
+    enabled_flag().store(true, std::memory_order_relaxed);
+  }
+
+  /// \brief Return true if the accounting is enabled
+  static bool enabled() {
+    return enabled_flag().load(std::memory_order_relaxed);
+  }
+
+  /// \brief Record an allocation of `size` bytes
+  static void allocate(MemoryCategory category, std::size_t size) {
+    add(category, static_cast< std::int64_t >(size));
+  }
+
+  /// \brief Record a deallocation of `size` bytes
+  static void deallocate(MemoryCategory category, std::size_t size) {
+    add(category, -static_cast< std::int64_t >(size));
+  }
+
+  /// \brief Return the number of bytes currently held in the given category
+  static std::size_t total(MemoryCategory category) {
+    Registry& r = registry();
+    std::lock_guard< std::mutex > lock(r.mutex);
+    std::int64_t sum = 0;
+    for (const auto& counters : r.counters) {
+      sum += counters->bytes[static_cast< std::size_t >(category)].load(
+          std::memory_order_relaxed);
+    }
+    return sum > 0 ? static_cast< std::size_t >(sum) : 0;
+  }
+
+  /// \brief Return the number of bytes currently held by abstract values
+  static std::size_t total() {
+    Registry& r = registry();
+    std::lock_guard< std::mutex > lock(r.mutex);
+    std::int64_t sum = 0;
+    for (const auto& counters : r.counters) {
+      for (const auto& counter : counters->bytes) {
+        sum += counter.load(std::memory_order_relaxed);
+      }
+    }
+    return sum > 0 ? static_cast< std::size_t >(sum) : 0;
+  }
+
+}; // end class MemoryUsage
+
+/// \brief Memory accounted for a data structure of varying size
+///
+/// Copying the account records a new allocation of the same size, moving it
+/// transfers the ownership of the bytes.
+class MemoryAccount {
+private:
+  MemoryCategory _category;
+  std::size_t _size = 0;
+
+public:
+  /// \brief Create an empty account for the given category
+  explicit MemoryAccount(MemoryCategory category) : _category(category) {}
+
+  /// \brief Copy constructor
+  MemoryAccount(const MemoryAccount& other)
+      : _category(other._category), _size(other._size) {
+    MemoryUsage::allocate(this->_category, this->_size);
+  }
+
+  /// \brief Move constructor
+  MemoryAccount(MemoryAccount&& other) noexcept
+      : _category(other._category), _size(other._size) {
+    other._size = 0;
+  }
+
+  /// \brief Copy assignment operator
+  MemoryAccount& operator=(const MemoryAccount& other) {
+    if (this != &other) {
+      this->update(other._size);
+    }
+    return *this;
+  }
+
+  /// \brief Move assignment operator
+  MemoryAccount& operator=(MemoryAccount&& other) noexcept {
+    if (this != &other) {
+      MemoryUsage::deallocate(this->_category, this->_size);
+      this->_size = other._size;
+      other._size = 0;
+    }
+    return *this;
+  }
+
+  /// \brief Destructor
+  ~MemoryAccount() { MemoryUsage::deallocate(this->_category, this->_size); }
+
+  /// \brief Set the number of bytes held
+  void update(std::size_t size) {
+    if (size > this->_size) {
+      MemoryUsage::allocate(this->_category, size - this->_size);
+    } else if (size < this->_size) {
+      MemoryUsage::deallocate(this->_category, this->_size - size);
+    }
+    this->_size = size;
+  }
+
+  /// \brief Return the number of bytes held
+  std::size_t size() const { return this->_size; }
+
+}; // end class MemoryAccount
+
+} // end namespace core
+} // end namespace ikos
@@ -0,0 +1,332 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Binary archives for abstract values
+ *
+ * Abstract values are written into a versioned binary stream, so that they
+ * can be stored on disk and reloaded by a later run (e.g, the function
+ * summaries of the analyzer). Types opt in by specializing SerializableTraits.
+ *
+ * Only numbers and machine integer abstract values are serializable. Abstract
+ * domains are not: their variables and memory locations point into factories
+ * of the analysis, and would need a stable numbering across runs first.
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include <ikos/core/exception.hpp>
+
+namespace ikos {
+namespace core {
+
+/// \brief Exception thrown when an archive cannot be read
+class SerializationError : public Exception {
+private:
+  /// \brief Explanatory message
+  std::shared_ptr< const std::string > _msg;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param msg Explanatory message
+  explicit SerializationError(const std::string& msg)
+      : _msg(std::make_shared< const std::string >(msg)) {}
+
+  /// \brief Constructor
+  ///
+  /// \param msg Explanatory message
+  explicit SerializationError(const char* msg)
+      : _msg(std::make_shared< const std::string >(msg)) {}
+
+  /// \brief No default constructor
+  SerializationError() = delete;
+
+  /// \brief Copy constructor
+  SerializationError(const SerializationError&) noexcept = default;
+
+  /// \brief Move constructor
+  SerializationError(SerializationError&&) noexcept = default;
+
+  /// \brief Copy assignment operator
+  SerializationError& operator=(const SerializationError&) noexcept = default;
+
+  /// \brief Move assignment operator
+  SerializationError& operator=(SerializationError&&) noexcept = default;
+
+  /// \brief Get the explanatory string
+  const char* what() const noexcept override { return this->_msg->c_str(); }
+
+  /// \brief Destructor
+  ~SerializationError() override = default;
+
+}; // end class SerializationError
+
+namespace serialization_impl {
+
+/// \brief Magic number at the beginning of an archive
+constexpr const char* Magic = "IKOS";
+
+/// \brief Length of the magic number
+constexpr std::size_t MagicLength = 4;
+
+} // end namespace serialization_impl
+
+/// \brief Version of the archive format
+///
+/// Bump this number whenever the encoding of a serializable type changes.
+constexpr uint32_t SerializationFormatVersion = 1;
+
+/// \brief Binary output archive
+///
+/// Integers are written as LEB128 variable-length quantities, so that the
+/// encoding does not depend on the endianness or word size of the host.
+class OutputArchive {
+private:
+  std::ostream& _stream;
+
+public:
+  /// \brief Create an output archive and write its header
+  explicit OutputArchive(std::ostream& stream) : _stream(stream) {
+    this->_stream.write(serialization_impl::Magic,
+                        serialization_impl::MagicLength);
+    this->write_uint(SerializationFormatVersion);
+  }
+
+  /// \brief No copy constructor
+  OutputArchive(const OutputArchive&) = delete;
+
+  /// \brief No move constructor
+  OutputArchive(OutputArchive&&) = delete;
+
+  /// \brief No copy assignment operator
+  OutputArchive& operator=(const OutputArchive&) = delete;
+
+  /// \brief No move assignment operator
+  OutputArchive& operator=(OutputArchive&&) = delete;
+
+  /// \brief Destructor
+  ~OutputArchive() = default;
+
+  /// \brief Write an unsigned integer
+  void write_uint(uint64_t n) {
+    do {
+      auto byte = static_cast< uint8_t >(n & 0x7f);
+      n >>= 7;
+      if (n != 0) {
+        byte |= 0x80;
+      }
+      this->_stream.put(static_cast< char >(byte));
+    } while (n != 0);
+  }
+
+  /// \brief Write a boolean
+  void write_bool(bool b) { this->_stream.put(b ? 1 : 0); }
+
+  /// \brief Write a string
+  void write_string(const std::string& s) {
+    this->write_uint(s.size());
+    this->_stream.write(s.data(), static_cast< std::streamsize >(s.size()));
+  }
+
+}; // end class OutputArchive
+
+/// \brief Binary input archive
+///
+/// Throws a SerializationError if the stream is truncated, or if it was not
+/// written by an OutputArchive with the same format version.
+class InputArchive {
+private:
+  std::istream& _stream;
+
+public:
+  /// \brief Create an input archive and check its header
+  explicit InputArchive(std::istream& stream) : _stream(stream) {
+    char magic[serialization_impl::MagicLength];
+    this->_stream.read(magic, serialization_impl::MagicLength);
+    if (!this->_stream ||
+        std::string(magic, serialization_impl::MagicLength) !=
+            serialization_impl::Magic) {
+      throw SerializationError("invalid archive: bad magic number");
+    }
+    if (this->read_uint() != SerializationFormatVersion) {
+      throw SerializationError("invalid archive: unsupported format version");
+    }
+  }
+
+  /// \brief No copy constructor
+  InputArchive(const InputArchive&) = delete;
+
+  /// \brief No move constructor
+  InputArchive(InputArchive&&) = delete;
+
+  /// \brief No copy assignment operator
+  InputArchive& operator=(const InputArchive&) = delete;
+
+  /// \brief No move assignment operator
+  InputArchive& operator=(InputArchive&&) = delete;
+
+  /// \brief Destructor
+  ~InputArchive() = default;
+
+  /// \brief Read an unsigned integer
+  uint64_t read_uint() {
+    uint64_t n = 0;
+    for (unsigned shift = 0;; shift += 7) {
+      if (shift >= 64) {
+        throw SerializationError("invalid archive: integer overflow");
+      }
+      uint8_t byte = this->read_byte();
+      n |= static_cast< uint64_t >(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return n;
+      }
+    }
+  }
+
+  /// \brief Read a boolean
+  bool read_bool() {
+    uint8_t byte = this->read_byte();
+    if (byte > 1) {
+      throw SerializationError("invalid archive: bad boolean");
+    }
+    return byte == 1;
+  }
+
+  /// \brief Read a string
+  ///
+  /// The size comes from the archive, so the string is read by chunks rather
+  /// than allocated upfront: a corrupted size throws a SerializationError at
+  /// the end of the stream instead of exhausting the memory.
+  std::string read_string() {
+    uint64_t size = this->read_uint();
+    std::string s;
+    char buf[4096];
+    while (size > 0) {
+      auto len = static_cast< std::streamsize >(
+          std::min< uint64_t >(size, sizeof(buf)));
+      this->_stream.read(buf, len);
+      if (this->_stream.gcount() != len) {
+        throw SerializationError("invalid archive: unexpected end of stream");
+      }
+      s.append(buf, static_cast< std::size_t >(len));
+      size -= static_cast< uint64_t >(len);
+    }
+    return s;
+  }
+
+private:
+  /// \brief Read one byte
+  uint8_t read_byte() {
+    int c = this->_stream.get();
+    if (c == std::istream::traits_type::eof()) {
+      throw SerializationError("invalid archive: unexpected end of stream");
+    }
+    return static_cast< uint8_t >(c);
+  }
+
+}; // end class InputArchive
+
+/// \brief Serialization traits
+///
+/// Specialize it to make a type serializable. It should implement:
+///   static void save(OutputArchive&, const Serializable&);
+///   static Serializable load(InputArchive&);
+template < typename Serializable, typename = void >
+struct SerializableTraits {};
+
+/// \brief Serialize an object into an archive
+template < typename Serializable >
+inline void save(OutputArchive& ar, const Serializable& obj) {
+  SerializableTraits< Serializable >::save(ar, obj);
+}
+
+/// \brief Deserialize an object from an archive
+template < typename Serializable >
+inline Serializable load(InputArchive& ar) {
+  return SerializableTraits< Serializable >::load(ar);
+}
+
+/// \brief Implement SerializableTraits for unsigned integral types
+template < typename T >
+struct SerializableTraits<
+    T,
+    std::enable_if_t< std::is_integral< T >::value &&
+                      std::is_unsigned< T >::value &&
+                      !std::is_same< T, bool >::value > > {
+  static void save(OutputArchive& ar, T n) { ar.write_uint(n); }
+
+  static T load(InputArchive& ar) {
+    uint64_t n = ar.read_uint();
+    if (n > std::numeric_limits< T >::max()) {
+      throw SerializationError("invalid archive: integer out of range");
+    }
+    return static_cast< T >(n);
+  }
+};
+
+/// \brief Implement SerializableTraits for bool
+template <>
+struct SerializableTraits< bool > {
+  static void save(OutputArchive& ar, bool b) { ar.write_bool(b); }
+
+  static bool load(InputArchive& ar) { return ar.read_bool(); }
+};
+
+/// \brief Implement SerializableTraits for std::string
+template <>
+struct SerializableTraits< std::string > {
+  static void save(OutputArchive& ar, const std::string& s) {
+    ar.write_string(s);
+  }
+
+  static std::string load(InputArchive& ar) { return ar.read_string(); }
+};
+
+} // end namespace core
+} // end namespace ikos
@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Serialization of machine integer abstract values
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/core/number/serialization.hpp>
+#include <ikos/core/value/machine_int/congruence.hpp>
+#include <ikos/core/value/machine_int/interval.hpp>
+#include <ikos/core/value/machine_int/interval_congruence.hpp>
+
+namespace ikos {
+namespace core {
+
+namespace machine_int {
+namespace serialization_impl {
+
+/// \brief Read a machine integer of the given type
+inline MachineInt load_int(InputArchive& ar,
+                           unsigned bit_width,
+                           Signedness sign) {
+  auto n = core::load< MachineInt >(ar);
+  if (n.bit_width() != bit_width || n.sign() != sign) {
+    throw SerializationError("invalid archive: incompatible machine integer");
+  }
+  return n;
+}
+
+} // end namespace serialization_impl
+} // end namespace machine_int
+
+/// \brief Implement SerializableTraits for machine_int::Interval
+template <>
+struct SerializableTraits< machine_int::Interval > {
+  static void save(OutputArchive& ar, const machine_int::Interval& i) {
+    ar.write_uint(i.bit_width());
+    core::save(ar, i.sign());
+    ar.write_bool(i.is_bottom());
+    if (!i.is_bottom()) {
+      core::save(ar, i.lb());
+      core::save(ar, i.ub());
+    }
+  }
+
+  static machine_int::Interval load(InputArchive& ar) {
+    auto bit_width = core::load< unsigned >(ar);
+    auto sign = core::load< Signedness >(ar);
+    if (bit_width == 0) {
+      throw SerializationError("invalid archive: bad bit width");
+    }
+    if (ar.read_bool()) {
+      return machine_int::Interval::bottom(bit_width, sign);
+    }
+    MachineInt lb = machine_int::serialization_impl::load_int(ar,
+                                                              bit_width,
+                                                              sign);
+    MachineInt ub = machine_int::serialization_impl::load_int(ar,
+                                                              bit_width,
+                                                              sign);
+    if (lb > ub) {
+      throw SerializationError("invalid archive: bad interval");
+    }
+    return machine_int::Interval(std::move(lb), std::move(ub));
+  }
+};
+
+/// \brief Implement SerializableTraits for machine_int::Congruence
+template <>
+struct SerializableTraits< machine_int::Congruence > {
+  static void save(OutputArchive& ar, const machine_int::Congruence& c) {
+    ar.write_uint(c.bit_width());
+    core::save(ar, c.sign());
+    ar.write_bool(c.is_bottom());
+    if (!c.is_bottom()) {
+      core::save(ar, c.modulus());
+      core::save(ar, c.residue());
+    }
+  }
+
+  static machine_int::Congruence load(InputArchive& ar) {
+    auto bit_width = core::load< unsigned >(ar);
+    auto sign = core::load< Signedness >(ar);
+    if (bit_width == 0) {
+      throw SerializationError("invalid archive: bad bit width");
+    }
+    if (ar.read_bool()) {
+      return machine_int::Congruence::bottom(bit_width, sign);
+    }
+    auto a = core::load< ZNumber >(ar);
+    auto b = core::load< ZNumber >(ar);
+    if (a < 0) {
+      throw SerializationError("invalid archive: bad congruence");
+    }
+    return machine_int::Congruence(std::move(a),
+                                   std::move(b),
+                                   bit_width,
+                                   sign);
+  }
+};
+
+/// \brief Implement SerializableTraits for machine_int::IntervalCongruence
+template <>
+struct SerializableTraits< machine_int::IntervalCongruence > {
+  static void save(OutputArchive& ar,
+                   const machine_int::IntervalCongruence& ic) {
+    ar.write_bool(ic.is_bottom());
+    if (ic.is_bottom()) {
+      ar.write_uint(ic.bit_width());
+      core::save(ar, ic.sign());
+    } else {
+      core::save(ar, ic.interval());
+      core::save(ar, ic.congruence());
+    }
+  }
+
+  static machine_int::IntervalCongruence load(InputArchive& ar) {
+    if (ar.read_bool()) {
+      auto bit_width = core::load< unsigned >(ar);
+      auto sign = core::load< Signedness >(ar);
+      if (bit_width == 0) {
+        throw SerializationError("invalid archive: bad bit width");
+      }
+      return machine_int::IntervalCongruence::bottom(bit_width, sign);
+    }
+    auto i = core::load< machine_int::Interval >(ar);
+    auto c = core::load< machine_int::Congruence >(ar);
+    if (i.bit_width() != c.bit_width() || i.sign() != c.sign()) {
+      throw SerializationError("invalid archive: bad interval-congruence");
+    }
+    return machine_int::IntervalCongruence(i, c);
+  }
+};
+
+} // end namespace core
+} // end namespace ikos
@@ -0,0 +1,172 @@
+/*******************************************************************************
+ *
+ * Benchmarks for PartitioningDomain
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <random>
+#include <vector>
+
+#include <ikos/core/domain/machine_int/interval.hpp>
+#include <ikos/core/domain/memory/dummy.hpp>
+#include <ikos/core/domain/memory/partitioning.hpp>
+#include <ikos/core/domain/scalar/machine_int.hpp>
+#include <ikos/core/domain/uninitialized/separate_domain.hpp>
+#include <ikos/core/example/memory_factory.hpp>
+#include <ikos/core/example/scalar/variable_factory.hpp>
+
+#include "harness.hpp"
+
+using Int = ikos::core::MachineInt;
+using Interval = ikos::core::machine_int::Interval;
+using ikos::core::Signed;
+using ikos::core::machine_int::BinaryOperator;
+using ikos::core::machine_int::Predicate;
+using VariableFactory = ikos::core::example::scalar::VariableFactory;
+using Variable = VariableFactory::VariableRef;
+using MemoryFactory = ikos::core::example::MemoryFactory;
+using MemoryLocation = MemoryFactory::MemoryLocationRef;
+using IntervalDomain = ikos::core::machine_int::IntervalDomain< Variable >;
+using UninitializedDomain =
+    ikos::core::uninitialized::SeparateDomain< Variable >;
+using ScalarDomain = ikos::core::scalar::MachineIntDomain< Variable,
+                                                           MemoryLocation,
+                                                           UninitializedDomain,
+                                                           IntervalDomain >;
+using MemoryDomain =
+    ikos::core::memory::DummyDomain< Variable, MemoryLocation, ScalarDomain >;
+using PartitioningDomain = ikos::core::memory::
+    PartitioningDomain< Variable, MemoryLocation, MemoryDomain >;
+using ikos::core::benchmark::Parameters;
+using ikos::core::benchmark::Runner;
+using ikos::core::benchmark::Sink;
+
+static PartitioningDomain make_top() {
+  return PartitioningDomain(MemoryDomain(
+      ScalarDomain(UninitializedDomain::top(), IntervalDomain::top())));
+}
+
+static Int make_int(int n) {
+  return Int(n, 32, Signed);
+}
+
+int main(int argc, char** argv) {
+  Parameters params = ikos::core::benchmark::parse_parameters(argc, argv);
+  Runner runner("memory-partitioning", params);
+  std::mt19937 rng(params.seed);
+
+  VariableFactory vfac;
+  std::vector< Variable > variables;
+  for (std::size_t i = 0; i < params.variables; i++) {
+    variables.push_back(vfac.get_int("v" + std::to_string(i), 32, Signed));
+  }
+
+  auto random_int = [&](int lb, int ub) {
+    return std::uniform_int_distribution< int >(lb, ub)(rng);
+  };
+  auto random_variable = [&] {
+    return variables[static_cast< std::size_t >(
+        random_int(0, static_cast< int >(variables.size()) - 1))];
+  };
+
+  // Synthetic abstract values, agreeing on a ratio `sharing` of the variables
+  PartitioningDomain a = make_top();
+  for (Variable x : variables) {
+    a.int_set(x, Interval(make_int(0), make_int(random_int(0, 100))));
+  }
+  PartitioningDomain b = a;
+  std::bernoulli_distribution shared(params.sharing);
+  for (Variable x : variables) {
+    if (!shared(rng)) {
+      int lb = random_int(0, 100);
+      b.int_set(x, Interval(make_int(lb), make_int(random_int(lb, 100))));
+    }
+  }
+  const PartitioningDomain j = a.join(b);
+
+  // Random operands, picked in a round-robin fashion
+  std::vector< std::pair< Variable, Variable > > pairs;
+  for (std::size_t i = 0; i < 64; i++) {
+    pairs.emplace_back(random_variable(), random_variable());
+  }
+  std::size_t next = 0;
+
+  runner.run("copy", 1, [&] {
+    PartitioningDomain c = a;
+    Sink = c.is_bottom();
+  });
+  runner.run("join", 1, [&] {
+    PartitioningDomain c = a.join(b);
+    Sink = c.is_bottom();
+  });
+  runner.run("widening", 1, [&] {
+    PartitioningDomain c = a.widening(j);
+    Sink = c.is_bottom();
+  });
+  runner.run("meet", 1, [&] {
+    PartitioningDomain c = a.meet(j);
+    Sink = c.is_bottom();
+  });
+  runner.run("leq", 1, [&] { Sink = a.leq(j); });
+  runner.run("copy+normalize", 1, [&] {
+    PartitioningDomain c = j;
+    c.normalize();
+    Sink = c.is_bottom();
+  });
+  runner.run("copy+int_apply", 1, [&] {
+    const auto& p = pairs[next++ % pairs.size()];
+    PartitioningDomain c = a;
+    c.int_apply(BinaryOperator::Add, p.first, p.second, make_int(1));
+    Sink = c.is_bottom();
+  });
+  runner.run("copy+int_add", 1, [&] {
+    const auto& p = pairs[next++ % pairs.size()];
+    PartitioningDomain c = a;
+    c.int_add(Predicate::LE, p.first, p.second);
+    Sink = c.is_bottom();
+  });
+  runner.run("copy+int_forget", 1, [&] {
+    const auto& p = pairs[next++ % pairs.size()];
+    PartitioningDomain c = a;
+    c.int_forget(p.first);
+    Sink = c.is_bottom();
+  });
+
+  return 0;
+}
@@ -0,0 +1,237 @@
+/*******************************************************************************
+ *
+ * Benchmarks for memory::ValueDomain
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ikos/core/domain/lifetime/separate_domain.hpp>
+#include <ikos/core/domain/machine_int/interval.hpp>
+#include <ikos/core/domain/memory/value.hpp>
+#include <ikos/core/domain/nullity/separate_domain.hpp>
+#include <ikos/core/domain/scalar/composite.hpp>
+#include <ikos/core/domain/uninitialized/separate_domain.hpp>
+#include <ikos/core/example/memory_factory.hpp>
+#include <ikos/core/example/scalar/variable_factory.hpp>
+
+#include "harness.hpp"
+
+using Int = ikos::core::MachineInt;
+using Interval = ikos::core::machine_int::Interval;
+using ikos::core::Nullity;
+using ikos::core::Signed;
+using ikos::core::Unsigned;
+using VariableFactory = ikos::core::example::scalar::VariableFactory;
+using Variable = VariableFactory::VariableRef;
+using MemoryFactory = ikos::core::example::MemoryFactory;
+using MemoryLocation = MemoryFactory::MemoryLocationRef;
+using Literal = ikos::core::Literal< Variable, MemoryLocation >;
+using CellSummarization = ikos::core::memory::CellSummarization;
+using IntervalDomain = ikos::core::machine_int::IntervalDomain< Variable >;
+using UninitializedDomain =
+    ikos::core::uninitialized::SeparateDomain< Variable >;
+using NullityDomain = ikos::core::nullity::SeparateDomain< Variable >;
+using ScalarDomain = ikos::core::scalar::CompositeDomain< Variable,
+                                                         MemoryLocation,
+                                                         UninitializedDomain,
+                                                         IntervalDomain,
+                                                         NullityDomain >;
+using LifetimeDomain = ikos::core::lifetime::SeparateDomain< MemoryLocation >;
+using ValueDomain = ikos::core::memory::ValueDomain< Variable,
+                                                     MemoryLocation,
+                                                     VariableFactory*,
+                                                     ScalarDomain,
+                                                     LifetimeDomain >;
+using ikos::core::benchmark::Parameters;
+using ikos::core::benchmark::Runner;
+using ikos::core::benchmark::Sink;
+
+/// \brief Number of memory locations of the synthetic abstract values
+static const std::size_t NumLocations = 4;
+
+static ValueDomain make_top(VariableFactory& vfac,
+                            CellSummarization* summarization) {
+  return ValueDomain(&vfac,
+                     ScalarDomain(UninitializedDomain::top(),
+                                  IntervalDomain::top(),
+                                  NullityDomain::top()),
+                     LifetimeDomain::top(),
+                     summarization);
+}
+
+static Int make_int(int n) {
+  return Int(n, 32, Signed);
+}
+
+static Int make_offset(std::size_t n) {
+  return Int(n, 64, Unsigned);
+}
+
+int main(int argc, char** argv) {
+  Parameters params = ikos::core::benchmark::parse_parameters(argc, argv);
+  Runner runner("memory-value", params);
+  std::mt19937 rng(params.seed);
+
+  VariableFactory vfac;
+  MemoryFactory mfac;
+  const Int four = make_offset(4);
+
+  // One base pointer per memory location, and a pointer used for accesses
+  std::vector< MemoryLocation > locations;
+  std::vector< Variable > bases;
+  for (std::size_t i = 0; i < NumLocations; i++) {
+    locations.push_back(mfac.get("m" + std::to_string(i)));
+    bases.push_back(vfac.get_pointer("p" + std::to_string(i), 64, Unsigned));
+  }
+  Variable ptr = vfac.get_pointer("q", 64, Unsigned);
+  Variable x = vfac.get_int("x", 32, Signed);
+
+  // The cells are 4-byte integers, spread over the memory locations
+  std::size_t cells_per_location =
+      std::max(params.variables / NumLocations, std::size_t(1));
+
+  auto random_int = [&](int lb, int ub) {
+    return std::uniform_int_distribution< int >(lb, ub)(rng);
+  };
+
+  // Write the cell `n` of the memory location `i`
+  auto write = [&](ValueDomain& inv, std::size_t i, std::size_t n, int v) {
+    inv.pointer_assign(ptr, bases[i], make_offset(4 * n));
+    inv.mem_write(ptr, Literal::machine_int(make_int(v)), four);
+  };
+
+  // Read the cell `n` of the memory location `i`
+  auto read = [&](ValueDomain& inv, std::size_t i, std::size_t n) {
+    inv.pointer_assign(ptr, bases[i], make_offset(4 * n));
+    inv.mem_read(Literal::machine_int_var(x), ptr, four);
+  };
+
+  // Synthetic abstract values, agreeing on a ratio `sharing` of the cells
+  auto make_values = [&](CellSummarization* summarization) {
+    ValueDomain a = make_top(vfac, summarization);
+    for (std::size_t i = 0; i < NumLocations; i++) {
+      a.pointer_assign(bases[i], locations[i], Nullity::non_null());
+      for (std::size_t n = 0; n < cells_per_location; n++) {
+        write(a, i, n, random_int(0, 100));
+      }
+    }
+    ValueDomain b = a;
+    std::bernoulli_distribution shared(params.sharing);
+    for (std::size_t i = 0; i < NumLocations; i++) {
+      for (std::size_t n = 0; n < cells_per_location; n++) {
+        if (!shared(rng)) {
+          write(b, i, n, random_int(0, 100));
+        }
+      }
+    }
+    a.pointer_forget(ptr);
+    b.pointer_forget(ptr);
+    return std::make_pair(a, b);
+  };
+
+  // Random accesses, picked in a round-robin fashion
+  std::vector< std::pair< std::size_t, std::size_t > > accesses;
+  for (std::size_t k = 0; k < 64; k++) {
+    accesses.emplace_back(
+        static_cast< std::size_t >(
+            random_int(0, static_cast< int >(NumLocations) - 1)),
+        static_cast< std::size_t >(
+            random_int(0, static_cast< int >(cells_per_location) - 1)));
+  }
+  std::size_t next = 0;
+
+  // Run the benchmarks on the given abstract values
+  auto run = [&](const std::string& suffix,
+                 const ValueDomain& a,
+                 const ValueDomain& b) {
+    const ValueDomain j = a.join(b);
+
+    runner.run("copy" + suffix, 1, [&] {
+      ValueDomain c = a;
+      Sink = c.is_bottom();
+    });
+    runner.run("join" + suffix, 1, [&] {
+      ValueDomain c = a.join(b);
+      Sink = c.is_bottom();
+    });
+    runner.run("widening" + suffix, 1, [&] {
+      ValueDomain c = a.widening(j);
+      Sink = c.is_bottom();
+    });
+    runner.run("meet" + suffix, 1, [&] {
+      ValueDomain c = a.meet(j);
+      Sink = c.is_bottom();
+    });
+    runner.run("leq" + suffix, 1, [&] { Sink = a.leq(j); });
+    runner.run("copy+mem_write" + suffix, 1, [&] {
+      const auto& access = accesses[next++ % accesses.size()];
+      ValueDomain c = a;
+      write(c, access.first, access.second, 42);
+      Sink = c.is_bottom();
+    });
+    runner.run("copy+mem_read" + suffix, 1, [&] {
+      const auto& access = accesses[next++ % accesses.size()];
+      ValueDomain c = a;
+      read(c, access.first, access.second);
+      Sink = c.is_bottom();
+    });
+    runner.run("copy+mem_forget" + suffix, 1, [&] {
+      const auto& access = accesses[next++ % accesses.size()];
+      ValueDomain c = a;
+      c.mem_forget(locations[access.first]);
+      Sink = c.is_bottom();
+    });
+  };
+
+  // One cell per memory slot
+  auto values = make_values(nullptr);
+  run("", values.first, values.second);
+
+  // Memory locations summarized into a smash cell
+  CellSummarization summarization(/* max_cells = */ 1);
+  auto summarized = make_values(&summarization);
+  run(" (summarized)", summarized.first, summarized.second);
+
+  return 0;
+}
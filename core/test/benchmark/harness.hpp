@@ -0,0 +1,328 @@
+/*******************************************************************************
+ *
+ * Harness for the benchmarks of abstract domains
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gmp.h>
+
+namespace ikos {
+namespace core {
+namespace benchmark {
+
+/// \brief Number of dynamic allocations, through operator new and GMP
+///
+/// Each benchmark executable is a single translation unit including this
+/// header, which replaces the global operator new.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static std::uint64_t AllocationCount = 0;
+
+/// \brief Sink for results that must not be optimized away
+// NOLINTNEXTLINE(readability-identifier-naming)
+static volatile bool Sink = false;
+
+/// \brief Parameters of the benchmarks
+struct Parameters {
+  /// \brief Number of variables of the synthetic abstract values
+  std::size_t variables = 32;
+
+  /// \brief Probability for a pair of variables to be related by a constraint
+  double density = 0.1;
+
+  /// \brief Ratio of variables with the same value in two synthetic abstract
+  /// values
+  double sharing = 0.9;
+
+  /// \brief Seed of the random number generator
+  unsigned seed = 0;
+
+  /// \brief Minimum running time of a benchmark, in seconds
+  double min_time = 0.2;
+
+  /// \brief Only run the benchmarks whose name contains this string
+  std::string filter;
+
+  /// \brief Operation traces to replay
+  std::vector< std::string > traces;
+
+  /// \brief Print the results in CSV format
+  bool csv = false;
+};
+
+/// \brief Print the usage and exit
+[[noreturn]] inline void usage(const char* progname, int status) {
+  std::ostream& o = (status == 0) ? std::cout : std::cerr;
+  o << "usage: " << progname << " [options] [trace...]\n"
+    << "\n"
+    << "options:\n"
+    << "  --variables=N  number of variables of the synthetic abstract values "
+       "(default: 32)\n"
+    << "  --density=D    probability for a pair of variables to be related "
+       "(default: 0.1)\n"
+    << "  --sharing=S    ratio of variables with the same value in two "
+       "abstract values (default: 0.9)\n"
+    << "  --seed=N       seed of the random number generator (default: 0)\n"
+    << "  --min-time=T   minimum running time of a benchmark, in seconds "
+       "(default: 0.2)\n"
+    << "  --filter=NAME  only run the benchmarks containing NAME\n"
+    << "  --csv          print the results in CSV format\n"
+    << "  -h, --help     print this help\n";
+  std::exit(status);
+}
+
+/// \brief Parse the command line arguments
+inline Parameters parse_parameters(int argc, char** argv) {
+  Parameters params;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    std::string::size_type eq = arg.find('=');
+    std::string key = arg.substr(0, eq);
+    std::string value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+
+    try {
+      if (key == "-h" || key == "--help") {
+        usage(argv[0], 0);
+      } else if (key == "--variables") {
+        params.variables = std::stoul(value);
+      } else if (key == "--density") {
+        params.density = std::stod(value);
+      } else if (key == "--sharing") {
+        params.sharing = std::stod(value);
+      } else if (key == "--seed") {
+        params.seed = static_cast< unsigned >(std::stoul(value));
+      } else if (key == "--min-time") {
+        params.min_time = std::stod(value);
+      } else if (key == "--filter") {
+        params.filter = value;
+      } else if (key == "--csv") {
+        params.csv = true;
+      } else if (!key.empty() && key[0] != '-') {
+        params.traces.push_back(arg);
+      } else {
+        std::cerr << argv[0] << ": error: unknown option '" << arg << "'\n";
+        usage(argv[0], 1);
+      }
+    } catch (const std::logic_error&) {
+      std::cerr << argv[0] << ": error: invalid value for '" << key << "'\n";
+      usage(argv[0], 1);
+    }
+  }
+
+  if (params.variables < 2 || params.density < 0 || params.density > 1 ||
+      params.sharing < 0 || params.sharing > 1 || params.min_time <= 0) {
+    std::cerr << argv[0] << ": error: parameter out of range\n";
+    usage(argv[0], 1);
+  }
+
+  return params;
+}
+
+namespace detail {
+
+inline void* gmp_allocate(std::size_t size) {
+  AllocationCount++;
+  void* p = std::malloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+inline void* gmp_reallocate(void* ptr,
+                            std::size_t /*old_size*/,
+                            std::size_t new_size) {
+  AllocationCount++;
+  void* p = std::realloc(ptr, new_size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+inline void gmp_free(void* ptr, std::size_t /*size*/) {
+  std::free(ptr);
+}
+
+} // end namespace detail
+
+/// \brief Runs benchmarks and prints their results
+class Runner {
+private:
+  using Clock = std::chrono::steady_clock;
+  using Duration = std::chrono::duration< double >;
+
+private:
+  /// \brief Name of the benchmarked abstract domain
+  std::string _domain;
+
+  /// \brief Parameters
+  const Parameters& _params;
+
+public:
+  /// \brief Constructor
+  Runner(std::string domain, const Parameters& params)
+      : _domain(std::move(domain)), _params(params) {
+    // Count the allocations of GMP numbers
+    mp_set_memory_functions(detail::gmp_allocate,
+                            detail::gmp_reallocate,
+                            detail::gmp_free);
+
+    if (this->_params.csv) {
+      std::cout << "domain,benchmark,variables,density,sharing,iterations,"
+                   "ns_per_op,ops_per_sec,allocs_per_op\n";
+    } else {
+      std::cout << std::left << std::setw(40) << (this->_domain + ":")
+                << std::right << std::setw(14) << "ns/op" << std::setw(16)
+                << "ops/sec" << std::setw(14) << "allocs/op"
+                << "\n";
+    }
+  }
+
+  /// \brief No copy constructor
+  Runner(const Runner&) = delete;
+
+  /// \brief No move constructor
+  Runner(Runner&&) = delete;
+
+  /// \brief No copy assignment operator
+  Runner& operator=(const Runner&) = delete;
+
+  /// \brief No move assignment operator
+  Runner& operator=(Runner&&) = delete;
+
+  /// \brief Destructor
+  ~Runner() = default;
+
+  /// \brief Return the parameters
+  const Parameters& params() const { return this->_params; }
+
+  /// \brief Run a benchmark
+  ///
+  /// Calls `fn` repeatedly, in batches of increasing size, until the running
+  /// time exceeds the `min_time` parameter.
+  ///
+  /// \param name Name of the benchmark
+  /// \param ops Number of operations performed by one call to `fn`
+  /// \param fn Function performing the operations
+  template < typename Function >
+  void run(const std::string& name, std::size_t ops, Function fn) {
+    if (!this->_params.filter.empty() &&
+        name.find(this->_params.filter) == std::string::npos) {
+      return;
+    }
+
+    // Warm up
+    fn();
+
+    std::uint64_t iterations = 0;
+    std::uint64_t batch = 1;
+    Duration elapsed = Duration::zero();
+    std::uint64_t allocations = AllocationCount;
+
+    while (elapsed.count() < this->_params.min_time) {
+      Clock::time_point start = Clock::now();
+      for (std::uint64_t i = 0; i < batch; i++) {
+        fn();
+      }
+      elapsed += std::chrono::duration_cast< Duration >(Clock::now() - start);
+      iterations += batch;
+      batch *= 2;
+    }
+
+    allocations = AllocationCount - allocations;
+    auto total_ops = static_cast< double >(iterations * ops);
+    double ns_per_op = elapsed.count() * 1e9 / total_ops;
+    double ops_per_sec = total_ops / elapsed.count();
+    double allocs_per_op = static_cast< double >(allocations) / total_ops;
+
+    if (this->_params.csv) {
+      std::cout << this->_domain << "," << name << ","
+                << this->_params.variables << "," << this->_params.density
+                << "," << this->_params.sharing << "," << iterations << ","
+                << ns_per_op << "," << ops_per_sec << "," << allocs_per_op
+                << "\n";
+    } else {
+      std::cout << "  " << std::left << std::setw(38) << name << std::right
+                << std::fixed << std::setprecision(1) << std::setw(14)
+                << ns_per_op << std::setw(16) << std::setprecision(0)
+                << ops_per_sec << std::setw(14) << std::setprecision(2)
+                << allocs_per_op << "\n";
+      std::cout.unsetf(std::ios::floatfield);
+    }
+  }
+
+}; // end class Runner
+
+} // end namespace benchmark
+} // end namespace core
+} // end namespace ikos
+
+/// \brief Count the dynamic allocations
+void* operator new(std::size_t size) {
+  ikos::core::benchmark::AllocationCount++;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+// Not inlined, otherwise gcc reports a mismatch between new and free
+__attribute__((noinline)) void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr,
+                                               std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
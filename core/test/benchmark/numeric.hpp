@@ -0,0 +1,457 @@
+/*******************************************************************************
+ *
+ * Benchmarks of numerical abstract domains
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/number/bound.hpp>
+#include <ikos/core/number/z_number.hpp>
+#include <ikos/core/support/assert.hpp>
+#include <ikos/core/value/numeric/interval.hpp>
+
+#include "harness.hpp"
+
+namespace ikos {
+namespace core {
+namespace benchmark {
+
+/// \brief Benchmarks of a numerical abstract domain
+///
+/// Synthetic abstract values are generated from the parameters: all variables
+/// are bounded, pairs of variables are related by a constraint `x - y <= k`
+/// with probability `density`, and two abstract values agree on a ratio
+/// `sharing` of the variables.
+///
+/// Operation traces are text files with one operation per line, applied on a
+/// current abstract value and a saved one:
+///
+///   set x LB UB     x in [LB, UB], where bounds can be -oo or +oo
+///   assign x N      x = N
+///   assign x y N    x = y + N
+///   add x y N       add the constraint x - y <= N
+///   forget x        forget x
+///   save            save the current abstract value
+///   restore         restore the saved abstract value
+///   join            current = saved join current
+///   widen           current = saved widening current
+///   meet            current = saved meet current
+///   narrow          current = saved narrowing current
+///   leq             check if current is included in saved
+///   normalize       normalize the current abstract value
+///   top             set the current abstract value to top
+///
+/// Lines starting with '#' are ignored.
+template < typename Domain >
+class NumericBenchmark {
+private:
+  using VariableFactory = example::VariableFactory;
+  using Variable = VariableFactory::VariableRef;
+  using VariableExpr = VariableExpression< ZNumber, Variable >;
+  using Bound = ZBound;
+  using Interval = numeric::ZInterval;
+
+  /// \brief Kind of operation in a trace
+  enum class OperationKind {
+    Set,
+    AssignConstant,
+    AssignVariable,
+    Add,
+    Forget,
+    Save,
+    Restore,
+    Join,
+    Widen,
+    Meet,
+    Narrow,
+    Leq,
+    Normalize,
+    Top,
+  };
+
+  /// \brief Operation in a trace
+  struct Operation {
+    OperationKind kind;
+    Variable x;
+    Variable y;
+    Bound lb;
+    Bound ub;
+    ZNumber n;
+  };
+
+private:
+  /// \brief Variable factory
+  VariableFactory _vfac;
+
+  /// \brief Variables of the synthetic abstract values
+  std::vector< Variable > _variables;
+
+  /// \brief Random number generator
+  std::mt19937 _rng;
+
+public:
+  /// \brief Constructor
+  explicit NumericBenchmark(const Parameters& params) : _rng(params.seed) {
+    for (std::size_t i = 0; i < params.variables; i++) {
+      this->_variables.push_back(this->_vfac.get("v" + std::to_string(i)));
+    }
+  }
+
+  /// \brief Run the benchmarks on synthetic abstract values
+  void run_synthetic(Runner& runner) {
+    const Parameters& params = runner.params();
+
+    const Domain a = this->make_value(params);
+    const Domain b = this->make_variant(a, params);
+    const Domain j = a.join(b);
+
+    // Random operands, picked in a round-robin fashion
+    std::vector< std::pair< Variable, Variable > > pairs;
+    for (std::size_t i = 0; i < 64; i++) {
+      pairs.emplace_back(this->random_variable(), this->random_variable());
+    }
+    std::size_t next = 0;
+
+    runner.run("copy", 1, [&] {
+      Domain c = a;
+      Sink = c.is_bottom();
+    });
+    runner.run("join", 1, [&] {
+      Domain c = a.join(b);
+      Sink = c.is_bottom();
+    });
+    runner.run("widening", 1, [&] {
+      Domain c = a.widening(j);
+      Sink = c.is_bottom();
+    });
+    runner.run("meet", 1, [&] {
+      Domain c = a.meet(j);
+      Sink = c.is_bottom();
+    });
+    runner.run("leq", 1, [&] { Sink = a.leq(j); });
+    runner.run("copy+normalize", 1, [&] {
+      Domain c = j;
+      c.normalize();
+      Sink = c.is_bottom();
+    });
+    runner.run("copy+assign", 1, [&] {
+      const auto& p = pairs[next++ % pairs.size()];
+      Domain c = a;
+      c.assign(p.first, VariableExpr(p.second) + 1);
+      Sink = c.is_bottom();
+    });
+    runner.run("copy+add", 1, [&] {
+      const auto& p = pairs[next++ % pairs.size()];
+      Domain c = a;
+      c.add(VariableExpr(p.first) - VariableExpr(p.second) <= 10);
+      Sink = c.is_bottom();
+    });
+    runner.run("copy+forget", 1, [&] {
+      const auto& p = pairs[next++ % pairs.size()];
+      Domain c = a;
+      c.forget(p.first);
+      Sink = c.is_bottom();
+    });
+  }
+
+  /// \brief Replay an operation trace
+  ///
+  /// \returns false if the trace could not be parsed
+  bool run_trace(Runner& runner, const std::string& path) {
+    std::vector< Operation > trace;
+    if (!this->parse_trace(path, trace)) {
+      return false;
+    }
+
+    runner.run("trace:" + path, trace.size(), [&] {
+      Domain current = Domain::top();
+      Domain saved = Domain::top();
+      for (const Operation& op : trace) {
+        this->apply(op, current, saved);
+      }
+      Sink = current.is_bottom();
+    });
+    return true;
+  }
+
+private:
+  /// \brief Return a random integer in [lb, ub]
+  int random_int(int lb, int ub) {
+    return std::uniform_int_distribution< int >(lb, ub)(this->_rng);
+  }
+
+  /// \brief Return true with the given probability
+  bool random_bool(double p) {
+    return std::bernoulli_distribution(p)(this->_rng);
+  }
+
+  /// \brief Return a random variable
+  Variable random_variable() {
+    return this->_variables[static_cast< std::size_t >(
+        this->random_int(0, static_cast< int >(this->_variables.size()) - 1))];
+  }
+
+  /// \brief Return a random non-empty interval in [0, 100]
+  Interval random_interval() {
+    int lb = this->random_int(0, 100);
+    int ub = this->random_int(lb, 100);
+    return Interval(Bound(lb), Bound(ub));
+  }
+
+  /// \brief Generate a synthetic abstract value
+  ///
+  /// The abstract value is satisfiable: all variables equal to zero is a
+  /// solution.
+  Domain make_value(const Parameters& params) {
+    Domain inv = Domain::top();
+
+    for (Variable x : this->_variables) {
+      inv.set(x, Interval(Bound(0), Bound(this->random_int(0, 100))));
+    }
+
+    for (Variable x : this->_variables) {
+      for (Variable y : this->_variables) {
+        if (x != y && this->random_bool(params.density / 2)) {
+          inv.add(VariableExpr(x) - VariableExpr(y) <= this->random_int(0, 100));
+        }
+      }
+    }
+
+    inv.normalize();
+    return inv;
+  }
+
+  /// \brief Generate a variant of the given abstract value
+  ///
+  /// The variant is a copy where a ratio `1 - sharing` of the variables are
+  /// assigned a new random interval.
+  Domain make_variant(const Domain& inv, const Parameters& params) {
+    Domain variant = inv;
+
+    for (Variable x : this->_variables) {
+      if (!this->random_bool(params.sharing)) {
+        variant.forget(x);
+        variant.set(x, this->random_interval());
+      }
+    }
+
+    variant.normalize();
+    return variant;
+  }
+
+  /// \brief Parse a bound
+  static Bound parse_bound(const std::string& str) {
+    if (str == "-oo") {
+      return Bound::minus_infinity();
+    } else if (str == "+oo") {
+      return Bound::plus_infinity();
+    } else {
+      return Bound(ZNumber::from_string(str));
+    }
+  }
+
+  /// \brief Parse an operation trace
+  bool parse_trace(const std::string& path, std::vector< Operation >& trace) {
+    std::ifstream file(path);
+    if (!file) {
+      std::cerr << path << ": error: could not open file\n";
+      return false;
+    }
+
+    std::string line;
+    for (unsigned lineno = 1; std::getline(file, line); lineno++) {
+      std::istringstream s(line);
+      std::vector< std::string > words;
+      std::string word;
+      while (s >> word) {
+        words.push_back(word);
+      }
+
+      if (words.empty() || words[0][0] == '#') {
+        continue;
+      }
+
+      Operation op{OperationKind::Top,
+                   nullptr,
+                   nullptr,
+                   Bound(0),
+                   Bound(0),
+                   ZNumber(0)};
+      const std::string& name = words[0];
+
+      try {
+        if (name == "set" && words.size() == 4) {
+          op.kind = OperationKind::Set;
+          op.x = this->_vfac.get(words[1]);
+          op.lb = parse_bound(words[2]);
+          op.ub = parse_bound(words[3]);
+        } else if (name == "assign" && words.size() == 3) {
+          op.kind = OperationKind::AssignConstant;
+          op.x = this->_vfac.get(words[1]);
+          op.n = ZNumber::from_string(words[2]);
+        } else if (name == "assign" && words.size() == 4) {
+          op.kind = OperationKind::AssignVariable;
+          op.x = this->_vfac.get(words[1]);
+          op.y = this->_vfac.get(words[2]);
+          op.n = ZNumber::from_string(words[3]);
+        } else if (name == "add" && words.size() == 4) {
+          op.kind = OperationKind::Add;
+          op.x = this->_vfac.get(words[1]);
+          op.y = this->_vfac.get(words[2]);
+          op.n = ZNumber::from_string(words[3]);
+        } else if (name == "forget" && words.size() == 2) {
+          op.kind = OperationKind::Forget;
+          op.x = this->_vfac.get(words[1]);
+        } else if (words.size() == 1 && name == "save") {
+          op.kind = OperationKind::Save;
+        } else if (words.size() == 1 && name == "restore") {
+          op.kind = OperationKind::Restore;
+        } else if (words.size() == 1 && name == "join") {
+          op.kind = OperationKind::Join;
+        } else if (words.size() == 1 && name == "widen") {
+          op.kind = OperationKind::Widen;
+        } else if (words.size() == 1 && name == "meet") {
+          op.kind = OperationKind::Meet;
+        } else if (words.size() == 1 && name == "narrow") {
+          op.kind = OperationKind::Narrow;
+        } else if (words.size() == 1 && name == "leq") {
+          op.kind = OperationKind::Leq;
+        } else if (words.size() == 1 && name == "normalize") {
+          op.kind = OperationKind::Normalize;
+        } else if (words.size() == 1 && name == "top") {
+          op.kind = OperationKind::Top;
+        } else {
+          std::cerr << path << ":" << lineno << ": error: invalid operation\n";
+          return false;
+        }
+      } catch (const std::exception&) {
+        std::cerr << path << ":" << lineno << ": error: invalid number\n";
+        return false;
+      }
+
+      trace.push_back(std::move(op));
+    }
+
+    return true;
+  }
+
+  /// \brief Apply an operation of a trace
+  static void apply(const Operation& op, Domain& current, Domain& saved) {
+    switch (op.kind) {
+      case OperationKind::Set: {
+        current.set(op.x, Interval(op.lb, op.ub));
+      } break;
+      case OperationKind::AssignConstant: {
+        current.assign(op.x, op.n);
+      } break;
+      case OperationKind::AssignVariable: {
+        current.assign(op.x, VariableExpr(op.y) + op.n);
+      } break;
+      case OperationKind::Add: {
+        current.add(VariableExpr(op.x) - VariableExpr(op.y) <= op.n);
+      } break;
+      case OperationKind::Forget: {
+        current.forget(op.x);
+      } break;
+      case OperationKind::Save: {
+        saved = current;
+      } break;
+      case OperationKind::Restore: {
+        current = saved;
+      } break;
+      case OperationKind::Join: {
+        current = saved.join(current);
+      } break;
+      case OperationKind::Widen: {
+        current = saved.widening(current);
+      } break;
+      case OperationKind::Meet: {
+        current = saved.meet(current);
+      } break;
+      case OperationKind::Narrow: {
+        current = saved.narrowing(current);
+      } break;
+      case OperationKind::Leq: {
+        Sink = current.leq(saved);
+      } break;
+      case OperationKind::Normalize: {
+        current.normalize();
+      } break;
+      case OperationKind::Top: {
+        current.set_to_top();
+      } break;
+      default: {
+        ikos_unreachable("unreachable");
+      }
+    }
+  }
+
+}; // end class NumericBenchmark
+
+/// \brief Run the benchmarks of a numerical abstract domain
+///
+/// \param name Name of the abstract domain
+template < typename Domain >
+int run_numeric_benchmarks(const char* name, int argc, char** argv) {
+  Parameters params = parse_parameters(argc, argv);
+  Runner runner(name, params);
+  NumericBenchmark< Domain > benchmark(params);
+
+  benchmark.run_synthetic(runner);
+
+  for (const std::string& trace : params.traces) {
+    if (!benchmark.run_trace(runner, trace)) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+} // end namespace benchmark
+} // end namespace core
+} // end namespace ikos
@@ -0,0 +1,703 @@
+/*******************************************************************************
+ *
+ * Tests for machine_int::CompactIntervalDomain
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_machine_int_compact_interval_domain
+#define BOOST_TEST_DYN_LINK
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/machine_int/compact_interval.hpp>
+#include <ikos/core/example/machine_int/variable_factory.hpp>
+
+using Int = ikos::core::MachineInt;
+using Interval = ikos::core::machine_int::Interval;
+using ikos::core::Signed;
+using ikos::core::Unsigned;
+using ikos::core::machine_int::BinaryOperator;
+using ikos::core::machine_int::Predicate;
+using ikos::core::machine_int::UnaryOperator;
+using VariableFactory = ikos::core::example::machine_int::VariableFactory;
+using Variable = VariableFactory::VariableRef;
+using VariableExpr = ikos::core::VariableExpression< Int, Variable >;
+using LinearExpr = ikos::core::LinearExpression< Int, Variable >;
+using IntervalDomain = ikos::core::machine_int::IntervalDomain< Variable >;
+using CompactDomain =
+    ikos::core::machine_int::CompactIntervalDomain< Variable >;
+
+BOOST_AUTO_TEST_CASE(is_top_and_bottom) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+
+  BOOST_CHECK(CompactDomain::top().is_top());
+  BOOST_CHECK(!CompactDomain::top().is_bottom());
+
+  BOOST_CHECK(!CompactDomain::bottom().is_top());
+  BOOST_CHECK(CompactDomain::bottom().is_bottom());
+
+  auto inv = CompactDomain::top();
+  BOOST_CHECK(inv.is_top());
+  BOOST_CHECK(!inv.is_bottom());
+
+  inv.set(x, Interval(Int(1, 32, Signed)));
+  BOOST_CHECK(!inv.is_top());
+  BOOST_CHECK(!inv.is_bottom());
+
+  inv.set(x, Interval::bottom(32, Signed));
+  BOOST_CHECK(!inv.is_top());
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(set_to_top_and_bottom) {
+  VariableFactory vfac;
+
+  auto inv = CompactDomain::top();
+  BOOST_CHECK(inv.is_top());
+  BOOST_CHECK(!inv.is_bottom());
+
+  inv.set_to_bottom();
+  BOOST_CHECK(!inv.is_top());
+  BOOST_CHECK(inv.is_bottom());
+
+  inv.set_to_top();
+  BOOST_CHECK(inv.is_top());
+  BOOST_CHECK(!inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(leq) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 32, Signed));
+  Variable z(vfac.get("z", 32, Signed));
+
+  BOOST_CHECK(CompactDomain::bottom().leq(CompactDomain::top()));
+  BOOST_CHECK(CompactDomain::bottom().leq(CompactDomain::bottom()));
+  BOOST_CHECK(!CompactDomain::top().leq(CompactDomain::bottom()));
+  BOOST_CHECK(CompactDomain::top().leq(CompactDomain::top()));
+
+  auto inv1 = CompactDomain::top();
+  inv1.set(x, Interval(Int(0, 32, Signed)));
+  BOOST_CHECK(inv1.leq(CompactDomain::top()));
+  BOOST_CHECK(!inv1.leq(CompactDomain::bottom()));
+
+  auto inv2 = CompactDomain::top();
+  inv2.set(x, Interval(Int(-1, 32, Signed), Int(1, 32, Signed)));
+  BOOST_CHECK(inv2.leq(CompactDomain::top()));
+  BOOST_CHECK(!inv2.leq(CompactDomain::bottom()));
+  BOOST_CHECK(inv1.leq(inv2));
+  BOOST_CHECK(!inv2.leq(inv1));
+
+  auto inv3 = CompactDomain::top();
+  inv3.set(x, Interval(Int(0, 32, Signed)));
+  inv3.set(y, Interval(Int(-1, 32, Signed), Int(1, 32, Signed)));
+  BOOST_CHECK(inv3.leq(CompactDomain::top()));
+  BOOST_CHECK(!inv3.leq(CompactDomain::bottom()));
+  BOOST_CHECK(inv3.leq(inv1));
+  BOOST_CHECK(!inv1.leq(inv3));
+
+  auto inv4 = CompactDomain::top();
+  inv4.set(x, Interval(Int(0, 32, Signed)));
+  inv4.set(y, Interval(Int(0, 32, Signed), Int(2, 32, Signed)));
+  BOOST_CHECK(inv4.leq(CompactDomain::top()));
+  BOOST_CHECK(!inv4.leq(CompactDomain::bottom()));
+  BOOST_CHECK(!inv3.leq(inv4));
+  BOOST_CHECK(!inv4.leq(inv3));
+
+  auto inv5 = CompactDomain::top();
+  inv5.set(x, Interval(Int(0, 32, Signed)));
+  inv5.set(y, Interval(Int(0, 32, Signed), Int(2, 32, Signed)));
+  inv5.set(z, Interval(Int::min(32, Signed), Int(0, 32, Signed)));
+  BOOST_CHECK(inv5.leq(CompactDomain::top()));
+  BOOST_CHECK(!inv5.leq(CompactDomain::bottom()));
+  BOOST_CHECK(!inv5.leq(inv3));
+  BOOST_CHECK(!inv3.leq(inv5));
+  BOOST_CHECK(inv5.leq(inv4));
+  BOOST_CHECK(!inv4.leq(inv5));
+}
+
+BOOST_AUTO_TEST_CASE(equals) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 32, Signed));
+
+  BOOST_CHECK(!CompactDomain::bottom().equals(CompactDomain::top()));
+  BOOST_CHECK(CompactDomain::bottom().equals(CompactDomain::bottom()));
+  BOOST_CHECK(!CompactDomain::top().equals(CompactDomain::bottom()));
+  BOOST_CHECK(CompactDomain::top().equals(CompactDomain::top()));
+
+  auto inv1 = CompactDomain::top();
+  inv1.set(x, Interval(Int(0, 32, Signed)));
+  BOOST_CHECK(!inv1.equals(CompactDomain::top()));
+  BOOST_CHECK(!inv1.equals(CompactDomain::bottom()));
+  BOOST_CHECK(inv1.equals(inv1));
+
+  auto inv2 = CompactDomain::top();
+  inv2.set(x, Interval(Int(-1, 32, Signed), Int(1, 32, Signed)));
+  BOOST_CHECK(!inv2.equals(CompactDomain::top()));
+  BOOST_CHECK(!inv2.equals(CompactDomain::bottom()));
+  BOOST_CHECK(!inv1.equals(inv2));
+  BOOST_CHECK(!inv2.equals(inv1));
+
+  auto inv3 = CompactDomain::top();
+  inv3.set(x, Interval(Int(0, 32, Signed)));
+  inv3.set(y, Interval(Int(-1, 32, Signed), Int(1, 32, Signed)));
+  BOOST_CHECK(!inv3.equals(CompactDomain::top()));
+  BOOST_CHECK(!inv3.equals(CompactDomain::bottom()));
+  BOOST_CHECK(!inv3.equals(inv1));
+  BOOST_CHECK(!inv1.equals(inv3));
+}
+
+BOOST_AUTO_TEST_CASE(join) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 32, Signed));
+
+  BOOST_CHECK((CompactDomain::bottom().join(CompactDomain::top()) ==
+               CompactDomain::top()));
+  BOOST_CHECK((CompactDomain::bottom().join(CompactDomain::bottom()) ==
+               CompactDomain::bottom()));
+  BOOST_CHECK((CompactDomain::top().join(CompactDomain::top()) ==
+               CompactDomain::top()));
+  BOOST_CHECK((CompactDomain::top().join(CompactDomain::bottom()) ==
+               CompactDomain::top()));
+
+  auto inv1 = CompactDomain::top();
+  inv1.set(x, Interval(Int(0, 32, Signed), Int(1, 32, Signed)));
+  BOOST_CHECK((inv1.join(CompactDomain::top()) == CompactDomain::top()));
+  BOOST_CHECK((inv1.join(CompactDomain::bottom()) == inv1));
+  BOOST_CHECK((CompactDomain::top().join(inv1) == CompactDomain::top()));
+  BOOST_CHECK((CompactDomain::bottom().join(inv1) == inv1));
+  BOOST_CHECK((inv1.join(inv1) == inv1));
+
+  auto inv2 = CompactDomain::top();
+  auto inv3 = CompactDomain::top();
+  inv2.set(x, Interval(Int(-1, 32, Signed), Int(0, 32, Signed)));
+  inv3.set(x, Interval(Int(-1, 32, Signed), Int(1, 32, Signed)));
+  BOOST_CHECK((inv1.join(inv2) == inv3));
+  BOOST_CHECK((inv2.join(inv1) == inv3));
+
+  auto inv4 = CompactDomain::top();
+  inv4.set(x, Interval(Int(-1, 32, Signed), Int(0, 32, Signed)));
+  inv4.set(y, Interval(Int(0, 32, Signed)));
+  BOOST_CHECK((inv4.join(inv2) == inv2));
+  BOOST_CHECK((inv2.join(inv4) == inv2));
+}
+
+BOOST_AUTO_TEST_CASE(widening) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+
+  BOOST_CHECK((CompactDomain::bottom().widening(CompactDomain::top()) ==
+               CompactDomain::top()));
+  BOOST_CHECK((CompactDomain::bottom().widening(CompactDomain::bottom()) ==
+               CompactDomain::bottom()));
+  BOOST_CHECK((CompactDomain::top().widening(CompactDomain::top()) ==
+               CompactDomain::top()));
+  BOOST_CHECK((CompactDomain::top().widening(CompactDomain::bottom()) ==
+               CompactDomain::top()));
+
+  auto inv1 = CompactDomain::top();
+  inv1.set(x, Interval(Int(0, 32, Signed), Int(1, 32, Signed)));
+  BOOST_CHECK((inv1.widening(CompactDomain::top()) == CompactDomain::top()));
+  BOOST_CHECK((inv1.widening(CompactDomain::bottom()) == inv1));
+  BOOST_CHECK((CompactDomain::top().widening(inv1) == CompactDomain::top()));
+  BOOST_CHECK((CompactDomain::bottom().widening(inv1) == inv1));
+  BOOST_CHECK((inv1.widening(inv1) == inv1));
+
+  auto inv2 = CompactDomain::top();
+  auto inv3 = CompactDomain::top();
+  inv2.set(x, Interval(Int(0, 32, Signed), Int(2, 32, Signed)));
+  inv3.set(x, Interval(Int(0, 32, Signed), Int::max(32, Signed)));
+  BOOST_CHECK((inv1.widening(inv2) == inv3));
+  BOOST_CHECK((inv2.widening(inv1) == inv2));
+}
+
+BOOST_AUTO_TEST_CASE(meet) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 32, Signed));
+
+  BOOST_CHECK((CompactDomain::bottom().meet(CompactDomain::top()) ==
+               CompactDomain::bottom()));
+  BOOST_CHECK((CompactDomain::bottom().meet(CompactDomain::bottom()) ==
+               CompactDomain::bottom()));
+  BOOST_CHECK((CompactDomain::top().meet(CompactDomain::top()) ==
+               CompactDomain::top()));
+  BOOST_CHECK((CompactDomain::top().meet(CompactDomain::bottom()) ==
+               CompactDomain::bottom()));
+
+  auto inv1 = CompactDomain::top();
+  inv1.set(x, Interval(Int(0, 32, Signed), Int(1, 32, Signed)));
+  BOOST_CHECK((inv1.meet(CompactDomain::top()) == inv1));
+  BOOST_CHECK(
+      (inv1.meet(CompactDomain::bottom()) == CompactDomain::bottom()));
+  BOOST_CHECK((CompactDomain::top().meet(inv1) == inv1));
+  BOOST_CHECK(
+      (CompactDomain::bottom().meet(inv1) == CompactDomain::bottom()));
+  BOOST_CHECK((inv1.meet(inv1) == inv1));
+
+  auto inv2 = CompactDomain::top();
+  auto inv3 = CompactDomain::top();
+  inv2.set(x, Interval(Int(-1, 32, Signed), Int(0, 32, Signed)));
+  inv3.set(x, Interval(Int(0, 32, Signed)));
+  BOOST_CHECK((inv1.meet(inv2) == inv3));
+  BOOST_CHECK((inv2.meet(inv1) == inv3));
+
+  auto inv4 = CompactDomain::top();
+  auto inv5 = CompactDomain::top();
+  inv4.set(x, Interval(Int(0, 32, Signed), Int(1, 32, Signed)));
+  inv4.set(y, Interval(Int(0, 32, Signed)));
+  inv5.set(x, Interval(Int(0, 32, Signed)));
+  inv5.set(y, Interval(Int(0, 32, Signed)));
+  BOOST_CHECK((inv4.meet(inv2) == inv5));
+  BOOST_CHECK((inv2.meet(inv4) == inv5));
+}
+
+BOOST_AUTO_TEST_CASE(narrowing) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+
+  BOOST_CHECK((CompactDomain::bottom().narrowing(CompactDomain::top()) ==
+               CompactDomain::bottom()));
+  BOOST_CHECK((CompactDomain::bottom().narrowing(CompactDomain::bottom()) ==
+               CompactDomain::bottom()));
+  BOOST_CHECK((CompactDomain::top().narrowing(CompactDomain::top()) ==
+               CompactDomain::top()));
+  BOOST_CHECK((CompactDomain::top().narrowing(CompactDomain::bottom()) ==
+               CompactDomain::bottom()));
+
+  auto inv1 = CompactDomain::top();
+  inv1.set(x, Interval(Int(0, 32, Signed), Int::max(32, Signed)));
+  BOOST_CHECK((inv1.narrowing(CompactDomain::top()) == inv1));
+  BOOST_CHECK(
+      (inv1.narrowing(CompactDomain::bottom()) == CompactDomain::bottom()));
+  BOOST_CHECK((CompactDomain::top().narrowing(inv1) == inv1));
+  BOOST_CHECK(
+      (CompactDomain::bottom().narrowing(inv1) == CompactDomain::bottom()));
+  BOOST_CHECK((inv1.narrowing(inv1) == inv1));
+
+  auto inv2 = CompactDomain::top();
+  auto inv3 = CompactDomain::top();
+  inv2.set(x, Interval(Int(0, 32, Signed), Int(1, 32, Signed)));
+  BOOST_CHECK((inv1.narrowing(inv2) == inv2));
+  BOOST_CHECK((inv2.narrowing(inv1) == inv2));
+}
+
+BOOST_AUTO_TEST_CASE(assign) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 32, Signed));
+  Variable z(vfac.get("z", 32, Signed));
+
+  auto inv1 = CompactDomain::top();
+  auto inv2 = CompactDomain::top();
+  inv1.assign(x, Int(0, 32, Signed));
+  inv2.set(x, Interval(Int(0, 32, Signed)));
+  BOOST_CHECK((inv1 == inv2));
+
+  inv1.set_to_bottom();
+  inv1.assign(x, Int(0, 32, Signed));
+  BOOST_CHECK(inv1.is_bottom());
+
+  inv1.set_to_top();
+  inv1.set(x, Interval(Int(-1, 32, Signed), Int(1, 32, Signed)));
+  inv1.assign(y, x);
+  BOOST_CHECK(inv1.to_interval(y) ==
+              Interval(Int(-1, 32, Signed), Int(1, 32, Signed)));
+
+  inv1.set_to_top();
+  inv1.set(x, Interval(Int(-1, 32, Signed), Int(1, 32, Signed)));
+  inv1.set(y, Interval(Int(1, 32, Signed), Int(2, 32, Signed)));
+
+  LinearExpr e(Int(1, 32, Signed));
+  e.add(Int(2, 32, Signed), x);
+  e.add(Int(-3, 32, Signed), y);
+  inv1.assign(z, e);
+
+  BOOST_CHECK(inv1.to_interval(z) ==
+              Interval(Int(-7, 32, Signed), Int(0, 32, Signed)));
+}
+
+BOOST_AUTO_TEST_CASE(unary_apply) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 8, Signed));
+  Variable y(vfac.get("y", 6, Signed));
+  Variable z(vfac.get("z", 8, Signed));
+  Variable w(vfac.get("w", 8, Unsigned));
+
+  auto inv = CompactDomain::top();
+  inv.assign(x, Int(85, 8, Signed));
+  BOOST_CHECK(inv.to_interval(x) == Interval(Int(85, 8, Signed)));
+  inv.apply(UnaryOperator::Trunc, y, x);
+  BOOST_CHECK(inv.to_interval(y) == Interval(Int(21, 6, Signed)));
+  inv.apply(UnaryOperator::Ext, z, y);
+  BOOST_CHECK(inv.to_interval(z) == Interval(Int(21, 8, Signed)));
+  inv.apply(UnaryOperator::SignCast, w, z);
+  BOOST_CHECK(inv.to_interval(w) == Interval(Int(21, 8, Unsigned)));
+}
+
+BOOST_AUTO_TEST_CASE(binary_apply) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 8, Signed));
+  Variable y(vfac.get("y", 8, Signed));
+  Variable z(vfac.get("z", 8, Signed));
+
+  auto inv = CompactDomain::top();
+  inv.assign(x, Int(85, 8, Signed));
+  BOOST_CHECK(inv.to_interval(x) == Interval(Int(85, 8, Signed)));
+  inv.apply(BinaryOperator::Add, y, x, Int(43, 8, Signed));
+  BOOST_CHECK(inv.to_interval(y) == Interval(Int(-128, 8, Signed)));
+  inv.apply(BinaryOperator::SubNoWrap, z, y, Int(1, 8, Signed));
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(add_var) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 32, Signed));
+
+  auto inv = CompactDomain::top();
+  inv.set(x, Interval(Int(0, 32, Signed), Int(4, 32, Signed)));
+  inv.set(y, Interval(Int(-4, 32, Signed), Int(0, 32, Signed)));
+  inv.add(Predicate::EQ, x, y);
+  BOOST_CHECK(inv.to_interval(x) == Interval(Int(0, 32, Signed)));
+  BOOST_CHECK(inv.to_interval(y) == Interval(Int(0, 32, Signed)));
+
+  inv.add(Predicate::NE, x, y);
+  BOOST_CHECK(inv.is_bottom());
+
+  inv.set_to_top();
+  inv.set(x, Interval(Int(0, 32, Signed), Int(4, 32, Signed)));
+  inv.set(y, Interval(Int(1, 32, Signed), Int(5, 32, Signed)));
+  inv.add(Predicate::GT, x, y);
+  BOOST_CHECK(inv.to_interval(x) ==
+              Interval(Int(2, 32, Signed), Int(4, 32, Signed)));
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(1, 32, Signed), Int(3, 32, Signed)));
+
+  inv.add(Predicate::LE, x, y);
+  BOOST_CHECK(inv.to_interval(x) ==
+              Interval(Int(2, 32, Signed), Int(3, 32, Signed)));
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(2, 32, Signed), Int(3, 32, Signed)));
+
+  inv.add(Predicate::LT, x, y);
+  BOOST_CHECK(inv.to_interval(x) == Interval(Int(2, 32, Signed)));
+  BOOST_CHECK(inv.to_interval(y) == Interval(Int(3, 32, Signed)));
+
+  inv.add(Predicate::EQ, x, y);
+  BOOST_CHECK(inv.is_bottom());
+
+  inv.set_to_top();
+  inv.set(x, Interval(Int(0, 32, Signed), Int(4, 32, Signed)));
+  inv.set(y, Interval(Int(1, 32, Signed), Int(5, 32, Signed)));
+  inv.add(Predicate::GE, x, y);
+  BOOST_CHECK(inv.to_interval(x) ==
+              Interval(Int(1, 32, Signed), Int(4, 32, Signed)));
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(1, 32, Signed), Int(4, 32, Signed)));
+
+  inv.set_to_top();
+  inv.set(y, Interval(Int::min(32, Signed)));
+  inv.add(Predicate::LT, x, y);
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(add_int) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 32, Signed));
+
+  auto inv = CompactDomain::top();
+  inv.set(x, Interval(Int(0, 32, Signed), Int(4, 32, Signed)));
+  inv.add(Predicate::EQ, x, Int(1, 32, Signed));
+  BOOST_CHECK(inv.to_interval(x) == Interval(Int(1, 32, Signed)));
+
+  inv.add(Predicate::NE, x, Int(1, 32, Signed));
+  BOOST_CHECK(inv.is_bottom());
+
+  inv.set_to_top();
+  inv.set(x, Interval(Int(0, 32, Signed), Int(4, 32, Signed)));
+  inv.add(Predicate::GT, x, Int(2, 32, Signed));
+  BOOST_CHECK(inv.to_interval(x) ==
+              Interval(Int(3, 32, Signed), Int(4, 32, Signed)));
+
+  inv.add(Predicate::LE, x, Int(3, 32, Signed));
+  BOOST_CHECK(inv.to_interval(x) == Interval(Int(3, 32, Signed)));
+
+  inv.add(Predicate::EQ, x, Int(2, 32, Signed));
+  BOOST_CHECK(inv.is_bottom());
+
+  inv.set_to_top();
+  inv.add(Predicate::GT, y, Int::max(32, Signed));
+  BOOST_CHECK(inv.is_bottom());
+
+  inv.set_to_top();
+  inv.add(Predicate::LT, y, Int::min(32, Signed));
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(set) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+
+  auto inv = CompactDomain::top();
+  inv.set(x, Interval(Int(1, 32, Signed), Int(2, 32, Signed)));
+  BOOST_CHECK(inv.to_interval(x) ==
+              Interval(Int(1, 32, Signed), Int(2, 32, Signed)));
+
+  inv.set(x, Interval::bottom(32, Signed));
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(refine) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+
+  auto inv = CompactDomain::top();
+  inv.refine(x, Interval(Int(1, 32, Signed), Int(2, 32, Signed)));
+  BOOST_CHECK(inv.to_interval(x) ==
+              Interval(Int(1, 32, Signed), Int(2, 32, Signed)));
+
+  inv.refine(x, Interval(Int(3, 32, Signed), Int(4, 32, Signed)));
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(forget) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 32, Signed));
+
+  auto inv = CompactDomain::top();
+  inv.set(x, Interval(Int(1, 32, Signed), Int(2, 32, Signed)));
+  inv.set(y, Interval(Int(3, 32, Signed), Int(4, 32, Signed)));
+  BOOST_CHECK(inv.to_interval(x) ==
+              Interval(Int(1, 32, Signed), Int(2, 32, Signed)));
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(3, 32, Signed), Int(4, 32, Signed)));
+
+  inv.forget(x);
+  BOOST_CHECK(inv.to_interval(x) == Interval::top(32, Signed));
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(3, 32, Signed), Int(4, 32, Signed)));
+
+  inv.forget(y);
+  BOOST_CHECK(inv.is_top());
+}
+
+BOOST_AUTO_TEST_CASE(to_interval) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 32, Signed));
+
+  auto inv = CompactDomain::top();
+  inv.set(x, Interval(Int(1, 32, Signed), Int(2, 32, Signed)));
+  inv.set(y, Interval(Int(3, 32, Signed), Int(4, 32, Signed)));
+
+  LinearExpr e1(Int(1, 32, Signed));
+  e1.add(Int(2, 32, Signed), x);
+  BOOST_CHECK(inv.to_interval(e1) ==
+              Interval(Int(3, 32, Signed), Int(5, 32, Signed)));
+
+  LinearExpr e2(Int(1, 32, Signed));
+  e2.add(Int(2, 32, Signed), x);
+  e2.add(Int(-3, 32, Signed), y);
+  BOOST_CHECK(inv.to_interval(e2) ==
+              Interval(Int(-9, 32, Signed), Int(-4, 32, Signed)));
+}
+
+namespace {
+
+/// \brief Random intervals on a set of variables of various types
+class RandomIntervals {
+private:
+  std::mt19937 _gen;
+
+public:
+  explicit RandomIntervals(unsigned seed) : _gen(seed) {}
+
+  /// \brief Return a random interval for the given variable
+  Interval interval(Variable x) {
+    std::uniform_int_distribution< int > dist(-50, 50);
+    unsigned bit_width = x->bit_width();
+    ikos::core::Signedness sign = x->sign();
+    Int a(dist(this->_gen), bit_width, sign);
+    Int b(dist(this->_gen), bit_width, sign);
+    return Interval(min(a, b), max(a, b));
+  }
+
+  /// \brief Return true with the given probability
+  bool flip(double p) {
+    std::bernoulli_distribution dist(p);
+    return dist(this->_gen);
+  }
+};
+
+/// \brief Create variables of various types
+std::vector< Variable > make_variables(VariableFactory& vfac, std::size_t n) {
+  std::vector< Variable > vars;
+  for (std::size_t i = 0; i < n; i++) {
+    std::string name = "v" + std::to_string(i);
+    switch (i % 5) {
+      case 0:
+        vars.push_back(vfac.get(name, 8, Unsigned));
+        break;
+      case 1:
+        vars.push_back(vfac.get(name, 32, Signed));
+        break;
+      case 2:
+        vars.push_back(vfac.get(name, 64, Signed));
+        break;
+      case 3:
+        vars.push_back(vfac.get(name, 64, Unsigned));
+        break;
+      default:
+        vars.push_back(vfac.get(name, 128, Signed));
+        break;
+    }
+  }
+  return vars;
+}
+
+/// \brief Check that both abstract values hold the same intervals
+bool same_intervals(const CompactDomain& inv,
+                    const IntervalDomain& ref,
+                    const std::vector< Variable >& vars) {
+  if (inv.is_bottom() || ref.is_bottom()) {
+    return inv.is_bottom() && ref.is_bottom();
+  }
+  for (Variable x : vars) {
+    if (!(inv.to_interval(x) == ref.to_interval(x))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(many_variables) {
+  VariableFactory vfac;
+  std::vector< Variable > vars = make_variables(vfac, 200);
+  RandomIntervals rand(0);
+
+  for (int round = 0; round < 20; round++) {
+    auto inv1 = CompactDomain::top();
+    auto ref1 = IntervalDomain::top();
+    for (Variable x : vars) {
+      if (rand.flip(0.9)) {
+        Interval i = rand.interval(x);
+        inv1.set(x, i);
+        ref1.set(x, i);
+      }
+    }
+    BOOST_CHECK(same_intervals(inv1, ref1, vars));
+
+    // Even rounds share the layout of inv1, odd rounds do not
+    CompactDomain inv2 = inv1;
+    IntervalDomain ref2 = ref1;
+    double p = (round % 2 == 0) ? 0.1 : 0.5;
+    for (Variable x : vars) {
+      if (rand.flip(p)) {
+        Interval i = rand.interval(x);
+        if (round % 2 == 1 && rand.flip(0.2)) {
+          inv2.forget(x);
+          ref2.forget(x);
+        } else {
+          inv2.set(x, i);
+          ref2.set(x, i);
+        }
+      }
+    }
+    BOOST_CHECK(same_intervals(inv1, ref1, vars));
+    BOOST_CHECK(same_intervals(inv2, ref2, vars));
+
+    BOOST_CHECK(inv1.leq(inv2) == ref1.leq(ref2));
+    BOOST_CHECK(inv2.leq(inv1) == ref2.leq(ref1));
+    BOOST_CHECK(inv1.equals(inv2) == ref1.equals(ref2));
+    BOOST_CHECK(inv1.leq(inv1.join(inv2)));
+    BOOST_CHECK(inv2.leq(inv1.join(inv2)));
+    BOOST_CHECK(inv1.meet(inv2).leq(inv1));
+
+    BOOST_CHECK(same_intervals(inv1.join(inv2), ref1.join(ref2), vars));
+    BOOST_CHECK(
+        same_intervals(inv1.widening(inv2), ref1.widening(ref2), vars));
+    BOOST_CHECK(same_intervals(inv1.meet(inv2), ref1.meet(ref2), vars));
+    BOOST_CHECK(
+        same_intervals(inv1.narrowing(inv2), ref1.narrowing(ref2), vars));
+
+    Int threshold(10, 32, Signed);
+    CompactDomain inv3 = inv1;
+    IntervalDomain ref3 = ref1;
+    inv3.widen_threshold_with(inv2, threshold);
+    ref3.widen_threshold_with(ref2, threshold);
+    BOOST_CHECK(same_intervals(inv3, ref3, vars));
+    inv3.narrow_threshold_with(inv2, threshold);
+    ref3.narrow_threshold_with(ref2, threshold);
+    BOOST_CHECK(same_intervals(inv3, ref3, vars));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(iterator) {
+  VariableFactory vfac;
+  std::vector< Variable > vars = make_variables(vfac, 100);
+  RandomIntervals rand(1);
+
+  auto inv = CompactDomain::top();
+  auto ref = IntervalDomain::top();
+  for (Variable x : vars) {
+    Interval i = rand.interval(x);
+    inv.set(x, i);
+    ref.set(x, i);
+  }
+
+  std::size_t n = 0;
+  for (const auto& entry : inv) {
+    BOOST_CHECK(entry.second == ref.to_interval(entry.first));
+    n++;
+  }
+  BOOST_CHECK(n == static_cast< std::size_t >(
+                       std::distance(ref.begin(), ref.end())));
+}
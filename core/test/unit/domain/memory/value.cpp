@@ -0,0 +1,300 @@
+/*******************************************************************************
+ *
+ * Tests for memory::ValueDomain
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_memory_value_domain
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/lifetime/separate_domain.hpp>
+#include <ikos/core/domain/machine_int/interval.hpp>
+#include <ikos/core/domain/memory/value.hpp>
+#include <ikos/core/domain/nullity/separate_domain.hpp>
+#include <ikos/core/domain/scalar/composite.hpp>
+#include <ikos/core/domain/uninitialized/separate_domain.hpp>
+#include <ikos/core/example/memory_factory.hpp>
+#include <ikos/core/example/scalar/variable_factory.hpp>
+
+using Int = ikos::core::MachineInt;
+using Interval = ikos::core::machine_int::Interval;
+using ikos::core::Nullity;
+using ikos::core::Signed;
+using ikos::core::Unsigned;
+using VariableFactory = ikos::core::example::scalar::VariableFactory;
+using Variable = VariableFactory::VariableRef;
+using MemoryFactory = ikos::core::example::MemoryFactory;
+using MemoryLocation = MemoryFactory::MemoryLocationRef;
+using Literal = ikos::core::Literal< Variable, MemoryLocation >;
+using CellSummarization = ikos::core::memory::CellSummarization;
+using IntervalDomain = ikos::core::machine_int::IntervalDomain< Variable >;
+using UninitializedDomain =
+    ikos::core::uninitialized::SeparateDomain< Variable >;
+using NullityDomain = ikos::core::nullity::SeparateDomain< Variable >;
+using ScalarDomain = ikos::core::scalar::CompositeDomain< Variable,
+                                                         MemoryLocation,
+                                                         UninitializedDomain,
+                                                         IntervalDomain,
+                                                         NullityDomain >;
+using LifetimeDomain = ikos::core::lifetime::SeparateDomain< MemoryLocation >;
+using ValueDomain = ikos::core::memory::ValueDomain< Variable,
+                                                     MemoryLocation,
+                                                     VariableFactory*,
+                                                     ScalarDomain,
+                                                     LifetimeDomain >;
+
+static ValueDomain make_top(VariableFactory& vfac,
+                            CellSummarization* summarization = nullptr) {
+  return ValueDomain(&vfac,
+                     ScalarDomain(UninitializedDomain::top(),
+                                  IntervalDomain::top(),
+                                  NullityDomain::top()),
+                     LifetimeDomain::top(),
+                     summarization);
+}
+
+BOOST_AUTO_TEST_CASE(read_write) {
+  VariableFactory vfac;
+  MemoryFactory mfac;
+  Variable x(vfac.get_int("x", 32, Signed));
+  Variable p(vfac.get_pointer("p", 64, Unsigned));
+  MemoryLocation a(mfac.get("a"));
+  Int four(4, 64, Unsigned);
+
+  auto inv = make_top(vfac);
+  inv.pointer_assign(p, a, Nullity::non_null());
+  inv.mem_write(p, Literal::machine_int(Int(1, 32, Signed)), four);
+  inv.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(inv.int_to_interval(x) == Interval(Int(1, 32, Signed)));
+
+  inv.mem_forget(a);
+  inv.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(inv.int_to_interval(x) == Interval::top(32, Signed));
+}
+
+BOOST_AUTO_TEST_CASE(summarization) {
+  VariableFactory vfac;
+  MemoryFactory mfac;
+  Variable x(vfac.get_int("x", 32, Signed));
+  Variable p(vfac.get_pointer("p", 64, Unsigned));
+  Variable q(vfac.get_pointer("q", 64, Unsigned));
+  MemoryLocation a(mfac.get("a"));
+  Int four(4, 64, Unsigned);
+  CellSummarization summarization(/* max_cells = */ 1);
+
+  // No cell on `a`
+  auto inv0 = make_top(vfac, &summarization);
+  inv0.pointer_assign(p, a, Nullity::non_null());
+  inv0.pointer_assign(q, p, Int(4, 64, Unsigned));
+
+  // Only one cell on `a`
+  auto inv1 = inv0;
+  inv1.mem_write(p, Literal::machine_int(Int(1, 32, Signed)), four);
+  inv1.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(inv1.int_to_interval(x) == Interval(Int(1, 32, Signed)));
+  BOOST_CHECK_EQUAL(summarization.num_summarizations(), 0);
+
+  // A second cell on `a` smashes both cells into one
+  auto inv2 = inv1;
+  inv2.mem_write(q, Literal::machine_int(Int(2, 32, Signed)), four);
+  BOOST_CHECK_EQUAL(summarization.num_summarizations(), 1);
+  auto inv3 = inv2;
+  inv3.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(inv3.int_to_interval(x) ==
+              Interval(Int(1, 32, Signed), Int(2, 32, Signed)));
+  inv3.mem_read(Literal::machine_int_var(x), q, four);
+  BOOST_CHECK(inv3.int_to_interval(x) ==
+              Interval(Int(1, 32, Signed), Int(2, 32, Signed)));
+
+  // Summarized memory locations hold less information
+  BOOST_CHECK(!inv2.leq(inv0));
+  BOOST_CHECK(!inv0.equals(inv2));
+  BOOST_CHECK(!inv2.equals(inv0));
+  BOOST_CHECK(!inv1.leq(inv2));
+  BOOST_CHECK(!inv2.leq(inv1));
+  BOOST_CHECK(!inv1.equals(inv2));
+  BOOST_CHECK(!inv2.equals(inv1));
+
+  // The join smashes the cells of `a`, in both directions
+  auto join1 = inv1.join(inv2);
+  auto join2 = inv2.join(inv1);
+  BOOST_CHECK(join1.equals(join2));
+  BOOST_CHECK(inv1.leq(join1));
+  BOOST_CHECK(inv2.leq(join1));
+  BOOST_CHECK(!join1.leq(inv2));
+  BOOST_CHECK(inv2.leq(inv0.join(inv2)));
+  BOOST_CHECK(!inv0.join(inv2).leq(inv0));
+
+  auto join3 = inv1;
+  join3.join_with(inv2);
+  BOOST_CHECK(join3.equals(join1));
+
+  auto join4 = inv1;
+  join4.join_loop_with(inv2);
+  BOOST_CHECK(join4.equals(join1));
+
+  // The smash cell only covers the bytes written on both sides
+  join1.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(join1.int_to_interval(x) ==
+              Interval(Int(1, 32, Signed), Int(2, 32, Signed)));
+  join1.mem_read(Literal::machine_int_var(x), q, four);
+  BOOST_CHECK(join1.int_to_interval(x) == Interval::top(32, Signed));
+
+  // The widening drops smash cells that grow
+  auto widening = inv1.widening(inv2);
+  BOOST_CHECK(inv2.leq(widening));
+  widening.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(widening.int_to_interval(x) == Interval::top(32, Signed));
+
+  // The meet keeps the cells of `a`
+  auto meet = inv1.meet(inv2);
+  BOOST_CHECK(meet.equals(inv1));
+  meet.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(meet.int_to_interval(x) == Interval(Int(1, 32, Signed)));
+}
+
+BOOST_AUTO_TEST_CASE(smash_cell) {
+  VariableFactory vfac;
+  MemoryFactory mfac;
+  Variable x(vfac.get_int("x", 32, Signed));
+  Variable p(vfac.get_pointer("p", 64, Unsigned));
+  Variable q(vfac.get_pointer("q", 64, Unsigned));
+  Variable r(vfac.get_pointer("r", 64, Unsigned));
+  Variable s(vfac.get_pointer("s", 64, Unsigned));
+  MemoryLocation a(mfac.get("a"));
+  Int two(2, 64, Unsigned);
+  Int four(4, 64, Unsigned);
+  CellSummarization summarization(/* max_cells = */ 1);
+
+  auto inv = make_top(vfac, &summarization);
+  inv.pointer_assign(p, a, Nullity::non_null());
+  inv.pointer_assign(q, p, Int(4, 64, Unsigned));
+  inv.pointer_assign(r, p, Int(8, 64, Unsigned));
+  inv.pointer_assign(s, p, Int(2, 64, Unsigned));
+  inv.mem_write(p, Literal::machine_int(Int(1, 32, Signed)), four);
+  inv.mem_write(q, Literal::machine_int(Int(2, 32, Signed)), four);
+
+  // Writes on a summarized location are weak updates
+  auto weak = inv;
+  weak.mem_write(p, Literal::machine_int(Int(5, 32, Signed)), four);
+  weak.mem_read(Literal::machine_int_var(x), q, four);
+  BOOST_CHECK(weak.int_to_interval(x) ==
+              Interval(Int(1, 32, Signed), Int(5, 32, Signed)));
+
+  // A contiguous aligned write extends the smash cell
+  auto extended = inv;
+  extended.mem_write(r, Literal::machine_int(Int(3, 32, Signed)), four);
+  extended.mem_read(Literal::machine_int_var(x), r, four);
+  BOOST_CHECK(extended.int_to_interval(x) ==
+              Interval(Int(1, 32, Signed), Int(3, 32, Signed)));
+
+  // A misaligned write drops the smash cell
+  auto misaligned = inv;
+  misaligned.mem_write(s, Literal::machine_int(Int(0, 16, Signed)), two);
+  misaligned.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(misaligned.int_to_interval(x) == Interval::top(32, Signed));
+
+  // A misaligned read gives no information
+  auto misaligned_read = inv;
+  misaligned_read.mem_read(Literal::machine_int_var(x), s, four);
+  BOOST_CHECK(misaligned_read.int_to_interval(x) ==
+              Interval::top(32, Signed));
+
+  // Forgetting the memory location clears its summary
+  auto forgotten = inv;
+  forgotten.mem_forget(a);
+  forgotten.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(forgotten.int_to_interval(x) == Interval::top(32, Signed));
+  forgotten.mem_write(p, Literal::machine_int(Int(7, 32, Signed)), four);
+  forgotten.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(forgotten.int_to_interval(x) == Interval(Int(7, 32, Signed)));
+  BOOST_CHECK(forgotten.leq(make_top(vfac, &summarization)));
+}
+
+BOOST_AUTO_TEST_CASE(write_array) {
+  VariableFactory vfac;
+  MemoryFactory mfac;
+  Variable x(vfac.get_int("x", 32, Signed));
+  Variable v(vfac.get_int("v", 32, Signed));
+  Variable p(vfac.get_pointer("p", 64, Unsigned));
+  Variable q(vfac.get_pointer("q", 64, Unsigned));
+  Variable r(vfac.get_pointer("r", 64, Unsigned));
+  MemoryLocation a(mfac.get("a"));
+  Int four(4, 64, Unsigned);
+
+  // Does not require cell summarization
+  auto inv = make_top(vfac);
+  inv.pointer_assign(p, a, Nullity::non_null());
+  inv.pointer_assign(q, p, Int(4000, 64, Unsigned));
+  inv.pointer_assign(r, p, Int(8000, 64, Unsigned));
+  inv.int_set(v, Interval(Int(-3, 32, Signed), Int(7, 32, Signed)));
+  inv.mem_write_array(p,
+                      Literal::machine_int_var(v),
+                      four,
+                      Int(8000, 64, Unsigned));
+
+  // Every element holds the written value
+  auto read = inv;
+  read.mem_read(Literal::machine_int_var(x), q, four);
+  BOOST_CHECK(read.int_to_interval(x) ==
+              Interval(Int(-3, 32, Signed), Int(7, 32, Signed)));
+
+  // Bytes after the array are unknown
+  read = inv;
+  read.mem_read(Literal::machine_int_var(x), r, four);
+  BOOST_CHECK(read.int_to_interval(x) == Interval::top(32, Signed));
+
+  // Writes on the array are weak updates
+  auto weak = inv;
+  weak.mem_write(q, Literal::machine_int(Int(9, 32, Signed)), four);
+  weak.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(weak.int_to_interval(x) ==
+              Interval(Int(-3, 32, Signed), Int(9, 32, Signed)));
+
+  // A single element array is a regular write
+  auto single = make_top(vfac);
+  single.pointer_assign(p, a, Nullity::non_null());
+  single.mem_write_array(p,
+                         Literal::machine_int(Int(1, 32, Signed)),
+                         four,
+                         four);
+  single.mem_read(Literal::machine_int_var(x), p, four);
+  BOOST_CHECK(single.int_to_interval(x) == Interval(Int(1, 32, Signed)));
+}
@@ -752,6 +752,54 @@ BOOST_AUTO_TEST_CASE(add) {
   BOOST_CHECK(inv.is_bottom());
 }
 
+BOOST_AUTO_TEST_CASE(incremental_closure) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+  Variable z(vfac.get("z"));
+  Variable w(vfac.get("w"));
+
+  // Constraints added on a normalized matrix are propagated immediately
+  auto inv = DBM::top();
+  inv.add(VariableExpr(x) - VariableExpr(y) <= 1);
+  inv.add(VariableExpr(y) - VariableExpr(z) <= 2);
+  inv.add(VariableExpr(z) - VariableExpr(w) <= 3);
+  inv.add(VariableExpr(w) <= 0);
+  BOOST_CHECK(inv.to_interval(z) ==
+              Interval(Bound::minus_infinity(), Bound(3)));
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Bound::minus_infinity(), Bound(5)));
+  BOOST_CHECK(inv.to_interval(x) ==
+              Interval(Bound::minus_infinity(), Bound(6)));
+
+  // Same result with a lazy normalization
+  auto inv2 = DBM::top();
+  inv2.add(VariableExpr(w) <= 0);
+  inv2 = inv2.widening(inv2);
+  inv2.add(VariableExpr(x) - VariableExpr(y) <= 1);
+  inv2.add(VariableExpr(y) - VariableExpr(z) <= 2);
+  inv2.add(VariableExpr(z) - VariableExpr(w) <= 3);
+  inv2.add(VariableExpr(w) <= 0);
+  inv2.normalize();
+  BOOST_CHECK(inv2.equals(inv));
+
+  // Assignments keep the matrix normalized
+  inv.assign(y, VariableExpr(z) + 1);
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Bound::minus_infinity(), Bound(4)));
+  inv.apply(BinaryOperator::Add, y, y, ZNumber(2));
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Bound::minus_infinity(), Bound(6)));
+  inv.add(VariableExpr(z) >= 3);
+  BOOST_CHECK(inv.to_interval(z) == Interval(3));
+  BOOST_CHECK(inv.to_interval(y) == Interval(6));
+  BOOST_CHECK(inv.to_interval(w) == Interval(0));
+
+  // Negative cycle
+  inv.add(VariableExpr(y) - VariableExpr(w) <= 5);
+  BOOST_CHECK(inv.is_bottom());
+}
+
 BOOST_AUTO_TEST_CASE(set) {
   VariableFactory vfac;
   Variable x(vfac.get("x"));
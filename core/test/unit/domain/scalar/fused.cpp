@@ -0,0 +1,394 @@
+/*******************************************************************************
+ *
+ * Tests for scalar::FusedDomain
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_scalar_fused_domain
+#define BOOST_TEST_DYN_LINK
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/machine_int/interval.hpp>
+#include <ikos/core/domain/nullity/separate_domain.hpp>
+#include <ikos/core/domain/scalar/composite.hpp>
+#include <ikos/core/domain/scalar/fused.hpp>
+#include <ikos/core/domain/uninitialized/separate_domain.hpp>
+#include <ikos/core/example/memory_factory.hpp>
+#include <ikos/core/example/scalar/variable_factory.hpp>
+
+using Int = ikos::core::MachineInt;
+using Interval = ikos::core::machine_int::Interval;
+using ikos::core::Nullity;
+using ikos::core::Signed;
+using ikos::core::Unsigned;
+using ikos::core::machine_int::BinaryOperator;
+using IntPredicate = ikos::core::machine_int::Predicate;
+using PointerPredicate = ikos::core::pointer::Predicate;
+using VariableFactory = ikos::core::example::scalar::VariableFactory;
+using Variable = VariableFactory::VariableRef;
+using MemoryFactory = ikos::core::example::MemoryFactory;
+using MemoryLocation = MemoryFactory::MemoryLocationRef;
+using PointsToSet = ikos::core::PointsToSet< MemoryLocation >;
+using IntervalDomain = ikos::core::machine_int::IntervalDomain< Variable >;
+using UninitializedDomain =
+    ikos::core::uninitialized::SeparateDomain< Variable >;
+using NullityDomain = ikos::core::nullity::SeparateDomain< Variable >;
+using CompositeDomain =
+    ikos::core::scalar::CompositeDomain< Variable,
+                                         MemoryLocation,
+                                         UninitializedDomain,
+                                         IntervalDomain,
+                                         NullityDomain >;
+using FusedDomain =
+    ikos::core::scalar::FusedDomain< Variable, MemoryLocation, IntervalDomain >;
+
+static FusedDomain make_top() {
+  return FusedDomain(IntervalDomain::top());
+}
+
+static FusedDomain make_bottom() {
+  return FusedDomain(IntervalDomain::bottom());
+}
+
+static CompositeDomain make_composite_top() {
+  return CompositeDomain(UninitializedDomain::top(),
+                         IntervalDomain::top(),
+                         NullityDomain::top());
+}
+
+BOOST_AUTO_TEST_CASE(is_top_and_bottom) {
+  VariableFactory vfac;
+  MemoryFactory mfac;
+  Variable x(vfac.get_int("x", 32, Signed));
+  Variable p(vfac.get_pointer("p", 32, Unsigned));
+  MemoryLocation a(mfac.get("a"));
+
+  BOOST_CHECK(make_top().is_top());
+  BOOST_CHECK(!make_top().is_bottom());
+
+  BOOST_CHECK(!make_bottom().is_top());
+  BOOST_CHECK(make_bottom().is_bottom());
+
+  auto inv = make_top();
+  inv.int_assign(x, Int(1, 32, Signed));
+  BOOST_CHECK(!inv.is_top());
+  BOOST_CHECK(!inv.is_bottom());
+
+  inv.pointer_assign(p, a, Nullity::non_null());
+  BOOST_CHECK(!inv.is_top());
+  BOOST_CHECK(!inv.is_bottom());
+
+  inv.nullity_assert_null(p);
+  BOOST_CHECK(!inv.is_top());
+  BOOST_CHECK(inv.is_bottom());
+
+  inv.set_to_top();
+  BOOST_CHECK(inv.is_top());
+  BOOST_CHECK(!inv.is_bottom());
+
+  inv.set_to_bottom();
+  BOOST_CHECK(!inv.is_top());
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(pointer) {
+  VariableFactory vfac;
+  MemoryFactory mfac;
+  Variable x(vfac.get_int("x", 32, Unsigned));
+  Variable p(vfac.get_pointer("p", 32, Unsigned));
+  Variable q(vfac.get_pointer("q", 32, Unsigned));
+  MemoryLocation a(mfac.get("a"));
+  MemoryLocation b(mfac.get("b"));
+
+  auto inv = make_top();
+  BOOST_CHECK(!inv.uninit_is_initialized(p));
+  BOOST_CHECK(!inv.nullity_is_null(p));
+  BOOST_CHECK(inv.pointer_to_points_to(p).is_top());
+
+  inv.pointer_assign(p, a, Nullity::non_null());
+  BOOST_CHECK(inv.uninit_is_initialized(p));
+  BOOST_CHECK(inv.nullity_is_non_null(p));
+  BOOST_CHECK(inv.pointer_to_points_to(p) == PointsToSet{a});
+  BOOST_CHECK(inv.pointer_offset_to_interval(p) ==
+              Interval(Int(0, 32, Unsigned)));
+
+  inv.pointer_assign(q, p, Int(4, 32, Unsigned));
+  BOOST_CHECK(inv.uninit_is_initialized(q));
+  BOOST_CHECK(inv.nullity_is_non_null(q));
+  BOOST_CHECK(inv.pointer_to_points_to(q) == PointsToSet{a});
+  BOOST_CHECK(inv.pointer_offset_to_interval(q) ==
+              Interval(Int(4, 32, Unsigned)));
+
+  inv.pointer_offset_to_int(x, q);
+  BOOST_CHECK(inv.uninit_is_initialized(x));
+  BOOST_CHECK(inv.int_to_interval(x) == Interval(Int(4, 32, Unsigned)));
+
+  auto inv2 = inv;
+  inv2.pointer_assign_null(q);
+  BOOST_CHECK(inv2.nullity_is_null(q));
+  BOOST_CHECK(inv2.pointer_to_points_to(q).is_empty());
+
+  auto inv3 = inv.join(inv2);
+  BOOST_CHECK(inv3.nullity_to_nullity(q).is_top());
+  BOOST_CHECK(inv3.pointer_to_points_to(q) == PointsToSet{a});
+  BOOST_CHECK(inv.leq(inv3));
+  BOOST_CHECK(inv2.leq(inv3));
+  BOOST_CHECK(!inv3.leq(inv));
+
+  inv3.pointer_add(PointerPredicate::NE, p, q);
+  BOOST_CHECK(!inv3.is_bottom());
+
+  auto inv4 = inv3;
+  inv4.nullity_assert_non_null(q);
+  BOOST_CHECK(inv4.nullity_is_non_null(q));
+  BOOST_CHECK(inv4.leq(inv3));
+  BOOST_CHECK(!inv3.leq(inv4));
+
+  auto inv5 = make_top();
+  inv5.pointer_assign(p, a, Nullity::non_null());
+  inv5.pointer_assign(q, b, Nullity::non_null());
+  inv5.pointer_add(PointerPredicate::EQ, p, q);
+  BOOST_CHECK(inv5.is_bottom());
+
+  auto inv6 = make_top();
+  inv6.pointer_assign_undef(p);
+  BOOST_CHECK(inv6.uninit_is_uninitialized(p));
+  inv6.pointer_assign(q, p);
+  BOOST_CHECK(inv6.uninit_is_uninitialized(q));
+  inv6.uninit_assert_initialized(q);
+  BOOST_CHECK(inv6.is_bottom());
+}
+
+namespace {
+
+/// \brief Variables and memory locations used by the random operations
+struct Environment {
+  std::vector< Variable > ints;
+  std::vector< Variable > offsets;
+  std::vector< Variable > pointers;
+  std::vector< MemoryLocation > locations;
+};
+
+/// \brief Random operation on a scalar domain
+struct Operation {
+  unsigned kind;
+  std::size_t a;
+  std::size_t b;
+  std::size_t c;
+  int n;
+};
+
+Operation random_operation(std::mt19937& rng, const Environment& env) {
+  std::uniform_int_distribution< unsigned > kind(0, 18);
+  std::uniform_int_distribution< std::size_t > var(0, env.ints.size() - 1);
+  std::uniform_int_distribution< int > n(-4, 4);
+  return Operation{kind(rng), var(rng), var(rng), var(rng), n(rng)};
+}
+
+template < typename Domain >
+void apply(Domain& inv, const Operation& op, const Environment& env) {
+  Variable x = env.ints[op.a];
+  Variable y = env.ints[op.b];
+  Variable z = env.ints[op.c];
+  Variable o = env.offsets[op.c];
+  Variable p = env.pointers[op.a];
+  Variable q = env.pointers[op.b];
+  MemoryLocation m = env.locations[op.c % env.locations.size()];
+  Int k(op.n, 32, Signed);
+
+  switch (op.kind) {
+    case 0: {
+      inv.int_assign(x, k);
+    } break;
+    case 1: {
+      inv.int_assign_undef(x);
+    } break;
+    case 2: {
+      inv.int_apply(BinaryOperator::Add, x, y, z);
+    } break;
+    case 3: {
+      inv.int_add(IntPredicate::LE, x, k);
+    } break;
+    case 4: {
+      inv.pointer_assign(p,
+                         m,
+                         (op.n < 0) ? Nullity::top() : Nullity::non_null());
+    } break;
+    case 5: {
+      inv.pointer_assign_null(p);
+    } break;
+    case 6: {
+      inv.pointer_assign_undef(p);
+    } break;
+    case 7: {
+      inv.pointer_assign(p, q);
+    } break;
+    case 8: {
+      inv.pointer_assign(p, q, Int(op.n & 7, 32, Unsigned));
+    } break;
+    case 9: {
+      inv.pointer_assign(p, q, o);
+    } break;
+    case 10: {
+      static const PointerPredicate preds[] = {PointerPredicate::EQ,
+                                               PointerPredicate::NE,
+                                               PointerPredicate::GT,
+                                               PointerPredicate::GE,
+                                               PointerPredicate::LT,
+                                               PointerPredicate::LE};
+      inv.pointer_add(preds[op.c % 6], p, q);
+    } break;
+    case 11: {
+      inv.nullity_assert_non_null(p);
+    } break;
+    case 12: {
+      inv.nullity_assert_null(p);
+    } break;
+    case 13: {
+      inv.pointer_forget(p);
+    } break;
+    case 14: {
+      inv.pointer_offset_to_int(x, p);
+    } break;
+    case 15: {
+      inv.uninit_assert_initialized((op.n < 0) ? x : p);
+    } break;
+    case 16: {
+      inv.pointer_assign_nondet(p);
+    } break;
+    case 17: {
+      inv.scalar_int_to_pointer(p, o, env.locations[0]);
+    } break;
+    case 18: {
+      inv.int_assign(o, Int(op.n & 7, 32, Unsigned));
+    } break;
+    default: {
+      ikos_unreachable("unreachable");
+    }
+  }
+}
+
+void check_same(const CompositeDomain& expected,
+                const FusedDomain& actual,
+                const Environment& env) {
+  BOOST_CHECK_EQUAL(expected.is_bottom(), actual.is_bottom());
+  if (expected.is_bottom() || actual.is_bottom()) {
+    return;
+  }
+  for (Variable x : env.ints) {
+    BOOST_CHECK(expected.uninit_to_uninitialized(x) ==
+                actual.uninit_to_uninitialized(x));
+    BOOST_CHECK(expected.int_to_interval(x) == actual.int_to_interval(x));
+  }
+  for (Variable o : env.offsets) {
+    BOOST_CHECK(expected.int_to_interval(o) == actual.int_to_interval(o));
+  }
+  for (Variable p : env.pointers) {
+    BOOST_CHECK(expected.pointer_to_pointer(p) ==
+                actual.pointer_to_pointer(p));
+    BOOST_CHECK(expected.nullity_to_nullity(p) ==
+                actual.nullity_to_nullity(p));
+    BOOST_CHECK(expected.pointer_to_points_to(p) ==
+                actual.pointer_to_points_to(p));
+  }
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(same_as_composite) {
+  VariableFactory vfac;
+  MemoryFactory mfac;
+  Environment env;
+  for (int i = 0; i < 4; i++) {
+    env.ints.push_back(vfac.get_int("x" + std::to_string(i), 32, Signed));
+    env.offsets.push_back(
+        vfac.get_int("o" + std::to_string(i), 32, Unsigned));
+    env.pointers.push_back(
+        vfac.get_pointer("p" + std::to_string(i), 32, Unsigned));
+  }
+  for (int i = 0; i < 3; i++) {
+    env.locations.push_back(mfac.get("m" + std::to_string(i)));
+  }
+
+  std::mt19937 rng(42);
+  for (int run = 0; run < 200; run++) {
+    auto composite_prefix = make_composite_top();
+    auto fused_prefix = make_top();
+    for (int i = 0; i < 6; i++) {
+      Operation op = random_operation(rng, env);
+      apply(composite_prefix, op, env);
+      apply(fused_prefix, op, env);
+      check_same(composite_prefix, fused_prefix, env);
+    }
+
+    auto composite1 = composite_prefix;
+    auto fused1 = fused_prefix;
+    auto composite2 = composite_prefix;
+    auto fused2 = fused_prefix;
+    for (int i = 0; i < 6; i++) {
+      Operation op1 = random_operation(rng, env);
+      apply(composite1, op1, env);
+      apply(fused1, op1, env);
+      check_same(composite1, fused1, env);
+
+      Operation op2 = random_operation(rng, env);
+      apply(composite2, op2, env);
+      apply(fused2, op2, env);
+      check_same(composite2, fused2, env);
+    }
+
+    check_same(composite1.join(composite2), fused1.join(fused2), env);
+    check_same(composite1.widening(composite2), fused1.widening(fused2), env);
+    check_same(composite1.meet(composite2), fused1.meet(fused2), env);
+    check_same(composite1.narrowing(composite2),
+               fused1.narrowing(fused2),
+               env);
+    BOOST_CHECK_EQUAL(composite1.leq(composite2), fused1.leq(fused2));
+    BOOST_CHECK_EQUAL(composite2.leq(composite1), fused2.leq(fused1));
+    BOOST_CHECK_EQUAL(composite1.equals(composite2), fused1.equals(fused2));
+
+    auto composite_join = composite1;
+    composite_join.join_with(composite2);
+    auto fused_join = fused1;
+    fused_join.join_with(fused2);
+    check_same(composite_join, fused_join, env);
+  }
+}
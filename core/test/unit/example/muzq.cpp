@@ -566,3 +566,77 @@ BOOST_AUTO_TEST_CASE(test6) {
   BOOST_CHECK(end.to_interval(temp1) ==
               ZInterval(ZBound(5), ZBound::plus_infinity()));
 }
+
+BOOST_AUTO_TEST_CASE(sparse) {
+  ControlFlowGraph cfg("entry");
+
+  BasicBlock* entry = cfg.get("entry");
+  BasicBlock* outer = cfg.get("outer");
+  BasicBlock* outer_t = cfg.get("outer_t");
+  BasicBlock* inner = cfg.get("inner");
+  BasicBlock* inner_t = cfg.get("inner_t");
+  BasicBlock* inner_f = cfg.get("inner_f");
+  BasicBlock* outer_f = cfg.get("outer_f");
+  BasicBlock* ret = cfg.get("ret");
+
+  VariableFactory vfac;
+  Variable i(vfac.get("i"));
+  Variable j(vfac.get("j"));
+  Variable k(vfac.get("k"));
+
+  entry->add_successor(outer);
+  outer->add_successor(outer_t);
+  outer->add_successor(outer_f);
+  outer_t->add_successor(inner);
+  inner->add_successor(inner_t);
+  inner->add_successor(inner_f);
+  inner_t->add_successor(inner);
+  inner_f->add_successor(outer);
+  outer_f->add_successor(ret);
+
+  entry->add(std::make_unique< ZLinearAssignment >(i, ZLinearExpression(0)));
+  entry->add(std::make_unique< ZLinearAssignment >(k, ZLinearExpression(0)));
+
+  outer_t->add(std::make_unique< ZLinearAssertion >(ZVarExpr(i) <= 9));
+  outer_t->add(std::make_unique< ZLinearAssignment >(j, ZLinearExpression(0)));
+
+  inner_t->add(std::make_unique< ZLinearAssertion >(ZVarExpr(j) <= 4));
+  inner_t->add(std::make_unique< ZLinearAssignment >(j, ZVarExpr(j) + 1));
+  inner_t->add(std::make_unique< ZLinearAssignment >(k, ZVarExpr(k) + 1));
+
+  inner_f->add(std::make_unique< ZLinearAssertion >(ZVarExpr(j) >= 5));
+  inner_f->add(std::make_unique< ZLinearAssignment >(i, ZVarExpr(i) + 1));
+
+  outer_f->add(std::make_unique< ZLinearAssertion >(ZVarExpr(i) >= 10));
+
+  ret->add(std::make_unique< CheckPoint >("end"));
+
+  muzq::FixpointIterator< Variable, ZIntervalDomain, QIntervalDomain > dense(
+      cfg);
+  dense.run({ZIntervalDomain::top(), QIntervalDomain::top()});
+
+  muzq::FixpointIterator< Variable, ZIntervalDomain, QIntervalDomain > sparse(
+      cfg, /* sparse = */ true);
+  sparse.run({ZIntervalDomain::top(), QIntervalDomain::top()});
+
+  // Only the entry and cycle heads are kept
+  BOOST_CHECK(!sparse.pre(entry).is_bottom());
+  BOOST_CHECK(!sparse.pre(outer).is_bottom());
+  BOOST_CHECK(!sparse.pre(inner).is_bottom());
+  BOOST_CHECK(sparse.pre(outer_t).is_bottom());
+  BOOST_CHECK(sparse.pre(inner_t).is_bottom());
+  BOOST_CHECK(sparse.pre(ret).is_bottom());
+
+  ZIntervalDomain end = sparse.checkpoint("end").first();
+  BOOST_CHECK(end.to_interval(i) == ZInterval(10));
+
+  // Recomputed pre invariants are the same as the ones of the dense mode
+  std::size_t visited = 0;
+  sparse.for_each_pre([&](BasicBlock* bb, auto pre) {
+    BOOST_CHECK(pre.leq(dense.pre(bb)));
+    BOOST_CHECK(dense.pre(bb).leq(pre));
+    visited++;
+    return sparse.analyze_node(bb, std::move(pre));
+  });
+  BOOST_CHECK(visited == 8);
+}
@@ -0,0 +1,121 @@
+/*******************************************************************************
+ *
+ * Tests for MemoryUsage
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_memory_usage
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/adt/patricia_tree/map.hpp>
+#include <ikos/core/domain/numeric/dbm.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/number/z_number.hpp>
+#include <ikos/core/support/memory_usage.hpp>
+
+using Index = ikos::core::Index;
+using MemoryUsage = ikos::core::MemoryUsage;
+using MemoryCategory = ikos::core::MemoryCategory;
+using MemoryAccount = ikos::core::MemoryAccount;
+using ZNumber = ikos::core::ZNumber;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = ikos::core::example::VariableFactory::VariableRef;
+using VariableExpr = ikos::core::VariableExpression< ZNumber, Variable >;
+using DBM = ikos::core::numeric::DBM< ZNumber, Variable >;
+
+BOOST_AUTO_TEST_CASE(disabled) {
+  std::size_t initial = MemoryUsage::total(MemoryCategory::DBM);
+  if (!MemoryUsage::enabled()) {
+    MemoryAccount a(MemoryCategory::DBM);
+    a.update(100);
+    BOOST_CHECK(MemoryUsage::total(MemoryCategory::DBM) == initial);
+    BOOST_CHECK(a.size() == 100);
+  }
+  MemoryUsage::enable();
+  BOOST_CHECK(MemoryUsage::enabled());
+}
+
+BOOST_AUTO_TEST_CASE(memory_account) {
+  MemoryUsage::enable();
+  std::size_t initial = MemoryUsage::total(MemoryCategory::DBM);
+  {
+    MemoryAccount a(MemoryCategory::DBM);
+    a.update(100);
+    BOOST_CHECK(MemoryUsage::total(MemoryCategory::DBM) == initial + 100);
+
+    MemoryAccount b(a);
+    BOOST_CHECK(MemoryUsage::total(MemoryCategory::DBM) == initial + 200);
+
+    MemoryAccount c(std::move(b));
+    BOOST_CHECK(MemoryUsage::total(MemoryCategory::DBM) == initial + 200);
+
+    c.update(50);
+    BOOST_CHECK(MemoryUsage::total(MemoryCategory::DBM) == initial + 150);
+  }
+  BOOST_CHECK(MemoryUsage::total(MemoryCategory::DBM) == initial);
+}
+
+BOOST_AUTO_TEST_CASE(patricia_tree) {
+  MemoryUsage::enable();
+  std::size_t initial = MemoryUsage::total(MemoryCategory::PatriciaTree);
+  {
+    ikos::core::PatriciaTreeMap< Index, int > m;
+    for (Index i = 0; i < 100; i++) {
+      m.insert_or_assign(i, static_cast< int >(i));
+    }
+    BOOST_CHECK(MemoryUsage::total(MemoryCategory::PatriciaTree) > initial);
+  }
+  BOOST_CHECK(MemoryUsage::total(MemoryCategory::PatriciaTree) == initial);
+}
+
+BOOST_AUTO_TEST_CASE(dbm) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+
+  MemoryUsage::enable();
+  std::size_t initial = MemoryUsage::total(MemoryCategory::DBM);
+  {
+    auto inv = DBM::top();
+    inv.add(VariableExpr(x) - VariableExpr(y) <= 1);
+    BOOST_CHECK(MemoryUsage::total(MemoryCategory::DBM) > initial);
+  }
+  BOOST_CHECK(MemoryUsage::total(MemoryCategory::DBM) == initial);
+}
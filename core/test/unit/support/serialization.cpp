@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * Tests for serialization
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_serialization
+#define BOOST_TEST_DYN_LINK
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/support/serialization.hpp>
+#include <ikos/core/value/machine_int/serialization.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using Int = ikos::core::MachineInt;
+using Interval = ikos::core::machine_int::Interval;
+using Congruence = ikos::core::machine_int::Congruence;
+using IntervalCongruence = ikos::core::machine_int::IntervalCongruence;
+using ikos::core::InputArchive;
+using ikos::core::OutputArchive;
+using ikos::core::SerializationError;
+using ikos::core::Signed;
+using ikos::core::Unsigned;
+
+template < typename T >
+static T round_trip(const T& obj) {
+  std::stringstream buf;
+  {
+    OutputArchive ar(buf);
+    ikos::core::save(ar, obj);
+  }
+  InputArchive ar(buf);
+  return ikos::core::load< T >(ar);
+}
+
+BOOST_AUTO_TEST_CASE(primitives) {
+  BOOST_CHECK(round_trip(0U) == 0U);
+  BOOST_CHECK(round_trip(127U) == 127U);
+  BOOST_CHECK(round_trip(128U) == 128U);
+  BOOST_CHECK(round_trip(UINT64_MAX) == UINT64_MAX);
+  BOOST_CHECK(round_trip(true));
+  BOOST_CHECK(!round_trip(false));
+  BOOST_CHECK(round_trip(std::string()).empty());
+  BOOST_CHECK(round_trip(std::string("a\0b", 3)) == std::string("a\0b", 3));
+}
+
+BOOST_AUTO_TEST_CASE(numbers) {
+  BOOST_CHECK(round_trip(ZNumber(0)) == ZNumber(0));
+  BOOST_CHECK(round_trip(ZNumber(-42)) == ZNumber(-42));
+  ZNumber big = ZNumber(1) << 200;
+  BOOST_CHECK(round_trip(big) == big);
+
+  BOOST_CHECK(round_trip(Int(-1, 8, Signed)) == Int(-1, 8, Signed));
+  BOOST_CHECK(round_trip(Int(255, 8, Unsigned)) == Int(255, 8, Unsigned));
+  Int wide = Int::max(128, Unsigned);
+  BOOST_CHECK(round_trip(wide) == wide);
+}
+
+BOOST_AUTO_TEST_CASE(values) {
+  Interval i(Int(-3, 32, Signed), Int(7, 32, Signed));
+  BOOST_CHECK(round_trip(i) == i);
+  BOOST_CHECK(round_trip(Interval::top(32, Signed)) ==
+              Interval::top(32, Signed));
+  BOOST_CHECK(round_trip(Interval::bottom(16, Unsigned)).is_bottom());
+
+  Congruence c(Int(4, 32, Unsigned), Int(1, 32, Unsigned));
+  BOOST_CHECK(round_trip(c) == c);
+  BOOST_CHECK(round_trip(Congruence::bottom(8, Signed)).is_bottom());
+
+  IntervalCongruence ic(Interval(Int(1, 32, Unsigned), Int(9, 32, Unsigned)),
+                        c);
+  BOOST_CHECK(round_trip(ic) == ic);
+  BOOST_CHECK(round_trip(IntervalCongruence::bottom(32, Signed)).is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_archives) {
+  {
+    std::stringstream buf("not an archive");
+    BOOST_CHECK_THROW(InputArchive ar(buf), SerializationError);
+  }
+  {
+    std::stringstream buf;
+    {
+      OutputArchive ar(buf);
+      ikos::core::save(ar, Int(42, 32, Signed));
+    }
+    std::string data = buf.str();
+    std::stringstream truncated(data.substr(0, data.size() - 1));
+    InputArchive ar(truncated);
+    BOOST_CHECK_THROW(ikos::core::load< Int >(ar), SerializationError);
+  }
+  {
+    std::stringstream buf;
+    {
+      OutputArchive ar(buf);
+      ikos::core::save(ar, 300U);
+    }
+    InputArchive ar(buf);
+    BOOST_CHECK_THROW(ikos::core::load< uint8_t >(ar), SerializationError);
+  }
+  {
+    // A corrupted string size must not be allocated upfront
+    std::stringstream buf;
+    {
+      OutputArchive ar(buf);
+      ar.write_uint(UINT64_MAX);
+      ar.write_bool(true);
+    }
+    InputArchive ar(buf);
+    BOOST_CHECK_THROW(ar.read_string(), SerializationError);
+  }
+}
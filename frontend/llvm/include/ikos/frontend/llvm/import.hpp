@@ -49,3 +49,4 @@
 
 #include <ikos/frontend/llvm/import/exception.hpp>
 #include <ikos/frontend/llvm/import/importer.hpp>
+#include <ikos/frontend/llvm/import/reachability.hpp>
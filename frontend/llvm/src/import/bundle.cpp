@@ -134,6 +134,7 @@ ar::Code* BundleImporter::translate_global_variable_initializer(
 
   // Initialize the ar::Code initializer
   ar::Code* init = ar_gv->initializer();
+  ar::Arena::Scope scope(init->arena());
   ar::BasicBlock* bb = ar::BasicBlock::create(init);
   init->set_entry_block(bb);
   init->set_exit_block(bb);
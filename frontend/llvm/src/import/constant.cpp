@@ -296,13 +296,31 @@ ar::VectorConstant* ConstantImporter::translate_constant_vector(
   return ar::VectorConstant::get(this->_context, type, values);
 }
 
-ar::ArrayConstant* ConstantImporter::translate_constant_data_array(
+ar::Constant* ConstantImporter::translate_constant_data_array(
     llvm::ConstantDataArray* cst,
     ar::ArrayType* type,
     ar::BasicBlock* bb,
     ConstantExpressionList& exprs) {
-  ar::ArrayConstant::Values values;
   ikos_assert(cst->getNumElements() == type->num_elements());
+
+  if (cst->getElementType()->isIntegerTy()) {
+    ikos_assert(type->element_type()->is_integer());
+    std::size_t size = cst->getElementByteSize();
+    std::string data;
+    data.reserve(cst->getNumElements() * size);
+
+    // Store the elements in little-endian byte order
+    for (unsigned i = 0; i < cst->getNumElements(); i++) {
+      uint64_t n = cst->getElementAsInteger(i);
+      for (std::size_t j = 0; j < size; j++) {
+        data.push_back(static_cast< char >((n >> (8 * j)) & 0xFF));
+      }
+    }
+
+    return ar::DataArrayConstant::get(this->_context, type, data);
+  }
+
+  ar::ArrayConstant::Values values;
   values.reserve(cst->getNumElements());
 
   for (unsigned i = 0; i < cst->getNumElements(); i++) {
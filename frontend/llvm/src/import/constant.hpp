@@ -175,8 +175,12 @@ private:
                                                 ar::BasicBlock* bb,
                                                 ConstantExpressionList& exprs);
 
-  /// \brief Translate a llvm::ConstantDataArray into an ar::ArrayConstant
-  ar::ArrayConstant* translate_constant_data_array(
+  /// \brief Translate a llvm::ConstantDataArray into an ar::DataArrayConstant
+  /// or an ar::ArrayConstant
+  ///
+  /// Arrays of integers are stored as raw bytes, other arrays are translated
+  /// element by element.
+  ar::Constant* translate_constant_data_array(
       llvm::ConstantDataArray* cst,
       ar::ArrayType* type,
       ar::BasicBlock* bb,
@@ -66,6 +66,9 @@ namespace frontend {
 namespace import {
 
 ar::Code* FunctionImporter::translate_body() {
+  // Allocate the statements in the arena of the code
+  ar::Arena::Scope scope(this->_body->arena());
+
   // Translate parameters
   this->translate_parameters();
 
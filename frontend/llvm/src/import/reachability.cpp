@@ -0,0 +1,183 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Remove the functions unreachable from the entry points
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/GlobalAlias.h>
+#include <llvm/IR/GlobalIFunc.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/InstIterator.h>
+
+#include <ikos/frontend/llvm/import/reachability.hpp>
+
+namespace ikos {
+namespace frontend {
+namespace import {
+
+namespace {
+
+/// \brief Compute the reachable functions of a module
+class ReachabilityAnalysis {
+private:
+  /// \brief Reachable functions
+  llvm::SmallPtrSet< llvm::Function*, 32 > _reachable;
+
+  /// \brief Reachable functions whose body has not been visited yet
+  llvm::SmallVector< llvm::Function*, 32 > _worklist;
+
+  /// \brief Visited constants
+  llvm::SmallPtrSet< llvm::Constant*, 32 > _visited;
+
+public:
+  /// \brief Mark the given function reachable
+  void add_function(llvm::Function* fun) {
+    if (this->_reachable.insert(fun).second) {
+      this->_worklist.push_back(fun);
+    }
+  }
+
+  /// \brief Mark all the functions referenced by the given constant reachable
+  void add_constant(llvm::Constant* cst) {
+    if (!this->_visited.insert(cst).second) {
+      return;
+    }
+
+    if (auto fun = llvm::dyn_cast< llvm::Function >(cst)) {
+      this->add_function(fun);
+    } else if (auto alias = llvm::dyn_cast< llvm::GlobalAlias >(cst)) {
+      this->add_constant(alias->getAliasee());
+    } else if (auto ifunc = llvm::dyn_cast< llvm::GlobalIFunc >(cst)) {
+      this->add_constant(ifunc->getResolver());
+    } else if (llvm::isa< llvm::GlobalValue >(cst)) {
+      // Global variables are handled separately
+      return;
+    } else {
+      // Constant expressions and aggregates
+      for (llvm::Value* op : cst->operand_values()) {
+        this->add_constant(llvm::cast< llvm::Constant >(op));
+      }
+    }
+  }
+
+  /// \brief Visit the reachable functions until a fixpoint is reached
+  void run() {
+    while (!this->_worklist.empty()) {
+      llvm::Function* fun = this->_worklist.pop_back_val();
+
+      if (fun->hasPersonalityFn()) {
+        this->add_constant(fun->getPersonalityFn());
+      }
+
+      for (auto it = llvm::inst_begin(fun), et = llvm::inst_end(fun); it != et;
+           ++it) {
+        for (llvm::Value* op : it->operand_values()) {
+          if (auto cst = llvm::dyn_cast< llvm::Constant >(op)) {
+            this->add_constant(cst);
+          }
+        }
+      }
+    }
+  }
+
+  /// \brief Return true if the given function is reachable
+  bool is_reachable(llvm::Function* fun) const {
+    return this->_reachable.count(fun) != 0;
+  }
+
+}; // end class ReachabilityAnalysis
+
+} // end anonymous namespace
+
+std::size_t remove_unreachable_functions(
+    llvm::Module& module, const std::vector< llvm::Function* >& entry_points) {
+  ReachabilityAnalysis reachability;
+
+  for (llvm::Function* fun : entry_points) {
+    reachability.add_function(fun);
+  }
+
+  // Global variables are initialized before the entry points are called
+  for (llvm::GlobalVariable& gv : module.globals()) {
+    if (gv.hasInitializer()) {
+      reachability.add_constant(gv.getInitializer());
+    }
+  }
+
+  // Aliases and indirect functions are not tracked through their uses
+  for (llvm::GlobalAlias& alias : module.aliases()) {
+    reachability.add_constant(alias.getAliasee());
+  }
+  for (llvm::GlobalIFunc& ifunc : module.ifuncs()) {
+    reachability.add_constant(ifunc.getResolver());
+  }
+
+  reachability.run();
+
+  // Drop the bodies first, since unreachable functions might reference each
+  // other
+  std::vector< llvm::Function* > unreachable;
+  for (llvm::Function& fun : module) {
+    if (!fun.isDeclaration() && !reachability.is_reachable(&fun)) {
+      fun.dropAllReferences();
+      unreachable.push_back(&fun);
+    }
+  }
+
+  for (llvm::Function* fun : unreachable) {
+    fun->removeDeadConstantUsers();
+    if (fun->use_empty()) {
+      fun->eraseFromParent();
+    } else {
+      // Should not happen, keep a declaration
+      fun->deleteBody();
+      fun->setComdat(nullptr);
+    }
+  }
+
+  return unreachable.size();
+}
+
+} // end namespace import
+} // end namespace frontend
+} // end namespace ikos